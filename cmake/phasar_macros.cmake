@@ -29,6 +29,7 @@ function(add_phasar_unittest test_name)
     phasar_passes
     ${PHASAR_PLUGINS_LIB}
     phasar_pointer
+    phasar_syncpds
     phasar_phasarllvm_utils
     phasar_utils
     boost_program_options
@@ -10,8 +10,12 @@
 #ifndef PHASAR_CONTROLLER_ANALYSIS_CONTROLLER_H_
 #define PHASAR_CONTROLLER_ANALYSIS_CONTROLLER_H_
 
+#include <fstream>
+#include <functional>
 #include <iosfwd>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -22,8 +26,14 @@
 namespace psr {
 
 class ProjectIRDB;
+class AliasOracle;
+class LLVMBasedCFG;
+class LLVMBasedICFG;
+class LLVMTypeHierarchy;
+class JsonStreamWriter;
+class BinaryResultWriter;
 
-enum class ExportType { JSON = 0 };
+enum class ExportType { JSON = 0, BINARY };
 
 extern const std::map<std::string, ExportType> StringToExportType;
 
@@ -36,15 +46,119 @@ public:
   using json = nlohmann::json;
 
 private:
-  json FinalResultsJson;
+  std::ofstream ResultsStream;
+  std::unique_ptr<JsonStreamWriter> JsonResults;
+  std::unique_ptr<BinaryResultWriter> BinaryResults;
+  // serializes the results of solvers running in parallel
+  std::mutex ResultsMutex;
+  // wraps the results of every analysis into an object naming the analysis
+  bool TagResults = false;
+  // writes the strings of the nodes, facts and values of the binary results
+  bool ExportSymbols = true;
+  // prefix of the files that keep the solver state between incremental runs,
+  // empty if every analysis is solved from scratch
+  std::string IncrementalPrefix;
+  // releases the jump functions and incoming edges of finished calling
+  // contexts, see SolverConfiguration::collectFinishedMethods
+  bool CollectFinishedMethods = false;
+  // answers the alias queries of the taint and typestate analyses on demand
+  // with a SyncPDSSolver instead of the whole-module points-to graph
+  bool DemandDrivenAliases = false;
+
+  /**
+   * Returns the alias oracle for a single problem, nullptr if the
+   * whole-module points-to graph is used.
+   */
+  std::unique_ptr<AliasOracle> makeAliasOracle(LLVMBasedICFG &ICFG) const;
+
+  template <typename SolverT>
+  void emitResults(SolverT &Solver, DataFlowAnalysisType Analysis);
+
+  template <typename SolverT>
+  void emitResults(SolverT &Solver, DataFlowAnalysisType Analysis,
+                   const std::string &EntryPoint, long Runtime);
+
+  /**
+   * Solves the problem from scratch, unless IncrementalPrefix is set: then
+   * the state stored by a previous run in
+   * <IncrementalPrefix>.<Analysis>.state is restored and updated for the
+   * functions that have been edited since. The new state is stored in the
+   * same file. The problem must have solver_config.incremental set.
+   */
+  template <typename SolverT>
+  void solveIncrementally(SolverT &Solver, DataFlowAnalysisType Analysis,
+                          ProjectIRDB &IRDB);
+
+  /**
+   * Solves a separate instance of the problem built by MakeProblem for every
+   * entry point, on Threads threads (0 uses one per hardware thread). The
+   * ICFG, type hierarchy and points-to information are shared by all
+   * solvers, as are the cached flow and edge functions if the problem allows
+   * it. The results are emitted per entry point along with the solver's
+   * runtime as soon as it is done.
+   */
+  template <typename SolverT, typename MakeProblemT>
+  void solvePerEntryPoint(DataFlowAnalysisType Analysis,
+                          const std::vector<std::string> &EntryPoints,
+                          MakeProblemT MakeProblem, unsigned Threads,
+                          const std::string &EdgeLogPrefix);
+
+  /**
+   * Solves the analysis per entry point (see solvePerEntryPoint), returns
+   * false for analyses that cannot be solved this way.
+   */
+  bool fanOut(DataFlowAnalysisType Analysis, LLVMBasedICFG &ICFG,
+              LLVMTypeHierarchy &CH, ProjectIRDB &IRDB,
+              const std::vector<std::string> &EntryPoints, unsigned Threads,
+              const std::string &EdgeLogPrefix);
+
+  /**
+   * Solves a single analysis over the shared ICFG and emits its results. The
+   * exploded super-graph is logged to EdgeLogPrefix.edges unless
+   * EdgeLogPrefix is empty.
+   */
+  void runAnalysis(DataFlowAnalysisType Analysis, LLVMBasedICFG &ICFG,
+                   LLVMTypeHierarchy &CH, ProjectIRDB &IRDB, LLVMBasedCFG &CFG,
+                   const std::vector<std::string> &EntryPoints,
+                   const std::string &EdgeLogPrefix);
+
+  /**
+   * Prefix of the PAMM statistics of the solvers of Analysis, tells the
+   * analyses apart if they run in parallel.
+   */
+  std::string statisticsScope(DataFlowAnalysisType Analysis) const;
 
 public:
+  /**
+   * Calls Run for every analysis, running up to ParallelAnalyses of them at
+   * the same time (0 uses one per hardware thread). While ResidentSetSize
+   * (in KB) exceeds MemoryBudget (in KB, 0 is unlimited) no further analysis
+   * is started until a running one has finished. The first exception thrown
+   * by an analysis is rethrown once all of them are done.
+   */
+  static void
+  scheduleAnalyses(const std::vector<DataFlowAnalysisType> &Analyses,
+                   unsigned ParallelAnalyses, long MemoryBudget,
+                   const std::function<void(DataFlowAnalysisType)> &Run,
+                   const std::function<long()> &ResidentSetSize =
+                       AnalysisController::residentSetSize);
+
+  /**
+   * @brief Returns the resident set size of the process in KB, -1 if unknown.
+   */
+  static long residentSetSize();
+
+  /**
+   * Results are streamed to ResultsFile while the analyses are running, as a
+   * json array with one entry per analysis or in the binary format of
+   * BinaryResultWriter. No results are written if ResultsFile is empty.
+   */
   AnalysisController(ProjectIRDB &&IRDB,
                      std::vector<DataFlowAnalysisType> Analyses,
                      bool WPA_MODE = true, bool PrintEdgeRecorder = true,
-                     std::string graph_id = "");
-  ~AnalysisController() = default;
-  void writeResults(std::string filename);
+                     std::string graph_id = "", std::string ResultsFile = "",
+                     ExportType Export = ExportType::JSON);
+  ~AnalysisController();
 };
 
 } // namespace psr
@@ -0,0 +1,132 @@
+/******************************************************************************
+ * Copyright (c) 2018 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_CONTROLLER_ANALYSISSERVER_H_
+#define PHASAR_CONTROLLER_ANALYSISSERVER_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <json.hpp>
+
+#include <phasar/DB/ProjectIRDB.h>
+#include <phasar/PhasarLLVM/ControlFlow/ICFG.h>
+#include <phasar/PhasarLLVM/Utils/DataFlowAnalysisType.h>
+#include <phasar/PhasarLLVM/Utils/TaintSensitiveFunctions.h>
+
+namespace llvm {
+class Instruction;
+} // namespace llvm
+
+namespace psr {
+
+class LLVMBasedICFG;
+class LLVMTypeHierarchy;
+
+/**
+ * Loads a project once and keeps the IR database, the type hierarchy, the
+ * ICFG (and with it the points-to graphs) as well as the results of every
+ * analysis that has been solved resident, so that many small queries against
+ * the same program can be answered without rebuilding any of them.
+ *
+ * Requests are single lines of whitespace separated words, every request is
+ * answered by a single line holding a json object with a "Status" of "ok" or
+ * "error":
+ *
+ *   facts <analysis> <instruction id>  facts holding at the instruction with
+ *                                      the given psr.id, solves the analysis
+ *                                      on first use
+ *   leaks <entry point>                leaks found by the IFDS taint analysis
+ *                                      starting at the given entry point
+ *   run <analysis>                     solves the analysis again
+ *   stats                              request latencies and resident analyses
+ *   shutdown                           stops serving
+ *
+ * Requests are answered one after another, the resident results are not
+ * synchronized. The solver statistics of an analysis are reported to PAMM
+ * under the analysis (and entry point), summed over all of its solves.
+ *
+ * @brief Answers queries about a resident project over a Unix domain socket.
+ */
+class AnalysisServer {
+public:
+  using json = nlohmann::json;
+
+  /// Results of a solved analysis that are kept resident.
+  class ResidentResults {
+  public:
+    virtual ~ResidentResults() = default;
+    virtual json factsAt(const llvm::Instruction *I) = 0;
+    /// Leaks found by the analysis, null if it does not report leaks.
+    virtual json leaks() = 0;
+  };
+
+private:
+  struct RequestLatency {
+    size_t Count = 0;
+    long TotalMicros = 0;
+    long MaxMicros = 0;
+  };
+
+  ProjectIRDB IRDB;
+  std::vector<std::string> EntryPoints;
+  TaintSensitiveFunctions TSF;
+  std::unique_ptr<LLVMTypeHierarchy> CH;
+  std::unique_ptr<LLVMBasedICFG> ICFG;
+  std::map<DataFlowAnalysisType, std::unique_ptr<ResidentResults>> Solutions;
+  // taint analyses solved for a single entry point
+  std::map<std::string, std::unique_ptr<ResidentResults>> TaintSolutions;
+  std::map<std::string, RequestLatency> Latencies;
+  bool Serving = false;
+
+  std::unique_ptr<ResidentResults>
+  solve(DataFlowAnalysisType Analysis,
+        const std::vector<std::string> &EntryPoints);
+  ResidentResults &getSolution(DataFlowAnalysisType Analysis);
+  DataFlowAnalysisType getAnalysis(const std::string &Name) const;
+
+  json factsAt(DataFlowAnalysisType Analysis, size_t InstructionId);
+  json leaksFor(const std::string &EntryPoint);
+  json rerun(DataFlowAnalysisType Analysis);
+  json getStats() const;
+
+  void serveConnection(int Connection);
+
+public:
+  /**
+   * Links the modules of IRDB into a single module and builds the type
+   * hierarchy and the ICFG for the given entry points. The taint analyses
+   * use the sources and sinks of TSF.
+   */
+  AnalysisServer(ProjectIRDB &&IRDB,
+                 std::vector<std::string> EntryPoints = {"main"},
+                 CallGraphAnalysisType CGType = CallGraphAnalysisType::OTF,
+                 TaintSensitiveFunctions TSF = TaintSensitiveFunctions());
+  ~AnalysisServer();
+
+  /**
+   * Answers a single request (without the trailing newline) and records its
+   * latency.
+   */
+  std::string handleRequest(const std::string &Request);
+
+  /**
+   * Accepts connections on a Unix domain socket at SocketPath and answers
+   * their requests until a shutdown request arrives. An existing socket file
+   * at SocketPath is replaced, any other file is left alone and an exception
+   * is thrown.
+   */
+  void serve(const std::string &SocketPath);
+};
+
+} // namespace psr
+
+#endif
@@ -13,140 +13,180 @@
  *  Created on: 23.08.2016
  *      Author: pdschbrt
  */
-/*
+
 #ifndef PHASAR_DB_DBCONN_H_
 #define PHASAR_DB_DBCONN_H_
 
-#include <initializer_list>
-#include <iostream> // Because of SQL_STD_ERROR_HANDLING
+#include <cstdint>
+#include <functional>
 #include <memory>
-#include <set>
 #include <string>
+#include <vector>
 
-#include <llvm/IR/Module.h>
-
-#include <phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h>
-#include <phasar/PhasarLLVM/IfdsIde/IDESummary.h>
-#include <phasar/PhasarLLVM/Pointer/LLVMTypeHierarchy.h>
-#include <phasar/PhasarLLVM/Pointer/PointsToGraph.h>
-// If ProjectIRDB is no more returned, forward declare it and remove this
-#include <phasar/DB/ProjectIRDB.h>
+#include <json.hpp>
 
-#include <mysql_connection.h>
 #include <sqlite3.h>
 
 namespace llvm {
+class Module;
+class Function;
 class GlobalVariable;
-class LLVMContext;
 class StructType;
 } // namespace llvm
 
 namespace psr {
 
-enum class QueryReturnCode { DBTrue, DBFalse, DBError };
-
-#define SQL_STD_ERROR_HANDLING                                                 \
-  std::cout << "# ERR: SQLException in " << __FILE__;                          \
-  std::cout << "(" << __FUNCTION__ << ") on line " << __LINE__ << std::endl;   \
-  std::cout << "# ERR: " << e.what();                                          \
-  std::cout << " (MySQL error code: " << e.getErrorCode();                     \
-  std::cout << ", SQLState: " << e.getSQLState() << " )" << std::endl;
-
-// forward declarations
-class VTable;
+class ProjectIRDB;
+class LLVMBasedICFG;
+class LLVMTypeHierarchy;
+class PointsToGraph;
 
+/**
+ * Persists the IR of a project and the artifacts computed from it, i.e.
+ * call-graphs, points-to graphs and type hierarchies, in an embedded SQLite
+ * database. No database server is required.
+ *
+ * Every store operation runs in a single transaction and re-uses its prepared
+ * statements. All ids are assigned by SQLite (AUTOINCREMENT).
+ *
+ * @brief Embedded database for project IR and analysis artifacts.
+ */
 class DBConn {
+public:
+  using json = nlohmann::json;
+
 private:
-  DBConn();
-  ~DBConn();
-  sql::Driver *driver;
-  sql::Connection *conn;
-  const static std::string db_user;
-  const static std::string db_password;
-  const static std::string db_schema_name;
-  const static std::string db_server_address;
-  // Functions for internal use only
-  int getNextAvailableID(const std::string &TableName);
-  int getProjectID(const std::string &Identifier);
-  int getModuleID(const std::string &Identifier);
-  std::set<int> getModuleIDsFromProject(const std::string &Identifier);
-  int getModuleIDFromFunctionID(const unsigned functionID);
-  int getModuleIDFromTypeID(const unsigned typeID);
-  std::set<int> getFunctionID(const std::string &Identifier);
-  std::set<int> getGlobalVariableID(const std::string &Identifier);
-  int getTypeID(const std::string &Identifier);
-  std::size_t getFunctionHash(const unsigned functionID);
-  std::size_t getModuleHash(const unsigned moduleID);
-  QueryReturnCode moduleHasTypeHierarchy(const unsigned moduleID);
-  QueryReturnCode globalVariableIsDeclaration(const unsigned globalVariableID);
-  std::set<int> getAllTypeHierarchyIDs();
-  std::set<int> getAllModuleIDsFromTH(const unsigned typeHierarchyID);
-
-  bool schemeExists();
+  sqlite3 *db = nullptr;
+  std::string db_path;
+  bool batch_transactions = true;
+  std::size_t committed_transactions = 0;
+  const static std::string db_default_path;
+
+  void executeSQL(const std::string &SQL);
+  sqlite3_stmt *prepareStatement(const std::string &SQL);
+  void stepStatement(sqlite3_stmt *Stmt);
+  void beginTransaction();
+  void commitTransaction();
+  void rollbackTransaction();
   void buildDBScheme();
-  void dropDBAndRebuildScheme();
-
-  bool insertModule(const std::string &ProjectIdentifier,
-                    const llvm::Module *module);
-  std::unique_ptr<llvm::Module> getModule(const std::string &mod_name,
-                                          llvm::LLVMContext &Context);
-  bool insertGlobalVariable(const llvm::GlobalVariable &G,
-                            const unsigned moduleID);
-  bool insertFunction(const llvm::Function &F, const unsigned moduleID);
-  bool insertType(const llvm::StructType &ST, const unsigned moduleID);
-  bool insertVTable(const VTable &VTBL, const std::string &TypeName,
-                    const std::string &ProjectName);
-  void storeLTHGraphToHex(const LLVMTypeHierarchy::bidigraph_t &G,
-                          const std::string hex_id);
+
+  std::int64_t getProjectID(const std::string &Identifier);
+  std::int64_t getOrInsertProjectID(const std::string &Identifier);
+  std::int64_t getModuleID(const std::string &Identifier, std::size_t Hash);
+  std::int64_t insertModule(std::int64_t ProjectID, const llvm::Module *M);
+  /// An edge of a stored graph, vertices without out-edges have no target.
+  struct GraphEdge {
+    std::string Source;
+    std::string Target;
+    bool HasTarget = false;
+    // psr.id of the call-site of a call-graph edge, -1 otherwise
+    std::int64_t CallSite = -1;
+  };
+
+  void storeInTransaction(const std::function<void()> &Store);
+  std::int64_t insertGraph(const std::string &ProjectName,
+                           const std::string &Kind);
+  std::int64_t getGraphID(const std::string &ProjectName,
+                          const std::string &Kind);
+  void insertGraphEdge(sqlite3_stmt *Stmt, std::int64_t GraphID,
+                       const std::string &Source, const std::string *Target,
+                       std::int64_t CallSite = -1);
+  std::vector<GraphEdge> loadGraphEdges(std::int64_t GraphID);
+  void storeGraph(const std::string &ProjectName, const std::string &Kind,
+                  const json &Graph);
 
 public:
+  /**
+   * @brief Opens (or creates) the database stored at the given path.
+   */
+  explicit DBConn(const std::string &DBPath);
+  ~DBConn();
   DBConn(const DBConn &db) = delete;
   DBConn(DBConn &&db) = delete;
   DBConn &operator=(const DBConn &db) = delete;
   DBConn &operator=(DBConn &&db) = delete;
+
+  /**
+   * @brief Returns the database stored in the current working directory.
+   */
   static DBConn &getInstance();
   std::string getDBName();
 
+  /**
+   * If disabled, every row is written in a transaction of its own, which is
+   * how the former client/server based implementation operated. This only
+   * exists for comparing the write throughput of both approaches.
+   *
+   * @brief Enables or disables batching all writes of a store operation in
+   * a single transaction.
+   */
+  void setTransactionBatching(bool Enable);
+  /**
+   * @brief Returns the number of transactions this connection has committed.
+   */
+  std::size_t getNumberOfTransactions() const;
+
+  /**
+   * Modules that are already stored with an identical hash are skipped.
+   *
+   * @brief Stores all modules of the given IRDB along with their functions,
+   * global variables and struct types.
+   */
   void storeProjectIRDB(const std::string &ProjectName,
                         const ProjectIRDB &IRDB);
-  // We may want to pass an empty ProjectIRDB and do not return anything in
-  // order to suppress the copy constructor of ProjectIRDB and enforce a no copy
-  // rule.
+  /**
+   * @brief Restores all modules of the given project into a new IRDB.
+   */
   ProjectIRDB loadProjectIRDB(const std::string &ProjectName);
-
-  void storeLLVMBasedICFG(const LLVMBasedICFG &ICFG,
-                          const std::string &ProjectName, bool use_hs = false);
-  LLVMBasedICFG loadLLVMBasedICFGfromModule(const std::string &ModuleName,
-                                            bool use_hs = false);
-  LLVMBasedICFG
-  loadLLVMBasedICFGfromModules(std::initializer_list<std::string> ModuleNames,
-                               bool use_hs = false);
-  LLVMBasedICFG loadLLVMBasedICFGfromProject(const std::string &ProjectName,
-                                             bool use_hs = false);
-
-  void storePointsToGraph(const PointsToGraph &PTG,
-                          const std::string &ProjectName, bool use_hs = false);
-  PointsToGraph loadPointsToGraphFromFunction(const std::string &FunctionName,
-                                              bool use_hs = false);
-
+  /**
+   * @brief Returns the hash of the stored function definition or 0 if the
+   * function is not stored.
+   */
+  std::size_t getFunctionHash(const std::string &FunctionName);
+
+  /**
+   * The call-sites are stored by their psr.id along with the call-graph
+   * analysis and the entry points the ICFG has been constructed for.
+   *
+   * @brief Stores the call graph of the given ICFG.
+   */
+  void storeLLVMBasedICFG(LLVMBasedICFG &ICFG, const std::string &ProjectName,
+                          const std::vector<std::string> &EntryPoints = {
+                              "main"});
+  void storePointsToGraph(PointsToGraph &PTG, const std::string &ProjectName);
+  /**
+   * @brief Stores the type hierarchy graph and the virtual function tables.
+   */
   void storeLLVMTypeHierarchy(LLVMTypeHierarchy &TH,
-                              const std::string &ProjectName,
-                              bool use_hs = false);
-  LLVMTypeHierarchy
-  loadLLVMTypeHierarchyFromModule(const std::string &ModuleName,
-                                  bool use_hs = false);
-  LLVMTypeHierarchy loadLLVMTypeHierarchyFromModules(
-      std::initializer_list<std::string> ModuleNames, bool use_hs = false);
-  LLVMTypeHierarchy
-  loadLLVMTypeHierarchyFromProject(const std::string &ProjectName,
-                                   bool use_hs = false);
-
-  void storeIDESummary(const IDESummary &S);
-  IDESummary loadIDESummary(const std::string &FunctionName,
-                            const std::string &AnalysisName);
+                              const std::string &ProjectName);
+  /**
+   * The types are looked up by name in the modules of IRDB, which has to
+   * contain the modules the type hierarchy has been constructed for.
+   *
+   * @brief Restores the most recently stored type hierarchy of the project.
+   */
+  std::unique_ptr<LLVMTypeHierarchy>
+  loadLLVMTypeHierarchy(const std::string &ProjectName,
+                        const ProjectIRDB &IRDB);
+  /**
+   * Functions are looked up by name and call-sites by their psr.id in IRDB,
+   * which has to be preprocessed. The whole-module points-to graph is rebuilt
+   * from the points-to graphs of IRDB.
+   *
+   * @brief Restores the most recently stored call graph of the project.
+   */
+  std::unique_ptr<LLVMBasedICFG>
+  loadLLVMBasedICFG(const std::string &ProjectName, LLVMTypeHierarchy &CH,
+                    ProjectIRDB &IRDB);
+  /**
+   * @brief Loads the most recently stored graph of the given kind, i.e.
+   * JsonCallGraphID, JsonPointToGraphID or JsonTypeHierarchyID, in the json
+   * representation the graph classes export.
+   */
+  json loadGraphAsJson(const std::string &ProjectName,
+                       const std::string &Kind);
 };
 
 } // namespace psr
 
 #endif
-*/
\ No newline at end of file
@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Copyright (c) 2018 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_DB_GRAPHSNAPSHOT_H_
+#define PHASAR_DB_GRAPHSNAPSHOT_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <phasar/PhasarLLVM/ControlFlow/ICFG.h>
+
+namespace llvm {
+class MemoryBuffer;
+class Module;
+} // namespace llvm
+
+namespace psr {
+
+class LLVMBasedICFG;
+class LLVMTypeHierarchy;
+class ProjectIRDB;
+
+/**
+ * A snapshot is keyed by the MD5 hash of the (preprocessed) module's
+ * bitcode, the call-graph analysis and the entry points, it is only used if
+ * all of them match. Functions and types are referred to by name and call
+ * sites by their psr.id, such that a snapshot can be restored into a freshly
+ * loaded module. The file is mapped into memory and read in place.
+ *
+ * The format is a 'PSRG' magic followed by a little-endian uint32 version
+ * and
+ *
+ *    <string>                             hex encoded module hash
+ *    <u8>                                 call-graph analysis
+ *    <u32> <string>*                      entry points
+ *    <u32> (<string> <u32> <u32>*)*       types: name, reachable types
+ *    <u32> (<u32> <u32>)*                 type hierarchy edges
+ *    <u32> (<string> <u32> <string>*)*    vtables: type name, functions
+ *    <u32> (<string> <u8>)*               call-graph vertices: function name,
+ *                                         is declaration
+ *    <u32> (<u32> <u32> <u64>)*           call-graph edges: caller, callee,
+ *                                         call-site id
+ *
+ * where <string> is a uint32 length followed by the raw bytes.
+ *
+ * @brief Binary snapshot of the type hierarchy and the call graph.
+ */
+class GraphSnapshot {
+public:
+  static const std::uint32_t Version = 1;
+
+private:
+  std::unique_ptr<llvm::MemoryBuffer> Buffer;
+  const llvm::Module &M;
+  CallGraphAnalysisType CGType;
+  std::vector<std::string> EntryPoints;
+  // offsets of the type hierarchy and the call graph within Buffer
+  size_t TypeHierarchyOffset = 0;
+  size_t CallGraphOffset = 0;
+
+  GraphSnapshot(std::unique_ptr<llvm::MemoryBuffer> Buffer,
+                const llvm::Module &M);
+
+public:
+  ~GraphSnapshot();
+
+  /**
+   * Returns the hex encoded MD5 hash of the module's bitcode.
+   */
+  static std::string hashModule(const llvm::Module &M);
+
+  /**
+   * Writes a snapshot of CH and ICFG, which have been constructed for module
+   * M and the given entry points, to Path.
+   */
+  static void store(const std::string &Path, const llvm::Module &M,
+                    const LLVMTypeHierarchy &CH, const LLVMBasedICFG &ICFG,
+                    const std::vector<std::string> &EntryPoints);
+
+  /**
+   * Maps the snapshot at Path, returns nullptr if there is none or if it has
+   * been taken of another version, module, call-graph analysis or entry
+   * points; the graphs have to be reconstructed in that case.
+   */
+  static std::unique_ptr<GraphSnapshot>
+  load(const std::string &Path, const llvm::Module &M,
+       CallGraphAnalysisType CGType,
+       const std::vector<std::string> &EntryPoints);
+
+  std::unique_ptr<LLVMTypeHierarchy> getTypeHierarchy() const;
+
+  /**
+   * Restores the call graph, the whole-module points-to graph is rebuilt
+   * from the points-to graphs of IRDB in the order in which the call graph
+   * construction merged them.
+   */
+  std::unique_ptr<LLVMBasedICFG> getICFG(LLVMTypeHierarchy &CH,
+                                         ProjectIRDB &IRDB) const;
+};
+
+} // namespace psr
+
+#endif
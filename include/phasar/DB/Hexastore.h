@@ -11,12 +11,15 @@
 #define PHASAR_DB_HEXASTORE_H_
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <iosfwd>
+#include <iterator>
+#include <limits>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
-#include <boost/format.hpp>
-
 #include <sqlite3.h>
 
 #include <phasar/DB/Queries.h>
@@ -47,6 +50,71 @@ struct hs_result {
            LHS.object == RHS.object;
   }
 };
+
+/// Dictionary-encoded identifier of a string stored in the Hexastore.
+using hs_id_t = std::uint32_t;
+
+/// A (subject, predicate, object) tuple of dictionary-encoded strings.
+using hs_triple = std::array<hs_id_t, 3>;
+
+/// Marks an unbound position in an ID-based query.
+const hs_id_t hs_wildcard = std::numeric_limits<hs_id_t>::max();
+
+/**
+ * @brief Read-only view on the results of an ID-based query.
+ *
+ * The view points directly into one of the Hexastore's indexes; no triple or
+ * string is copied. Dereferencing an iterator yields the triple in (subject,
+ * predicate, object) order. A view is invalidated by the next put() that is
+ * merged into the indexes, i.e. by any subsequent query or flush().
+ */
+class hs_id_range {
+public:
+  class iterator {
+  private:
+    const hs_triple *pos;
+    const std::array<unsigned, 3> *spo;
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = hs_triple;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const hs_triple *;
+    using reference = hs_triple;
+
+    iterator(const hs_triple *pos, const std::array<unsigned, 3> *spo)
+        : pos(pos), spo(spo) {}
+    hs_triple operator*() const {
+      return {{(*pos)[(*spo)[0]], (*pos)[(*spo)[1]], (*pos)[(*spo)[2]]}};
+    }
+    iterator &operator++() {
+      ++pos;
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator tmp = *this;
+      ++pos;
+      return tmp;
+    }
+    bool operator==(const iterator &other) const { return pos == other.pos; }
+    bool operator!=(const iterator &other) const { return pos != other.pos; }
+  };
+
+private:
+  const hs_triple *first;
+  const hs_triple *last;
+  const std::array<unsigned, 3> *spo;
+
+public:
+  hs_id_range(const hs_triple *first, const hs_triple *last,
+              const std::array<unsigned, 3> *spo)
+      : first(first), last(last), spo(spo) {}
+  iterator begin() const { return iterator(first, spo); }
+  iterator end() const { return iterator(last, spo); }
+  std::size_t size() const { return last - first; }
+  bool empty() const { return first == last; }
+};
+
 /**
  * A Hexastore is an efficient approach to store large graphs.
  * This approach is based on the paper "Database-Backed Program Analysis
@@ -63,13 +131,43 @@ struct hs_result {
  * look-up. In general, given one or two fixed elements of a (source, edge,
  * destination) tuple, Hexastore can quickly access the related information.
  *
+ * All strings are dictionary-encoded to integer IDs and the six permutation
+ * indexes are kept in memory as sorted arrays of ID triples. New entries are
+ * collected in a write-ahead batch that is merged into the indexes before the
+ * next query is answered. Apart from SPO, an index is only built once a query
+ * requires its order. The SQLite database only serves as persistent
+ * storage: it is loaded on construction and written by flush() in a single
+ * transaction.
+ *
  * @brief Efficient data structure for holding graphs in databases.
  */
 class Hexastore {
 private:
+  /// Index orders: SPO, SOP, PSO, POS, OSP, OPS
+  enum hs_order : unsigned { SPO, SOP, PSO, POS, OSP, OPS };
+  /// An index is only built once a query needs it, SPO always exists.
+  /// Positions of subject, predicate and object for each index order
+  static const std::array<std::array<unsigned, 3>, 6> permutations;
+  /// Maps a permuted triple back to (subject, predicate, object) order
+  static const std::array<std::array<unsigned, 3>, 6> inverse_permutations;
+
   sqlite3 *hs_internal_db;
-  static int callback(void *NotUsed, int argc, char **argv, char **azColName);
-  void doPut(std::string query, std::array<std::string, 3> edge);
+  std::unordered_map<std::string, hs_id_t> string_to_id;
+  std::vector<const std::string *> id_to_string;
+  std::array<std::vector<hs_triple>, 6> indexes;
+  std::array<bool, 6> built = {{true, false, false, false, false, false}};
+  /// Write-ahead batch of entries that are not yet merged into the indexes
+  std::vector<hs_triple> batch;
+  /// Entries that are merged into the indexes but not yet persisted
+  std::vector<hs_triple> unpersisted;
+  /// Number of dictionary entries that are already persisted
+  std::size_t persisted_strings = 0;
+
+  void executeSQL(const std::string &query);
+  void load();
+  void mergeBatch();
+  void buildIndex(unsigned order);
+  hs_id_range lookup(const hs_triple &query);
 
 public:
   /**
@@ -83,10 +181,13 @@ public:
   Hexastore(std::string filename);
 
   /**
-   * Destructor.
+   * Destructor. Flushes all pending entries to the database.
    */
   ~Hexastore();
 
+  Hexastore(const Hexastore &) = delete;
+  Hexastore &operator=(const Hexastore &) = delete;
+
   /**
    * Adds the given tuple as a new entry to the Hexastore. It is not
    * possible to have duplicate entries in the Hexastore and
@@ -98,7 +199,13 @@ public:
    *        hexastore.put({{"subject", "predicate", "object"}});
    * @param edge New entry in the form of a 3-tuple.
    */
-  void put(std::array<std::string, 3> edge);
+  void put(const std::array<std::string, 3> &edge);
+
+  /**
+   * @brief Creates a new entry of already encoded strings in the Hexastore.
+   * @param edge New entry in the form of a 3-tuple of IDs obtained by getID().
+   */
+  void put(const hs_triple &edge);
 
   /**
    * A query is always in the form of a 3-tuple (source, edge, destination)
@@ -115,8 +222,45 @@ public:
    * @param result_size_hint Used for possible optimization.
    * @return An object of hs_result, holding the queried information.
    */
-  std::vector<hs_result> get(std::array<std::string, 3> edge_query,
+  std::vector<hs_result> get(const std::array<std::string, 3> &edge_query,
                              size_t result_size_hint = 0);
+
+  /**
+   * Works like the string based query, but unbound positions are given as
+   * hs_wildcard. The results are sorted by the IDs of the bound positions
+   * followed by the unbound ones.
+   *
+   * @brief Query information from the Hexastore without copying strings.
+   * @param edge_query Query in the form of a 3-tuple of IDs.
+   * @return A view on the matching entries.
+   */
+  hs_id_range get(const hs_triple &edge_query);
+
+  /**
+   * @brief Returns the ID of the given string, encoding it if necessary.
+   */
+  hs_id_t getID(const std::string &s);
+
+  /**
+   * @brief Returns the ID of the given string or hs_wildcard if the string
+   * is not encoded.
+   */
+  hs_id_t findID(const std::string &s) const;
+
+  /**
+   * @brief Returns the string encoded by the given ID.
+   */
+  const std::string &getString(hs_id_t id) const;
+
+  /**
+   * @brief Returns the number of entries including the pending ones.
+   */
+  std::size_t size();
+
+  /**
+   * @brief Persists all pending strings and entries in a single transaction.
+   */
+  void flush();
 };
 
 } // namespace psr
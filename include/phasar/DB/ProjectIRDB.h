@@ -14,6 +14,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <clang/Tooling/CompilationDatabase.h>
 
@@ -36,7 +37,11 @@ enum class IRDBOptions : uint32_t {
   NONE = 0,
   MEM2REG = (1 << 0),
   WPA = (1 << 1),
-  OWNSNOT = (1 << 2)
+  OWNSNOT = (1 << 2),
+  // read function bodies of bitcode files on demand, see materializeReachable
+  LAZY = (1 << 3),
+  // skip the verification of modules read from files
+  NOVERIFY = (1 << 4)
 };
 
 /**
@@ -49,12 +54,13 @@ class ProjectIRDB {
 private:
   llvm::Module *WPAMOD = nullptr;
   IRDBOptions Options;
-  void compileAndAddToDB(std::vector<const char *> CompileCommand);
   std::vector<std::string> header_search_paths;
   static const std::set<std::string> unknown_flags;
   void setupHeaderSearchPaths();
   // Stores all source files that have been examined
   std::set<std::string> source_files;
+  // Number of modules that were loaded from the bitcode cache
+  std::size_t cached_modules = 0;
   // Stores all allocation instructions
   std::set<const llvm::Value *> alloca_instructions;
   // Stores all return/resume instructions
@@ -86,10 +92,22 @@ public:
   /// Constructs a ProjectIRDB from a bunch of llvm IR files
   ProjectIRDB(const std::vector<std::string> &IRFiles,
               enum IRDBOptions Opt = IRDBOptions::NONE);
-  /// Constructs a ProjectIRDB from a CompilationDatabase (only for simple
-  /// projects)
+  /**
+   * Every translation unit of the compilation database is compiled into a
+   * module of its own context, Jobs of them at a time (0 uses one job per
+   * hardware thread). If a CacheDir is given, the bitcode of every
+   * translation unit is stored in it under a key that is made up of the
+   * command line and the preprocessed source, a later construction only
+   * compiles the translation units whose key is not cached yet. A header
+   * that is force-included by the commands (-include) is then precompiled
+   * into the CacheDir as well and shared by all commands with the same
+   * flags.
+   *
+   * @brief Constructs a ProjectIRDB from a CompilationDatabase.
+   */
   ProjectIRDB(const clang::tooling::CompilationDatabase &CompileDB,
-              enum IRDBOptions Opt);
+              enum IRDBOptions Opt, unsigned Jobs = 0,
+              const std::string &CacheDir = "");
   /// Constructs a ProjectIRDB from files which may have to be compiled to llvm
   /// IR
   ProjectIRDB(const std::vector<std::string> &Files,
@@ -104,6 +122,17 @@ public:
 
   void preprocessIR();
 
+  /**
+   * Every function that is not reachable from the entry points, a global
+   * initializer (e.g. a virtual function table) or the address of a function
+   * taken in reachable code is turned into a declaration, its body is never
+   * read. Has to be called before the IR is linked or pre-processed. Does
+   * nothing if the IRDB has not been constructed with IRDBOptions::LAZY.
+   *
+   * @brief Reads the function bodies that the analysis may reach.
+   */
+  void materializeReachable(const std::vector<std::string> &EntryPoints);
+
   // add WPA support by providing a fat completely linked module
   void linkForWPA();
   // get a completely linked module for the WPA_MODE
@@ -126,6 +155,9 @@ public:
   std::set<const llvm::Value *> getAllMemoryLocations();
   std::set<std::string> getAllSourceFiles();
   std::size_t getNumberOfModules();
+  /// Returns the number of modules that have been loaded from the bitcode
+  /// cache instead of being compiled.
+  std::size_t getNumberOfCachedModules() const;
   llvm::Module *getModuleDefiningFunction(const std::string &FunctionName);
   llvm::Function *getFunction(const std::string &FunctionName);
   llvm::GlobalVariable *
@@ -174,6 +206,22 @@ public:
    */
   const llvm::Value *persistedStringToValue(const std::string &StringRep);
   std::set<const llvm::Type *> getAllocatedTypes();
+  /**
+   * @brief Returns a hash value for every function defined in the IRDB.
+   */
+  std::map<std::string, std::size_t> getFunctionHashes();
+  /**
+   * @brief Stores the current function hashes in the given file such that a
+   * later run can determine which functions have been edited in between.
+   */
+  void exportFunctionHashes(const std::string &Path);
+  /**
+   * @brief Compares the current IR against the function hashes stored by
+   * exportFunctionHashes().
+   * @return Names of all functions that are new or whose definition has
+   * changed.
+   */
+  std::set<std::string> getChangedFunctions(const std::string &Path);
 };
 
 } // namespace psr
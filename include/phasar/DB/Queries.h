@@ -14,35 +14,15 @@
 
 namespace psr {
 
-extern const std::string SPO_INSERT;
-
-extern const std::string SOP_INSERT;
-
-extern const std::string PSO_INSERT;
-
-extern const std::string POS_INSERT;
-
-extern const std::string OSP_INSERT;
-
-extern const std::string OPS_INSERT;
-
-extern const std::string SEARCH_SPO;
-
-extern const std::string SEARCH_SPX;
-
-extern const std::string SEARCH_SXO;
-
-extern const std::string SEARCH_XPO;
-
-extern const std::string SEARCH_SXX;
+extern const std::string INIT;
 
-extern const std::string SEARCH_XPX;
+extern const std::string INSERT_STRING;
 
-extern const std::string SEARCH_XXO;
+extern const std::string INSERT_TRIPLE;
 
-extern const std::string SEARCH_XXX;
+extern const std::string SELECT_STRINGS;
 
-extern const std::string INIT;
+extern const std::string SELECT_TRIPLES;
 
 } // namespace psr
 
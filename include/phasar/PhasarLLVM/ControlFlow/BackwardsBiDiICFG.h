@@ -0,0 +1,155 @@
+/******************************************************************************
+ * Copyright (c) 2018 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_CONTROLFLOW_BACKWARDSBIDIICFG_H_
+#define PHASAR_PHASARLLVM_CONTROLFLOW_BACKWARDSBIDIICFG_H_
+
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <phasar/PhasarLLVM/ControlFlow/BiDiICFG.h>
+
+namespace psr {
+
+/**
+ * Successors and predecessors, start and end points as well as return sites
+ * and the predecessors of calls swap their roles, such that a backward
+ * analysis can be solved by an unmodified forward solver. The view holds no
+ * data of its own, hence it shares the (possibly precomputed) neighbours of
+ * the wrapped ICFG with any forward analysis running on the same ICFG.
+ *
+ * @brief Reversed view of a bidirectional ICFG.
+ */
+template <typename N, typename M>
+class BackwardsBiDiICFG : public BiDiICFG<N, M> {
+private:
+  BiDiICFG<N, M> &Delegate;
+
+public:
+  BackwardsBiDiICFG(BiDiICFG<N, M> &Delegate) : Delegate(Delegate) {}
+
+  ~BackwardsBiDiICFG() override = default;
+
+  M getMethodOf(N stmt) override { return Delegate.getMethodOf(stmt); }
+
+  std::vector<N> getPredsOf(N stmt) override {
+    return Delegate.getSuccsOf(stmt);
+  }
+
+  std::vector<N> getSuccsOf(N stmt) override {
+    return Delegate.getPredsOf(stmt);
+  }
+
+  std::vector<std::pair<N, N>> getAllControlFlowEdges(M fun) override {
+    std::vector<std::pair<N, N>> Edges = Delegate.getAllControlFlowEdges(fun);
+    for (auto &Edge : Edges) {
+      std::swap(Edge.first, Edge.second);
+    }
+    return Edges;
+  }
+
+  std::vector<N> getAllInstructionsOf(M fun) override {
+    return Delegate.getAllInstructionsOf(fun);
+  }
+
+  bool isExitStmt(N stmt) override { return Delegate.isStartPoint(stmt); }
+
+  bool isStartPoint(N stmt) override { return Delegate.isExitStmt(stmt); }
+
+  bool isFieldLoad(N stmt) override { return Delegate.isFieldLoad(stmt); }
+
+  bool isFieldStore(N stmt) override { return Delegate.isFieldStore(stmt); }
+
+  bool isFallThroughSuccessor(N stmt, N succ) override {
+    return Delegate.isFallThroughSuccessor(succ, stmt);
+  }
+
+  bool isBranchTarget(N stmt, N succ) override {
+    return Delegate.isBranchTarget(succ, stmt);
+  }
+
+  std::string getStatementId(N stmt) override {
+    return Delegate.getStatementId(stmt);
+  }
+
+  std::string getMethodName(M fun) override {
+    return Delegate.getMethodName(fun);
+  }
+
+  bool isCallStmt(N stmt) override { return Delegate.isCallStmt(stmt); }
+
+  M getMethod(const std::string &fun) override {
+    return Delegate.getMethod(fun);
+  }
+
+  std::set<N> allNonCallStartNodes() override {
+    return Delegate.allNonCallEndNodes();
+  }
+
+  std::set<M> getCalleesOfCallAt(N stmt) override {
+    return Delegate.getCalleesOfCallAt(stmt);
+  }
+
+  std::set<N> getCallersOf(M fun) override {
+    return Delegate.getCallersOf(fun);
+  }
+
+  std::set<N> getCallsFromWithin(M fun) override {
+    return Delegate.getCallsFromWithin(fun);
+  }
+
+  std::set<N> getStartPointsOf(M fun) override {
+    return Delegate.getEndPointsOf(fun);
+  }
+
+  std::set<N> getExitPointsOf(M fun) override {
+    return Delegate.getStartPointsOf(fun);
+  }
+
+  std::set<N> getReturnSitesOfCallAt(N stmt) override {
+    std::vector<N> Preds = Delegate.getPredsOfCallAt(stmt);
+    return std::set<N>(Preds.begin(), Preds.end());
+  }
+
+  json getAsJson() override { return Delegate.getAsJson(); }
+
+  std::set<N> getEndPointsOf(M fun) override {
+    return Delegate.getStartPointsOf(fun);
+  }
+
+  std::vector<N> getPredsOfCallAt(N stmt) override {
+    std::set<N> RetSites = Delegate.getReturnSitesOfCallAt(stmt);
+    return std::vector<N>(RetSites.begin(), RetSites.end());
+  }
+
+  std::set<N> allNonCallEndNodes() override {
+    return Delegate.allNonCallStartNodes();
+  }
+
+  std::vector<N> getParameterRefs(M fun) override {
+    return Delegate.getParameterRefs(fun);
+  }
+
+  bool isReturnSite(N stmt) override {
+    for (N Succ : Delegate.getSuccsOf(stmt)) {
+      if (Delegate.isCallStmt(Succ)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool isReachable(N stmt) override { return Delegate.isReachable(stmt); }
+};
+
+} // namespace psr
+
+#endif
@@ -1,4 +1,135 @@
+/******************************************************************************
+ * Copyright (c) 2018 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
 #ifndef PHASAR_PHASARLLVM_CONTROLFLOW_LLVMBASEDBIDIICFG_H_
 #define PHASAR_PHASARLLVM_CONTROLFLOW_LLVMBASEDBIDIICFG_H_
 
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <phasar/PhasarLLVM/ControlFlow/BiDiICFG.h>
+#include <phasar/PhasarLLVM/ControlFlow/LLVMBasedCFG.h>
+
+namespace llvm {
+class Function;
+class Instruction;
+} // namespace llvm
+
+namespace psr {
+
+class LLVMBasedICFG;
+
+/**
+ * All neighbours of all instructions and methods known to the wrapped ICFG,
+ * i.e. successors and predecessors, callees and callers as well as the
+ * start, end and return points, are computed once on construction. Since the
+ * index is never modified afterwards, a single instance can be shared by a
+ * forward and a backward analysis (see BackwardsBiDiICFG) that run in
+ * different threads, without searching the call graph on every query as
+ * LLVMBasedICFG does.
+ *
+ * @brief Read-only bidirectional view of an LLVMBasedICFG.
+ */
+class LLVMBasedBiDiICFG
+    : public BiDiICFG<const llvm::Instruction *, const llvm::Function *>,
+      public virtual LLVMBasedCFG {
+private:
+  struct NodeInfo {
+    std::vector<const llvm::Instruction *> Succs;
+    std::vector<const llvm::Instruction *> Preds;
+    std::set<const llvm::Function *> Callees;
+    std::set<const llvm::Instruction *> ReturnSites;
+    bool IsReturnSite = false;
+    bool IsReachable = false;
+  };
+  struct MethodInfo {
+    std::vector<const llvm::Instruction *> Instructions;
+    std::set<const llvm::Instruction *> StartPoints;
+    std::set<const llvm::Instruction *> ExitPoints;
+    std::set<const llvm::Instruction *> CallSites;
+    std::set<const llvm::Instruction *> Callers;
+    std::vector<const llvm::Instruction *> ParameterRefs;
+  };
+
+  LLVMBasedICFG &ICFG;
+  std::unordered_map<const llvm::Instruction *, NodeInfo> Nodes;
+  std::unordered_map<const llvm::Function *, MethodInfo> Methods;
+  std::unordered_map<std::string, const llvm::Function *> MethodsByName;
+  std::set<const llvm::Instruction *> NonCallStartNodes;
+  std::set<const llvm::Instruction *> NonCallEndNodes;
+
+  void buildIndex();
+
+public:
+  LLVMBasedBiDiICFG(LLVMBasedICFG &ICFG);
+
+  ~LLVMBasedBiDiICFG() override = default;
+
+  LLVMBasedICFG &getForwardICFG() { return ICFG; }
+
+  std::vector<const llvm::Instruction *>
+  getPredsOf(const llvm::Instruction *stmt) override;
+
+  std::vector<const llvm::Instruction *>
+  getSuccsOf(const llvm::Instruction *stmt) override;
+
+  std::vector<const llvm::Instruction *>
+  getAllInstructionsOf(const llvm::Function *fun) override;
+
+  bool isCallStmt(const llvm::Instruction *stmt) override;
+
+  const llvm::Function *getMethod(const std::string &fun) override;
+
+  std::set<const llvm::Instruction *> allNonCallStartNodes() override;
+
+  std::set<const llvm::Function *>
+  getCalleesOfCallAt(const llvm::Instruction *stmt) override;
+
+  std::set<const llvm::Instruction *>
+  getCallersOf(const llvm::Function *fun) override;
+
+  std::set<const llvm::Instruction *>
+  getCallsFromWithin(const llvm::Function *fun) override;
+
+  std::set<const llvm::Instruction *>
+  getStartPointsOf(const llvm::Function *fun) override;
+
+  std::set<const llvm::Instruction *>
+  getExitPointsOf(const llvm::Function *fun) override;
+
+  std::set<const llvm::Instruction *>
+  getReturnSitesOfCallAt(const llvm::Instruction *stmt) override;
+
+  std::set<const llvm::Instruction *>
+  getEndPointsOf(const llvm::Function *fun) override;
+
+  std::vector<const llvm::Instruction *>
+  getPredsOfCallAt(const llvm::Instruction *stmt) override;
+
+  std::set<const llvm::Instruction *> allNonCallEndNodes() override;
+
+  /**
+   * @brief Returns the instructions of the given method that use one of its
+   * formal parameters.
+   */
+  std::vector<const llvm::Instruction *>
+  getParameterRefs(const llvm::Function *fun) override;
+
+  bool isReturnSite(const llvm::Instruction *stmt) override;
+
+  bool isReachable(const llvm::Instruction *stmt) override;
+
+  json getAsJson() override;
+};
+
+} // namespace psr
+
 #endif
@@ -20,6 +20,7 @@
 #include <functional>
 #include <iosfwd>
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -43,12 +44,22 @@ namespace psr {
 
 class Resolver;
 class ProjectIRDB;
+class JsonStreamWriter;
 class LLVMTypeHierarchy;
 
+/**
+ * Once constructed, the queries of the ICFG and of its whole-module points-to
+ * graph only read them, so a single instance may be shared by solvers running
+ * in parallel, see the fan-out mode of AnalysisController. Points-to queries
+ * for values that are not in the graph yield an empty set.
+ */
 class LLVMBasedICFG
     : public ICFG<const llvm::Instruction *, const llvm::Function *>,
       public virtual LLVMBasedCFG {
   friend class LLVMBasedBackwardsICFG;
+  friend class LLVMBasedBiDiICFG;
+  friend class GraphSnapshot;
+  friend class DBConn;
 
 private:
   CallGraphAnalysisType CGType;
@@ -104,6 +115,12 @@ private:
 
   void constructionWalker(const llvm::Function *F, Resolver *resolver);
 
+  std::unique_ptr<Resolver> makeResolver();
+
+  /// Rebuilds the whole-module points-to graph of a restored call graph by
+  /// replaying the merges of the construction from the given entry points.
+  void restoreWholeModulePTG(const std::vector<std::string> &EntryPoints);
+
   struct dependency_visitor;
 
 public:
@@ -154,6 +171,14 @@ public:
 
   void mergeWith(const LLVMBasedICFG &other);
 
+  /**
+   * @brief Updates the call-graph after the given functions have been edited
+   * in place. Their outgoing call edges are dropped and resolved again, newly
+   * reachable functions are added to the call-graph.
+   * @note The points-to graphs of the edited functions are not recomputed.
+   */
+  void updateFunctions(const std::set<const llvm::Function *> &Functions);
+
   bool isPrimitiveFunction(const std::string &name);
 
   void print();
@@ -164,6 +189,12 @@ public:
 
   json getAsJson() override;
 
+  /**
+   * @brief Streams the same document as getAsJson() without building it in
+   * memory.
+   */
+  void emitAsJson(JsonStreamWriter &W);
+
   unsigned getNumOfVertices();
 
   unsigned getNumOfEdges();
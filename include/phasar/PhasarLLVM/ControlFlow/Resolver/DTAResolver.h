@@ -21,8 +21,9 @@
 #include <string>
 
 #include <phasar/PhasarLLVM/ControlFlow/Resolver/CHAResolver.h>
-#include <phasar/PhasarLLVM/Pointer/TypeGraphs/CachedTypeGraph.h>
 // To switch the TypeGraph
+#include <phasar/PhasarLLVM/Pointer/TypeGraphs/IncrementalTypeGraph.h>
+//#include <phasar/PhasarLLVM/Pointer/TypeGraphs/CachedTypeGraph.h>
 //#include <phasar/PhasarLLVM/Pointer/TypeGraphs/LazyTypeGraph.h>
 
 namespace llvm {
@@ -35,7 +36,7 @@ class ProjectIRDB;
 
 struct DTAResolver : public CHAResolver {
 public:
-  using TypeGraph_t = CachedTypeGraph;
+  using TypeGraph_t = IncrementalTypeGraph;
 
 protected:
   TypeGraph_t typegraph;
@@ -12,6 +12,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <tuple>
 
@@ -36,139 +37,168 @@ struct FlowEdgeFunctionCache {
   // Auto add zero
   bool autoAddZero;
   D zeroValue;
-  // Caches for the flow functions
-  std::map<std::tuple<N, N>, std::shared_ptr<FlowFunction<D>>>
-      NormalFlowFunctionCache;
-  std::map<std::tuple<N, M>, std::shared_ptr<FlowFunction<D>>>
-      CallFlowFunctionCache;
-  std::map<std::tuple<N, M, N, N>, std::shared_ptr<FlowFunction<D>>>
-      ReturnFlowFunctionCache;
-  std::map<std::tuple<N, N, std::set<M>>, std::shared_ptr<FlowFunction<D>>>
-      CallToRetFlowFunctionCache;
-  // Caches for the edge functions
-  std::map<std::tuple<N, D, N, D>, std::shared_ptr<EdgeFunction<V>>>
-      NormalEdgeFunctionCache;
-  std::map<std::tuple<N, D, M, D>, std::shared_ptr<EdgeFunction<V>>>
-      CallEdgeFunctionCache;
-  std::map<std::tuple<N, M, N, D, N, D>, std::shared_ptr<EdgeFunction<V>>>
-      ReturnEdgeFunctionCache;
-  std::map<std::tuple<N, D, N, D>, std::shared_ptr<EdgeFunction<V>>>
-      CallToRetEdgeFunctionCache;
-  std::map<std::tuple<N, D, N, D>, std::shared_ptr<EdgeFunction<V>>>
-      SummaryEdgeFunctionCache;
+  /**
+   * The cached functions. A store may be shared by the caches of several
+   * solvers whose problems construct the same flow and edge functions, e.g.
+   * instances of one problem for different entry points, which are then
+   * solved in parallel.
+   */
+  struct Store {
+    // only locked if the store is shared
+    std::mutex Mutex;
+    bool Shared = false;
+    // Caches for the flow functions
+    std::map<std::tuple<N, N>, std::shared_ptr<FlowFunction<D>>>
+        NormalFlowFunctionCache;
+    std::map<std::tuple<N, M>, std::shared_ptr<FlowFunction<D>>>
+        CallFlowFunctionCache;
+    std::map<std::tuple<N, M, N, N>, std::shared_ptr<FlowFunction<D>>>
+        ReturnFlowFunctionCache;
+    std::map<std::tuple<N, N, std::set<M>>, std::shared_ptr<FlowFunction<D>>>
+        CallToRetFlowFunctionCache;
+    // Caches for the edge functions
+    std::map<std::tuple<N, D, N, D>, std::shared_ptr<EdgeFunction<V>>>
+        NormalEdgeFunctionCache;
+    std::map<std::tuple<N, D, M, D>, std::shared_ptr<EdgeFunction<V>>>
+        CallEdgeFunctionCache;
+    std::map<std::tuple<N, M, N, D, N, D>, std::shared_ptr<EdgeFunction<V>>>
+        ReturnEdgeFunctionCache;
+    std::map<std::tuple<N, D, N, D>, std::shared_ptr<EdgeFunction<V>>>
+        CallToRetEdgeFunctionCache;
+    std::map<std::tuple<N, D, N, D>, std::shared_ptr<EdgeFunction<V>>>
+        SummaryEdgeFunctionCache;
+  };
+  std::shared_ptr<Store> store;
 
+private:
+  std::unique_lock<std::mutex> lock() {
+    std::unique_lock<std::mutex> Lock(store->Mutex, std::defer_lock);
+    if (store->Shared) {
+      Lock.lock();
+    }
+    return Lock;
+  }
+
+  template <typename KeyT, typename FunctionT>
+  FunctionT lookup(std::map<KeyT, FunctionT> &Cache, const KeyT &key) {
+    auto Lock = lock();
+    auto search = Cache.find(key);
+    return search != Cache.end() ? search->second : nullptr;
+  }
+
+  // if another solver sharing the store was faster, its function is used
+  template <typename KeyT, typename FunctionT>
+  FunctionT insert(std::map<KeyT, FunctionT> &Cache, const KeyT &key,
+                   FunctionT function) {
+    auto Lock = lock();
+    return Cache.emplace(key, std::move(function)).first->second;
+  }
+
+public:
   // Ctor allows access to the IDEProblem in order to get access to flow and
   // edge function factory functions.
   FlowEdgeFunctionCache(IDETabulationProblem<N, D, M, V, I> &problem)
       : problem(problem), autoAddZero(problem.solver_config.autoAddZero),
-        zeroValue(problem.zeroValue()) {
+        zeroValue(problem.zeroValue()), store(std::make_shared<Store>()) {
     PAMM_GET_INSTANCE;
-    REG_COUNTER("Normal-FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Normal-FF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("Normal-FF Construction", PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("Normal-FF Cache Hit", PAMM_SEVERITY_LEVEL::Full);
     // Counters for the call flow functions
-    REG_COUNTER("Call-FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Call-FF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("Call-FF Construction", PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("Call-FF Cache Hit", PAMM_SEVERITY_LEVEL::Full);
     // Counters for return flow functions
-    REG_COUNTER("Return-FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Return-FF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("Return-FF Construction", PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("Return-FF Cache Hit", PAMM_SEVERITY_LEVEL::Full);
     // Counters for the call to return flow functions
-    REG_COUNTER("CallToRet-FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("CallToRet-FF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("CallToRet-FF Construction", PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("CallToRet-FF Cache Hit", PAMM_SEVERITY_LEVEL::Full);
     // Counters for the summary flow functions
-    // REG_COUNTER("Summary-FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    // REG_COUNTER("Summary-FF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    // REG_SHARED_COUNTER("Summary-FF Construction", PAMM_SEVERITY_LEVEL::Full);
+    // REG_SHARED_COUNTER("Summary-FF Cache Hit", PAMM_SEVERITY_LEVEL::Full);
     // Counters for the normal edge functions
-    REG_COUNTER("Normal-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Normal-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("Normal-EF Construction", PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("Normal-EF Cache Hit", PAMM_SEVERITY_LEVEL::Full);
     // Counters for the call edge functions
-    REG_COUNTER("Call-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Call-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("Call-EF Construction", PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("Call-EF Cache Hit", PAMM_SEVERITY_LEVEL::Full);
     // Counters for the return edge functions
-    REG_COUNTER("Return-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Return-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("Return-EF Construction", PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("Return-EF Cache Hit", PAMM_SEVERITY_LEVEL::Full);
     // Counters for the call to return edge functions
-    REG_COUNTER("CallToRet-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("CallToRet-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("CallToRet-EF Construction", PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("CallToRet-EF Cache Hit", PAMM_SEVERITY_LEVEL::Full);
     // Counters for the summary edge functions
-    REG_COUNTER("Summary-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Summary-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("Summary-EF Construction", PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("Summary-EF Cache Hit", PAMM_SEVERITY_LEVEL::Full);
   }
 
   std::shared_ptr<FlowFunction<D>> getNormalFlowFunction(N curr, N succ) {
     PAMM_GET_INSTANCE;
-    auto key = std::tie(curr, succ);
-    if (NormalFlowFunctionCache.count(key)) {
+    auto key = std::make_tuple(curr, succ);
+    if (auto ff = lookup(store->NormalFlowFunctionCache, key)) {
       INC_COUNTER("Normal-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return NormalFlowFunctionCache.at(key);
-    } else {
-      INC_COUNTER("Normal-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ff = (autoAddZero)
-                    ? std::make_shared<ZeroedFlowFunction<D>>(
-                          problem.getNormalFlowFunction(curr, succ), zeroValue)
-                    : problem.getNormalFlowFunction(curr, succ);
-      NormalFlowFunctionCache.insert(make_pair(key, ff));
       return ff;
     }
+    INC_COUNTER("Normal-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto ff = (autoAddZero)
+                  ? std::make_shared<ZeroedFlowFunction<D>>(
+                        problem.getNormalFlowFunction(curr, succ), zeroValue)
+                  : problem.getNormalFlowFunction(curr, succ);
+    return insert(store->NormalFlowFunctionCache, key, ff);
   }
 
   std::shared_ptr<FlowFunction<D>> getCallFlowFunction(N callStmt, M destMthd) {
     PAMM_GET_INSTANCE;
-    auto key = std::tie(callStmt, destMthd);
-    if (CallFlowFunctionCache.count(key)) {
+    auto key = std::make_tuple(callStmt, destMthd);
+    if (auto ff = lookup(store->CallFlowFunctionCache, key)) {
       INC_COUNTER("Call-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return CallFlowFunctionCache.at(key);
-    } else {
-      INC_COUNTER("Call-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ff =
-          (autoAddZero)
-              ? std::make_shared<ZeroedFlowFunction<D>>(
-                    problem.getCallFlowFunction(callStmt, destMthd), zeroValue)
-              : problem.getCallFlowFunction(callStmt, destMthd);
-      CallFlowFunctionCache.insert(std::make_pair(key, ff));
       return ff;
     }
+    INC_COUNTER("Call-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto ff =
+        (autoAddZero)
+            ? std::make_shared<ZeroedFlowFunction<D>>(
+                  problem.getCallFlowFunction(callStmt, destMthd), zeroValue)
+            : problem.getCallFlowFunction(callStmt, destMthd);
+    return insert(store->CallFlowFunctionCache, key, ff);
   }
 
   std::shared_ptr<FlowFunction<D>> getRetFlowFunction(N callSite, M calleeMthd,
                                                       N exitStmt, N retSite) {
     PAMM_GET_INSTANCE;
-    auto key = std::tie(callSite, calleeMthd, exitStmt, retSite);
-    if (ReturnFlowFunctionCache.count(key)) {
+    auto key = std::make_tuple(callSite, calleeMthd, exitStmt, retSite);
+    if (auto ff = lookup(store->ReturnFlowFunctionCache, key)) {
       INC_COUNTER("Return-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return ReturnFlowFunctionCache.at(key);
-    } else {
-      INC_COUNTER("Return-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ff = (autoAddZero)
-                    ? std::make_shared<ZeroedFlowFunction<D>>(
-                          problem.getRetFlowFunction(callSite, calleeMthd,
-                                                     exitStmt, retSite),
-                          zeroValue)
-                    : problem.getRetFlowFunction(callSite, calleeMthd, exitStmt,
-                                                 retSite);
-      ReturnFlowFunctionCache.insert(std::make_pair(key, ff));
       return ff;
     }
+    INC_COUNTER("Return-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto ff = (autoAddZero)
+                  ? std::make_shared<ZeroedFlowFunction<D>>(
+                        problem.getRetFlowFunction(callSite, calleeMthd,
+                                                   exitStmt, retSite),
+                        zeroValue)
+                  : problem.getRetFlowFunction(callSite, calleeMthd, exitStmt,
+                                               retSite);
+    return insert(store->ReturnFlowFunctionCache, key, ff);
   }
 
   std::shared_ptr<FlowFunction<D>>
   getCallToRetFlowFunction(N callSite, N retSite, std::set<M> callees) {
     PAMM_GET_INSTANCE;
-    auto key = std::tie(callSite, retSite, callees);
-    if (CallToRetFlowFunctionCache.count(key)) {
+    auto key = std::make_tuple(callSite, retSite, callees);
+    if (auto ff = lookup(store->CallToRetFlowFunctionCache, key)) {
       INC_COUNTER("CallToRet-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return CallToRetFlowFunctionCache.at(key);
-    } else {
-      INC_COUNTER("CallToRet-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ff =
-          (autoAddZero)
-              ? std::make_shared<ZeroedFlowFunction<D>>(
-                    problem.getCallToRetFlowFunction(callSite, retSite,
-                                                     callees),
-                    zeroValue)
-              : problem.getCallToRetFlowFunction(callSite, retSite, callees);
-      CallToRetFlowFunctionCache.insert(std::make_pair(key, ff));
       return ff;
     }
+    INC_COUNTER("CallToRet-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto ff =
+        (autoAddZero)
+            ? std::make_shared<ZeroedFlowFunction<D>>(
+                  problem.getCallToRetFlowFunction(callSite, retSite,
+                                                   callees),
+                  zeroValue)
+            : problem.getCallToRetFlowFunction(callSite, retSite, callees);
+    return insert(store->CallToRetFlowFunctionCache, key, ff);
   }
 
   std::shared_ptr<FlowFunction<D>> getSummaryFlowFunction(N callStmt,
@@ -182,32 +212,28 @@ struct FlowEdgeFunctionCache {
   std::shared_ptr<EdgeFunction<V>> getNormalEdgeFunction(N curr, D currNode,
                                                          N succ, D succNode) {
     PAMM_GET_INSTANCE;
-    auto key = std::tie(curr, currNode, succ, succNode);
-    if (NormalEdgeFunctionCache.count(key)) {
+    auto key = std::make_tuple(curr, currNode, succ, succNode);
+    if (auto ef = lookup(store->NormalEdgeFunctionCache, key)) {
       INC_COUNTER("Normal-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return NormalEdgeFunctionCache.at(key);
-    } else {
-      INC_COUNTER("Normal-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ef = problem.getNormalEdgeFunction(curr, currNode, succ, succNode);
-      NormalEdgeFunctionCache.insert(std::make_pair(key, ef));
       return ef;
     }
+    INC_COUNTER("Normal-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto ef = problem.getNormalEdgeFunction(curr, currNode, succ, succNode);
+    return insert(store->NormalEdgeFunctionCache, key, ef);
   }
 
   std::shared_ptr<EdgeFunction<V>>
   getCallEdgeFunction(N callStmt, D srcNode, M destiantionMethod, D destNode) {
     PAMM_GET_INSTANCE;
-    auto key = std::tie(callStmt, srcNode, destiantionMethod, destNode);
-    if (CallEdgeFunctionCache.count(key)) {
+    auto key = std::make_tuple(callStmt, srcNode, destiantionMethod, destNode);
+    if (auto ef = lookup(store->CallEdgeFunctionCache, key)) {
       INC_COUNTER("Call-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return CallEdgeFunctionCache.at(key);
-    } else {
-      INC_COUNTER("Call-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ef = problem.getCallEdgeFunction(callStmt, srcNode,
-                                            destiantionMethod, destNode);
-      CallEdgeFunctionCache.insert(std::make_pair(key, ef));
       return ef;
     }
+    INC_COUNTER("Call-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto ef = problem.getCallEdgeFunction(callStmt, srcNode,
+                                          destiantionMethod, destNode);
+    return insert(store->CallEdgeFunctionCache, key, ef);
   }
 
   std::shared_ptr<EdgeFunction<V>> getReturnEdgeFunction(N callSite,
@@ -215,51 +241,71 @@ struct FlowEdgeFunctionCache {
                                                          N exitStmt, D exitNode,
                                                          N reSite, D retNode) {
     PAMM_GET_INSTANCE;
-    auto key =
-        std::tie(callSite, calleeMethod, exitStmt, exitNode, reSite, retNode);
-    if (ReturnEdgeFunctionCache.count(key)) {
+    auto key = std::make_tuple(callSite, calleeMethod, exitStmt, exitNode,
+                               reSite, retNode);
+    if (auto ef = lookup(store->ReturnEdgeFunctionCache, key)) {
       INC_COUNTER("Return-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return ReturnEdgeFunctionCache.at(key);
-    } else {
-      INC_COUNTER("Return-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ef = problem.getReturnEdgeFunction(callSite, calleeMethod, exitStmt,
-                                              exitNode, reSite, retNode);
-      ReturnEdgeFunctionCache.insert(std::make_pair(key, ef));
       return ef;
     }
+    INC_COUNTER("Return-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto ef = problem.getReturnEdgeFunction(callSite, calleeMethod, exitStmt,
+                                            exitNode, reSite, retNode);
+    return insert(store->ReturnEdgeFunctionCache, key, ef);
   }
 
   std::shared_ptr<EdgeFunction<V>>
   getCallToRetEdgeFunction(N callSite, D callNode, N retSite, D retSiteNode,
                            std::set<M> callees) {
     PAMM_GET_INSTANCE;
-    auto key = std::tie(callSite, callNode, retSite, retSiteNode);
-    if (CallToRetEdgeFunctionCache.count(key)) {
+    auto key = std::make_tuple(callSite, callNode, retSite, retSiteNode);
+    if (auto ef = lookup(store->CallToRetEdgeFunctionCache, key)) {
       INC_COUNTER("CallToRet-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return CallToRetEdgeFunctionCache.at(key);
-    } else {
-      INC_COUNTER("CallToRet-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ef = problem.getCallToRetEdgeFunction(callSite, callNode, retSite,
-                                                 retSiteNode, callees);
-      CallToRetEdgeFunctionCache.insert(std::make_pair(key, ef));
       return ef;
     }
+    INC_COUNTER("CallToRet-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto ef = problem.getCallToRetEdgeFunction(callSite, callNode, retSite,
+                                               retSiteNode, callees);
+    return insert(store->CallToRetEdgeFunctionCache, key, ef);
   }
 
   std::shared_ptr<EdgeFunction<V>>
   getSummaryEdgeFunction(N callSite, D callNode, N retSite, D retSiteNode) {
     PAMM_GET_INSTANCE;
-    auto key = std::tie(callSite, callNode, retSite, retSiteNode);
-    if (SummaryEdgeFunctionCache.count(key)) {
+    auto key = std::make_tuple(callSite, callNode, retSite, retSiteNode);
+    if (auto ef = lookup(store->SummaryEdgeFunctionCache, key)) {
       INC_COUNTER("Summary-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return SummaryEdgeFunctionCache.at(key);
-    } else {
-      INC_COUNTER("Summary-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ef = problem.getSummaryEdgeFunction(callSite, callNode, retSite,
-                                               retSiteNode);
-      SummaryEdgeFunctionCache.insert(std::make_pair(key, ef));
       return ef;
     }
+    INC_COUNTER("Summary-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto ef = problem.getSummaryEdgeFunction(callSite, callNode, retSite,
+                                             retSiteNode);
+    return insert(store->SummaryEdgeFunctionCache, key, ef);
+  }
+
+  /**
+   * Uses and extends the given store instead of the own one. Every cache
+   * sharing a store must do so before any function is requested.
+   */
+  void share(std::shared_ptr<Store> other) {
+    other->Shared = true;
+    store = std::move(other);
+  }
+
+  /**
+   * Drops all cached flow and edge functions, e.g. after the underlying IR
+   * has been edited.
+   */
+  void clear() {
+    auto Lock = lock();
+    store->NormalFlowFunctionCache.clear();
+    store->CallFlowFunctionCache.clear();
+    store->ReturnFlowFunctionCache.clear();
+    store->CallToRetFlowFunctionCache.clear();
+    store->NormalEdgeFunctionCache.clear();
+    store->CallEdgeFunctionCache.clear();
+    store->ReturnEdgeFunctionCache.clear();
+    store->CallToRetEdgeFunctionCache.clear();
+    store->SummaryEdgeFunctionCache.clear();
   }
 
   void print() {
@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Copyright (c) 2018 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_FLOWFUNCTIONS_FLOWPRIMITIVES_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_FLOWFUNCTIONS_FLOWPRIMITIVES_H_
+
+#include <memory>
+#include <set>
+#include <utility>
+
+#include <llvm/ADT/SmallVector.h>
+
+#include <phasar/PhasarLLVM/IfdsIde/FlowFunction.h>
+
+namespace psr {
+
+/*
+ * A flow primitive is any callable of the form
+ *
+ *   void (D Source, llvm::SmallVectorImpl<D> &Targets)
+ *
+ * that appends the targets of Source to Targets. Primitives are passed by
+ * type rather than through std::function, such that compositions of them are
+ * inlined, and they do not allocate as long as the targets fit into the
+ * inline storage of the caller's buffer. A primitive may append a target more
+ * than once.
+ */
+
+/// Predicate of the primitives that holds for every argument.
+struct AnyFact {
+  template <typename T> bool operator()(const T &) const { return true; }
+};
+
+/**
+ * Appends the targets of every fact in Sources to Targets.
+ */
+template <typename D, typename RangeT, typename PrimitiveT>
+inline void computeTargetsOf(PrimitiveT &Primitive, const RangeT &Sources,
+                             llvm::SmallVectorImpl<D> &Targets) {
+  for (const D &Source : Sources) {
+    Primitive(Source, Targets);
+  }
+}
+
+/**
+ * @brief Applies Second to each target of First.
+ */
+template <typename D, typename FirstT, typename SecondT, unsigned N = 4>
+class ComposedPrimitive {
+private:
+  FirstT First;
+  SecondT Second;
+
+public:
+  ComposedPrimitive(FirstT First, SecondT Second)
+      : First(std::move(First)), Second(std::move(Second)) {}
+
+  void operator()(D Source, llvm::SmallVectorImpl<D> &Targets) {
+    llvm::SmallVector<D, N> Intermediate;
+    First(Source, Intermediate);
+    computeTargetsOf(Second, Intermediate, Targets);
+  }
+};
+
+/**
+ * @brief Generates the targets of First as well as of Second.
+ */
+template <typename D, typename FirstT, typename SecondT> class UnitedPrimitive {
+private:
+  FirstT First;
+  SecondT Second;
+
+public:
+  UnitedPrimitive(FirstT First, SecondT Second)
+      : First(std::move(First)), Second(std::move(Second)) {}
+
+  void operator()(D Source, llvm::SmallVectorImpl<D> &Targets) {
+    First(Source, Targets);
+    Second(Source, Targets);
+  }
+};
+
+template <typename D, typename FirstT, typename SecondT>
+ComposedPrimitive<D, FirstT, SecondT> composePrimitives(FirstT First,
+                                                        SecondT Second) {
+  return ComposedPrimitive<D, FirstT, SecondT>(std::move(First),
+                                               std::move(Second));
+}
+
+template <typename D, typename FirstT, typename SecondT>
+UnitedPrimitive<D, FirstT, SecondT> unitePrimitives(FirstT First,
+                                                    SecondT Second) {
+  return UnitedPrimitive<D, FirstT, SecondT>(std::move(First),
+                                             std::move(Second));
+}
+
+/**
+ * @brief Makes a flow primitive usable where a FlowFunction is expected.
+ */
+template <typename D, typename PrimitiveT, unsigned N = 4>
+class PrimitiveFlow : public FlowFunction<D> {
+private:
+  PrimitiveT Primitive;
+
+public:
+  PrimitiveFlow(PrimitiveT Primitive) : Primitive(std::move(Primitive)) {}
+  virtual ~PrimitiveFlow() = default;
+
+  std::set<D> computeTargets(D source) override {
+    llvm::SmallVector<D, N> Targets;
+    Primitive(source, Targets);
+    return std::set<D>(Targets.begin(), Targets.end());
+  }
+};
+
+template <typename D, typename PrimitiveT>
+std::shared_ptr<FlowFunction<D>> makePrimitiveFlow(PrimitiveT Primitive) {
+  return std::make_shared<PrimitiveFlow<D, PrimitiveT>>(std::move(Primitive));
+}
+
+} // namespace psr
+
+#endif
@@ -48,6 +48,10 @@ public:
 
   N getStartNode() const { return StartNode; }
 
+  const std::vector<bool> &getContext() const { return Context; }
+
+  const std::set<D> &getOutputs() const { return Outputs; }
+
   N getEndNode() const { return EndNode; }
 };
 
@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <iostream> // Suppress the cout as soon as to possible and get rid of this header
 #include <map>
+#include <mutex>
 #include <set>
 #include <vector>
 
@@ -27,10 +28,25 @@
 
 namespace psr {
 
+/**
+ * Summaries are either stored per context or in a distributive form, i.e.
+ * the facts generated by the zero value alone plus the facts generated by
+ * every single input. The latter represents the summaries of all 2^k contexts
+ * of a function with k inputs using k + 1 sets, the summary of a context is
+ * the union of the sets of its inputs. Summaries may be inserted by several
+ * threads at once.
+ */
 template <typename D, typename N> class IFDSSummaryPool {
 private:
+  struct DistributiveSummary {
+    N EndNode;
+    std::set<D> ZeroOutputs;
+    std::vector<std::set<D>> InputOutputs;
+  };
   /// Stores the summary that starts at a given node.
   std::map<N, std::map<std::vector<bool>, IFDSSummary<D, N>>> SummaryMap;
+  std::map<N, DistributiveSummary> DistributiveSummaryMap;
+  mutable std::mutex Mutex;
 
 public:
   IFDSSummaryPool() = default;
@@ -38,16 +54,60 @@ public:
 
   void insertSummary(N StartNode, std::vector<bool> Context,
                      IFDSSummary<D, N> Summary) {
-    SummaryMap[StartNode][Context] = Summary;
+    std::lock_guard<std::mutex> Lock(Mutex);
+    auto &Summaries = SummaryMap[StartNode];
+    Summaries.erase(Context);
+    Summaries.insert(std::make_pair(std::move(Context), std::move(Summary)));
+  }
+
+  /**
+   * @brief Stores the summaries of all contexts of the function starting at
+   * StartNode, InputOutputs[i] are the facts generated by the i-th input.
+   */
+  void insertDistributiveSummary(N StartNode, N EndNode,
+                                 std::set<D> ZeroOutputs,
+                                 std::vector<std::set<D>> InputOutputs) {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    DistributiveSummaryMap[StartNode] = {EndNode, std::move(ZeroOutputs),
+                                         std::move(InputOutputs)};
   }
 
-  bool containsSummary(N StartNode) { return SummaryMap.count(StartNode); }
+  bool containsSummary(N StartNode) const {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    return SummaryMap.count(StartNode) ||
+           DistributiveSummaryMap.count(StartNode);
+  }
 
-  std::set<D> getSummary(N StartNode, std::vector<bool> Context) {
-    return SummaryMap[StartNode][Context];
+  /**
+   * @brief Returns the facts that the function starting at StartNode
+   * generates in the given context.
+   */
+  std::set<D> getSummary(N StartNode, const std::vector<bool> &Context) const {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    auto Summaries = SummaryMap.find(StartNode);
+    if (Summaries != SummaryMap.end()) {
+      auto Summary = Summaries->second.find(Context);
+      if (Summary != Summaries->second.end()) {
+        return Summary->second.getOutputs();
+      }
+    }
+    auto Search = DistributiveSummaryMap.find(StartNode);
+    if (Search == DistributiveSummaryMap.end()) {
+      return {};
+    }
+    std::set<D> Outputs = Search->second.ZeroOutputs;
+    for (size_t i = 0;
+         i < Context.size() && i < Search->second.InputOutputs.size(); ++i) {
+      if (Context[i]) {
+        Outputs.insert(Search->second.InputOutputs[i].begin(),
+                       Search->second.InputOutputs[i].end());
+      }
+    }
+    return Outputs;
   }
 
   void print() {
+    std::lock_guard<std::mutex> Lock(Mutex);
     std::cout << "DynamicSummaries:\n";
     for (auto &entry : SummaryMap) {
       std::cout << "Function: " << entry.first << "\n";
@@ -57,13 +117,22 @@ public:
                  [](bool b) { std::cout << b; });
         std::cout << "\n";
         std::cout << "Beg results:\n";
-        for (auto &result : context_summaries.second) {
-          // result->dump();
-          std::cout << "fixme\n";
+        for (auto &result : context_summaries.second.getOutputs()) {
+          std::cout << result << "\n";
         }
         std::cout << "End results!\n";
       }
     }
+    for (auto &entry : DistributiveSummaryMap) {
+      std::cout << "Function: " << entry.first << "\n";
+      std::cout << "Zero generates: " << entry.second.ZeroOutputs.size()
+                << " facts\n";
+      for (size_t i = 0; i < entry.second.InputOutputs.size(); ++i) {
+        std::cout << "Input " << i
+                  << " generates: " << entry.second.InputOutputs[i].size()
+                  << " facts\n";
+      }
+    }
   }
 };
 
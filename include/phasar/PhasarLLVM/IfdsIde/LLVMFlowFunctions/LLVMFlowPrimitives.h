@@ -0,0 +1,163 @@
+/******************************************************************************
+ * Copyright (c) 2018 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_LLVMFLOWFUNCTIONS_LLVMFLOWPRIMITIVES_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_LLVMFLOWFUNCTIONS_LLVMFLOWPRIMITIVES_H_
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/IR/Argument.h>
+#include <llvm/IR/CallSite.h> // llvm::ImmutableCallSite
+#include <llvm/IR/Instructions.h>
+
+#include <phasar/PhasarLLVM/IfdsIde/FlowFunctions/FlowPrimitives.h>
+#include <phasar/PhasarLLVM/IfdsIde/LLVMZeroValue.h>
+
+namespace llvm {
+class Function;
+class Value;
+} // namespace llvm
+
+namespace psr {
+
+/**
+ * @brief Generates the loaded value if the pointer operand holds.
+ */
+template <typename D> class LoadPrimitive {
+private:
+  const llvm::LoadInst *Load;
+
+public:
+  LoadPrimitive(const llvm::LoadInst *Load) : Load(Load) {}
+
+  void operator()(D Source, llvm::SmallVectorImpl<D> &Targets) const {
+    Targets.push_back(Source);
+    if (Source == Load->getPointerOperand()) {
+      Targets.push_back(Load);
+    }
+  }
+};
+
+/**
+ * @brief Generates the pointer operand if the stored value holds.
+ */
+template <typename D> class StorePrimitive {
+private:
+  const llvm::StoreInst *Store;
+
+public:
+  StorePrimitive(const llvm::StoreInst *Store) : Store(Store) {}
+
+  void operator()(D Source, llvm::SmallVectorImpl<D> &Targets) const {
+    Targets.push_back(Source);
+    if (Store->getValueOperand() == Source) {
+      Targets.push_back(Store->getPointerOperand());
+    }
+  }
+};
+
+/**
+ * Precomputes which actual parameters of a call site correspond to which
+ * formal parameters of a callee, such that facts can be mapped between the
+ * two contexts without scanning the parameter lists. A mapping is meant to
+ * be built once per call site and callee and used for all facts reaching it.
+ *
+ * Actual parameters that are passed to the variadic part of a callee with a
+ * body are mapped onto its %struct.__va_list_tag allocations and vice versa.
+ *
+ * @brief Maps facts between a call site and a callee.
+ */
+class CallSiteParameterMapping {
+private:
+  llvm::ImmutableCallSite CallSite;
+  const llvm::Function *Callee;
+  // actual parameters along with their positions, sorted by the actual
+  // parameter; an actual passed more than once has an entry per position
+  std::vector<std::pair<const llvm::Value *, unsigned>> ActualIndices;
+  llvm::SmallVector<const llvm::Argument *, 4> Formals;
+  llvm::SmallVector<const llvm::AllocaInst *, 1> VarArgLists;
+
+public:
+  CallSiteParameterMapping(llvm::ImmutableCallSite CallSite,
+                           const llvm::Function *Callee);
+
+  /**
+   * Appends the formal parameters Source is passed to, provided Predicate
+   * holds for Source. The zero value is mapped to itself.
+   */
+  template <typename PredicateT = AnyFact>
+  void mapToCallee(const llvm::Value *Source,
+                   llvm::SmallVectorImpl<const llvm::Value *> &Targets,
+                   const PredicateT &Predicate = PredicateT()) const {
+    if (isLLVMZeroValue(Source)) {
+      Targets.push_back(Source);
+      return;
+    }
+    auto It = std::lower_bound(ActualIndices.begin(), ActualIndices.end(),
+                               std::make_pair(Source, 0u));
+    if (It == ActualIndices.end() || It->first != Source ||
+        !Predicate(Source)) {
+      return;
+    }
+    bool VarArgsMapped = false;
+    for (; It != ActualIndices.end() && It->first == Source; ++It) {
+      if (It->second < Formals.size()) {
+        Targets.push_back(Formals[It->second]);
+      } else if (!VarArgsMapped) {
+        // over-approximate by generating the va_list of the callee
+        Targets.append(VarArgLists.begin(), VarArgLists.end());
+        VarArgsMapped = true;
+      }
+    }
+  }
+
+  /**
+   * Appends the actual parameters that correspond to Source, provided
+   * ParamPredicate holds for Source, and the call site if Source is returned
+   * at Exit and ReturnPredicate holds for the callee. The zero value is
+   * mapped to itself.
+   */
+  template <typename ParamPredicateT = AnyFact,
+            typename ReturnPredicateT = AnyFact>
+  void mapToCaller(const llvm::Value *Source, const llvm::ReturnInst *Exit,
+                   llvm::SmallVectorImpl<const llvm::Value *> &Targets,
+                   const ParamPredicateT &ParamPredicate = ParamPredicateT(),
+                   const ReturnPredicateT &ReturnPredicate =
+                       ReturnPredicateT()) const {
+    if (isLLVMZeroValue(Source)) {
+      Targets.push_back(Source);
+      return;
+    }
+    if (llvm::is_contained(VarArgLists, Source)) {
+      // over-approximate by generating all variadic actual parameters
+      for (unsigned Idx = Formals.size(); Idx < CallSite.getNumArgOperands();
+           ++Idx) {
+        Targets.push_back(CallSite.getArgOperand(Idx));
+      }
+    }
+    if (auto Formal = llvm::dyn_cast<llvm::Argument>(Source)) {
+      if (Formal->getParent() == Callee &&
+          Formal->getArgNo() < CallSite.getNumArgOperands() &&
+          ParamPredicate(Source)) {
+        Targets.push_back(CallSite.getArgOperand(Formal->getArgNo()));
+      }
+    }
+    if (Exit && Source == Exit->getReturnValue() && ReturnPredicate(Callee)) {
+      Targets.push_back(CallSite.getInstruction());
+    }
+  }
+};
+
+} // namespace psr
+
+#endif
@@ -11,14 +11,13 @@
 #define PHASAR_PHASARLLVM_IFDSIDE_LLVMFLOWFUNCTIONS_MAPFACTSTOCALLEE_H_
 
 #include <functional>
-#include <vector>
 
 #include <phasar/PhasarLLVM/IfdsIde/FlowFunction.h>
+#include <phasar/PhasarLLVM/IfdsIde/LLVMFlowFunctions/LLVMFlowPrimitives.h>
 
 namespace llvm {
 class Value;
 class Function;
-class ImmutableCallSite;
 } // namespace llvm
 
 namespace psr {
@@ -27,12 +26,13 @@ namespace psr {
  * A predicate can be used to specifiy additonal requirements for mapping
  * actual parameter into formal parameter.
  * @brief Generates all valid formal parameter in the callee context.
+ * @see CallSiteParameterMapping for a primitive that works without a
+ * std::function predicate and without allocating a result set.
  */
 class MapFactsToCallee : public FlowFunction<const llvm::Value *> {
 protected:
   const llvm::Function *destMthd;
-  std::vector<const llvm::Value *> actuals;
-  std::vector<const llvm::Value *> formals;
+  CallSiteParameterMapping mapping;
   std::function<bool(const llvm::Value *)> predicate;
 
 public:
@@ -11,11 +11,11 @@
 #define PHASAR_PHASARLLVM_IFDSIDE_LLVMFLOWFUNCTIONS_MAPFACTSTOCALLER_H_
 
 #include <functional>
-#include <vector>
 
 #include <llvm/IR/CallSite.h> // llvm::ImmutableCallSite
 
 #include <phasar/PhasarLLVM/IfdsIde/FlowFunction.h>
+#include <phasar/PhasarLLVM/IfdsIde/LLVMFlowFunctions/LLVMFlowPrimitives.h>
 
 namespace llvm {
 class Function;
@@ -32,14 +32,15 @@ namespace psr {
  * the callee method.
  * @brief Generates all valid actual parameters and the return value in the
  * caller context.
+ * @see CallSiteParameterMapping for a primitive that works without
+ * std::function predicates and without allocating a result set.
  */
 class MapFactsToCaller : public FlowFunction<const llvm::Value *> {
 private:
   llvm::ImmutableCallSite callSite;
   const llvm::Function *calleeMthd;
   const llvm::ReturnInst *exitStmt;
-  std::vector<const llvm::Value *> actuals;
-  std::vector<const llvm::Value *> formals;
+  CallSiteParameterMapping mapping;
   std::function<bool(const llvm::Value *)> paramPredicate;
   std::function<bool(const llvm::Function *)> returnPredicate;
 
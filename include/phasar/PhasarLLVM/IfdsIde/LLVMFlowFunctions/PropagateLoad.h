@@ -11,6 +11,7 @@
 #define PHASAR_PHASARLLVM_IFDSIDE_LLVMFLOWFUNCTIONS_PROPAGATELOAD_H_
 
 #include <phasar/PhasarLLVM/IfdsIde/FlowFunction.h>
+#include <phasar/PhasarLLVM/IfdsIde/LLVMFlowFunctions/LLVMFlowPrimitives.h>
 
 #include <llvm/IR/Instructions.h>
 
@@ -25,10 +26,10 @@ public:
   virtual ~PropagateLoad() = default;
 
   std::set<D> computeTargets(D source) override {
-    if (source == Load->getPointerOperand()) {
-      return {source, Load};
-    }
-    return {source};
+    llvm::SmallVector<D, 2> Targets;
+    LoadPrimitive<D> Primitive(Load);
+    Primitive(source, Targets);
+    return std::set<D>(Targets.begin(), Targets.end());
   }
 };
 
@@ -11,6 +11,7 @@
 #define PHASAR_PHASARLLVM_IFDSIDE_LLVMFLOWFUNCTIONS_PROPAGATESTORE_H_
 
 #include <phasar/PhasarLLVM/IfdsIde/FlowFunction.h>
+#include <phasar/PhasarLLVM/IfdsIde/LLVMFlowFunctions/LLVMFlowPrimitives.h>
 
 #include <llvm/IR/Instructions.h>
 
@@ -25,10 +26,10 @@ public:
   virtual ~PropagateStore() = default;
 
   std::set<D> computeTargets(D source) override {
-    if (Store->getValueOperand() == source) {
-      return {source, Store->getPointerOperand()};
-    }
-    return {source};
+    llvm::SmallVector<D, 2> Targets;
+    StorePrimitive<D> Primitive(Store);
+    Primitive(source, Targets);
+    return std::set<D>(Targets.begin(), Targets.end());
   }
 };
 
@@ -25,10 +25,12 @@
 #include <llvm/IR/Value.h>
 
 #include <phasar/PhasarLLVM/IfdsIde/DefaultIFDSTabulationProblem.h>
+#include <phasar/PhasarLLVM/IfdsIde/IFDSSummaryPool.h>
 #include <phasar/PhasarLLVM/IfdsIde/IFDSTabulationProblem.h>
 #include <phasar/PhasarLLVM/IfdsIde/Solver/IFDSSummaryGenerator.h>
 #include <phasar/PhasarLLVM/IfdsIde/Solver/LLVMIFDSSolver.h>
 #include <phasar/Utils/LLVMShorthands.h>
+#include <phasar/Utils/Parallel.h>
 
 namespace psr {
 
@@ -79,6 +81,30 @@ public:
                                                                      S) {}
 
   virtual ~LLVMIFDSSummaryGenerator() = default;
+
+  /**
+   * The functions are independent of each other, they are summarized by
+   * Threads threads (0 uses one per hardware thread). All threads query the
+   * same ICFG, which therefore has to support concurrent queries, e.g.
+   * LLVMBasedBiDiICFG; use a single thread otherwise. Declarations are
+   * skipped.
+   *
+   * @brief Stores the summaries of all contexts of the given functions in
+   * the pool.
+   */
+  static void
+  generateSummaries(const std::vector<const llvm::Function *> &Functions,
+                    I icfg, SummaryGenerationStrategy S,
+                    IFDSSummaryPool<const llvm::Value *,
+                                    const llvm::Instruction *> &Pool,
+                    unsigned Threads = 0) {
+    parallelForEach(Functions.size(), Threads, [&](size_t i) {
+      if (!Functions[i]->isDeclaration()) {
+        LLVMIFDSSummaryGenerator Generator(Functions[i], icfg, S);
+        Generator.generateSummary(Pool);
+      }
+    });
+  }
 };
 } // namespace psr
 
@@ -10,6 +10,7 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_PROBLEMS_IDELINEARCONSTANTANALYSIS_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_PROBLEMS_IDELINEARCONSTANTANALYSIS_H_
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <set>
@@ -36,9 +37,9 @@ private:
   std::vector<std::string> EntryPoints;
 
   // For debug purpose only
-  static unsigned CurrGenConstant_Id;
-  static unsigned CurrLCAID_Id;
-  static unsigned CurrBinary_Id;
+  static std::atomic<unsigned> CurrGenConstant_Id;
+  static std::atomic<unsigned> CurrLCAID_Id;
+  static std::atomic<unsigned> CurrBinary_Id;
 
 public:
   typedef const llvm::Value *d_t;
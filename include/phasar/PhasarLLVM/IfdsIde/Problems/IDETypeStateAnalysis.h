@@ -27,6 +27,7 @@ class Value;
 } // namespace llvm
 
 namespace psr {
+class AliasOracle;
 class LLVMBasedICFG;
 
 // caution the underlying intergers do matter!
@@ -67,6 +68,7 @@ public:
 private:
   std::vector<std::string> EntryPoints;
   static const std::set<std::string> STDIOFunctions;
+  AliasOracle *Aliases = nullptr;
 
 public:
   static const State TOP;
@@ -80,6 +82,12 @@ public:
 
   virtual ~IDETypeStateAnalysis() = default;
 
+  /**
+   * @brief The oracle is used to find the aliases of file handles that are
+   * consumed by a function, e.g. fclose().
+   */
+  void setAliasOracle(AliasOracle &Oracle);
+
   // start formulating our analysis by specifying the parts required for IFDS
 
   std::shared_ptr<FlowFunction<d_t>> getNormalFlowFunction(n_t curr,
@@ -28,6 +28,7 @@ class Value;
 
 namespace psr {
 
+class AliasOracle;
 class LLVMBasedICFG;
 
 /**
@@ -51,6 +52,7 @@ public:
 private:
   TaintSensitiveFunctions SourceSinkFunctions;
   std::vector<std::string> EntryPoints;
+  AliasOracle *Aliases = nullptr;
 
 public:
   /// Holds all leaks found during the analysis
@@ -68,6 +70,12 @@ public:
 
   virtual ~IFDSTaintAnalysis() = default;
 
+  /**
+   * @brief Queries the given oracle for the aliases of tainted values instead
+   * of the whole-module points-to graph.
+   */
+  void setAliasOracle(AliasOracle &Oracle);
+
   std::shared_ptr<FlowFunction<d_t>> getNormalFlowFunction(n_t curr,
                                                            n_t succ) override;
 
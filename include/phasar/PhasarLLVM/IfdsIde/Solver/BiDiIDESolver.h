@@ -17,4 +17,321 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_BIDIIDESOLVER_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_BIDIIDESOLVER_H_
 
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <phasar/PhasarLLVM/IfdsIde/IDETabulationProblem.h>
+#include <phasar/PhasarLLVM/IfdsIde/IFDSTabulationProblem.h>
+#include <phasar/PhasarLLVM/IfdsIde/Solver/IDESolver.h>
+#include <phasar/Utils/Logger.h>
+#include <phasar/Utils/PAMMMacros.h>
+#include <phasar/Utils/Profiler.h>
+
+namespace psr {
+
+/**
+ * Solves a forward and a backward problem, e.g. on an LLVMBasedBiDiICFG and
+ * the BackwardsBiDiICFG of it, on two threads. Both problems must follow
+ * returns past their seeds. An unbalanced return, i.e. a leak of one
+ * direction out of the method containing its seed, is paused until the other
+ * direction leaks into the caller at the same call site, since a caller that
+ * is only reachable in one direction cannot be relevant for a bidirectional
+ * query. Unbalanced returns that never find a partner are dropped.
+ *
+ * The directions only synchronize at these leaks and otherwise run
+ * independently, such that a query finishes in roughly the time of the slower
+ * direction. Each direction exclusively owns its solver; only the leaks are
+ * shared under a lock.
+ *
+ * @brief Runs a forward and a backward IDE analysis concurrently.
+ */
+template <typename N, typename D, typename M, typename V, typename I>
+class BiDiIDESolver {
+private:
+  /// An unbalanced return as passed to propagteUnbalancedReturnFlow()
+  struct UnbalancedReturn {
+    N RetSite;
+    D Fact;
+    std::shared_ptr<EdgeFunction<V>> EdgeFn;
+    N CallSite;
+  };
+
+  class SingleDirectionSolver : public IDESolver<N, D, M, V, I> {
+  private:
+    BiDiIDESolver &Parent;
+    bool IsForward;
+
+  public:
+    template <typename ProblemTy>
+    SingleDirectionSolver(ProblemTy &Problem, BiDiIDESolver &Parent,
+                          bool IsForward)
+        : IDESolver<N, D, M, V, I>(Problem), Parent(Parent),
+          IsForward(IsForward) {
+      if (!this->followReturnPastSeeds) {
+        throw std::runtime_error("bidirectional analysis requires problems "
+                                 "that follow returns past seeds");
+      }
+      // both directions report to the same PAMM instance
+      this->setStatisticsScope(IsForward ? "Forward " : "Backward ");
+    }
+
+    ~SingleDirectionSolver() override = default;
+
+    void propagteUnbalancedReturnFlow(
+        N retSiteC, D targetVal, std::shared_ptr<EdgeFunction<V>> edgeFunction,
+        N relatedCallSite) override {
+      if (Parent.leak(IsForward,
+                      {retSiteC, targetVal, edgeFunction, relatedCallSite})) {
+        resume({retSiteC, targetVal, edgeFunction, relatedCallSite});
+      }
+    }
+
+    void resume(const UnbalancedReturn &R) {
+      IDESolver<N, D, M, V, I>::propagteUnbalancedReturnFlow(
+          R.RetSite, R.Fact, R.EdgeFn, R.CallSite);
+    }
+
+    using IDESolver<N, D, M, V, I>::registerStatistics;
+    using IDESolver<N, D, M, V, I>::submitInitalSeeds;
+    using IDESolver<N, D, M, V, I>::computeValues;
+    using IDESolver<N, D, M, V, I>::computeAndPrintStatistics;
+
+    bool computesValues() const { return this->computevalues; }
+
+    unsigned getPathEdgeCount() const { return this->PathEdgeCount; }
+
+    const std::string &getStatisticsScope() const {
+      return this->StatisticsScope;
+    }
+  };
+
+  struct Direction {
+    std::unique_ptr<SingleDirectionSolver> Solver;
+    /// Call sites this direction has returned to past its seeds
+    std::set<N> LeakedAt;
+    /// Unbalanced returns waiting for the other direction, by call site
+    std::map<N, std::vector<UnbalancedReturn>> Paused;
+    /// Unbalanced returns the other direction has released
+    std::vector<UnbalancedReturn> Released;
+    bool Idle = false;
+    unsigned Leaks = 0;
+    unsigned Resumed = 0;
+    std::exception_ptr Error;
+  };
+
+  Direction Forward;
+  Direction Backward;
+  std::mutex Mtx;
+  std::condition_variable CV;
+  bool Aborted = false;
+
+  Direction &get(bool IsForward) { return IsForward ? Forward : Backward; }
+
+  /**
+   * @brief Records an unbalanced return of one direction and returns whether
+   * it may be propagated right away, otherwise it is paused.
+   */
+  bool leak(bool IsForward, const UnbalancedReturn &R) {
+    Direction &Own = get(IsForward);
+    Direction &Other = get(!IsForward);
+    std::lock_guard<std::mutex> Lock(Mtx);
+    ++Own.Leaks;
+    Own.LeakedAt.insert(R.CallSite);
+    if (!Other.LeakedAt.count(R.CallSite)) {
+      Own.Paused[R.CallSite].push_back(R);
+      return false;
+    }
+    auto Search = Other.Paused.find(R.CallSite);
+    if (Search != Other.Paused.end()) {
+      Other.Released.insert(Other.Released.end(), Search->second.begin(),
+                            Search->second.end());
+      Other.Paused.erase(Search);
+      CV.notify_all();
+    }
+    return true;
+  }
+
+  /**
+   * A direction is done as soon as it and the other direction are idle and
+   * neither has released unbalanced returns left to propagate.
+   */
+  void run(bool IsForward) {
+    PROFILE_SCOPE_DETAIL("BiDiIDESolver::run",
+                         std::string(IsForward ? "forward" : "backward"));
+    PAMM_GET_INSTANCE;
+    Direction &Own = get(IsForward);
+    Direction &Other = get(!IsForward);
+    try {
+      // the timers computeAndPrintStatistics() reports for the direction
+      const std::string &Scope = Own.Solver->getStatisticsScope();
+      START_NAMED_TIMER(Scope + "DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
+      Own.Solver->submitInitalSeeds();
+      std::unique_lock<std::mutex> Lock(Mtx);
+      while (true) {
+        if (!Own.Released.empty()) {
+          std::vector<UnbalancedReturn> Returns;
+          Returns.swap(Own.Released);
+          Own.Resumed += Returns.size();
+          Lock.unlock();
+          for (const auto &R : Returns) {
+            Own.Solver->resume(R);
+          }
+          Lock.lock();
+          continue;
+        }
+        Own.Idle = true;
+        CV.notify_all();
+        CV.wait(Lock, [&]() {
+          return Aborted || !Own.Released.empty() ||
+                 (Other.Idle && Other.Released.empty());
+        });
+        if (Aborted || Own.Released.empty()) {
+          break;
+        }
+        Own.Idle = false;
+      }
+      bool Abort = Aborted;
+      Lock.unlock();
+      STOP_NAMED_TIMER(Scope + "DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
+      START_NAMED_TIMER(Scope + "DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
+      if (!Abort && Own.Solver->computesValues()) {
+        Own.Solver->computeValues();
+      }
+      STOP_NAMED_TIMER(Scope + "DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
+    } catch (...) {
+      std::lock_guard<std::mutex> Lock(Mtx);
+      Own.Error = std::current_exception();
+      Own.Idle = true;
+      Aborted = true;
+      CV.notify_all();
+    }
+  }
+
+  void printStatistics() {
+    auto &lg = lg::get();
+    PAMM_GET_INSTANCE;
+    Forward.Solver->computeAndPrintStatistics();
+    Backward.Solver->computeAndPrintStatistics();
+    unsigned ForwardDropped = 0, BackwardDropped = 0;
+    for (const auto &Entry : Forward.Paused) {
+      ForwardDropped += Entry.second.size();
+    }
+    for (const auto &Entry : Backward.Paused) {
+      BackwardDropped += Entry.second.size();
+    }
+    INC_NAMED_COUNTER("Forward Path Edges", Forward.Solver->getPathEdgeCount(),
+                      PAMM_SEVERITY_LEVEL::Core);
+    INC_NAMED_COUNTER("Backward Path Edges",
+                      Backward.Solver->getPathEdgeCount(),
+                      PAMM_SEVERITY_LEVEL::Core);
+    INC_NAMED_COUNTER("Forward Unbalanced Returns", Forward.Leaks,
+                      PAMM_SEVERITY_LEVEL::Core);
+    INC_NAMED_COUNTER("Backward Unbalanced Returns", Backward.Leaks,
+                      PAMM_SEVERITY_LEVEL::Core);
+    INC_NAMED_COUNTER("Forward Resumed Returns", Forward.Resumed,
+                      PAMM_SEVERITY_LEVEL::Core);
+    INC_NAMED_COUNTER("Backward Resumed Returns", Backward.Resumed,
+                      PAMM_SEVERITY_LEVEL::Core);
+    INC_NAMED_COUNTER("Forward Dropped Returns", ForwardDropped,
+                      PAMM_SEVERITY_LEVEL::Core);
+    INC_NAMED_COUNTER("Backward Dropped Returns", BackwardDropped,
+                      PAMM_SEVERITY_LEVEL::Core);
+    LOG_SEV_IF_ENABLE(lg, INFO, "=== Bidirectional Solver Statistics ===");
+    LOG_SEV_IF_ENABLE(lg, INFO, "#Path Edges       : "
+                                << Forward.Solver->getPathEdgeCount()
+                                << " forward, "
+                                << Backward.Solver->getPathEdgeCount()
+                                << " backward");
+    LOG_SEV_IF_ENABLE(lg, INFO, "#Unbalanced Ret.  : "
+                                << Forward.Leaks << " forward, "
+                                << Backward.Leaks << " backward");
+    LOG_SEV_IF_ENABLE(lg, INFO, "#Dropped Returns  : "
+                                << ForwardDropped << " forward, "
+                                << BackwardDropped << " backward");
+    if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Full) {
+      LOG_SEV_IF_ENABLE(lg, INFO, "Forward DFA Phase I : "
+                                  << PRINT_TIMER("Forward DFA Phase I"));
+      LOG_SEV_IF_ENABLE(lg, INFO, "Backward DFA Phase I: "
+                                  << PRINT_TIMER("Backward DFA Phase I"));
+    }
+  }
+
+protected:
+  BiDiIDESolver(IFDSTabulationProblem<N, D, M, I> &ForwardProblem,
+                IFDSTabulationProblem<N, D, M, I> &BackwardProblem) {
+    Forward.Solver =
+        std::make_unique<SingleDirectionSolver>(ForwardProblem, *this, true);
+    Backward.Solver =
+        std::make_unique<SingleDirectionSolver>(BackwardProblem, *this, false);
+  }
+
+public:
+  BiDiIDESolver(IDETabulationProblem<N, D, M, V, I> &ForwardProblem,
+                IDETabulationProblem<N, D, M, V, I> &BackwardProblem) {
+    Forward.Solver =
+        std::make_unique<SingleDirectionSolver>(ForwardProblem, *this, true);
+    Backward.Solver =
+        std::make_unique<SingleDirectionSolver>(BackwardProblem, *this, false);
+  }
+
+  virtual ~BiDiIDESolver() = default;
+
+  /**
+   * The backward direction runs on a new thread, the forward direction on the
+   * calling one. Exceptions thrown by either direction are rethrown.
+   *
+   * @brief Runs both solvers on their problems.
+   */
+  virtual void solve() {
+    PROFILE_SCOPE("BiDiIDESolver::solve");
+    auto &lg = lg::get();
+    LOG_SEV_IF_ENABLE(lg, INFO, "Bidirectional IDE solver is solving the "
+                                "specified problems");
+    Forward.Solver->registerStatistics();
+    std::thread BackwardThread([this]() { run(false); });
+    run(true);
+    BackwardThread.join();
+    for (Direction *Dir : {&Forward, &Backward}) {
+      if (Dir->Error) {
+        std::rethrow_exception(Dir->Error);
+      }
+    }
+    LOG_SEV_IF_ENABLE(lg, INFO, "Problems solved");
+    if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Core) {
+      printStatistics();
+    }
+  }
+
+  IDESolver<N, D, M, V, I> &getForwardSolver() { return *Forward.Solver; }
+
+  IDESolver<N, D, M, V, I> &getBackwardSolver() { return *Backward.Solver; }
+
+  V forwardResultAt(N stmt, D value) {
+    return Forward.Solver->resultAt(stmt, value);
+  }
+
+  V backwardResultAt(N stmt, D value) {
+    return Backward.Solver->resultAt(stmt, value);
+  }
+
+  std::unordered_map<D, V> forwardResultsAt(N stmt, bool stripZero = false) {
+    return Forward.Solver->resultsAt(stmt, stripZero);
+  }
+
+  std::unordered_map<D, V> backwardResultsAt(N stmt, bool stripZero = false) {
+    return Backward.Solver->resultsAt(stmt, stripZero);
+  }
+};
+
+} // namespace psr
+
 #endif
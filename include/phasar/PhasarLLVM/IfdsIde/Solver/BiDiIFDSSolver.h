@@ -16,4 +16,43 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_BIDIIFDSSOLVER_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_BIDIIFDSSOLVER_H_
 
+#include <set>
+#include <unordered_map>
+
+#include <phasar/PhasarLLVM/IfdsIde/Solver/BiDiIDESolver.h>
+#include <phasar/PhasarLLVM/Utils/BinaryDomain.h>
+
+namespace psr {
+
+template <typename N, typename D, typename M, typename I>
+class BiDiIFDSSolver : public BiDiIDESolver<N, D, M, BinaryDomain, I> {
+public:
+  BiDiIFDSSolver(IFDSTabulationProblem<N, D, M, I> &ForwardProblem,
+                 IFDSTabulationProblem<N, D, M, I> &BackwardProblem)
+      : BiDiIDESolver<N, D, M, BinaryDomain, I>(ForwardProblem,
+                                                BackwardProblem) {}
+
+  virtual ~BiDiIFDSSolver() = default;
+
+  std::set<D> ifdsForwardResultsAt(N stmt) {
+    return keySet(this->forwardResultsAt(stmt));
+  }
+
+  std::set<D> ifdsBackwardResultsAt(N stmt) {
+    return keySet(this->backwardResultsAt(stmt));
+  }
+
+private:
+  static std::set<D>
+  keySet(const std::unordered_map<D, BinaryDomain> &Results) {
+    std::set<D> keyset;
+    for (auto d : Results) {
+      keyset.insert(d.first);
+    }
+    return keyset;
+  }
+};
+
+} // namespace psr
+
 #endif
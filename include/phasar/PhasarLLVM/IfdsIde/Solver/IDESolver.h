@@ -18,14 +18,20 @@
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_IDESOLVER_H_
 
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <set>
+#include <stdexcept>
 #include <string>
+#include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include <curl/curl.h>
 #include <json.hpp>
@@ -51,6 +57,8 @@
 #include <phasar/Utils/LLVMShorthands.h>
 #include <phasar/Utils/Logger.h>
 #include <phasar/Utils/PAMMMacros.h>
+#include <phasar/Utils/Profiler.h>
+#include <phasar/Utils/ResultWriter.h>
 #include <phasar/Utils/Table.h>
 
 namespace psr {
@@ -86,6 +94,11 @@ public:
         computePersistedSummaries(
             tabulationProblem.solver_config.computePersistedSummaries),
         recordEdges(tabulationProblem.solver_config.recordEdges),
+        collectFinishedMethods(
+            tabulationProblem.solver_config.collectFinishedMethods &&
+            !tabulationProblem.solver_config.followReturnsPastSeeds &&
+            !tabulationProblem.solver_config.computeValues),
+        incremental(tabulationProblem.solver_config.incremental),
         PathEdgeCount(0), cachedFlowEdgeFunctions(tabulationProblem),
         allTop(tabulationProblem.allTopFunction()),
         jumpFn(std::make_shared<JumpFunctions<N, D, M, V, I>>(
@@ -93,6 +106,7 @@ public:
         initialSeeds(tabulationProblem.initialSeeds()) {
     // std::cout << "called IDESolver::IDESolver() ctor with IDEProblem"
     //           << std::endl;
+    openEdgeLog(tabulationProblem.solver_config.edgeLogFile);
   }
 
   virtual ~IDESolver() = default;
@@ -129,6 +143,102 @@ public:
     return J;
   }
 
+  /**
+   * Writes the same document as getAsJson(), but streams it node by node
+   * instead of building it in memory. Every node and fact is rendered only
+   * once.
+   *
+   * @brief Streams the computed results as json.
+   */
+  void emitResults(JsonStreamWriter &W) {
+    const static std::string DataFlowID = "DataFlow";
+    W.beginObject();
+    W.key(DataFlowID);
+    if (valtab.rowMapView().empty()) {
+      W.value("EMPTY");
+      W.endObject();
+      return;
+    }
+    std::unordered_map<D, std::string> facts;
+    W.beginObject();
+    for (auto &row : valtab.rowMapView()) {
+      W.key(nodeToString(row.first));
+      W.beginObject();
+      W.key("Facts");
+      W.beginArray();
+      for (auto &cell : row.second) {
+        auto search = facts.find(cell.first);
+        if (search == facts.end()) {
+          std::string fact = ideTabulationProblem.DtoString(cell.first);
+          boost::algorithm::trim(fact);
+          search = facts.emplace(cell.first, std::move(fact)).first;
+        }
+        std::string value = ideTabulationProblem.VtoString(cell.second);
+        boost::algorithm::trim(value);
+        W.beginArray();
+        W.value(search->second);
+        W.value(value);
+        W.endArray();
+      }
+      W.endArray();
+      W.endObject();
+    }
+    W.endObject();
+    W.endObject();
+  }
+
+  /**
+   * Nodes, facts and values are written as dictionary IDs. The node IDs are
+   * given by NodeID if set, e.g. the psr.id annotations of the instructions,
+   * such that the results of different analyses and runs refer to the same
+   * nodes; otherwise the nodes are numbered in the order they are written.
+   * Values are interned like the facts, so no value is converted to a string
+   * while the results are written. If WithSymbols is set, the strings the IDs
+   * stand for are rendered after all results have been written, once per
+   * distinct node, fact and value.
+   *
+   * @brief Streams the computed results in the compact binary format.
+   */
+  void emitResults(BinaryResultWriter &W, bool WithSymbols = true,
+                   const std::function<uint32_t(N)> &NodeID = nullptr) {
+    using Kind = BinaryResultWriter::SymbolKind;
+    std::vector<std::pair<uint32_t, N>> nodes;
+    std::unordered_map<D, uint32_t> factIDs;
+    std::vector<D> facts;
+    std::unordered_map<V, uint32_t> valueIDs;
+    std::vector<V> values;
+    for (auto &row : valtab.rowMapView()) {
+      uint32_t nodeID = NodeID ? NodeID(row.first) : nodes.size();
+      nodes.emplace_back(nodeID, row.first);
+      for (auto &cell : row.second) {
+        auto fact = factIDs.emplace(cell.first, facts.size());
+        if (fact.second) {
+          facts.push_back(cell.first);
+        }
+        auto value = valueIDs.emplace(cell.second, values.size());
+        if (value.second) {
+          values.push_back(cell.second);
+        }
+        W.addResult(nodeID, fact.first->second, value.first->second);
+      }
+    }
+    if (WithSymbols) {
+      for (auto &node : nodes) {
+        W.addSymbol(Kind::Node, node.first, nodeToString(node.second));
+      }
+      for (uint32_t id = 0; id < facts.size(); ++id) {
+        std::string fact = ideTabulationProblem.DtoString(facts[id]);
+        boost::algorithm::trim(fact);
+        W.addSymbol(Kind::Fact, id, fact);
+      }
+      for (uint32_t id = 0; id < values.size(); ++id) {
+        std::string value = ideTabulationProblem.VtoString(values[id]);
+        boost::algorithm::trim(value);
+        W.addSymbol(Kind::Value, id, value);
+      }
+    }
+  }
+
   std::unordered_set<std::string> methodSet;
   std::unordered_set<std::string> stmtSet;
   json graph;
@@ -306,55 +416,154 @@ public:
     }
   }
 
+  using FlowEdgeFunctionStore =
+      typename FlowEdgeFunctionCache<N, D, M, V, I>::Store;
+
+  /**
+   * Lets this solver use and extend the given flow and edge functions, which
+   * may be shared with solvers of other instances of the same problem running
+   * in parallel. Only allowed if the problem sets
+   * solver_config.shareFlowEdgeFunctions and before solve() is called.
+   */
+  void shareFlowEdgeFunctions(std::shared_ptr<FlowEdgeFunctionStore> Store) {
+    if (!ideTabulationProblem.solver_config.shareFlowEdgeFunctions) {
+      throw std::runtime_error(
+          "problem does not allow to share flow and edge functions");
+    }
+    cachedFlowEdgeFunctions.share(std::move(Store));
+  }
+
+  /**
+   * Prefixes the ids of the timers and of the per-solver counters this solver
+   * reports to PAMM, such that solvers running in the same process, e.g. one
+   * per entry point, report separately. Counters of the flow and edge function
+   * queries are shared by all solvers of a run.
+   */
+  void setStatisticsScope(std::string Scope) {
+    StatisticsScope = std::move(Scope);
+  }
+
   /**
    * @brief Runs the solver on the configured problem. This can take some time.
    */
   virtual void solve() {
+    PROFILE_SCOPE("IDESolver::solve");
     PAMM_GET_INSTANCE;
-    REG_COUNTER("Gen facts", 0, PAMM_SEVERITY_LEVEL::Core);
-    REG_COUNTER("Kill facts", 0, PAMM_SEVERITY_LEVEL::Core);
-    REG_COUNTER("Summary-reuse", 0, PAMM_SEVERITY_LEVEL::Core);
-    REG_COUNTER("Intra Path Edges", 0, PAMM_SEVERITY_LEVEL::Core);
-    REG_COUNTER("Inter Path Edges", 0, PAMM_SEVERITY_LEVEL::Core);
-    REG_COUNTER("FF Queries", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("EF Queries", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Value Propagation", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Value Computation", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("SpecialSummary-FF Application", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("SpecialSummary-EF Queries", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("JumpFn Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Process Call", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Process Normal", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Process Exit", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("[Calls] getPointsToSet", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_HISTOGRAM("Data-flow facts", PAMM_SEVERITY_LEVEL::Full);
-    REG_HISTOGRAM("Points-to", PAMM_SEVERITY_LEVEL::Full);
+    registerStatistics();
 
     auto &lg = lg::get();
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
-                  << "IDE solver is solving the specified problem");
+    LOG_SEV_IF_ENABLE(lg, INFO, "IDE solver is solving the specified problem");
     // computations starting here
-    START_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
+    START_NAMED_TIMER(StatisticsScope + "DFA Phase I",
+                      PAMM_SEVERITY_LEVEL::Full);
     // We start our analysis and construct exploded supergraph
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
-                  << "Submit initial seeds, construct exploded super graph");
+    LOG_SEV_IF_ENABLE(lg, INFO,
+                      "Submit initial seeds, construct exploded super graph");
     submitInitalSeeds();
-    STOP_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
+    STOP_NAMED_TIMER(StatisticsScope + "DFA Phase I",
+                     PAMM_SEVERITY_LEVEL::Full);
+    LOG_SEV_IF_ENABLE(lg, INFO, "Peak RSS after Phase I: " << PEAK_RSS()
+                                << " KB");
     if (computevalues) {
-      START_TIMER("DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
+      START_NAMED_TIMER(StatisticsScope + "DFA Phase II",
+                        PAMM_SEVERITY_LEVEL::Full);
       // Computing the final values for the edge functions
-      LOG_IF_ENABLE(
-          BOOST_LOG_SEV(lg, INFO)
-          << "Compute the final values according to the edge functions");
+      LOG_SEV_IF_ENABLE(lg, INFO,
+                        "Compute the final values according to the edge "
+                        "functions");
       computeValues();
-      STOP_TIMER("DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
+      STOP_NAMED_TIMER(StatisticsScope + "DFA Phase II",
+                       PAMM_SEVERITY_LEVEL::Full);
     }
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO) << "Problem solved");
+    LOG_SEV_IF_ENABLE(lg, INFO, "Problem solved");
     if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Core) {
       computeAndPrintStatistics();
     }
   }
 
+  /**
+   * @brief Updates the results of a previous call to solve() after the
+   * definitions of the given methods have been edited in place. The ICFG must
+   * already reflect the edits, e.g. by means of
+   * LLVMBasedICFG::updateFunctions().
+   *
+   * Only the affected region, i.e. the edited methods and their transitive
+   * callers, is invalidated. Its jump functions, end summaries and incoming
+   * edges are dropped and the analysis is re-propagated from the initial
+   * seeds, reusing the summaries of all unaffected methods. Contexts of
+   * unaffected methods that became unreachable are pruned afterwards, such
+   * that the results equal those of a from-scratch run.
+   *
+   * Requires solver_config.incremental to be set before the solver is
+   * constructed.
+   */
+  virtual void update(const std::set<M> &ChangedMethods) {
+    PROFILE_SCOPE("IDESolver::update");
+    if (!incremental) {
+      throw std::runtime_error(
+          "IDESolver::update() requires solver_config.incremental");
+    }
+    PAMM_GET_INSTANCE;
+    auto &lg = lg::get();
+    LOG_SEV_IF_ENABLE(lg, INFO, "IDE solver is updating the results of "
+                                << ChangedMethods.size()
+                                << " changed method(s)");
+    START_NAMED_TIMER(StatisticsScope + "DFA Incremental Phase I",
+                      PAMM_SEVERITY_LEVEL::Full);
+    // flow and edge functions of edited statements might be stale
+    cachedFlowEdgeFunctions.clear();
+    if (followReturnPastSeeds || collectFinishedMethods) {
+      // unbalanced returns may flow into arbitrary callers, hence the
+      // invalidation cannot be confined to the affected region; the same
+      // holds if the incoming edges of finished methods have been released
+      LOG_SEV_IF_ENABLE(lg, INFO, "Unbalanced problem or released methods, "
+                                  "invalidating all results");
+      jumpFn->clear();
+      endsummarytab.clear();
+      incomingtab.clear();
+      unbalancedRetSites.clear();
+      computedIntraPathEdges.clear();
+      computedInterPathEdges.clear();
+      fSummaryReuse.clear();
+      nodesOfMethod.clear();
+      pinnedContexts.clear();
+    } else {
+      // edited methods invalidate the summaries of all their transitive
+      // callers
+      std::set<M> AffectedMethods;
+      std::vector<M> WorkList(ChangedMethods.begin(), ChangedMethods.end());
+      while (!WorkList.empty()) {
+        M m = WorkList.back();
+        WorkList.pop_back();
+        if (AffectedMethods.insert(m).second) {
+          for (N callSite : icfg.getCallersOf(m)) {
+            WorkList.push_back(icfg.getMethodOf(callSite));
+          }
+        }
+      }
+      LOG_SEV_IF_ENABLE(lg, INFO, "Invalidating " << AffectedMethods.size()
+                                  << " affected method(s)");
+      invalidateMethods(AffectedMethods);
+    }
+    LOG_SEV_IF_ENABLE(lg, INFO, "Re-propagate from the initial seeds");
+    submitInitalSeeds();
+    pruneUnreachableContexts();
+    STOP_NAMED_TIMER(StatisticsScope + "DFA Incremental Phase I",
+                     PAMM_SEVERITY_LEVEL::Full);
+    if (computevalues) {
+      START_NAMED_TIMER(StatisticsScope + "DFA Incremental Phase II",
+                        PAMM_SEVERITY_LEVEL::Full);
+      LOG_SEV_IF_ENABLE(lg, INFO,
+                        "Compute the final values according to the edge "
+                        "functions");
+      valtab.clear();
+      computeValues();
+      STOP_NAMED_TIMER(StatisticsScope + "DFA Incremental Phase II",
+                       PAMM_SEVERITY_LEVEL::Full);
+    }
+    LOG_SEV_IF_ENABLE(lg, INFO, "Problem updated");
+  }
+
   /**
    * Returns the V-type result for the given value at the given statement.
    * TOP values are never returned.
@@ -380,10 +589,30 @@ public:
     return result;
   }
 
+  /**
+   * Returns the resulting environment for the given statement without the
+   * artificial zero value as a json array of {"Fact", "Value"} objects.
+   */
+  json resultsAtAsJson(N stmt) {
+    json results = json::array();
+    for (auto &cell : resultsAt(stmt, true)) {
+      results.push_back(
+          {{"Fact", ideTabulationProblem.DtoString(cell.first)},
+           {"Value", ideTabulationProblem.VtoString(cell.second)}});
+    }
+    return results;
+  }
+
 protected:
   std::unique_ptr<IFDSToIDETabulationProblem<N, D, M, I>> transformedProblem;
   IDETabulationProblem<N, D, M, V, I> &ideTabulationProblem;
 
+  std::string nodeToString(N n) {
+    std::string node = ideTabulationProblem.NtoString(n);
+    boost::algorithm::trim(node);
+    return icfg.getMethodName(icfg.getMethodOf(n)) + "::" + node;
+  }
+
   /**
    * Lines 13-20 of the algorithm; processing a call site in the caller's
    * context.
@@ -406,24 +635,22 @@ protected:
     PAMM_GET_INSTANCE;
     INC_COUNTER("Process Call", 1, PAMM_SEVERITY_LEVEL::Full);
     auto &lg = lg::get();
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "Process call at target: "
-                  << ideTabulationProblem.NtoString(edge.getTarget()));
+    LOG_SEV_IF_ENABLE(lg, DEBUG,
+                      "Process call at target: "
+                      << ideTabulationProblem.NtoString(edge.getTarget()));
     D d1 = edge.factAtSource();
     N n = edge.getTarget(); // a call node; line 14...
     D d2 = edge.factAtTarget();
     std::shared_ptr<EdgeFunction<V>> f = jumpFunction(edge);
     std::set<N> returnSiteNs = icfg.getReturnSitesOfCallAt(n);
     std::set<M> callees = icfg.getCalleesOfCallAt(n);
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Possible callees:");
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Possible callees:");
     for (auto callee : callees) {
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                    << "  " << callee->getName().str());
+      LOG_SEV_IF_ENABLE(lg, DEBUG, "  " << callee->getName().str());
     }
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Possible return sites:");
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Possible return sites:");
     for (auto ret : returnSiteNs) {
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                    << "  " << ideTabulationProblem.NtoString(ret));
+      LOG_SEV_IF_ENABLE(lg, DEBUG, "  " << ideTabulationProblem.NtoString(ret));
     }
     // for each possible callee
     for (M sCalledProcN : callees) { // still line 14
@@ -433,8 +660,7 @@ protected:
       // if a special summary is available, treat this as a normal flow
       // and use the summary flow and edge functions
       if (specialSum) {
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                      << "Found and process special summary");
+        LOG_SEV_IF_ENABLE(lg, DEBUG, "Found and process special summary");
         for (N returnSiteN : returnSiteNs) {
           std::set<D> res = computeSummaryFlowFunction(specialSum, d1, d2);
           INC_COUNTER("SpecialSummary-FF Application", 1,
@@ -448,10 +674,9 @@ protected:
                                                                returnSiteN, d3);
             INC_COUNTER("SpecialSummary-EF Queries", 1,
                         PAMM_SEVERITY_LEVEL::Full);
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                          << "Compose: " << sumEdgFnE->str() << " * "
-                          << f->str());
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+            LOG_SEV_IF_ENABLE(lg, DEBUG, "Compose: " << sumEdgFnE->str()
+                                         << " * " << f->str());
+            LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
             propagate(d1, returnSiteN, d3, f->composeWith(sumEdgFnE), n, false);
           }
         }
@@ -466,10 +691,10 @@ protected:
         // for each callee's start point(s)
         std::set<N> startPointsOf = icfg.getStartPointsOf(sCalledProcN);
         if (startPointsOf.empty()) {
-          LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                        << "Start points of '" +
-                               icfg.getMethodName(sCalledProcN) +
-                               "' currently not available!");
+          LOG_SEV_IF_ENABLE(lg, DEBUG,
+                            "Start points of '" +
+                                icfg.getMethodName(sCalledProcN) +
+                                "' currently not available!");
         }
         // if startPointsOf is empty, the called function is a declaration
         for (N sP : startPointsOf) {
@@ -477,8 +702,12 @@ protected:
           // for each result node of the call-flow function
           for (D d3 : res) {
             // create initial self-loop
+            bool entered = collectFinishedMethods && enterContext(sP, d3);
             propagate(d3, sP, d3, EdgeIdentity<V>::getInstance(), n,
                       false); // line 15
+            if (entered) {
+              leaveContext();
+            }
             // register the fact that <sp,d3> has an incoming edge from <n,d2>
             // line 15.1 of Naeem/Lhotak/Rodriguez
             addIncoming(sP, d3, n, d2);
@@ -531,22 +760,21 @@ protected:
                           n, sCalledProcN, eP, d4, retSiteN, d5);
                   INC_COUNTER("EF Queries", 2, PAMM_SEVERITY_LEVEL::Full);
                   // compose call * calleeSummary * return edge functions
-                  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                                << "Compose: " << f5->str() << " * "
-                                << fCalleeSummary->str() << " * " << f4->str());
-                  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                                << "         (return * calleeSummary * call)");
+                  LOG_SEV_IF_ENABLE(lg, DEBUG, "Compose: " << f5->str()
+                                               << " * "
+                                               << fCalleeSummary->str()
+                                               << " * " << f4->str());
+                  LOG_SEV_IF_ENABLE(lg, DEBUG,
+                                    "         (return * calleeSummary * call)");
                   std::shared_ptr<EdgeFunction<V>> fPrime =
                       f4->composeWith(fCalleeSummary)->composeWith(f5);
-                  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                                << "       = " << fPrime->str());
-                  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+                  LOG_SEV_IF_ENABLE(lg, DEBUG, "       = " << fPrime->str());
+                  LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
                   D d5_restoredCtx = restoreContextOnReturnedFact(n, d2, d5);
                   // propagte the effects of the entire call
-                  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                                << "Compose: " << fPrime->str() << " * "
-                                << f->str());
-                  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+                  LOG_SEV_IF_ENABLE(lg, DEBUG, "Compose: " << fPrime->str()
+                                               << " * " << f->str());
+                  LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
                   propagate(d1, retSiteN, d5_restoredCtx,
                             f->composeWith(fPrime), n, false);
                 }
@@ -572,9 +800,9 @@ protected:
               cachedFlowEdgeFunctions.getCallToRetEdgeFunction(
                   n, d2, returnSiteN, d3, callees);
           INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-          LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                        << "Compose: " << edgeFnE->str() << " * " << f->str());
-          LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+          LOG_SEV_IF_ENABLE(lg, DEBUG, "Compose: " << edgeFnE->str() << " * "
+                                       << f->str());
+          LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
           propagate(d1, returnSiteN, d3, f->composeWith(edgeFnE), n, false);
         }
       }
@@ -590,9 +818,9 @@ protected:
     PAMM_GET_INSTANCE;
     INC_COUNTER("Process Normal", 1, PAMM_SEVERITY_LEVEL::Full);
     auto &lg = lg::get();
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "Process normal at target: "
-                  << ideTabulationProblem.NtoString(edge.getTarget()));
+    LOG_SEV_IF_ENABLE(lg, DEBUG,
+                      "Process normal at target: "
+                      << ideTabulationProblem.NtoString(edge.getTarget()));
     D d1 = edge.factAtSource();
     N n = edge.getTarget();
     D d2 = edge.factAtTarget();
@@ -610,9 +838,9 @@ protected:
         std::shared_ptr<EdgeFunction<V>> g =
             cachedFlowEdgeFunctions.getNormalEdgeFunction(n, d2, m, d3);
         std::shared_ptr<EdgeFunction<V>> fprime = f->composeWith(g);
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                      << "Compose: " << g->str() << " * " << f->str());
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+        LOG_SEV_IF_ENABLE(lg, DEBUG, "Compose: " << g->str() << " * "
+                                     << f->str());
+        LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
         INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
         propagate(d1, m, d3, fprime, nullptr, false);
       }
@@ -624,7 +852,7 @@ protected:
     D d = nAndD.second;
     M p = icfg.getMethodOf(n);
     for (N c : icfg.getCallsFromWithin(p)) {
-      for (auto entry : jumpFn->forwardLookup(d, c)) {
+      for (auto &entry : jumpFn->forwardLookup(d, c)) {
         D dPrime = entry.first;
         std::shared_ptr<EdgeFunction<V>> fPrime = entry.second;
         N sP = n;
@@ -681,26 +909,25 @@ protected:
     } else {
       valtab.insert(nHashN, nHashD, l);
     }
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "Function : "
-                  << icfg.getMethodOf(nHashN)->getName().str());
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "Inst.    : " << ideTabulationProblem.NtoString(nHashN));
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "Fact     : " << ideTabulationProblem.DtoString(nHashD));
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "Value    : " << ideTabulationProblem.VtoString(l));
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Function : "
+                                 << icfg.getMethodOf(nHashN)->getName().str());
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Inst.    : "
+                                 << ideTabulationProblem.NtoString(nHashN));
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Fact     : "
+                                 << ideTabulationProblem.DtoString(nHashD));
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Value    : "
+                                 << ideTabulationProblem.VtoString(l));
+    LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
   }
 
   std::shared_ptr<EdgeFunction<V>> jumpFunction(PathEdge<N, D> edge) {
-    if (!jumpFn->forwardLookup(edge.factAtSource(), edge.getTarget())
-             .count(edge.factAtTarget())) {
+    std::shared_ptr<EdgeFunction<V>> f = jumpFn->getFunction(
+        edge.factAtSource(), edge.getTarget(), edge.factAtTarget());
+    if (!f) {
       // JumpFn initialized to all-top, see line [2] in SRH96 paper
       return allTop;
     }
-    return jumpFn->forwardLookup(edge.factAtSource(),
-                                 edge.getTarget())[edge.factAtTarget()];
+    return f;
   }
 
   void addEndSummary(N sP, D d1, N eP, D d2,
@@ -713,28 +940,33 @@ protected:
 
   // should be made a callable at some point
   void pathEdgeProcessingTask(PathEdge<N, D> edge) {
+    // self time and path edges are attributed to the method of the target
+    PROFILE_METHOD("IDESolver::processEdge",
+                   icfg.getMethodName(icfg.getMethodOf(edge.getTarget())));
+    PROFILE_COUNT_EDGES(1);
     PAMM_GET_INSTANCE;
     auto &lg = lg::get();
     INC_COUNTER("JumpFn Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-    LOG_IF_ENABLE(
-        BOOST_LOG_SEV(lg, DEBUG)
-        << "-------------------------------------------- " << PathEdgeCount
-        << ". Path Edge --------------------------------------------");
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "Process " << PathEdgeCount << ". path edge:");
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "< D source: "
-                  << ideTabulationProblem.DtoString(edge.factAtSource())
-                  << " ;");
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "  N target: "
-                  << ideTabulationProblem.NtoString(edge.getTarget()) << " ;");
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "  D target: "
-                  << ideTabulationProblem.DtoString(edge.factAtTarget())
-                  << " >");
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+    LOG_SEV_IF_ENABLE(lg, DEBUG,
+                      "-------------------------------------------- "
+                          << PathEdgeCount
+                          << ". Path Edge "
+                             "--------------------------------------------");
+    LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Process " << PathEdgeCount << ". path edge:");
+    LOG_SEV_IF_ENABLE(lg, DEBUG,
+                      "< D source: "
+                      << ideTabulationProblem.DtoString(edge.factAtSource())
+                      << " ;");
+    LOG_SEV_IF_ENABLE(lg, DEBUG,
+                      "  N target: "
+                      << ideTabulationProblem.NtoString(edge.getTarget())
+                      << " ;");
+    LOG_SEV_IF_ENABLE(lg, DEBUG,
+                      "  D target: "
+                      << ideTabulationProblem.DtoString(edge.factAtTarget())
+                      << " >");
+    LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
     bool isCall = icfg.isCallStmt(edge.getTarget());
 
     if (!isCall) {
@@ -769,19 +1001,18 @@ protected:
     PAMM_GET_INSTANCE;
     for (N n : values) {
       for (N sP : icfg.getStartPointsOf(icfg.getMethodOf(n))) {
-        Table<D, D, std::shared_ptr<EdgeFunction<V>>> lookupByTarget;
-        lookupByTarget = jumpFn->lookupByTarget(n);
-        for (typename Table<D, D, std::shared_ptr<EdgeFunction<V>>>::Cell
-                 sourceValTargetValAndFunction : lookupByTarget.cellSet()) {
-          D dPrime = sourceValTargetValAndFunction.getRowKey();
-          D d = sourceValTargetValAndFunction.getColumnKey();
-          std::shared_ptr<EdgeFunction<V>> fPrime =
-              sourceValTargetValAndFunction.getValue();
+        for (auto &sourceValAndFunctions : jumpFn->lookupByTarget(n)) {
+          D dPrime = sourceValAndFunctions.first;
           V targetVal = val(sP, dPrime);
-          setVal(n, d,
-                 ideTabulationProblem.join(val(n, d),
-                                           fPrime->computeTarget(targetVal)));
-          INC_COUNTER("Value Computation", 1, PAMM_SEVERITY_LEVEL::Full);
+          for (auto &targetValAndFunction : sourceValAndFunctions.second) {
+            D d = targetValAndFunction.first;
+            std::shared_ptr<EdgeFunction<V>> fPrime =
+                targetValAndFunction.second;
+            setVal(n, d,
+                   ideTabulationProblem.join(val(n, d),
+                                             fPrime->computeTarget(targetVal)));
+            INC_COUNTER("Value Computation", 1, PAMM_SEVERITY_LEVEL::Full);
+          }
         }
       }
     }
@@ -795,6 +1026,8 @@ protected:
   bool followReturnPastSeeds;
   bool computePersistedSummaries;
   bool recordEdges;
+  bool collectFinishedMethods;
+  bool incremental;
   unsigned PathEdgeCount;
 
   FlowEdgeFunctionCache<N, D, M, V, I> cachedFlowEdgeFunctions;
@@ -803,6 +1036,33 @@ protected:
 
   Table<N, N, std::map<D, std::set<D>>> computedInterPathEdges;
 
+  // statistics that are counted while the edges are propagated, see
+  // countEdges()
+  std::size_t GenFacts = 0;
+  std::size_t KillFacts = 0;
+  std::size_t IntraPathEdges = 0;
+  std::size_t InterPathEdges = 0;
+  // the calling contexts released by releaseContext()
+  std::size_t ReleasedContexts = 0;
+  // the sources (node, successor, fact) of the exploded super-graph edges
+  // counted so far; one entry per distinct flow-function application rather
+  // than per path edge, i.e. independent of the number of calling contexts
+  std::set<std::tuple<N, N, D>> CountedEdges;
+  // all valid facts at a return site in the caller context, at most one
+  // entry per (return site, fact) node of the exploded super-graph
+  std::unordered_map<N, std::set<D>> ValidInCallerContext;
+  // all pairs of (start point, fact) for which a summary was applied, at most
+  // one entry per calling context
+  std::set<std::pair<N, D>> ProcessSummaryFacts;
+
+  // prefix of the ids of the timers and counters reported to PAMM
+  std::string StatisticsScope;
+
+  std::ofstream EdgeLogStream;
+  std::unique_ptr<BinaryEdgeLogWriter> EdgeLog;
+  std::unordered_map<N, uint32_t> EdgeLogNodes;
+  std::unordered_map<D, uint32_t> EdgeLogFacts;
+
   std::shared_ptr<EdgeFunction<V>> allTop;
 
   std::shared_ptr<JumpFunctions<N, D, M, V, I>> jumpFn;
@@ -825,6 +1085,27 @@ protected:
 
   std::map<std::pair<N, D>, size_t> fSummaryReuse;
 
+  // stores the nodes of each method that are the target of a jump function,
+  // since an edited method's former statements cannot be enumerated anymore;
+  // only maintained if collectFinishedMethods or incremental is set
+  std::unordered_map<M, std::unordered_set<N>> nodesOfMethod;
+
+  // calling contexts, i.e. pairs of a start point and a fact at this start
+  // point, whose exploration has not finished yet, in the order in which they
+  // have been entered, see enterContext()
+  std::vector<std::pair<N, D>> openContexts;
+  std::map<std::pair<N, D>, std::size_t> openContextIndex;
+  struct ContextFrame {
+    std::size_t Index;
+    std::size_t LowLink;
+    bool Pinned;
+  };
+  // the contexts whose exploration is currently in progress
+  std::vector<ContextFrame> contextStack;
+  // finished contexts that depend on an initial seed, whose summaries may
+  // still change
+  std::set<std::pair<N, D>> pinnedContexts;
+
   // When transforming an IFDSTabulationProblem into an IDETabulationProblem,
   // we need to allocate dynamically, otherwise the objects lifetime runs out -
   // as a modifiable r-value reference created here that should be stored in a
@@ -845,6 +1126,11 @@ protected:
         computePersistedSummaries(
             ideTabulationProblem.solver_config.computePersistedSummaries),
         recordEdges(ideTabulationProblem.solver_config.recordEdges),
+        collectFinishedMethods(
+            ideTabulationProblem.solver_config.collectFinishedMethods &&
+            !ideTabulationProblem.solver_config.followReturnsPastSeeds &&
+            !ideTabulationProblem.solver_config.computeValues),
+        incremental(ideTabulationProblem.solver_config.incremental),
         PathEdgeCount(0), cachedFlowEdgeFunctions(ideTabulationProblem),
         allTop(ideTabulationProblem.allTopFunction()),
         jumpFn(std::make_shared<JumpFunctions<N, D, M, V, I>>(
@@ -852,10 +1138,17 @@ protected:
         initialSeeds(ideTabulationProblem.initialSeeds()) {
     // std::cout << "called IDESolver::IDESolver() ctor with IFDSProblem" <<
     // std::endl;
+    openEdgeLog(ideTabulationProblem.solver_config.edgeLogFile);
   }
 
   virtual void saveEdges(N sourceNode, N sinkStmt, D sourceVal,
-                         std::set<D> destVals, bool interP) {
+                         const std::set<D> &destVals, bool interP) {
+    if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Core) {
+      countEdges(sourceNode, sinkStmt, sourceVal, destVals, interP);
+    }
+    if (EdgeLog) {
+      logEdges(sourceNode, sinkStmt, sourceVal, destVals, interP);
+    }
     if (!recordEdges)
       return;
     Table<N, N, std::map<D, std::set<D>>> &tgtMap =
@@ -864,12 +1157,194 @@ protected:
                                                        destVals.end());
   }
 
+  void openEdgeLog(const std::string &Path) {
+    if (Path.empty()) {
+      return;
+    }
+    EdgeLogStream.open(Path, std::ios::out | std::ios::binary);
+    if (!EdgeLogStream) {
+      throw std::runtime_error("could not open edge log: " + Path);
+    }
+    EdgeLog.reset(new BinaryEdgeLogWriter(EdgeLogStream));
+  }
+
+  void logEdges(N sourceNode, N sinkStmt, D sourceVal,
+                const std::set<D> &destVals, bool interP) {
+    using Kind = BinaryEdgeLogWriter::SymbolKind;
+    auto nodeID = [&](N n) {
+      auto ID = EdgeLogNodes.emplace(n, EdgeLogNodes.size());
+      if (ID.second) {
+        EdgeLog->addSymbol(Kind::Node, ID.first->second, nodeToString(n));
+      }
+      return ID.first->second;
+    };
+    auto factID = [&](D d) {
+      auto ID = EdgeLogFacts.emplace(d, EdgeLogFacts.size());
+      if (ID.second) {
+        std::string fact = ideTabulationProblem.DtoString(d);
+        boost::algorithm::trim(fact);
+        EdgeLog->addSymbol(Kind::Fact, ID.first->second, fact);
+      }
+      return ID.first->second;
+    };
+    std::vector<uint32_t> targetFacts;
+    targetFacts.reserve(destVals.size());
+    for (auto &d : destVals) {
+      targetFacts.push_back(factID(d));
+    }
+    EdgeLog->addEdges(interP, nodeID(sourceNode), nodeID(sinkStmt),
+                      factID(sourceVal), targetFacts);
+  }
+
+  /**
+   * Counts the generated and killed facts as well as the path edges of the
+   * given edges as described in computeAndPrintStatistics(). Every edge is
+   * counted once. Since the counting happens while the edges are propagated,
+   * summaries and facts valid in the caller context that are discovered
+   * after an edge has been propagated are not taken into account for it.
+   *
+   * The bookkeeping needed to count every edge once is bounded by the number
+   * of distinct (node, successor, fact) triples the flow functions are
+   * applied to, which is what recordEdges keeps as well, minus the target
+   * facts. Unlike the jump functions it does not grow with the number of
+   * calling contexts. Its size is reported as "Statistics Entries".
+   */
+  void countEdges(N sourceNode, N sinkStmt, D sourceVal,
+                  const std::set<D> &destVals, bool interP) {
+    if (!CountedEdges.insert(std::make_tuple(sourceNode, sinkStmt, sourceVal))
+             .second) {
+      return;
+    }
+    if (!interP) {
+      /* --- Intra-procedural Path Edges ---
+       * d1 --> d2-Set
+       * Case 1: d1 in d2-Set
+       * Case 2: d1 not in d2-Set, i.e. d1 was killed. d2-Set could be empty.
+       */
+      IntraPathEdges += destVals.size();
+      if (destVals.count(sourceVal)) {
+        GenFacts += destVals.size() - 1;
+      } else {
+        GenFacts += destVals.size();
+        // We ignore the zero value
+        if (!ideTabulationProblem.isZeroValue(sourceVal)) {
+          KillFacts++;
+        }
+      }
+      // Store all valid facts after call-to-return flow
+      if (icfg.isCallStmt(sourceNode)) {
+        ValidInCallerContext[sinkStmt].insert(destVals.begin(),
+                                              destVals.end());
+      }
+      return;
+    }
+    /* --- Call-flow Path Edges ---
+     * Case 1: d1 --> empty set
+     *   Can be ignored, since killing a fact in the caller context will
+     *   actually happen during  call-to-return.
+     *
+     * Case 2: d1 --> d2-Set
+     *   Every fact d_i != zeroValue in d2-set will be generated in the callee
+     * context, thus counts as a new fact. Even if d1 is passed as it is, it
+     * will count as a new fact. The reason for this is, that d1 can be
+     * killed in the callee context, but still be valid in the caller
+     * context.
+     *
+     * Special Case: Summary was applied for a particular call
+     *   Process the summary's #gen and #kill.
+     */
+    if (icfg.isCallStmt(sourceNode)) {
+      InterPathEdges += destVals.size();
+      for (auto D2 : destVals) {
+        if (!ideTabulationProblem.isZeroValue(D2)) {
+          GenFacts++;
+        }
+        // Special case
+        if (!ProcessSummaryFacts.insert(std::make_pair(sinkStmt, D2)).second) {
+          std::multiset<D> SummaryDMultiSet =
+              endsummarytab.get(sinkStmt, D2).columnKeySet();
+          // remove duplicates from multiset
+          std::set<D> SummaryDSet(SummaryDMultiSet.begin(),
+                                  SummaryDMultiSet.end());
+          // Process summary just as an intra-procedural edge
+          if (SummaryDSet.find(D2) != SummaryDSet.end()) {
+            GenFacts += SummaryDSet.size() - 1;
+          } else {
+            GenFacts += SummaryDSet.size();
+            // We ignore the zero value
+            if (!ideTabulationProblem.isZeroValue(sourceVal)) {
+              KillFacts++;
+            }
+          }
+        }
+      }
+    }
+    /* --- Return-flow Path Edges ---
+     * Since every fact passed to the callee was counted as a new fact, we
+     * have to count every fact propagated to the caller as a kill to satisfy
+     * our invariant. Obviously, every fact not propagated to the caller will
+     * count as a kill. If an actual new fact is propagated to the caller, we
+     * have to increase the number of generated facts by one. Zero value does
+     * not count towards generated/killed facts.
+     */
+    if (icfg.isExitStmt(sourceNode)) {
+      InterPathEdges += destVals.size();
+      auto &CallerFacts = ValidInCallerContext[sinkStmt];
+      for (auto D2 : destVals) {
+        // d2 not valid in caller context
+        if (CallerFacts.find(D2) == CallerFacts.end()) {
+          GenFacts++;
+        }
+      }
+      if (!ideTabulationProblem.isZeroValue(sourceVal)) {
+        KillFacts++;
+      }
+    }
+  }
+
+  /**
+   * Returns the number of entries kept to count every edge once, see
+   * countEdges().
+   */
+  std::size_t statisticsEntries() const {
+    std::size_t Entries = CountedEdges.size() + ProcessSummaryFacts.size();
+    for (auto &RetSite : ValidInCallerContext) {
+      Entries += RetSite.second.size();
+    }
+    return Entries;
+  }
+
+  /**
+   * Registers the counters and histograms the solver increments while it
+   * propagates. They are shared by all solvers of a run, registering them
+   * again has no effect. The per-solver statistics are reported under the
+   * statistics scope once the solver is done, see computeAndPrintStatistics().
+   */
+  void registerStatistics() {
+    PAMM_GET_INSTANCE;
+    REG_SHARED_COUNTER("FF Queries", PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("EF Queries", PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("Value Propagation", PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("Value Computation", PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("SpecialSummary-FF Application",
+                       PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("SpecialSummary-EF Queries", PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("JumpFn Construction", PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("Process Call", PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("Process Normal", PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("Process Exit", PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_COUNTER("[Calls] getPointsToSet", PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_HISTOGRAM("Data-flow facts", PAMM_SEVERITY_LEVEL::Full);
+    REG_SHARED_HISTOGRAM("Points-to", PAMM_SEVERITY_LEVEL::Full);
+  }
+
   /**
    * Computes the final values for edge functions.
    */
   void computeValues() {
+    PROFILE_SCOPE("IDESolver::computeValues");
     auto &lg = lg::get();
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Start computing values");
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Start computing values");
     // Phase II(i)
     std::map<N, std::set<D>> allSeeds(initialSeeds);
     for (N unbalancedRetSite : unbalancedRetSites) {
@@ -905,18 +1380,18 @@ protected:
    * their own. Normally, solve() should be called instead.
    */
   void submitInitalSeeds() {
+    PROFILE_SCOPE("IDESolver::submitInitalSeeds");
     auto &lg = lg::get();
     PAMM_GET_INSTANCE;
     for (const auto &seed : initialSeeds) {
       N startPoint = seed.first;
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                    << "Start point: "
-                    << ideTabulationProblem.NtoString(startPoint));
+      LOG_SEV_IF_ENABLE(lg, DEBUG,
+                        "Start point: "
+                        << ideTabulationProblem.NtoString(startPoint));
       for (const D &value : seed.second) {
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                      << "      Value: "
-                      << ideTabulationProblem.DtoString(value));
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+        LOG_SEV_IF_ENABLE(lg, DEBUG, "      Value: "
+                                     << ideTabulationProblem.DtoString(value));
+        LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
         if (!ideTabulationProblem.isZeroValue(value)) {
           INC_COUNTER("Gen facts", 1, PAMM_SEVERITY_LEVEL::Core);
         }
@@ -928,6 +1403,202 @@ protected:
     }
   }
 
+  /**
+   * Called before the self-loop of a callee's context (sP, d) is propagated.
+   * The contexts are tracked like the nodes of Tarjan's algorithm: a context
+   * whose exploration calls into a context that is still open belongs to the
+   * same strongly connected component, i.e. a recursion, and all contexts of
+   * a component are finished once the exploration of its first context
+   * returns. Contexts calling into the initial seeds or into other pinned
+   * contexts are pinned and never released.
+   *
+   * @brief Returns true if the context has not been entered before and must
+   * be left by means of leaveContext() after its self-loop is propagated.
+   */
+  bool enterContext(N sP, D d) {
+    auto context = std::make_pair(sP, d);
+    auto search = openContextIndex.find(context);
+    if (search != openContextIndex.end()) {
+      if (!contextStack.empty()) {
+        contextStack.back().LowLink =
+            std::min(contextStack.back().LowLink, search->second);
+      }
+      return false;
+    }
+    if (jumpFunction(PathEdge<N, D>(d, sP, d)) != allTop) {
+      // either finished or an initial seed that is explored from the outside
+      // of the context stack
+      if (!contextStack.empty() &&
+          (pinnedContexts.count(context) ||
+           (initialSeeds.count(sP) && ideTabulationProblem.isZeroValue(d)))) {
+        contextStack.back().Pinned = true;
+      }
+      return false;
+    }
+    std::size_t index = openContexts.size();
+    openContexts.push_back(context);
+    openContextIndex[context] = index;
+    contextStack.push_back({index, index, false});
+    return true;
+  }
+
+  /**
+   * Called once the self-loop of the context that was entered last has been
+   * propagated. Releases the contexts of a finished component.
+   */
+  void leaveContext() {
+    ContextFrame frame = contextStack.back();
+    contextStack.pop_back();
+    if (!contextStack.empty()) {
+      contextStack.back().LowLink =
+          std::min(contextStack.back().LowLink, frame.LowLink);
+      contextStack.back().Pinned |= frame.Pinned;
+    }
+    if (frame.LowLink != frame.Index) {
+      return;
+    }
+    for (std::size_t i = frame.Index; i < openContexts.size(); ++i) {
+      openContextIndex.erase(openContexts[i]);
+      if (frame.Pinned) {
+        pinnedContexts.insert(openContexts[i]);
+      } else {
+        releaseContext(openContexts[i].first, openContexts[i].second);
+      }
+    }
+    openContexts.resize(frame.Index);
+  }
+
+  /**
+   * Releases the incoming edges and the jump functions of the finished
+   * context (sP, d) except for its self-loop, since the latter identifies the
+   * context as already explored.
+   */
+  void releaseContext(N sP, D d) {
+    ++ReleasedContexts;
+    incomingtab.remove(sP, d);
+    if (incomingtab.row(sP).empty()) {
+      incomingtab.remove(sP);
+    }
+    auto search = nodesOfMethod.find(icfg.getMethodOf(sP));
+    if (search == nodesOfMethod.end()) {
+      return;
+    }
+    for (N n : search->second) {
+      if (n == sP) {
+        continue;
+      }
+      jumpFn->removeFunctionsFrom(d, n);
+    }
+  }
+
+  /**
+   * Drops all jump functions, end summaries and incoming edges that belong to
+   * the given methods.
+   */
+  void invalidateMethods(const std::set<M> &Methods) {
+    std::unordered_set<N> InvalidNodes;
+    for (M m : Methods) {
+      auto Search = nodesOfMethod.find(m);
+      if (Search == nodesOfMethod.end()) {
+        continue;
+      }
+      for (N n : Search->second) {
+        jumpFn->removeFunctionsAt(n);
+        endsummarytab.remove(n);
+        incomingtab.remove(n);
+        computedIntraPathEdges.remove(n);
+        computedInterPathEdges.remove(n);
+        unbalancedRetSites.erase(n);
+        InvalidNodes.insert(n);
+      }
+      nodesOfMethod.erase(Search);
+    }
+    // remove the remaining references to the invalidated nodes, i.e. call
+    // sites in the incoming edges of callees and return sites of exit edges
+    for (auto &cell : incomingtab.cellVec()) {
+      std::map<N, std::set<D>> &callSites = incomingtab.get(cell.r, cell.c);
+      for (auto it = callSites.begin(); it != callSites.end();) {
+        if (InvalidNodes.count(it->first)) {
+          it = callSites.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+    for (auto &cell : computedInterPathEdges.cellVec()) {
+      if (InvalidNodes.count(cell.c)) {
+        computedInterPathEdges.remove(cell.r, cell.c);
+      }
+    }
+    for (auto it = fSummaryReuse.begin(); it != fSummaryReuse.end();) {
+      if (InvalidNodes.count(it->first.first)) {
+        it = fSummaryReuse.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  /**
+   * Removes the jump functions of all contexts, i.e. pairs of a start point
+   * and a fact at that start point, that are not reachable from the initial
+   * seeds anymore.
+   */
+  void pruneUnreachableContexts() {
+    std::set<std::pair<N, D>> LiveContexts;
+    std::vector<std::pair<N, D>> WorkList;
+    for (const auto &seed : initialSeeds) {
+      WorkList.push_back(std::make_pair(seed.first, zeroValue));
+    }
+    for (N unbalancedRetSite : unbalancedRetSites) {
+      WorkList.push_back(std::make_pair(unbalancedRetSite, zeroValue));
+    }
+    while (!WorkList.empty()) {
+      auto Context = WorkList.back();
+      WorkList.pop_back();
+      if (!LiveContexts.insert(Context).second) {
+        continue;
+      }
+      M m = icfg.getMethodOf(Context.first);
+      for (N callSite : icfg.getCallsFromWithin(m)) {
+        auto &factsAtCallSite = jumpFn->forwardLookup(Context.second, callSite);
+        if (factsAtCallSite.empty()) {
+          continue;
+        }
+        for (M callee : icfg.getCalleesOfCallAt(callSite)) {
+          for (N sP : icfg.getStartPointsOf(callee)) {
+            if (!incomingtab.containsRow(sP)) {
+              continue;
+            }
+            for (auto &entry : incomingtab.row(sP)) {
+              auto Search = entry.second.find(callSite);
+              if (Search == entry.second.end()) {
+                continue;
+              }
+              for (D d2 : Search->second) {
+                if (factsAtCallSite.count(d2)) {
+                  WorkList.push_back(std::make_pair(sP, entry.first));
+                  break;
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+    for (auto &cell : incomingtab.cellVec()) {
+      if (LiveContexts.count(std::make_pair(cell.r, cell.c))) {
+        continue;
+      }
+      M m = icfg.getMethodOf(cell.r);
+      for (N n : nodesOfMethod[m]) {
+        jumpFn->removeFunctionsFrom(cell.c, n);
+      }
+      endsummarytab.remove(cell.r, cell.c);
+      incomingtab.remove(cell.r, cell.c);
+    }
+  }
+
   /**
    * Lines 21-32 of the algorithm.
    *
@@ -941,9 +1612,9 @@ protected:
     PAMM_GET_INSTANCE;
     INC_COUNTER("Process Exit", 1, PAMM_SEVERITY_LEVEL::Full);
     auto &lg = lg::get();
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "Process exit at target: "
-                  << ideTabulationProblem.NtoString(edge.getTarget()));
+    LOG_SEV_IF_ENABLE(lg, DEBUG,
+                      "Process exit at target: "
+                      << ideTabulationProblem.NtoString(edge.getTarget()));
     N n = edge.getTarget(); // an exit node; line 21...
     std::shared_ptr<EdgeFunction<V>> f = jumpFunction(edge);
     M methodThatNeedsSummary = icfg.getMethodOf(n);
@@ -995,27 +1666,26 @@ protected:
                     c, icfg.getMethodOf(n), n, d2, retSiteC, d5);
             INC_COUNTER("EF Queries", 2, PAMM_SEVERITY_LEVEL::Full);
             // compose call function * function * return function
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                          << "Compose: " << f5->str() << " * " << f->str()
-                          << " * " << f4->str());
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                          << "         (return * function * call)");
+            LOG_SEV_IF_ENABLE(lg, DEBUG, "Compose: " << f5->str() << " * "
+                                         << f->str() << " * " << f4->str());
+            LOG_SEV_IF_ENABLE(lg, DEBUG, "         (return * function * call)");
             std::shared_ptr<EdgeFunction<V>> fPrime =
                 f4->composeWith(f)->composeWith(f5);
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                          << "       = " << fPrime->str());
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+            LOG_SEV_IF_ENABLE(lg, DEBUG, "       = " << fPrime->str());
+            LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
             // for each jump function coming into the call, propagate to return
             // site using the composed function
-            for (auto valAndFunc : jumpFn->reverseLookup(c, d4)) {
+            // copy, since propagate() may add jump functions at the call site
+            std::map<D, std::shared_ptr<EdgeFunction<V>>> callerFunctions =
+                jumpFn->reverseLookup(c, d4);
+            for (auto valAndFunc : callerFunctions) {
               std::shared_ptr<EdgeFunction<V>> f3 = valAndFunc.second;
               if (!f3->equal_to(allTop)) {
                 D d3 = valAndFunc.first;
                 D d5_restoredCtx = restoreContextOnReturnedFact(c, d4, d5);
-                LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                              << "Compose: " << fPrime->str() << " * "
-                              << f3->str());
-                LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+                LOG_SEV_IF_ENABLE(lg, DEBUG, "Compose: " << fPrime->str()
+                                             << " * " << f3->str());
+                LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
                 propagate(d3, retSiteC, d5_restoredCtx, f3->composeWith(fPrime),
                           c, false);
               }
@@ -1048,9 +1718,9 @@ protected:
                 cachedFlowEdgeFunctions.getReturnEdgeFunction(
                     c, icfg.getMethodOf(n), n, d2, retSiteC, d5);
             INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                          << "Compose: " << f5->str() << " * " << f->str());
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+            LOG_SEV_IF_ENABLE(lg, DEBUG, "Compose: " << f5->str() << " * "
+                                         << f->str());
+            LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
             propagteUnbalancedReturnFlow(retSiteC, d5, f->composeWith(f5), c);
             // register for value processing (2nd IDE phase)
             unbalancedRetSites.insert(retSiteC);
@@ -1071,7 +1741,7 @@ protected:
     }
   }
 
-  void
+  virtual void
   propagteUnbalancedReturnFlow(N retSiteC, D targetVal,
                                std::shared_ptr<EdgeFunction<V>> edgeFunction,
                                N relatedCallSite) {
@@ -1191,57 +1861,53 @@ protected:
             /* deliberately exposed to clients */ N relatedCallSite,
             /* deliberately exposed to clients */ bool isUnbalancedReturn) {
     auto &lg = lg::get();
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Propagate flow");
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "Source value  : "
-                  << ideTabulationProblem.DtoString(sourceVal));
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "Target        : "
-                  << ideTabulationProblem.NtoString(target));
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "Target value  : "
-                  << ideTabulationProblem.DtoString(targetVal));
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "Edge function : " << f.get()->str()
-                  << " (result of previous compose)");
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
-    std::shared_ptr<EdgeFunction<V>> jumpFnE = nullptr;
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Propagate flow");
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Source value  : "
+                                 << ideTabulationProblem.DtoString(sourceVal));
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Target        : "
+                                 << ideTabulationProblem.NtoString(target));
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Target value  : "
+                                 << ideTabulationProblem.DtoString(targetVal));
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Edge function : " << f.get()->str()
+                                 << " (result of previous compose)");
+    LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
+    std::shared_ptr<EdgeFunction<V>> jumpFnE =
+        jumpFn->getFunction(sourceVal, target, targetVal);
     std::shared_ptr<EdgeFunction<V>> fPrime;
-    if (!jumpFn->reverseLookup(target, targetVal).empty()) {
-      jumpFnE = jumpFn->reverseLookup(target, targetVal)[sourceVal];
-    }
     if (jumpFnE == nullptr) {
       jumpFnE = allTop; // jump function is initialized to all-top
     }
     fPrime = jumpFnE->joinWith(f);
     bool newFunction = !(fPrime->equal_to(jumpFnE));
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "Join: " << jumpFnE->str() << " & " << f.get()->str()
-                  << (jumpFnE->equal_to(f) ? " (EF's are equal)" : " "));
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "    = " << fPrime->str()
-                  << (newFunction ? " (new jump func)" : " "));
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+    LOG_SEV_IF_ENABLE(lg, DEBUG,
+                      "Join: " << jumpFnE->str() << " & " << f.get()->str()
+                      << (jumpFnE->equal_to(f) ? " (EF's are equal)" : " "));
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "    = " << fPrime->str()
+                                 << (newFunction ? " (new jump func)" : " "));
+    LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
     if (newFunction) {
       jumpFn->addFunction(sourceVal, target, targetVal, fPrime);
+      if (collectFinishedMethods || incremental) {
+        nodesOfMethod[icfg.getMethodOf(target)].insert(target);
+      }
       PathEdge<N, D> edge(sourceVal, target, targetVal);
       PathEdgeCount++;
       pathEdgeProcessingTask(edge);
       if (!ideTabulationProblem.isZeroValue(targetVal)) {
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                      << "EDGE: <F: " << target->getFunction()->getName().str()
-                      << ", D: " << ideTabulationProblem.DtoString(sourceVal)
-                      << ">");
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                      << " ---> <N: " << ideTabulationProblem.NtoString(target)
-                      << ",");
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                      << "       D: "
-                      << ideTabulationProblem.DtoString(targetVal) << ">");
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+        LOG_SEV_IF_ENABLE(lg, DEBUG,
+                          "EDGE: <F: "
+                          << target->getFunction()->getName().str() << ", D: "
+                          << ideTabulationProblem.DtoString(sourceVal) << ">");
+        LOG_SEV_IF_ENABLE(lg, DEBUG, " ---> <N: "
+                                     << ideTabulationProblem.NtoString(target)
+                                     << ",");
+        LOG_SEV_IF_ENABLE(lg, DEBUG,
+                          "       D: "
+                          << ideTabulationProblem.DtoString(targetVal) << ">");
+        LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
       }
     } else {
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "PROPAGATE: No new function!");
+      LOG_SEV_IF_ENABLE(lg, DEBUG, "PROPAGATE: No new function!");
     }
   }
 
@@ -1273,51 +1939,50 @@ protected:
 
   void printIncomingTab() {
     auto &lg = lg::get();
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Start of incomingtab entry");
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Start of incomingtab entry");
     for (auto cell : incomingtab.cellSet()) {
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                    << "sP: " << ideTabulationProblem.NtoString(cell.r));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                    << "d3: " << ideTabulationProblem.DtoString(cell.c));
+      LOG_SEV_IF_ENABLE(lg, DEBUG, "sP: "
+                                   << ideTabulationProblem.NtoString(cell.r));
+      LOG_SEV_IF_ENABLE(lg, DEBUG, "d3: "
+                                   << ideTabulationProblem.DtoString(cell.c));
       for (auto entry : cell.v) {
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                      << "  n: "
-                      << ideTabulationProblem.NtoString(entry.first));
+        LOG_SEV_IF_ENABLE(lg, DEBUG,
+                          "  n: "
+                          << ideTabulationProblem.NtoString(entry.first));
         for (auto fact : entry.second) {
-          LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                        << "  d2: " << ideTabulationProblem.DtoString(fact));
+          LOG_SEV_IF_ENABLE(lg, DEBUG, "  d2: "
+                                       << ideTabulationProblem.DtoString(fact));
         }
       }
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "---------------");
+      LOG_SEV_IF_ENABLE(lg, DEBUG, "---------------");
     }
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "End of incomingtab entry");
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "End of incomingtab entry");
+    LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
   }
 
   void printEndSummaryTab() {
     auto &lg = lg::get();
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Start of endsummarytab entry");
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Start of endsummarytab entry");
     for (auto cell : endsummarytab.cellVec()) {
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                    << "sP: " << ideTabulationProblem.NtoString(cell.r));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                    << "d1: " << ideTabulationProblem.DtoString(cell.c));
+      LOG_SEV_IF_ENABLE(lg, DEBUG, "sP: "
+                                   << ideTabulationProblem.NtoString(cell.r));
+      LOG_SEV_IF_ENABLE(lg, DEBUG, "d1: "
+                                   << ideTabulationProblem.DtoString(cell.c));
       for (auto inner_cell : cell.v.cellVec()) {
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                      << "  eP: "
-                      << ideTabulationProblem.NtoString(inner_cell.r));
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                      << "  d2: "
-                      << ideTabulationProblem.DtoString(inner_cell.c));
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                      << "  EF: " << inner_cell.v->str());
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+        LOG_SEV_IF_ENABLE(lg, DEBUG,
+                          "  eP: "
+                          << ideTabulationProblem.NtoString(inner_cell.r));
+        LOG_SEV_IF_ENABLE(lg, DEBUG,
+                          "  d2: "
+                          << ideTabulationProblem.DtoString(inner_cell.c));
+        LOG_SEV_IF_ENABLE(lg, DEBUG, "  EF: " << inner_cell.v->str());
+        LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
       }
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "---------------");
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+      LOG_SEV_IF_ENABLE(lg, DEBUG, "---------------");
+      LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
     }
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "End of endsummarytab entry");
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "End of endsummarytab entry");
+    LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
   }
 
   /**
@@ -1338,205 +2003,77 @@ protected:
   void computeAndPrintStatistics() {
     auto &lg = lg::get();
     PAMM_GET_INSTANCE;
-    // Stores all valid facts at return site in caller context; return-site is
-    // key
-    std::unordered_map<N, std::set<D>> ValidInCallerContext;
-    std::size_t genFacts = 0, killFacts = 0, intraPathEdges = 0,
-                interPathEdges = 0;
-    /* --- Intra-procedural Path Edges ---
-     * d1 --> d2-Set
-     * Case 1: d1 in d2-Set
-     * Case 2: d1 not in d2-Set, i.e. d1 was killed. d2-Set could be empty.
-     */
-    for (auto cell : computedIntraPathEdges.cellSet()) {
-      auto Edge = std::make_pair(cell.r, cell.c);
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                    << "N1: " << ideTabulationProblem.NtoString(Edge.first));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                    << "N2: " << ideTabulationProblem.NtoString(Edge.second));
-      for (auto D1ToD2Set : cell.v) {
-        auto D1 = D1ToD2Set.first;
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                      << "d1: " << ideTabulationProblem.DtoString(D1));
-        auto D2Set = D1ToD2Set.second;
-        intraPathEdges += D2Set.size();
-        // Case 1
-        if (D2Set.find(D1) != D2Set.end()) {
-          genFacts += D2Set.size() - 1;
-        }
-        // Case 2
-        else {
-          genFacts += D2Set.size();
-          // We ignore the zero value
-          if (!ideTabulationProblem.isZeroValue(D1)) {
-            killFacts++;
-          }
-        }
-        // Store all valid facts after call-to-return flow
-        if (icfg.isCallStmt(Edge.first)) {
-          ValidInCallerContext[Edge.second].insert(D2Set.begin(), D2Set.end());
-        }
-        for (auto D2 : D2Set) {
-          LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                        << "d2: " << ideTabulationProblem.DtoString(D2));
-        }
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "----");
-      }
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << " ");
-    }
-
-    // Stores all pairs of (Startpoint, Fact) for which a summary was applied
-    std::set<std::pair<N, D>> ProcessSummaryFacts;
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "==============================================");
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "INTER PATH EDGES");
-    for (auto cell : computedInterPathEdges.cellSet()) {
-      auto Edge = std::make_pair(cell.r, cell.c);
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                    << "N1: " << ideTabulationProblem.NtoString(Edge.first));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                    << "N2: " << ideTabulationProblem.NtoString(Edge.second));
-      /* --- Call-flow Path Edges ---
-       * Case 1: d1 --> empty set
-       *   Can be ignored, since killing a fact in the caller context will
-       *   actually happen during  call-to-return.
-       *
-       * Case 2: d1 --> d2-Set
-       *   Every fact d_i != zeroValue in d2-set will be generated in the callee
-       * context, thus counts as a new fact. Even if d1 is passed as it is, it
-       * will count as a new fact. The reason for this is, that d1 can be
-       * killed in the callee context, but still be valid in the caller
-       * context.
-       *
-       * Special Case: Summary was applied for a particular call
-       *   Process the summary's #gen and #kill.
-       */
-      if (icfg.isCallStmt(Edge.first)) {
-        for (auto D1ToD2Set : cell.v) {
-          auto D1 = D1ToD2Set.first;
-          LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                        << "d1: " << ideTabulationProblem.DtoString(D1));
-          auto DSet = D1ToD2Set.second;
-          interPathEdges += DSet.size();
-          for (auto D2 : DSet) {
-            if (!ideTabulationProblem.isZeroValue(D2)) {
-              genFacts++;
-            }
-            // Special case
-            if (ProcessSummaryFacts.find(std::make_pair(Edge.second, D2)) !=
-                ProcessSummaryFacts.end()) {
-              std::multiset<D> SummaryDMultiSet =
-                  endsummarytab.get(Edge.second, D2).columnKeySet();
-              // remove duplicates from multiset
-              std::set<D> SummaryDSet(SummaryDMultiSet.begin(),
-                                      SummaryDMultiSet.end());
-              // Process summary just as an intra-procedural edge
-              if (SummaryDSet.find(D2) != SummaryDSet.end()) {
-                genFacts += SummaryDSet.size() - 1;
-              } else {
-                genFacts += SummaryDSet.size();
-                // We ignore the zero value
-                if (!ideTabulationProblem.isZeroValue(D1)) {
-                  killFacts++;
-                }
-              }
-            } else {
-              ProcessSummaryFacts.insert(std::make_pair(Edge.second, D2));
-            }
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                          << "d2: " << ideTabulationProblem.DtoString(D2));
-          }
-          LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "----");
-        }
-      }
-      /* --- Return-flow Path Edges ---
-       * Since every fact passed to the callee was counted as a new fact, we
-       * have to count every fact propagated to the caller as a kill to satisfy
-       * our invariant. Obviously, every fact not propagated to the caller will
-       * count as a kill. If an actual new fact is propagated to the caller, we
-       * have to increase the number of generated facts by one. Zero value does
-       * not count towards generated/killed facts.
-       */
-      if (icfg.isExitStmt(cell.r)) {
-        for (auto D1ToD2Set : cell.v) {
-          auto D1 = D1ToD2Set.first;
-          LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                        << "d1: " << ideTabulationProblem.DtoString(D1));
-          auto DSet = D1ToD2Set.second;
-          interPathEdges += DSet.size();
-          auto CallerFacts = ValidInCallerContext[Edge.second];
-          for (auto D2 : DSet) {
-            // d2 not valid in caller context
-            if (CallerFacts.find(D2) == CallerFacts.end()) {
-              genFacts++;
-            }
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                          << "d2: " << ideTabulationProblem.DtoString(D2));
-          }
-          if (!ideTabulationProblem.isZeroValue(D1)) {
-            killFacts++;
-          }
-          LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "----");
-        }
-      }
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << " ");
-    }
-
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "SUMMARY REUSE");
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "SUMMARY REUSE");
     std::size_t TotalSummaryReuse = 0;
     for (auto entry : fSummaryReuse) {
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                    << "N1: "
-                    << ideTabulationProblem.NtoString(entry.first.first));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                    << "D1: "
-                    << ideTabulationProblem.DtoString(entry.first.second));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "#Reuse: " << entry.second);
+      LOG_SEV_IF_ENABLE(lg, DEBUG,
+                        "N1: "
+                        << ideTabulationProblem.NtoString(entry.first.first));
+      LOG_SEV_IF_ENABLE(lg, DEBUG,
+                        "D1: "
+                        << ideTabulationProblem.DtoString(entry.first.second));
+      LOG_SEV_IF_ENABLE(lg, DEBUG, "#Reuse: " << entry.second);
       TotalSummaryReuse += entry.second;
     }
 
-    INC_COUNTER("Gen facts", genFacts, PAMM_SEVERITY_LEVEL::Core);
-    INC_COUNTER("Kill facts", killFacts, PAMM_SEVERITY_LEVEL::Core);
-    INC_COUNTER("Summary-reuse", TotalSummaryReuse, PAMM_SEVERITY_LEVEL::Core);
-    INC_COUNTER("Intra Path Edges", intraPathEdges, PAMM_SEVERITY_LEVEL::Core);
-    INC_COUNTER("Inter Path Edges", interPathEdges, PAMM_SEVERITY_LEVEL::Core);
-
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
-                  << "----------------------------------------------");
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO) << "=== Solver Statistics ===");
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
-                  << "#Facts generated : " << GET_COUNTER("Gen facts"));
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
-                  << "#Facts killed    : " << GET_COUNTER("Kill facts"));
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
-                  << "#Summary-reuse   : " << GET_COUNTER("Summary-reuse"));
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
-                  << "#Intra Path Edges: " << GET_COUNTER("Intra Path Edges"));
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
-                  << "#Inter Path Edges: " << GET_COUNTER("Inter Path Edges"));
+    const std::string &Scope = StatisticsScope;
+    INC_NAMED_COUNTER(Scope + "Gen facts", GenFacts,
+                      PAMM_SEVERITY_LEVEL::Core);
+    INC_NAMED_COUNTER(Scope + "Kill facts", KillFacts,
+                      PAMM_SEVERITY_LEVEL::Core);
+    INC_NAMED_COUNTER(Scope + "Summary-reuse", TotalSummaryReuse,
+                      PAMM_SEVERITY_LEVEL::Core);
+    INC_NAMED_COUNTER(Scope + "Intra Path Edges", IntraPathEdges,
+                      PAMM_SEVERITY_LEVEL::Core);
+    INC_NAMED_COUNTER(Scope + "Inter Path Edges", InterPathEdges,
+                      PAMM_SEVERITY_LEVEL::Core);
+    INC_NAMED_COUNTER(Scope + "Jump Functions", jumpFn->size(),
+                      PAMM_SEVERITY_LEVEL::Core);
+    INC_NAMED_COUNTER(Scope + "Statistics Entries", statisticsEntries(),
+                      PAMM_SEVERITY_LEVEL::Core);
+    INC_NAMED_COUNTER(Scope + "Released Contexts", ReleasedContexts,
+                      PAMM_SEVERITY_LEVEL::Core);
+
+    LOG_SEV_IF_ENABLE(lg, INFO,
+                      "----------------------------------------------");
+    LOG_SEV_IF_ENABLE(lg, INFO, "=== Solver Statistics ===");
+    LOG_SEV_IF_ENABLE(lg, INFO, "#Facts generated : "
+                                << GET_COUNTER(Scope + "Gen facts"));
+    LOG_SEV_IF_ENABLE(lg, INFO, "#Facts killed    : "
+                                << GET_COUNTER(Scope + "Kill facts"));
+    LOG_SEV_IF_ENABLE(lg, INFO, "#Summary-reuse   : "
+                                << GET_COUNTER(Scope + "Summary-reuse"));
+    LOG_SEV_IF_ENABLE(lg, INFO, "#Intra Path Edges: "
+                                << GET_COUNTER(Scope + "Intra Path Edges"));
+    LOG_SEV_IF_ENABLE(lg, INFO, "#Inter Path Edges: "
+                                << GET_COUNTER(Scope + "Inter Path Edges"));
+    LOG_SEV_IF_ENABLE(lg, INFO, "#Jump Functions  : "
+                                << GET_COUNTER(Scope + "Jump Functions"));
+    LOG_SEV_IF_ENABLE(lg, INFO, "#Statistics Entr.: "
+                                << GET_COUNTER(Scope + "Statistics Entries"));
+    LOG_SEV_IF_ENABLE(lg, INFO, "#Released Context: "
+                                << GET_COUNTER(Scope + "Released Contexts"));
+    LOG_SEV_IF_ENABLE(lg, INFO, "Peak RSS         : " << PEAK_RSS() << " KB");
     if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Full) {
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO) << "Flow function query count: "
-                                            << GET_COUNTER("FF Queries"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO) << "Edge function query count: "
-                                            << GET_COUNTER("EF Queries"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
-                    << "Data-flow value propagation count: "
-                    << GET_COUNTER("Value Propagation"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
-                    << "Data-flow value computation count: "
-                    << GET_COUNTER("Value Computation"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
-                    << "Special flow function usage count: "
-                    << GET_COUNTER("SpecialSummary-FF Application"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
-                    << "Jump function construciton count: "
-                    << GET_COUNTER("JumpFn Construction"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
-                    << "Phase I duration: " << PRINT_TIMER("DFA Phase I"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
-                    << "Phase II duration: " << PRINT_TIMER("DFA Phase II"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
-                    << "----------------------------------------------");
+      LOG_SEV_IF_ENABLE(lg, INFO, "Flow function query count: "
+                                  << GET_COUNTER("FF Queries"));
+      LOG_SEV_IF_ENABLE(lg, INFO, "Edge function query count: "
+                                  << GET_COUNTER("EF Queries"));
+      LOG_SEV_IF_ENABLE(lg, INFO, "Data-flow value propagation count: "
+                                  << GET_COUNTER("Value Propagation"));
+      LOG_SEV_IF_ENABLE(lg, INFO, "Data-flow value computation count: "
+                                  << GET_COUNTER("Value Computation"));
+      LOG_SEV_IF_ENABLE(lg, INFO,
+                        "Special flow function usage count: "
+                        << GET_COUNTER("SpecialSummary-FF Application"));
+      LOG_SEV_IF_ENABLE(lg, INFO, "Jump function construciton count: "
+                                  << GET_COUNTER("JumpFn Construction"));
+      LOG_SEV_IF_ENABLE(lg, INFO, "Phase I duration: "
+                                  << PRINT_TIMER(Scope + "DFA Phase I"));
+      LOG_SEV_IF_ENABLE(lg, INFO, "Phase II duration: "
+                                  << PRINT_TIMER(Scope + "DFA Phase II"));
+      LOG_SEV_IF_ENABLE(lg, INFO,
+                        "----------------------------------------------");
       cachedFlowEdgeFunctions.print();
     }
   }
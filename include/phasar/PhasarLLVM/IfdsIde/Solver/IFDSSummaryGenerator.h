@@ -17,17 +17,29 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_IFDSSUMMARYGENERATOR_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_IFDSSUMMARYGENERATOR_H_
 
-#include <iostream> // std::cout
+#include <map>
+#include <memory>
 #include <set>
+#include <utility>
 #include <vector>
 
 #include <phasar/PhasarLLVM/IfdsIde/FlowFunction.h>
 #include <phasar/PhasarLLVM/IfdsIde/FlowFunctions/GenAll.h>
+#include <phasar/PhasarLLVM/IfdsIde/IFDSSummaryPool.h>
 #include <phasar/PhasarLLVM/IfdsIde/LLVMZeroValue.h>
 #include <phasar/PhasarLLVM/Utils/SummaryStrategy.h>
+#include <phasar/Utils/Macros.h>
 
 namespace psr {
 
+/**
+ * IFDS flow functions are distributive, the facts that hold at the exit of a
+ * function in a context, i.e. a subset S of its inputs, are therefore the
+ * facts generated by the zero value alone plus the facts generated by every
+ * input in S. Instead of solving the function once per context, it is solved
+ * once for the zero value and once per input, the summaries of the contexts
+ * are then composed from these results.
+ */
 template <typename N, typename D, typename M, typename I,
           typename ConcreteTabulationProblem, typename ConcreteSolver>
 class IFDSSummaryGenerator {
@@ -61,58 +73,110 @@ protected:
     }
   };
 
+  /// Solves the function for the given input facts (and the zero value) and
+  /// returns the facts that hold at any of its exit points.
+  std::set<D> solveFor(const std::set<D> &facts) {
+    CTXFunctionProblem functionProblem(
+        *icfg.getStartPointsOf(toSummarize).begin(), facts, icfg);
+    ConcreteSolver solver(functionProblem, false, false);
+    // the solves of all generators, which may run in parallel, are reported
+    // together and apart from the analysis that uses the summaries
+    solver.setStatisticsScope("Summary Generation ");
+    solver.solve();
+    std::set<D> results;
+    for (auto exit : icfg.getExitPointsOf(toSummarize)) {
+      for (auto &fact : solver.resultsAt(exit)) {
+        results.insert(fact.first);
+      }
+    }
+    return results;
+  }
+
+  /// Computes the facts generated by the zero value and by every input.
+  std::pair<std::set<D>, std::vector<std::set<D>>>
+  solveDistributive(const std::vector<D> &inputs) {
+    std::pair<std::set<D>, std::vector<std::set<D>>> outputs;
+    outputs.first = solveFor({});
+    for (auto input : inputs) {
+      outputs.second.push_back(solveFor({input}));
+    }
+    return outputs;
+  }
+
+  std::shared_ptr<FlowFunction<D>> makeSummary(std::set<D> results) {
+    return std::make_shared<GenAll<D>>(results, LLVMZeroValue::getInstance());
+  }
+
 public:
   IFDSSummaryGenerator(M Function, I icfg, SummaryGenerationStrategy Strategy)
       : toSummarize(Function), icfg(icfg), CTXStrategy(Strategy) {}
   virtual ~IFDSSummaryGenerator() = default;
+
+  /**
+   * The contexts are chosen by the summary generation strategy, the function
+   * is solved at most once per input plus once for the zero value.
+   *
+   * @brief Returns a summary flow function for every context.
+   */
   virtual std::set<
       std::pair<std::vector<bool>, std::shared_ptr<FlowFunction<D>>>>
   generateSummaryFlowFunction() {
     std::set<std::pair<std::vector<bool>, std::shared_ptr<FlowFunction<D>>>>
         summary;
     std::vector<D> inputs = getInputs();
-    std::set<D> inputset;
-    inputset.insert(inputs.begin(), inputs.end());
-    std::set<std::set<D>> InputCombinations;
-    // initialize the input combinations that should be considered
+    std::set<D> inputset(inputs.begin(), inputs.end());
+    // the contexts that are made up of all or no inputs are cheaper to solve
+    // directly than to compose
     switch (CTXStrategy) {
     case SummaryGenerationStrategy::always_all:
-      InputCombinations.insert(inputset);
+      summary.insert(make_pair(generateBitPattern(inputs, inputset),
+                               makeSummary(solveFor(inputset))));
       break;
     case SummaryGenerationStrategy::always_none:
-      InputCombinations.insert(std::set<D>());
+      summary.insert(make_pair(generateBitPattern(inputs, {}),
+                               makeSummary(solveFor({}))));
       break;
     case SummaryGenerationStrategy::all_and_none:
-      InputCombinations.insert(inputset);
-      InputCombinations.insert(std::set<D>());
+      summary.insert(make_pair(generateBitPattern(inputs, inputset),
+                               makeSummary(solveFor(inputset))));
+      summary.insert(make_pair(generateBitPattern(inputs, {}),
+                               makeSummary(solveFor({}))));
       break;
-    case SummaryGenerationStrategy::powerset:
-      InputCombinations = computePowerSet(inputset);
+    case SummaryGenerationStrategy::powerset: {
+      auto outputs = solveDistributive(inputs);
+      for (auto &subset : computePowerSet(inputset)) {
+        std::set<D> results = outputs.first;
+        for (size_t i = 0; i < inputs.size(); ++i) {
+          if (subset.count(inputs[i])) {
+            results.insert(outputs.second[i].begin(), outputs.second[i].end());
+          }
+        }
+        summary.insert(make_pair(generateBitPattern(inputs, subset),
+                                 makeSummary(std::move(results))));
+      }
       break;
+    }
     case SummaryGenerationStrategy::all_observed:
       // TODO here we have to track what we have already observed first!
       break;
     }
-    for (auto subset : InputCombinations) {
-      std::cout << "Generate summary for specific context: "
-                << generateBitPattern(inputs, subset) << "\n";
-      CTXFunctionProblem functionProblem(
-          *icfg.getStartPointsOf(toSummarize).begin(), subset, icfg);
-      ConcreteSolver solver(functionProblem, true);
-      solver.solve();
-      // get the result at the end of this function and
-      // create a flow function from this set using the GenAll class
-      std::set<N> LastInsts = icfg.getExitPointsOf(toSummarize);
-      std::set<D> results;
-      for (auto fact : solver.resultsAt(*LastInsts.begin())) {
-        results.insert(fact.first);
-      }
-      summary.insert(make_pair(
-          generateBitPattern(inputs, subset),
-          std::make_shared<GenAll<D>>(results, LLVMZeroValue::getInstance())));
-    }
     return summary;
   }
+
+  /**
+   * Unlike generateSummaryFlowFunction() the contexts are not enumerated, the
+   * pool composes the summary of any context on demand, which keeps functions
+   * with many inputs feasible.
+   *
+   * @brief Stores the summaries of all contexts in the given pool.
+   */
+  void generateSummary(IFDSSummaryPool<D, N> &pool) {
+    auto outputs = solveDistributive(getInputs());
+    pool.insertDistributiveSummary(
+        *icfg.getStartPointsOf(toSummarize).begin(),
+        *icfg.getExitPointsOf(toSummarize).begin(), std::move(outputs.first),
+        std::move(outputs.second));
+  }
 };
 
 } // namespace psr
@@ -26,7 +26,6 @@
 #include <phasar/PhasarLLVM/IfdsIde/EdgeFunction.h>
 #include <phasar/Utils/LLVMShorthands.h>
 #include <phasar/Utils/Logger.h>
-#include <phasar/Utils/Table.h>
 
 namespace psr {
 
@@ -35,28 +34,41 @@ namespace psr {
 template <typename N, typename D, typename M, typename V, typename I>
 class IDETabulationProblem;
 
+/**
+ * The jump functions are stored in a single primary index that maps a target
+ * node to the source values and, for each source value, to the target values
+ * and their functions. Forward lookups and lookups by target are answered
+ * from the primary index directly. Reverse lookups are only required for the
+ * call sites of the methods returned from, hence the reverse index is built
+ * on demand, i.e. for the target nodes it is queried for, and maintained
+ * afterwards. All lookups return references that stay valid until the
+ * queried jump functions are modified; callers that add or remove jump
+ * functions while iterating must copy the result.
+ *
+ * @brief Stores the jump functions of an IDE solver.
+ */
 template <typename N, typename D, typename M, typename L, typename I>
 class JumpFunctions {
 private:
   std::shared_ptr<EdgeFunction<L>> allTop;
   const IDETabulationProblem<N, D, M, L, I> &problem;
+  // returned by the lookups if there are no jump functions
+  const std::map<D, std::shared_ptr<EdgeFunction<L>>> noFunctions;
+  const std::map<D, std::map<D, std::shared_ptr<EdgeFunction<L>>>>
+      noFunctionsByTarget;
+  std::size_t numFunctions = 0;
 
 protected:
-  // mapping from target node and value to a list of all source values and
-  // associated functions where the list is implemented as a mapping from
-  // the source value to the function we exclude empty default functions
-  Table<N, D, std::map<D, std::shared_ptr<EdgeFunction<L>>>>
-      nonEmptyReverseLookup;
-  // mapping from source value and target node to a list of all target values
-  // and associated functions where the list is implemented as a mapping from
-  // the source value to the function we exclude empty default functions
-  Table<D, N, std::map<D, std::shared_ptr<EdgeFunction<L>>>>
-      nonEmptyForwardLookup;
-  // a mapping from target node to a list of triples consisting of source value,
-  // target value and associated function; the triple is implemented by a table
+  // mapping from target node to source value to target value to function;
   // we exclude empty default functions
-  std::unordered_map<N, Table<D, D, std::shared_ptr<EdgeFunction<L>>>>
+  std::unordered_map<N,
+                     std::map<D, std::map<D, std::shared_ptr<EdgeFunction<L>>>>>
       nonEmptyLookupByTargetNode;
+  // mapping from target node to target value to source value to function,
+  // only contains the target nodes that reverseLookup() has been queried for
+  std::unordered_map<N,
+                     std::map<D, std::map<D, std::shared_ptr<EdgeFunction<L>>>>>
+      nonEmptyReverseLookup;
 
 public:
   JumpFunctions(std::shared_ptr<EdgeFunction<L>> allTop,
@@ -66,36 +78,50 @@ public:
   virtual ~JumpFunctions() = default;
 
   /**
-   * Records a jump function. The source statement is implicit.
+   * Records a jump function. The source statement is implicit. A jump
+   * function that has already been recorded for the given values is
+   * replaced.
    * @see PathEdge
    */
   void addFunction(D sourceVal, N target, D targetVal,
                    std::shared_ptr<EdgeFunction<L>> function) {
     auto &lg = lg::get();
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Start adding new jump function");
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "Fact at source : " << problem.DtoString(sourceVal));
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "Fact at target : " << problem.DtoString(targetVal));
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "Destination    : " << problem.NtoString(target));
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "Edge Function  : " << function->str());
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Start adding new jump function");
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Fact at source : "
+                                 << problem.DtoString(sourceVal));
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Fact at target : "
+                                 << problem.DtoString(targetVal));
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Destination    : "
+                                 << problem.NtoString(target));
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Edge Function  : " << function->str());
     // we do not store the default function (all-top)
     if (function->equal_to(allTop))
       return;
-    std::map<D, std::shared_ptr<EdgeFunction<L>>> &sourceValToFunc =
-        nonEmptyReverseLookup.get(target, targetVal);
-    sourceValToFunc.insert({sourceVal, function});
-    //	printNonEmptyReverseLookup();
-    std::map<D, std::shared_ptr<EdgeFunction<L>>> &targetValToFunc =
-        nonEmptyForwardLookup.get(sourceVal, target);
-    targetValToFunc.insert({targetVal, function});
-    //	printNonEmptyForwardLookup();
-    nonEmptyLookupByTargetNode[target].insert(sourceVal, targetVal, function);
-    //	printNonEmptyLookupByTargetNode();
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "End adding new jump function");
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+    std::shared_ptr<EdgeFunction<L>> &entry =
+        nonEmptyLookupByTargetNode[target][sourceVal][targetVal];
+    if (!entry)
+      ++numFunctions;
+    entry = function;
+    auto reverse = nonEmptyReverseLookup.find(target);
+    if (reverse != nonEmptyReverseLookup.end()) {
+      reverse->second[targetVal][sourceVal] = function;
+    }
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "End adding new jump function");
+    LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
+  }
+
+  /**
+   * Returns the jump function for the given source value, target statement
+   * and target value or nullptr if there is none.
+   */
+  std::shared_ptr<EdgeFunction<L>> getFunction(D sourceVal, N target,
+                                               D targetVal) const {
+    const std::map<D, std::shared_ptr<EdgeFunction<L>>> &targetValToFunc =
+        forwardLookup(sourceVal, target);
+    auto search = targetValToFunc.find(targetVal);
+    if (search == targetValToFunc.end())
+      return nullptr;
+    return search->second;
   }
 
   /**
@@ -103,12 +129,17 @@ public:
    * source values, and for each the associated edge function.
    * The return value is a mapping from source value to function.
    */
-  std::map<D, std::shared_ptr<EdgeFunction<L>>> reverseLookup(N target,
-                                                              D targetVal) {
-    if (!nonEmptyReverseLookup.contains(target, targetVal))
-      return std::map<D, std::shared_ptr<EdgeFunction<L>>>{};
-    else
-      return nonEmptyReverseLookup.get(target, targetVal);
+  const std::map<D, std::shared_ptr<EdgeFunction<L>>> &
+  reverseLookup(N target, D targetVal) {
+    auto reverse = nonEmptyReverseLookup.find(target);
+    if (reverse == nonEmptyReverseLookup.end()) {
+      reverse = nonEmptyReverseLookup.emplace(target, buildReverseLookup(target))
+                    .first;
+    }
+    auto search = reverse->second.find(targetVal);
+    if (search == reverse->second.end())
+      return noFunctions;
+    return search->second;
   }
 
   /**
@@ -116,25 +147,29 @@ public:
    * associated target values, and for each the associated edge function.
    * The return value is a mapping from target value to function.
    */
-  std::map<D, std::shared_ptr<EdgeFunction<L>>> forwardLookup(D sourceVal,
-                                                              N target) {
-    if (!nonEmptyForwardLookup.contains(sourceVal, target))
-      return std::map<D, std::shared_ptr<EdgeFunction<L>>>{};
-    else
-      return nonEmptyForwardLookup.get(sourceVal, target);
+  const std::map<D, std::shared_ptr<EdgeFunction<L>>> &
+  forwardLookup(D sourceVal, N target) const {
+    auto functions = nonEmptyLookupByTargetNode.find(target);
+    if (functions == nonEmptyLookupByTargetNode.end())
+      return noFunctions;
+    auto search = functions->second.find(sourceVal);
+    if (search == functions->second.end())
+      return noFunctions;
+    return search->second;
   }
 
   /**
    * Returns for a given target statement all jump function records with this
    * target.
-   * The return value is a set of records of the form
-   * (sourceVal,targetVal,edgeFunction).
+   * The return value is a mapping from source value to target value to
+   * function.
    */
-  Table<D, D, std::shared_ptr<EdgeFunction<L>>> lookupByTarget(N target) {
-    // if (nonEmptyLookupByTargetNode.count(target))
-    //	return Table<D, D, std::shared_ptr<EdgeFunction<L>>>{};
-    // else
-    return nonEmptyLookupByTargetNode[target];
+  const std::map<D, std::map<D, std::shared_ptr<EdgeFunction<L>>>> &
+  lookupByTarget(N target) const {
+    auto search = nonEmptyLookupByTargetNode.find(target);
+    if (search == nonEmptyLookupByTargetNode.end())
+      return noFunctionsByTarget;
+    return search->second;
   }
 
   /**
@@ -144,115 +179,113 @@ public:
    * there anyway.
    */
   bool removeFunction(D sourceVal, N target, D targetVal) {
-    //			Map<D,EdgeFunction<L>> sourceValToFunc =
-    // nonEmptyReverseLookup.get(target, targetVal);
-    //			if (sourceValToFunc == null)
-    //				return false;
-    //			if (sourceValToFunc.remove(sourceVal) == null)
-    //				return false;
-    //			if (sourceValToFunc.empty())
-    //				nonEmptyReverseLookup.remove(targetVal,
-    // targetVal);
-    //
-    //			Map<D, EdgeFunction<L>> targetValToFunc =
-    // nonEmptyForwardLookup.get(sourceVal, target);
-    //			if (targetValToFunc == null)
-    //				return false;
-    //			if (targetValToFunc.remove(targetVal) == null)
-    //				return false;
-    //			if (targetValToFunc.empty())
-    //				nonEmptyForwardLookup.remove(sourceVal, target);
-    //
-    //			Table<D,D,EdgeFunction<L>> table =
-    // nonEmptyLookupByTargetNode.get(target);
-    //			if (table == null)
-    //				return false;
-    //			if (table.remove(sourceVal, targetVal) == null)
-    //				return false;
-    //			if (table.empty())
-    //				nonEmptyLookupByTargetNode.remove(target);
-    //
-    //			return true;
-    return false;
+    auto functions = nonEmptyLookupByTargetNode.find(target);
+    if (functions == nonEmptyLookupByTargetNode.end())
+      return false;
+    auto search = functions->second.find(sourceVal);
+    if (search == functions->second.end() || !search->second.erase(targetVal))
+      return false;
+    --numFunctions;
+    if (search->second.empty())
+      functions->second.erase(search);
+    if (functions->second.empty())
+      nonEmptyLookupByTargetNode.erase(functions);
+    auto reverse = nonEmptyReverseLookup.find(target);
+    if (reverse != nonEmptyReverseLookup.end()) {
+      auto sourceValToFunc = reverse->second.find(targetVal);
+      if (sourceValToFunc != reverse->second.end()) {
+        sourceValToFunc->second.erase(sourceVal);
+        if (sourceValToFunc->second.empty())
+          reverse->second.erase(sourceValToFunc);
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Removes all jump functions that have the given target statement.
+   */
+  void removeFunctionsAt(N target) {
+    auto search = nonEmptyLookupByTargetNode.find(target);
+    if (search == nonEmptyLookupByTargetNode.end())
+      return;
+    for (auto &sourceValEntry : search->second) {
+      numFunctions -= sourceValEntry.second.size();
+    }
+    nonEmptyLookupByTargetNode.erase(search);
+    nonEmptyReverseLookup.erase(target);
+  }
+
+  /**
+   * Removes the jump functions of the given target statement from the reverse
+   * index. The functions are still found by all lookups, since the reverse
+   * index is rebuilt on demand.
+   */
+  void compactFunctionsAt(N target) { nonEmptyReverseLookup.erase(target); }
+
+  /**
+   * Removes all jump functions with the given source value and target
+   * statement.
+   */
+  void removeFunctionsFrom(D sourceVal, N target) {
+    auto functions = nonEmptyLookupByTargetNode.find(target);
+    if (functions == nonEmptyLookupByTargetNode.end())
+      return;
+    auto search = functions->second.find(sourceVal);
+    if (search == functions->second.end())
+      return;
+    numFunctions -= search->second.size();
+    functions->second.erase(search);
+    if (functions->second.empty())
+      nonEmptyLookupByTargetNode.erase(functions);
+    nonEmptyReverseLookup.erase(target);
   }
 
   /**
    * Removes all jump functions
    */
   void clear() {
-    nonEmptyReverseLookup.clear();
-    nonEmptyForwardLookup.clear();
     nonEmptyLookupByTargetNode.clear();
+    nonEmptyReverseLookup.clear();
+    numFunctions = 0;
   }
 
+  /**
+   * Returns the number of jump functions.
+   */
+  std::size_t size() const { return numFunctions; }
+
   void printJumpFunctions() {
     auto &lg = lg::get();
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Jump Functions:");
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Jump Functions:");
     for (auto &entry : nonEmptyLookupByTargetNode) {
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                    << "Node: " << problem.NtoString(entry.first));
-      for (auto cell : entry.second.cellSet()) {
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                      << "fact at src: " << problem.DtoString(cell.r));
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                      << "fact at dst: " << problem.DtoString(cell.c));
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                      << "edge fnct: " << cell.v->str());
-      }
-    }
-  }
-
-  void printNonEmptyReverseLookup() {
-    auto &lg = lg::get();
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "DUMP nonEmptyReverseLookup");
-    LOG_IF_ENABLE(
-        BOOST_LOG_SEV(lg, DEBUG)
-        << "Table<N, D, std::map<D, std::shared_ptr<EdgeFunction<L>>>>");
-    auto cellset = nonEmptyReverseLookup.cellSet();
-    for (auto cell : cellset) {
-      cell.r->dump();
-      cell.c->dump();
-      for (auto edgefunction : cell.v) {
-        edgefunction.first->dump();
-        edgefunction.second->dump();
+      LOG_SEV_IF_ENABLE(lg, DEBUG, "Node: " << problem.NtoString(entry.first));
+      for (auto &sourceValEntry : entry.second) {
+        for (auto &targetValEntry : sourceValEntry.second) {
+          LOG_SEV_IF_ENABLE(lg, DEBUG, "fact at src: "
+                                       << problem.DtoString(
+                                              sourceValEntry.first));
+          LOG_SEV_IF_ENABLE(lg, DEBUG, "fact at dst: "
+                                       << problem.DtoString(
+                                              targetValEntry.first));
+          LOG_SEV_IF_ENABLE(lg, DEBUG,
+                            "edge fnct: " << targetValEntry.second->str());
+        }
       }
     }
   }
 
-  void printNonEmptyForwardLookup() {
-    auto &lg = lg::get();
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "DUMP nonEmptyForwardLookup");
-    LOG_IF_ENABLE(
-        BOOST_LOG_SEV(lg, DEBUG)
-        << "Table<D, N, std::map<D, std::shared_ptr<EdgeFunction<L>>>>");
-    auto cellset = nonEmptyForwardLookup.cellSet();
-    for (auto cell : cellset) {
-      cell.r->dump();
-      cell.c->dump();
-      for (auto edgefunction : cell.v) {
-        edgefunction.first->dump();
-        edgefunction.second->dump();
-      }
-    }
-  }
-
-  void printNonEmptyLookupByTargetNode() {
-    auto &lg = lg::get();
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "DUMP nonEmptyLookupByTargetNode");
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "std::unordered_map<N, Table<D, D, "
-                     "std::shared_ptr<EdgeFunction<L>>>>");
-    for (auto node : nonEmptyLookupByTargetNode) {
-      node.first->dump();
-      auto table = nonEmptyLookupByTargetNode[node.first];
-      auto cellset = table.cellSet();
-      for (auto cell : cellset) {
-        cell.r->dump();
-        cell.c->dump();
-        cell.v->dump();
+private:
+  std::map<D, std::map<D, std::shared_ptr<EdgeFunction<L>>>>
+  buildReverseLookup(N target) const {
+    std::map<D, std::map<D, std::shared_ptr<EdgeFunction<L>>>> reverse;
+    for (auto &sourceValEntry : lookupByTarget(target)) {
+      for (auto &targetValEntry : sourceValEntry.second) {
+        reverse[targetValEntry.first][sourceValEntry.first] =
+            targetValEntry.second;
       }
     }
+    return reverse;
   }
 };
 
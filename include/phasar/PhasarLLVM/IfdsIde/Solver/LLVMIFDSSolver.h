@@ -19,15 +19,28 @@
 
 #include <algorithm>
 #include <map>
+#include <set>
+#include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <curl/curl.h>
 #include <json.hpp>
 
+#include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalValue.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instruction.h>
+
+#include <phasar/DB/ProjectIRDB.h>
 #include <phasar/PhasarLLVM/ControlFlow/ICFG.h>
+#include <phasar/PhasarLLVM/IfdsIde/EdgeFunctions/EdgeIdentity.h>
 #include <phasar/PhasarLLVM/IfdsIde/IFDSTabulationProblem.h>
+#include <phasar/PhasarLLVM/IfdsIde/LLVMZeroValue.h>
 #include <phasar/PhasarLLVM/IfdsIde/Solver/IFDSSolver.h>
 #include <phasar/PhasarLLVM/IfdsIde/Solver/SolverResults.h>
+#include <phasar/Utils/IO.h>
 #include <phasar/Utils/PAMMMacros.h>
 #include <phasar/Utils/Table.h>
 
@@ -44,6 +57,24 @@ private:
   const bool DUMP_RESULTS;
   const bool PRINT_REPORT;
 
+  static const llvm::Function *getFunctionOf(const llvm::Value *V) {
+    if (auto Inst = llvm::dyn_cast_or_null<llvm::Instruction>(V)) {
+      return Inst->getFunction();
+    }
+    if (auto A = llvm::dyn_cast_or_null<llvm::Argument>(V)) {
+      return A->getParent();
+    }
+    return nullptr;
+  }
+
+  static std::shared_ptr<EdgeFunction<BinaryDomain>>
+  makeEdgeFunction(bool Identity) {
+    if (Identity) {
+      return EdgeIdentity<BinaryDomain>::getInstance();
+    }
+    return ALL_BOTTOM;
+  }
+
 public:
   virtual ~LLVMIFDSSolver() = default;
 
@@ -74,6 +105,249 @@ public:
     Problem.printIFDSReport(std::cout, SR);
   }
 
+  /**
+   * @brief Writes the jump functions, end summaries and incoming edges
+   * computed by solve() or update() to the given file, together with the
+   * hashes of all functions of the IRDB. A later run on an edited version of
+   * the program continues from this state by means of restoreState() and
+   * update().
+   *
+   * Instructions, arguments and global values are stored by means of keys
+   * that do not depend on the current run, all other facts cannot be stored
+   * and cause the methods they occur in to be recomputed when restoring.
+   * Requires solver_config.incremental.
+   */
+  void saveState(const std::string &Path, ProjectIRDB &IRDB) {
+    if (!this->incremental) {
+      throw std::runtime_error(
+          "LLVMIFDSSolver::saveState() requires solver_config.incremental");
+    }
+    std::unordered_map<const llvm::Value *, json> Keys;
+    auto Encode = [&](const llvm::Value *V) -> json {
+      auto Search = Keys.find(V);
+      if (Search != Keys.end()) {
+        return Search->second;
+      }
+      if (isLLVMZeroValue(V)) {
+        return json::array({"Z"});
+      }
+      if (auto G = llvm::dyn_cast<llvm::GlobalValue>(V)) {
+        return json::array({"G", G->getName().str()});
+      }
+      const llvm::Function *F = getFunctionOf(V);
+      if (!F) {
+        return nullptr;
+      }
+      // number all arguments and instructions of the function at once
+      std::string Name = F->getName().str();
+      for (auto &A : F->args()) {
+        Keys[&A] = json::array({"A", Name, A.getArgNo()});
+      }
+      unsigned Idx = 0;
+      for (auto &Inst : llvm::instructions(F)) {
+        Keys[&Inst] = json::array({"I", Name, Idx++});
+      }
+      return Keys[V];
+    };
+    auto IsIdentity = [](std::shared_ptr<EdgeFunction<BinaryDomain>> F) {
+      return F->equal_to(EdgeIdentity<BinaryDomain>::getInstance());
+    };
+    json State;
+    State["Functions"] = IRDB.getFunctionHashes();
+    State["JumpFunctions"] = json::array();
+    for (auto &Entry : this->nodesOfMethod) {
+      for (auto n : Entry.second) {
+        for (auto &Source : this->jumpFn->lookupByTarget(n)) {
+          for (auto &Target : Source.second) {
+            State["JumpFunctions"].push_back(
+                json::array({Encode(Source.first), Encode(n),
+                             Encode(Target.first), IsIdentity(Target.second)}));
+          }
+        }
+      }
+    }
+    State["EndSummaries"] = json::array();
+    for (auto &Cell : this->endsummarytab.cellVec()) {
+      for (auto &Summary : Cell.v.cellVec()) {
+        State["EndSummaries"].push_back(json::array(
+            {Encode(Cell.r), Encode(Cell.c), Encode(Summary.r),
+             Encode(Summary.c), IsIdentity(Summary.v)}));
+      }
+    }
+    State["Incoming"] = json::array();
+    for (auto &Cell : this->incomingtab.cellVec()) {
+      for (auto &CallSite : Cell.v) {
+        for (auto d : CallSite.second) {
+          State["Incoming"].push_back(
+              json::array({Encode(Cell.r), Encode(Cell.c),
+                           Encode(CallSite.first), Encode(d)}));
+        }
+      }
+    }
+    writeFile(Path, State.dump());
+  }
+
+  /**
+   * @brief Restores the state stored by saveState() for an edited version of
+   * the program. Call update() with the returned methods instead of solve()
+   * afterwards.
+   *
+   * The state of the methods whose definition has changed, and of the
+   * methods whose state refers to values that cannot be restored anymore, is
+   * dropped.
+   * @return Methods whose state has been dropped.
+   */
+  std::set<const llvm::Function *> restoreState(const std::string &Path,
+                                                ProjectIRDB &IRDB) {
+    if (!this->incremental || this->followReturnPastSeeds ||
+        this->collectFinishedMethods) {
+      throw std::runtime_error("LLVMIFDSSolver::restoreState() requires "
+                               "solver_config.incremental and a balanced "
+                               "problem that keeps finished methods");
+    }
+    json State = json::parse(readFile(Path));
+    std::map<std::string, std::size_t> PreviousHashes = State["Functions"];
+    std::set<const llvm::Function *> Invalid;
+    for (auto &Entry : IRDB.getFunctionHashes()) {
+      auto Search = PreviousHashes.find(Entry.first);
+      if (Search == PreviousHashes.end() || Search->second != Entry.second) {
+        Invalid.insert(IRDB.getFunction(Entry.first));
+      }
+    }
+    std::map<std::string, std::vector<const llvm::Instruction *>> Instructions;
+    auto Decode = [&](const json &Key) -> const llvm::Value * {
+      if (!Key.is_array() || Key.empty()) {
+        return nullptr;
+      }
+      std::string Kind = Key[0];
+      if (Kind == "Z") {
+        return this->zeroValue;
+      }
+      if (Kind == "G") {
+        for (auto M : IRDB.getAllModules()) {
+          if (auto G = M->getNamedValue(Key[1].get<std::string>())) {
+            return G;
+          }
+        }
+        return nullptr;
+      }
+      const llvm::Function *F = IRDB.getFunction(Key[1].get<std::string>());
+      unsigned Idx = Key[2];
+      if (!F || F->isDeclaration()) {
+        return nullptr;
+      }
+      if (Kind == "A") {
+        return Idx < F->arg_size() ? &*std::next(F->arg_begin(), Idx)
+                                   : nullptr;
+      }
+      auto &Insts = Instructions[F->getName().str()];
+      if (Insts.empty()) {
+        for (auto &Inst : llvm::instructions(F)) {
+          Insts.push_back(&Inst);
+        }
+      }
+      return Idx < Insts.size() ? Insts[Idx] : nullptr;
+    };
+    // an entry refers to the method of its node and to some facts
+    struct Entry {
+      std::vector<const llvm::Value *> Values;
+      bool Identity;
+    };
+    auto DecodeAll = [&](const json &Entries, std::size_t NumValues) {
+      std::vector<Entry> Decoded;
+      for (auto &E : Entries) {
+        Entry Restored;
+        for (std::size_t Idx = 0; Idx < NumValues; ++Idx) {
+          Restored.Values.push_back(Decode(E[Idx]));
+        }
+        Restored.Identity = E.size() > NumValues && E[NumValues].get<bool>();
+        // drop the entries of removed or edited methods right away
+        auto Node =
+            llvm::dyn_cast_or_null<llvm::Instruction>(Restored.Values[1]);
+        if (Node && !Invalid.count(Node->getFunction())) {
+          Decoded.push_back(Restored);
+        }
+      }
+      return Decoded;
+    };
+    // the node an entry belongs to is always at index 1, i.e. jump functions
+    // are stored as d1, n, d2 and the start point and its fact of the end
+    // summaries and incoming edges are swapped to d1, sP, eP, d2 and d1, sP,
+    // callSite, d2
+    std::vector<Entry> JumpFunctions = DecodeAll(State["JumpFunctions"], 3);
+    json EndSummaries = State["EndSummaries"];
+    for (auto &E : EndSummaries) {
+      std::swap(E[0], E[1]);
+    }
+    std::vector<Entry> Summaries = DecodeAll(EndSummaries, 4);
+    json IncomingEdges = State["Incoming"];
+    for (auto &E : IncomingEdges) {
+      std::swap(E[0], E[1]);
+    }
+    std::vector<Entry> Incoming = DecodeAll(IncomingEdges, 4);
+    // a method whose state refers to a fact that cannot be restored or that
+    // belongs to a dropped method is dropped as well, until a fixpoint
+    auto IsValidFact = [&](const llvm::Value *V) {
+      return V && !Invalid.count(getFunctionOf(V));
+    };
+    auto MethodOf = [](const Entry &E) {
+      return llvm::cast<llvm::Instruction>(E.Values[1])->getFunction();
+    };
+    bool Changed = true;
+    while (Changed) {
+      Changed = false;
+      for (auto *Entries : {&JumpFunctions, &Summaries}) {
+        for (auto &E : *Entries) {
+          if (Invalid.count(MethodOf(E))) {
+            continue;
+          }
+          for (std::size_t Idx = 0; Idx < E.Values.size(); ++Idx) {
+            if (Idx != 1 && !IsValidFact(E.Values[Idx])) {
+              Changed |= Invalid.insert(MethodOf(E)).second;
+              break;
+            }
+          }
+        }
+      }
+      for (auto &E : Incoming) {
+        if (!Invalid.count(MethodOf(E)) && !IsValidFact(E.Values[0])) {
+          Changed |= Invalid.insert(MethodOf(E)).second;
+        }
+        // facts at a call site belong to the caller
+        auto CallSite = llvm::dyn_cast_or_null<llvm::Instruction>(E.Values[2]);
+        if (CallSite && !Invalid.count(CallSite->getFunction()) &&
+            !IsValidFact(E.Values[3])) {
+          Changed |= Invalid.insert(CallSite->getFunction()).second;
+        }
+      }
+    }
+    for (auto &E : JumpFunctions) {
+      if (!Invalid.count(MethodOf(E))) {
+        auto n = llvm::cast<llvm::Instruction>(E.Values[1]);
+        this->jumpFn->addFunction(E.Values[0], n, E.Values[2],
+                                  makeEdgeFunction(E.Identity));
+        this->nodesOfMethod[MethodOf(E)].insert(n);
+      }
+    }
+    for (auto &E : Summaries) {
+      if (!Invalid.count(MethodOf(E))) {
+        this->endsummarytab
+            .get(llvm::cast<llvm::Instruction>(E.Values[1]), E.Values[0])
+            .insert(llvm::cast<llvm::Instruction>(E.Values[2]), E.Values[3],
+                    makeEdgeFunction(E.Identity));
+      }
+    }
+    for (auto &E : Incoming) {
+      auto CallSite = llvm::dyn_cast_or_null<llvm::Instruction>(E.Values[2]);
+      if (!Invalid.count(MethodOf(E)) && CallSite &&
+          !Invalid.count(CallSite->getFunction())) {
+        this->addIncoming(llvm::cast<llvm::Instruction>(E.Values[1]),
+                          E.Values[0], CallSite, E.Values[3]);
+      }
+    }
+    return Invalid;
+  }
+
   void dumpResults() {
     PAMM_GET_INSTANCE;
     START_TIMER("DFA IFDS Result Dumping", PAMM_SEVERITY_LEVEL::Full);
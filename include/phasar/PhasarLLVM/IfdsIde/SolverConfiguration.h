@@ -18,6 +18,7 @@
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVERCONFIGURATION_H_
 
 #include <iosfwd>
+#include <string>
 
 namespace psr {
 
@@ -40,6 +41,24 @@ struct SolverConfiguration {
   bool computeValues = false;
   bool recordEdges = false;
   bool computePersistedSummaries = false;
+  /// If set, the jump functions and incoming edges of a method's calling
+  /// context are released as soon as the context has been explored
+  /// completely, only the end summaries are kept. Has no effect for problems
+  /// that follow returns past seeds, nor for problems that compute values, as
+  /// phase II evaluates the jump functions at every node.
+  bool collectFinishedMethods = false;
+  /// If set, the solver keeps track of the nodes of each method that carry
+  /// jump functions, such that IDESolver::update() can invalidate the results
+  /// of edited methods and the state can be saved and restored across runs.
+  bool incremental = false;
+  /// Set by problems whose flow and edge functions depend neither on the
+  /// entry points nor on state that the problem modifies while being solved.
+  /// The solvers of several instances of such a problem may share the cached
+  /// flow and edge functions, see IDESolver::shareFlowEdgeFunctions().
+  bool shareFlowEdgeFunctions = false;
+  /// If set, the edges of the exploded super-graph are streamed to this file
+  /// in the format of BinaryEdgeLogWriter, independent of recordEdges.
+  std::string edgeLogFile;
   friend std::ostream &operator<<(std::ostream &os,
                                   const SolverConfiguration &sc);
 };
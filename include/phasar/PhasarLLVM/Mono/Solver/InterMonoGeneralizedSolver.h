@@ -26,6 +26,7 @@
 #include <phasar/Config/ContainerConfiguration.h>
 #include <phasar/PhasarLLVM/Mono/Contexts/ContextBase.h>
 #include <phasar/PhasarLLVM/Mono/InterMonoProblem.h>
+#include <phasar/Utils/Profiler.h>
 
 namespace psr {
 
@@ -198,6 +199,7 @@ public:
   analysis_t &getAnalysisResults() { return Analysis; }
 
   virtual void solve() {
+    PROFILE_SCOPE("InterMonoGeneralizedSolver::solve");
     while (!isWLempty()) {
       getNext();
       auto &edge = *current_it_on_edge;
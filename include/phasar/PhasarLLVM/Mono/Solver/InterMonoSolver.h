@@ -22,6 +22,7 @@
 #include <phasar/Config/ContainerConfiguration.h>
 #include <phasar/PhasarLLVM/Mono/CallString.h>
 #include <phasar/PhasarLLVM/Mono/InterMonoProblem.h>
+#include <phasar/Utils/Profiler.h>
 #include <utility>
 #include <vector>
 
@@ -66,6 +67,7 @@ public:
   ~InterMonoSolver() = default;
 
   virtual void solve() {
+    PROFILE_SCOPE("InterMonoSolver::solve");
     std::cout << "starting the InterMonoSolver::solve() procedure!\n";
     initialize();
     while (!Worklist.empty()) {
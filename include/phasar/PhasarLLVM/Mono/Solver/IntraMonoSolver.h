@@ -25,6 +25,7 @@
 
 #include <phasar/Config/ContainerConfiguration.h>
 #include <phasar/PhasarLLVM/Mono/IntraMonoProblem.h>
+#include <phasar/Utils/Profiler.h>
 
 namespace psr {
 
@@ -58,6 +59,7 @@ public:
       : IMProblem(IMP), CFG(IMP.getCFG()), prealloc_hint(prealloc_hint) {}
   virtual ~IntraMonoSolver() = default;
   virtual void solve() {
+    PROFILE_SCOPE("IntraMonoSolver::solve");
     // step 1: Initalization (of Worklist and Analysis)
     initialize();
     // step 2: Iteration (updating Worklist and Analysis)
@@ -10,25 +10,32 @@
 #ifndef PHASAR_PHASARLLVM_PLUGINS_ANALYSISPLUGINCONTROLLER_H_
 #define PHASAR_PHASARLLVM_PLUGINS_ANALYSISPLUGINCONTROLLER_H_
 
+#include <functional>
 #include <string>
 #include <vector>
 
-#include <json.hpp>
+namespace llvm {
+class Value;
+} // namespace llvm
 
 namespace psr {
 
 class LLVMBasedICFG;
-
-using json = nlohmann::json;
+template <typename D, typename I> class LLVMIFDSSolver;
 
 class AnalysisPluginController {
+public:
+  using ResultsExporter = std::function<void(
+      LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> &)>;
+
 private:
-  json &FinalResultsJson;
+  ResultsExporter ExportResults;
 
 public:
   AnalysisPluginController(std::vector<std::string> AnalysisPlygins,
                            LLVMBasedICFG &ICFG,
-                           std::vector<std::string> EntryPoints, json &Results);
+                           std::vector<std::string> EntryPoints,
+                           ResultsExporter ExportResults);
 };
 
 } // namespace psr
@@ -0,0 +1,44 @@
+/******************************************************************************
+ * Copyright (c) 2018 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_POINTER_ALIASORACLE_H_
+#define PHASAR_PHASARLLVM_POINTER_ALIASORACLE_H_
+
+#include <set>
+
+namespace llvm {
+class Instruction;
+class Value;
+} // namespace llvm
+
+namespace psr {
+
+/**
+ * Analyses that only need the aliases of a few values, e.g. the arguments of
+ * taint sources, can be given an oracle that answers these queries on demand
+ * instead of consulting the whole-module points-to graph.
+ *
+ * @brief Interface for single alias queries.
+ */
+class AliasOracle {
+public:
+  virtual ~AliasOracle() = default;
+
+  /**
+   * @brief Returns the values (including V itself) that may alias V and are
+   * visible at the given instruction, i.e. globals and the values of the
+   * function containing I.
+   */
+  virtual std::set<const llvm::Value *>
+  getAliasesOf(const llvm::Value *V, const llvm::Instruction *I) = 0;
+};
+
+} // namespace psr
+
+#endif
@@ -52,7 +52,8 @@ class ProjectIRDB;
 class LLVMTypeHierarchy {
 public:
   /// necessary for storing/loading the LLVMTypeHierarchy to/from database
-  // friend class DBConn;
+  friend class DBConn;
+  friend class GraphSnapshot;
   using json = nlohmann::json;
 
   struct VertexProperties {
@@ -95,6 +96,8 @@ private:
   std::unordered_set<const llvm::Module *> contained_modules;
 
   void reconstructVTables(const llvm::Module &M);
+  // caches the transitively reachable types of every vertex
+  void computeReachableTypes();
   // FRIEND_TEST(VTableTest, SameTypeDifferentVTables);
   FRIEND_TEST(LTHTest, GraphConstruction);
   FRIEND_TEST(LTHTest, HandleLoadAndPrintOfNonEmptyGraph);
@@ -38,6 +38,8 @@ class Type;
 
 namespace psr {
 
+class JsonStreamWriter;
+
 using json = nlohmann::json;
 
 // See the following llvm classes for comprehension
@@ -308,6 +310,14 @@ public:
    * @brief NOT YET IMPLEMENTED
    */
   json getAsJson();
+
+  /**
+   * All vertices are rendered in parallel before the document is written.
+   *
+   * @brief Streams the same document as getAsJson() without building it in
+   * memory.
+   */
+  void emitAsJson(JsonStreamWriter &W);
 };
 
 } // namespace psr
@@ -0,0 +1,74 @@
+/******************************************************************************
+ * Copyright (c) 2018 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_POINTER_TYPEGRAPHS_INCREMENTALTYPEGRAPH_H_
+#define PHASAR_PHASARLLVM_POINTER_TYPEGRAPHS_INCREMENTALTYPEGRAPH_H_
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <llvm/ADT/SparseBitVector.h>
+
+#include <phasar/PhasarLLVM/Pointer/TypeGraphs/TypeGraph.h>
+
+namespace llvm {
+class StructType;
+}
+
+namespace psr {
+
+/**
+ * Every struct type is interned to an integer id and the types that may flow
+ * into a type, i.e. the types reachable from it, are kept as a sparse bit set
+ * over these ids. Adding a link only pushes the types that are new to the
+ * source of the link and its transitive predecessors (difference
+ * propagation). Since every type is contained in its own set, a link closes a
+ * cycle iff the source's id is already reachable from the target; the types
+ * of such a cycle are equal and are collapsed into a single node, which is
+ * found by means of a union-find structure.
+ *
+ * @brief Type graph that maintains the reachable types incrementally.
+ */
+class IncrementalTypeGraph : public TypeGraph<IncrementalTypeGraph> {
+protected:
+  using type_set_t = llvm::SparseBitVector<>;
+
+  std::unordered_map<const llvm::StructType *, unsigned> type_ids;
+  std::vector<const llvm::StructType *> id_types;
+  // union-find parent of every id, the representative of a strongly connected
+  // component is its own parent
+  std::vector<unsigned> parent;
+  // the following are only valid for representatives, the successors and
+  // predecessors may refer to ids that have been merged since
+  std::vector<type_set_t> types;
+  std::vector<std::set<unsigned>> succs;
+  std::vector<std::set<unsigned>> preds;
+
+  unsigned addType(const llvm::StructType *new_type);
+  unsigned find(unsigned id);
+  void collapseCycle(unsigned from, unsigned to);
+  void propagate(unsigned id, const type_set_t &delta);
+
+public:
+  IncrementalTypeGraph() = default;
+
+  ~IncrementalTypeGraph() override = default;
+
+  bool addLink(const llvm::StructType *from,
+               const llvm::StructType *to) override;
+  void printAsDot(const std::string &path = "typegraph.dot") const override;
+  std::set<const llvm::StructType *>
+  getTypes(const llvm::StructType *struct_type) override;
+};
+
+} // namespace psr
+
+#endif
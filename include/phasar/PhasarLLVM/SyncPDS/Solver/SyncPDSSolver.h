@@ -10,12 +10,139 @@
 #ifndef PHASAR_PHASARLLVM_SYNCSPDS_SOLVER_SYNCSPDSSOLVER_H_
 #define PHASAR_PHASARLLVM_SYNCSPDS_SOLVER_SYNCSPDSSOLVER_H_
 
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <phasar/PhasarLLVM/Pointer/AliasOracle.h>
+
+namespace llvm {
+class Function;
+class Instruction;
+class Value;
+} // namespace llvm
+
 namespace psr {
 
-class SyncPDSSolver {
+class LLVMBasedICFG;
+
+/**
+ * Answers alias queries on demand in the spirit of Boomerang/SPDS: a query
+ * first searches backwards for the allocation sites the value may point to
+ * and then forwards from these allocation sites for all pointers that may
+ * point to the same object. Whenever the searches pass through memory, i.e. a
+ * load or a store, the pointer operand is resolved by a nested query.
+ *
+ * Objects are distinguished by their allocation site and by the (struct)
+ * fields accessed within them, field paths are bounded by FieldDepth. Calls
+ * and returns are matched using call strings bounded by ContextDepth; a
+ * return with an empty call string flows to all callers. Only the part of
+ * the program that is relevant for the queries is ever looked at and all
+ * intermediate results are kept for later queries.
+ *
+ * The analysis is flow-insensitive, calls to functions without a body are
+ * assumed to return fresh objects and not to modify pointers in memory.
+ *
+ * @brief Demand-driven, field- and context-sensitive alias analysis.
+ */
+class SyncPDSSolver : public AliasOracle {
+public:
+  using Context = std::vector<const llvm::Instruction *>;
+  using FieldPath = std::vector<unsigned>;
+
 private:
+  /// An allocation site and the fields accessed within the allocated object
+  using Object = std::pair<const llvm::Value *, FieldPath>;
+  /// A pointer within a calling context or, if value is null, the memory cell
+  /// of the object with the id cell
+  struct Node {
+    const llvm::Value *value;
+    Context context;
+    unsigned cell;
+    bool operator<(const Node &Other) const;
+  };
+  struct NodeData {
+    std::set<unsigned> points_to;
+    /// Nodes that point to whatever this node points to, extended by a path
+    std::set<std::pair<unsigned, FieldPath>> copies;
+    /// Nodes that are loaded from this pointer
+    std::set<unsigned> loads;
+    /// Nodes that are stored through this pointer
+    std::set<unsigned> stores;
+    bool backward = false;
+    bool forward = false;
+  };
+
+  LLVMBasedICFG &ICFG;
+  unsigned ContextDepth;
+  unsigned FieldDepth;
+  std::map<Node, unsigned> node_ids;
+  std::vector<Node> nodes;
+  /// A deque never moves its elements
+  std::deque<NodeData> data;
+  std::map<Object, unsigned> object_ids;
+  std::vector<Object> objects;
+  std::map<const llvm::Value *, std::set<unsigned>> site_objects;
+  /// Pointers (not cells) that point to an object
+  std::map<unsigned, std::set<unsigned>> pointers;
+  /// Allocation sites whose pointers have been searched for
+  std::set<const llvm::Value *> forward_sites;
+  /// Pending facts (node, object) and pending searches
+  std::deque<std::pair<unsigned, unsigned>> worklist;
+  std::deque<unsigned> backward_worklist;
+  std::deque<unsigned> forward_worklist;
+  size_t num_facts = 0;
+  std::map<const llvm::Value *, std::set<const llvm::Value *>> alias_cache;
+
+  unsigned getNode(const llvm::Value *V, const Context &C);
+  unsigned getCell(unsigned Object);
+  unsigned getObject(const llvm::Value *Site, const FieldPath &Path);
+  unsigned extend(unsigned Object, const FieldPath &Path);
+  Context push(const Context &C, const llvm::Instruction *CallSite) const;
+  std::vector<std::pair<const llvm::Instruction *, Context>>
+  getReturnSites(const llvm::Function *F, const Context &C);
+  void addFact(unsigned N, unsigned Object);
+  void addCopy(unsigned From, unsigned To, const FieldPath &Path = {});
+  void addLoad(unsigned Pointer, unsigned Target);
+  void addStore(unsigned Value, unsigned Pointer);
+  void demandBackward(unsigned N);
+  void demandForward(const llvm::Value *Site);
+  void scheduleForward(unsigned N);
+  void searchBackward(unsigned N);
+  void searchForward(unsigned N);
+  void process(unsigned N, unsigned Object);
+  void solve();
+  /// Returns the objects V may point to, all of which are searched forwards
+  const std::set<unsigned> &query(const llvm::Value *V);
+
 public:
-  ~SyncPDSSolver() = default;
+  SyncPDSSolver(LLVMBasedICFG &ICFG, unsigned ContextDepth = 3,
+                unsigned FieldDepth = 4);
+
+  ~SyncPDSSolver() override;
+
+  /**
+   * The results are cached, later queries benefit from the parts of the
+   * program that have been analyzed for earlier ones.
+   *
+   * @brief Returns the values that may alias V and are visible at I, V itself
+   * included. If I is null, all aliases are returned.
+   */
+  std::set<const llvm::Value *> getAliasesOf(const llvm::Value *V,
+                                             const llvm::Instruction *I) override;
+
+  /**
+   * @brief Returns the allocation sites of the objects V may point to.
+   */
+  std::set<const llvm::Value *> getAllocationSitesOf(const llvm::Value *V);
+
+  /**
+   * @brief Drops all results, e.g. after the IR has been modified.
+   */
+  void clear();
 };
 
 } // namespace psr
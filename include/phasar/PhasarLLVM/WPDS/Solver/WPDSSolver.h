@@ -17,6 +17,7 @@
 #include <set>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <llvm/Support/Casting.h>
 #include <llvm/Support/raw_ostream.h>
@@ -40,6 +41,7 @@
 #include <phasar/PhasarLLVM/WPDS/WPDSProblem.h>
 #include <phasar/Utils/LLVMShorthands.h>
 #include <phasar/Utils/Logger.h>
+#include <phasar/Utils/Profiler.h>
 #include <phasar/Utils/Table.h>
 
 namespace llvm {
@@ -61,11 +63,66 @@ private:
   D ZeroValue;
   wali::Key ZeroPDSState;
   wali::Key AcceptingState;
-  std::unordered_map<D, wali::Key> DKey;
+  /// Facts are interned once, the keys of fact i are stored at FactKeys[i]
+  std::unordered_map<D, size_t> FactIds;
+  std::vector<D> Facts;
+  std::vector<wali::Key> FactKeys;
+  std::unordered_map<N, wali::Key> NodeKeys;
   wali::wfa::WFA Query;
   wali::wfa::WFA Answer;
   wali::sem_elem_t SRElem;
-  Table<N, D, std::map<N, std::set<D>>> incomingtab;
+  bool DumpAutomata = false;
+
+  wali::Key getFactKey(D Fact) {
+    auto Search = FactIds.find(Fact);
+    if (Search != FactIds.end()) {
+      return FactKeys[Search->second];
+    }
+    FactIds[Fact] = Facts.size();
+    Facts.push_back(Fact);
+    FactKeys.push_back(wali::getKey(Fact));
+    return FactKeys.back();
+  }
+
+  wali::Key getNodeKey(N Node) {
+    auto Search = NodeKeys.find(Node);
+    if (Search != NodeKeys.end()) {
+      return Search->second;
+    }
+    return NodeKeys[Node] = wali::getKey(Node);
+  }
+
+  /**
+   * @brief Combines the weights of all accepting paths of the answer
+   * automaton that start with the transition (Fact, Node), i.e. of all
+   * stacks with Node on top. The weights of the states must have been
+   * computed by path_summary() beforehand.
+   */
+  wali::sem_elem_t getWeight(wali::Key Fact, wali::Key Node) {
+    wali::sem_elem_t Weight = nullptr;
+    if (SearchDirection::BACKWARD == P.getSearchDirection()) {
+      wali::wfa::Trans Goal;
+      if (Answer.find(Fact, Node, AcceptingState, Goal)) {
+        Weight = Goal.weight();
+      }
+      return Weight;
+    }
+    wali::wfa::TransSet Transitions = Answer.match(Fact, Node);
+    for (auto Trans : Transitions) {
+      wali::sem_elem_t Path(Answer.getState(Trans->to())->weight());
+      if (!Path.is_valid()) {
+        continue;
+      }
+      Path = Path->extend(Trans->weight());
+      Weight = Weight.is_valid() ? Weight->combine(Path) : Path;
+    }
+    return Weight;
+  }
+
+  V computeValue(const wali::sem_elem_t &Weight) {
+    return static_cast<JoinLatticeToSemiRingElem<V> &>(*Weight)
+        .F->computeTarget(V{});
+  }
 
   wali::wpds::WPDS *makePDS(WPDSType T, bool Witnesses) {
     wali::wpds::Wrapper *Wrapper =
@@ -92,96 +149,55 @@ public:
         PDS(makePDS(P.getWPDSTy(), P.recordWitnesses())),
         ZeroValue(P.zeroValue()), AcceptingState(wali::getKey("__accept")),
         SRElem(nullptr) {
-    ZeroPDSState = wali::getKey(ZeroValue);
-    DKey[ZeroValue] = ZeroPDSState;
+    ZeroPDSState = getFactKey(ZeroValue);
   }
   ~WPDSSolver() override = default;
 
+  /**
+   * @brief If set, the PDS and the query and answer automata are printed and
+   * written to .dot files in the working directory while solving.
+   */
+  void setDumpAutomata(bool Dump) { DumpAutomata = Dump; }
+
   void solve() override {
+    PROFILE_SCOPE("WPDSSolver::solve");
     auto &lg = lg::get();
     // Construct the PDS
     IDESolver<N, D, M, V, I>::submitInitalSeeds();
-    std::ofstream pdsfile("pds.dot");
-    PDS->print_dot(pdsfile, true);
-    pdsfile.flush();
-    pdsfile.close();
-    // test the SRElem
-    wali::test_semelem_impl(SRElem);
+    // without any rule there is nothing to solve
+    if (!SRElem.is_valid()) {
+      return;
+    }
+    if (DumpAutomata) {
+      std::ofstream pdsfile("pds.dot");
+      PDS->print_dot(pdsfile, true);
+      // test the SRElem
+      wali::test_semelem_impl(SRElem);
+    }
     // Solve the PDS
-    wali::sem_elem_t ret = nullptr;
     if (SearchDirection::FORWARD == P.getSearchDirection()) {
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "FORWARD");
+      LOG_SEV_IF_ENABLE(lg, DEBUG, "FORWARD");
       doForwardSearch(Answer);
+      // computes the state weights that are used by getWeight()
       Answer.path_summary();
-      // another way not using path summary
-      // wali::Key node = wali::getKey(n);
-      // auto ret = SRElem->zero();
-      // wali::wfa::TransSet tset;
-      // wali::wfa::TransSet::iterator titer;
-      // tset = Answer.match(ZeroPDSState, node);
-      // for (titer = tset.begin(); titer != tset.end(); titer++) {
-      //   wali::wfa::ITrans *t = *titer;
-      //   wali::sem_elem_t tmp(Answer.getState(t->to())->weight());
-      //   tmp = tmp->extend(t->weight());
-      //   ret = ret->combine(tmp);
-      // }
     } else {
-      auto retnode = wali::getKey(
+      auto retnode = getNodeKey(
           &IDESolver<N, D, M, V, I>::icfg.getMethod("main")->back().back());
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "BACKWARD");
+      LOG_SEV_IF_ENABLE(lg, DEBUG, "BACKWARD");
       doBackwardSearch(retnode, Answer);
       Answer.path_summary();
-
-      // access the results
-      // wali::wfa::Trans goal;
-      // // check all data-flow facts
-      // std::cout << "All D(s)" << std::endl;
-      // for (auto Entry : DKey) {
-      //   if (Answer.find(Entry.second, retnode, AcceptingState, goal)) {
-      //     std::cout << "FOUND ANSWER!" << std::endl;
-      //     std::cout << llvmIRToString(Entry.first);
-      //     goal.weight()->print(std::cout << " :--- weight ---: ");
-      //     std::cout << " : --- "
-      //               << static_cast<JoinLatticeToSemiRingElem<V>
-      //               &>(*goal.weight())
-      //                      .F->computeTarget(V{});
-      //     std::cout << std::endl;
-      //   }
-      // }
-
-      // wali::sem_elem_t ret = SRElem->zero();
-      // wali::wfa::TransSet tset;
-      // wali::wfa::TransSet::iterator titer;
-      // tset = Answer.match(a1key, retnode);
-      // std::cout << "TRANSSET" << std::endl;
-      // for (auto trans : tset) {
-      //   trans->print(std::cout);
-      //   std::cout << std::endl;
-      // }
-      // for (titer = tset.begin(); titer != tset.end(); titer++) {
-      //   wali::wfa::ITrans *t = *titer;
-      //   if (!Answer.isFinalState(t->to())) continue;
-      //   wali::sem_elem_t tmp(Answer.getState(t->to())->weight());
-      //   ret = ret->combine(tmp);
-      // }
-      // std::cout << "FOUND ANSWER!" << std::endl;
-      // // std::cout << llvmIRToString(alloca1);
-      // ret->print(std::cout << " :--- weight ---: ");
-      // std::cout << " : --- "
-      //           << static_cast<JoinLatticeToSemiRingElem<V>
-      //           &>(*ret).F->computeTarget(V{});
-      // std::cout << std::endl;
     }
   }
 
   void processNormalFlow(PathEdge<N, D> edge) override {
     auto &lg = lg::get();
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "WPDS::processNormal");
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "WPDS::processNormal");
     PAMM_GET_INSTANCE;
     INC_COUNTER("Process Normal", 1, PAMM_SEVERITY_LEVEL::Full);
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "Process normal at target: "
-                  << this->ideTabulationProblem.NtoString(edge.getTarget()));
+    LOG_SEV_IF_ENABLE(
+        lg, DEBUG,
+        "Process normal at target: "
+            << this->ideTabulationProblem.NtoString(edge.getTarget()));
     D d1 = edge.factAtSource();
     N n = edge.getTarget();
     D d2 = edge.factAtTarget();
@@ -203,27 +219,25 @@ public:
             IDESolver<N, D, M, V, I>::cachedFlowEdgeFunctions
                 .getNormalEdgeFunction(n, d2, m, d3);
         // add normal PDS rule
-        auto d2_k = wali::getKey(d2);
-        DKey[d2] = d2_k;
-        auto d3_k = wali::getKey(d3);
-        DKey[d3] = d3_k;
-        auto n_k = wali::getKey(n);
-        auto m_k = wali::getKey(m);
+        auto d2_k = getFactKey(d2);
+        auto d3_k = getFactKey(d3);
+        auto n_k = getNodeKey(n);
+        auto m_k = getNodeKey(m);
         wali::ref_ptr<JoinLatticeToSemiRingElem<V>> wptr;
         wptr = new JoinLatticeToSemiRingElem<V>(
             g, static_cast<JoinLattice<V> &>(P));
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                      << "ADD NORMAL RULE: " << P.DtoString(d2) << " | "
-                      << P.NtoString(n) << " --> " << P.DtoString(d3) << " | "
-                      << P.DtoString(m) << ", " << *wptr << ")");
+        LOG_SEV_IF_ENABLE(lg, DEBUG, "ADD NORMAL RULE: " << P.DtoString(d2)
+                                     << " | " << P.NtoString(n) << " --> "
+                                     << P.DtoString(d3) << " | "
+                                     << P.DtoString(m) << ", " << *wptr << ")");
         PDS->add_rule(d2_k, n_k, d3_k, m_k, wptr);
         if (!SRElem.is_valid()) {
           SRElem = wptr;
         }
         std::shared_ptr<EdgeFunction<V>> fprime = f->composeWith(g);
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                      << "Compose: " << g->str() << " * " << f->str());
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+        LOG_SEV_IF_ENABLE(lg, DEBUG, "Compose: " << g->str() << " * "
+                                     << f->str());
+        LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
         INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
         IDESolver<N, D, M, V, I>::propagate(d1, m, d3, fprime, nullptr, false);
       }
@@ -232,12 +246,13 @@ public:
 
   void processCall(PathEdge<N, D> edge) override {
     auto &lg = lg::get();
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "WPDS::processCall");
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "WPDS::processCall");
     PAMM_GET_INSTANCE;
     INC_COUNTER("Process Call", 1, PAMM_SEVERITY_LEVEL::Full);
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "Process call at target: "
-                  << this->ideTabulationProblem.NtoString(edge.getTarget()));
+    LOG_SEV_IF_ENABLE(
+        lg, DEBUG,
+        "Process call at target: "
+            << this->ideTabulationProblem.NtoString(edge.getTarget()));
     D d1 = edge.factAtSource();
     N n = edge.getTarget(); // a call node; line 14...
     D d2 = edge.factAtTarget();
@@ -246,15 +261,14 @@ public:
     std::set<N> returnSiteNs =
         IDESolver<N, D, M, V, I>::icfg.getReturnSitesOfCallAt(n);
     std::set<M> callees = IDESolver<N, D, M, V, I>::icfg.getCalleesOfCallAt(n);
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Possible callees:");
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Possible callees:");
     for (auto callee : callees) {
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                    << "  " << callee->getName().str());
+      LOG_SEV_IF_ENABLE(lg, DEBUG, "  " << callee->getName().str());
     }
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "Possible return sites:");
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "Possible return sites:");
     for (auto ret : returnSiteNs) {
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                    << "  " << this->ideTabulationProblem.NtoString(ret));
+      LOG_SEV_IF_ENABLE(lg, DEBUG,
+                        "  " << this->ideTabulationProblem.NtoString(ret));
     }
     // for each possible callee
     for (M sCalledProcN : callees) { // still line 14
@@ -265,8 +279,7 @@ public:
       // if a special summary is available, treat this as a normal flow
       // and use the summary flow and edge functions
       if (specialSum) {
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                      << "Found and process special summary");
+        LOG_SEV_IF_ENABLE(lg, DEBUG, "Found and process special summary");
         for (N returnSiteN : returnSiteNs) {
           std::set<D> res =
               IDESolver<N, D, M, V, I>::computeSummaryFlowFunction(specialSum,
@@ -282,10 +295,9 @@ public:
                     .getSummaryEdgeFunction(n, d2, returnSiteN, d3);
             INC_COUNTER("SpecialSummary-EF Queries", 1,
                         PAMM_SEVERITY_LEVEL::Full);
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                          << "Compose: " << sumEdgFnE->str() << " * "
-                          << f->str());
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+            LOG_SEV_IF_ENABLE(lg, DEBUG, "Compose: " << sumEdgFnE->str()
+                                         << " * " << f->str());
+            LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
             IDESolver<N, D, M, V, I>::propagate(
                 d1, returnSiteN, d3, f->composeWith(sumEdgFnE), n, false);
           }
@@ -304,10 +316,10 @@ public:
         std::set<N> startPointsOf =
             IDESolver<N, D, M, V, I>::icfg.getStartPointsOf(sCalledProcN);
         if (startPointsOf.empty()) {
-          LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                        << "Start points of '" +
-                               this->icfg.getMethodName(sCalledProcN) +
-                               "' currently not available!");
+          LOG_SEV_IF_ENABLE(lg, DEBUG,
+                            "Start points of '" +
+                                this->icfg.getMethodName(sCalledProcN) +
+                                "' currently not available!");
         }
         // if startPointsOf is empty, the called function is a declaration
         for (N sP : startPointsOf) {
@@ -367,21 +379,19 @@ public:
                       IDESolver<N, D, M, V, I>::cachedFlowEdgeFunctions
                           .getCallEdgeFunction(n, d2, sCalledProcN, d3);
                   // add call PDS rule
-                  auto d2_k = wali::getKey(d2);
-                  DKey[d2] = d2_k;
-                  auto d3_k = wali::getKey(d3);
-                  DKey[d3] = d3_k;
-                  auto n_k = wali::getKey(n);
-                  auto sP_k = wali::getKey(sP);
+                  auto d2_k = getFactKey(d2);
+                  auto d3_k = getFactKey(d3);
+                  auto n_k = getNodeKey(n);
+                  auto sP_k = getNodeKey(sP);
                   wali::ref_ptr<JoinLatticeToSemiRingElem<V>> wptrCall(
                       new JoinLatticeToSemiRingElem<V>(
                           f4, static_cast<JoinLattice<V> &>(P)));
-                  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                                << "ADD CALL RULE: " << P.DtoString(d2) << ", "
-                                << P.NtoString(n) << ", " << P.DtoString(d3)
-                                << ", " << P.NtoString(sP) << ", "
-                                << *wptrCall);
-                  auto retSiteN_k = wali::getKey(retSiteN);
+                  LOG_SEV_IF_ENABLE(lg, DEBUG,
+                                    "ADD CALL RULE: " << P.DtoString(d2)
+                                    << ", " << P.NtoString(n) << ", "
+                                    << P.DtoString(d3) << ", "
+                                    << P.NtoString(sP) << ", " << *wptrCall);
+                  auto retSiteN_k = getNodeKey(retSiteN);
                   PDS->add_rule(d2_k, n_k, d3_k, sP_k, retSiteN_k, wptrCall);
                   if (!SRElem.is_valid()) {
                     SRElem = wptrCall;
@@ -392,22 +402,20 @@ public:
                           .getReturnEdgeFunction(n, sCalledProcN, eP, d4,
                                                  retSiteN, d5);
                   // add ret PDS rule
-                  auto d4_k = wali::getKey(d4);
-                  DKey[d4] = d4_k;
-                  auto d5_k = wali::getKey(d5);
-                  DKey[d5] = d5_k;
+                  auto d4_k = getFactKey(d4);
+                  auto d5_k = getFactKey(d5);
                   wali::ref_ptr<JoinLatticeToSemiRingElem<V>> wptrRet(
                       new JoinLatticeToSemiRingElem<V>(
                           f5, static_cast<JoinLattice<V> &>(P)));
-                  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                                << "ADD RET RULE (CALL): " << P.DtoString(d4)
-                                << ", " << P.NtoString(retSiteN) << ", "
-                                << P.DtoString(d5) << ", " << *wptrRet);
+                  LOG_SEV_IF_ENABLE(lg, DEBUG,
+                                    "ADD RET RULE (CALL): " << P.DtoString(d4)
+                                    << ", " << P.NtoString(retSiteN) << ", "
+                                    << P.DtoString(d5) << ", " << *wptrRet);
                   std::set<N> exitPointsN =
                       IDESolver<N, D, M, V, I>::icfg.getExitPointsOf(
                           IDESolver<N, D, M, V, I>::icfg.getMethodOf(sP));
                   for (auto exitPointN : exitPointsN) {
-                    auto exitPointN_k = wali::getKey(exitPointN);
+                    auto exitPointN_k = getNodeKey(exitPointN);
                     PDS->add_rule(d4_k, exitPointN_k, d5_k, wptrRet);
                   }
                   if (!SRElem.is_valid()) {
@@ -415,24 +423,23 @@ public:
                   }
                   INC_COUNTER("EF Queries", 2, PAMM_SEVERITY_LEVEL::Full);
                   // compose call * calleeSummary * return edge functions
-                  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                                << "Compose: " << f5->str() << " * "
-                                << fCalleeSummary->str() << " * " << f4->str());
-                  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                                << "         (return * calleeSummary * call)");
+                  LOG_SEV_IF_ENABLE(lg, DEBUG, "Compose: " << f5->str()
+                                               << " * "
+                                               << fCalleeSummary->str()
+                                               << " * " << f4->str());
+                  LOG_SEV_IF_ENABLE(lg, DEBUG,
+                                    "         (return * calleeSummary * call)");
                   std::shared_ptr<EdgeFunction<V>> fPrime =
                       f4->composeWith(fCalleeSummary)->composeWith(f5);
-                  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                                << "       = " << fPrime->str());
-                  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+                  LOG_SEV_IF_ENABLE(lg, DEBUG, "       = " << fPrime->str());
+                  LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
                   D d5_restoredCtx =
                       IDESolver<N, D, M, V, I>::restoreContextOnReturnedFact(
                           n, d2, d5);
                   // propagte the effects of the entire call
-                  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                                << "Compose: " << fPrime->str() << " * "
-                                << f->str());
-                  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+                  LOG_SEV_IF_ENABLE(lg, DEBUG, "Compose: " << fPrime->str()
+                                               << " * " << f->str());
+                  LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
                   IDESolver<N, D, M, V, I>::propagate(
                       d1, retSiteN, d5_restoredCtx, f->composeWith(fPrime), n,
                       false);
@@ -461,27 +468,26 @@ public:
               IDESolver<N, D, M, V, I>::cachedFlowEdgeFunctions
                   .getCallToRetEdgeFunction(n, d2, returnSiteN, d3, callees);
           // add calltoret PDS rule
-          auto d2_k = wali::getKey(d2);
-          DKey[d2] = d2_k;
-          auto d3_k = wali::getKey(d3);
-          DKey[d3] = d3_k;
-          auto n_k = wali::getKey(n);
-          auto returnSiteN_k = wali::getKey(returnSiteN);
+          auto d2_k = getFactKey(d2);
+          auto d3_k = getFactKey(d3);
+          auto n_k = getNodeKey(n);
+          auto returnSiteN_k = getNodeKey(returnSiteN);
           wali::ref_ptr<JoinLatticeToSemiRingElem<V>> wptr(
               new JoinLatticeToSemiRingElem<V>(
                   edgeFnE, static_cast<JoinLattice<V> &>(P)));
-          LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                        << "ADD CALLTORET RULE: " << P.DtoString(d2) << " | "
-                        << P.NtoString(n) << " --> " << P.DtoString(d3) << ", "
-                        << P.NtoString(returnSiteN) << ", " << *wptr);
+          LOG_SEV_IF_ENABLE(lg, DEBUG,
+                            "ADD CALLTORET RULE: " << P.DtoString(d2) << " | "
+                            << P.NtoString(n) << " --> " << P.DtoString(d3)
+                            << ", " << P.NtoString(returnSiteN) << ", "
+                            << *wptr);
           PDS->add_rule(d2_k, n_k, d3_k, returnSiteN_k, wptr);
           if (!SRElem.is_valid()) {
             SRElem = wptr;
           }
           INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-          LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                        << "Compose: " << edgeFnE->str() << " * " << f->str());
-          LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+          LOG_SEV_IF_ENABLE(lg, DEBUG, "Compose: " << edgeFnE->str() << " * "
+                                       << f->str());
+          LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
           IDESolver<N, D, M, V, I>::propagate(
               d1, returnSiteN, d3, f->composeWith(edgeFnE), n, false);
         }
@@ -491,12 +497,13 @@ public:
 
   void processExit(PathEdge<N, D> edge) override {
     auto &lg = lg::get();
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << "WPDS::processExit");
+    LOG_SEV_IF_ENABLE(lg, DEBUG, "WPDS::processExit");
     PAMM_GET_INSTANCE;
     INC_COUNTER("Process Exit", 1, PAMM_SEVERITY_LEVEL::Full);
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                  << "Process exit at target: "
-                  << this->ideTabulationProblem.NtoString(edge.getTarget()));
+    LOG_SEV_IF_ENABLE(
+        lg, DEBUG,
+        "Process exit at target: "
+            << this->ideTabulationProblem.NtoString(edge.getTarget()));
     N n = edge.getTarget(); // an exit node; line 21...
     std::shared_ptr<EdgeFunction<V>> f =
         IDESolver<N, D, M, V, I>::jumpFunction(edge);
@@ -515,8 +522,10 @@ public:
         inc[entry.first] = std::set<D>{entry.second};
       }
     }
-    IDESolver<N, D, M, V, I>::printEndSummaryTab();
-    IDESolver<N, D, M, V, I>::printIncomingTab();
+    if constexpr (DEBUG >= PHASAR_CURR_LOG_LEVEL) {
+      IDESolver<N, D, M, V, I>::printEndSummaryTab();
+      IDESolver<N, D, M, V, I>::printIncomingTab();
+    }
     // for each incoming call edge already processed
     //(see processCall(..))
     for (auto entry : inc) {
@@ -538,7 +547,7 @@ public:
           ADD_TO_HISTOGRAM("Data-flow facts", targets.size(), 1,
                            PAMM_SEVERITY_LEVEL::Full);
           IDESolver<N, D, M, V, I>::saveEdges(n, retSiteC, d2, targets, true);
-          std::cout << "RETURN TARGETS: " << targets.size() << std::endl;
+          LOG_SEV_IF_ENABLE(lg, DEBUG, "Return targets: " << targets.size());
           // for each target value at the return site
           // line 23
           for (D d5 : targets) {
@@ -556,50 +565,44 @@ public:
                         c, IDESolver<N, D, M, V, I>::icfg.getMethodOf(n), n, d2,
                         retSiteC, d5);
             // add ret PDS rule
-            auto d1_k = wali::getKey(d1);
-            DKey[d1] = d1_k;
-            auto d2_k = wali::getKey(d2);
-            DKey[d2] = d2_k;
-            auto d5_k = wali::getKey(d5);
-            DKey[d5] = d5_k;
-            auto n_k = wali::getKey(n);
+            auto d1_k = getFactKey(d1);
+            auto d2_k = getFactKey(d2);
+            auto d5_k = getFactKey(d5);
+            auto n_k = getNodeKey(n);
             wali::ref_ptr<JoinLatticeToSemiRingElem<V>> wptr(
                 new JoinLatticeToSemiRingElem<V>(
                     f5, static_cast<JoinLattice<V> &>(P)));
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                          << "ADD RET RULE: " << P.DtoString(d2) << ", "
-                          << P.NtoString(n) << ", " << P.DtoString(d5) << ", "
-                          << *wptr);
+            LOG_SEV_IF_ENABLE(lg, DEBUG, "ADD RET RULE: " << P.DtoString(d2)
+                                         << ", " << P.NtoString(n) << ", "
+                                         << P.DtoString(d5) << ", " << *wptr);
             PDS->add_rule(d2_k, n_k, d5_k, wptr);
             if (!SRElem.is_valid()) {
               SRElem = wptr;
             }
             INC_COUNTER("EF Queries", 2, PAMM_SEVERITY_LEVEL::Full);
             // compose call function * function * return function
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                          << "Compose: " << f5->str() << " * " << f->str()
-                          << " * " << f4->str());
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                          << "         (return * function * call)");
+            LOG_SEV_IF_ENABLE(lg, DEBUG, "Compose: " << f5->str() << " * "
+                                         << f->str() << " * " << f4->str());
+            LOG_SEV_IF_ENABLE(lg, DEBUG, "         (return * function * call)");
             std::shared_ptr<EdgeFunction<V>> fPrime =
                 f4->composeWith(f)->composeWith(f5);
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                          << "       = " << fPrime->str());
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+            LOG_SEV_IF_ENABLE(lg, DEBUG, "       = " << fPrime->str());
+            LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
             // for each jump function coming into the call, propagate to return
             // site using the composed function
-            for (auto valAndFunc :
-                 IDESolver<N, D, M, V, I>::jumpFn->reverseLookup(c, d4)) {
+            // copy, since propagate() may add jump functions at the call site
+            std::map<D, std::shared_ptr<EdgeFunction<V>>> callerFunctions =
+                IDESolver<N, D, M, V, I>::jumpFn->reverseLookup(c, d4);
+            for (auto valAndFunc : callerFunctions) {
               std::shared_ptr<EdgeFunction<V>> f3 = valAndFunc.second;
               if (!f3->equal_to(IDESolver<N, D, M, V, I>::allTop)) {
                 D d3 = valAndFunc.first;
                 D d5_restoredCtx =
                     IDESolver<N, D, M, V, I>::restoreContextOnReturnedFact(
                         c, d4, d5);
-                LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                              << "Compose: " << fPrime->str() << " * "
-                              << f3->str());
-                LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+                LOG_SEV_IF_ENABLE(lg, DEBUG, "Compose: " << fPrime->str()
+                                             << " * " << f3->str());
+                LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
                 IDESolver<N, D, M, V, I>::propagate(
                     d3, retSiteC, d5_restoredCtx, f3->composeWith(fPrime), c,
                     false);
@@ -639,9 +642,9 @@ public:
                         c, IDESolver<N, D, M, V, I>::icfg.getMethodOf(n), n, d2,
                         retSiteC, d5);
             INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
-                          << "Compose: " << f5->str() << " * " << f->str());
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG) << ' ');
+            LOG_SEV_IF_ENABLE(lg, DEBUG, "Compose: " << f5->str() << " * "
+                                         << f->str());
+            LOG_SEV_IF_ENABLE(lg, DEBUG, ' ');
             IDESolver<N, D, M, V, I>::propagteUnbalancedReturnFlow(
                 retSiteC, d5, f->composeWith(f5), c);
             // register for value processing (2nd IDE phase)
@@ -666,20 +669,24 @@ public:
 
   void doForwardSearch(wali::wfa::WFA &Answer) {
     // Create an automaton to AcceptingState the configuration:
-    // <ZeroPDSState, entry>
+    // <ZeroPDSState, entry>, all seeds are solved by a single poststar
     for (auto seed : IDESolver<N, D, M, V, I>::initialSeeds) {
-      wali::Key entry = wali::getKey(seed.first);
+      wali::Key entry = getNodeKey(seed.first);
       Query.addTrans(ZeroPDSState, entry, AcceptingState, SRElem->one());
     }
     Query.set_initial_state(ZeroPDSState);
     Query.add_final_state(AcceptingState);
-    Query.print(std::cout << "BEFORE POSTSTAR\n");
-    std::ofstream before("before_poststar.dot");
-    Query.print_dot(before, true);
+    if (DumpAutomata) {
+      Query.print(std::cout << "BEFORE POSTSTAR\n");
+      std::ofstream before("before_poststar.dot");
+      Query.print_dot(before, true);
+    }
     PDS->poststar(Query, Answer);
-    Answer.print(std::cout << "AFTER POSTSTAR\n");
-    std::ofstream after("after_poststar.dot");
-    Answer.print_dot(after, true);
+    if (DumpAutomata) {
+      Answer.print(std::cout << "AFTER POSTSTAR\n");
+      std::ofstream after("after_poststar.dot");
+      Answer.print_dot(after, true);
+    }
   }
 
   void doBackwardSearch(wali::Key node, wali::wfa::WFA &Answer) {
@@ -688,24 +695,26 @@ public:
     wali::wpds::WpdsStackSymbols syms;
     PDS->for_each(syms);
     auto alloca1 = &ICFG.getMethod("main")->front().front();
-    auto a1key = wali::getKey(alloca1);
+    auto a1key = getNodeKey(alloca1);
     // the weight is essential here!
     Query.addTrans(a1key, node, AcceptingState, SRElem->one());
     std::set<wali::Key>::iterator it;
     for (it = syms.returnPoints.begin(); it != syms.returnPoints.end(); it++) {
-      wali::getKeySource(*it)->print(std::cout);
-      std::cout << std::endl;
       Query.addTrans(AcceptingState, *it, AcceptingState, SRElem->one());
     }
     Query.set_initial_state(a1key);
     Query.add_final_state(AcceptingState);
-    Query.print(std::cout << "BEFORE PRESTAR\n");
-    std::ofstream before("before_prestar.dot");
-    Query.print_dot(before, true);
+    if (DumpAutomata) {
+      Query.print(std::cout << "BEFORE PRESTAR\n");
+      std::ofstream before("before_prestar.dot");
+      Query.print_dot(before, true);
+    }
     PDS->prestar(Query, Answer);
-    Answer.print(std::cout << "AFTER PRESTAR\n");
-    std::ofstream after("after_prestar.dot");
-    Answer.print_dot(after, true);
+    if (DumpAutomata) {
+      Answer.print(std::cout << "AFTER PRESTAR\n");
+      std::ofstream after("after_prestar.dot");
+      Answer.print_dot(after, true);
+    }
   }
 
   void doBackwardSearch(std::vector<wali::Key> node_stack,
@@ -729,27 +738,30 @@ public:
 
   std::unordered_map<D, V> resultsAt(N stmt, bool stripZero = false) override {
     std::unordered_map<D, V> Results;
-    wali::wfa::Trans goal;
-    for (auto Entry : DKey) {
-      if (Answer.find(Entry.second, wali::getKey(stmt), AcceptingState, goal)) {
-        Results.insert(std::make_pair(
-            Entry.first,
-            static_cast<JoinLatticeToSemiRingElem<V> &>(*goal.weight())
-                .F->computeTarget(V{})));
-      }
+    if (!SRElem.is_valid()) {
+      return Results;
     }
-    if (stripZero) {
-      Results.erase(ZeroValue);
+    wali::Key Node = getNodeKey(stmt);
+    for (size_t i = 0; i < Facts.size(); ++i) {
+      if (stripZero && Facts[i] == ZeroValue) {
+        continue;
+      }
+      wali::sem_elem_t Weight = getWeight(FactKeys[i], Node);
+      if (Weight.is_valid()) {
+        Results.insert(std::make_pair(Facts[i], computeValue(Weight)));
+      }
     }
     return Results;
   }
 
   V resultAt(N stmt, D fact) override {
-    wali::wfa::Trans goal;
-    if (Answer.find(wali::getKey(fact), wali::getKey(stmt), AcceptingState,
-                    goal)) {
-      return static_cast<JoinLatticeToSemiRingElem<V> &>(*goal.weight())
-          .F->computeTarget(V{});
+    auto Search = FactIds.find(fact);
+    if (Search != FactIds.end() && SRElem.is_valid()) {
+      wali::sem_elem_t Weight =
+          getWeight(FactKeys[Search->second], getNodeKey(stmt));
+      if (Weight.is_valid()) {
+        return computeValue(Weight);
+      }
     }
     throw std::runtime_error("Requested invalid fact!");
   }
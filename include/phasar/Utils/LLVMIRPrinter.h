@@ -0,0 +1,148 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_LLVMIRPRINTER_H_
+#define PHASAR_UTILS_LLVMIRPRINTER_H_
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace llvm {
+class Value;
+class Function;
+class Module;
+class ModuleSlotTracker;
+} // namespace llvm
+
+namespace psr {
+
+/**
+ * Printing a LLVM Value from scratch numbers all slots of its module each
+ * time, which is what makes llvmIRToString() so expensive. The printer re-uses
+ * the slot numbering for consecutive values of a function and does not render
+ * a value again while it is cached. Rendered
+ * strings are stored in an arena and indexed by the ID the ValueAnnotationPass
+ * attached to the value; values without an ID are indexed by address.
+ *
+ * Instead of the full text, analyses can emit compact references of the form
+ * <function>.<id> (instructions), <function>.arg<#argument> (formal arguments)
+ * or @<id> (global variables) and resolve them later, e.g. when the results
+ * are exported. render() prints many values in parallel for that purpose.
+ *
+ * Values are printed outside of the printer's lock, each printing thread uses
+ * slot trackers of its own. The cache holds at most capacity() strings; once
+ * it is full, the cached strings are dropped as a whole.
+ *
+ * Cached strings become stale when the IR changes, clear() has to be called
+ * in that case. The ProjectIRDB does so on destruction.
+ *
+ * @brief Cached, thread-safe pretty-printer for LLVM Values.
+ */
+class LLVMIRPrinter {
+private:
+  struct Entry {
+    const llvm::Value *value;
+    std::string text;
+  };
+
+  std::mutex mtx;
+  std::size_t max_entries = DefaultCapacity;
+  /// Owns the rendered strings, a deque never moves its elements
+  std::deque<Entry> arena;
+  std::unordered_map<std::string, const Entry *> by_id;
+  std::unordered_map<const llvm::Value *, const Entry *> by_value;
+  /// Values of all references handed out, needed to resolve them later
+  std::unordered_map<std::string, const llvm::Value *> references;
+  /// Slot numberings re-used among consecutive renderings
+  struct SlotTrackers {
+    std::unordered_map<const llvm::Module *,
+                       std::unique_ptr<llvm::ModuleSlotTracker>>
+        module_trackers;
+    const llvm::Function *function = nullptr;
+    std::unique_ptr<llvm::ModuleSlotTracker> function_tracker;
+    llvm::ModuleSlotTracker *get(const llvm::Value *V);
+  };
+  /// Slot trackers not used by any thread at the moment
+  std::vector<SlotTrackers> idle_trackers;
+  /// Incremented by clear(), renderings started before are not cached
+  std::size_t generation = 0;
+
+  LLVMIRPrinter();
+  const Entry *find(const llvm::Value *V, const std::string &ID);
+  const std::string &insert(const llvm::Value *V, const std::string &ID,
+                            std::string Text);
+
+public:
+  static const std::size_t DefaultCapacity = 1 << 20;
+
+  ~LLVMIRPrinter();
+  LLVMIRPrinter(const LLVMIRPrinter &) = delete;
+  LLVMIRPrinter &operator=(const LLVMIRPrinter &) = delete;
+
+  static LLVMIRPrinter &getInstance();
+
+  /**
+   * @brief Returns the same string as llvmIRToString(), rendering the value
+   * only if it is not cached.
+   */
+  std::string getString(const llvm::Value *V);
+
+  /**
+   * Values that have no ID, e.g. constants, have no compact reference and
+   * are rendered right away.
+   *
+   * @brief Returns a compact reference to the given value.
+   */
+  std::string getReference(const llvm::Value *V);
+
+  /**
+   * @brief Returns the full string for a reference obtained by getReference()
+   * or the reference itself if it is unknown.
+   */
+  std::string resolve(const std::string &Reference);
+
+  /**
+   * Every worker renders whole functions with a slot tracker of its own.
+   *
+   * @brief Renders all given values that are not cached yet in parallel.
+   * @param Threads Number of worker threads, 0 selects the number of cores.
+   */
+  void render(const std::vector<const llvm::Value *> &Values,
+              unsigned Threads = 0);
+
+  /**
+   * @brief Renders all values of which references were handed out.
+   */
+  void renderReferences(unsigned Threads = 0);
+
+  /**
+   * @brief Drops all cached strings, references and slot trackers.
+   */
+  void clear();
+
+  /**
+   * @brief Sets the maximal number of cached strings.
+   */
+  void setCapacity(std::size_t Capacity);
+
+  std::size_t capacity();
+
+  /**
+   * @brief Returns the number of cached strings.
+   */
+  std::size_t size();
+};
+
+} // namespace psr
+
+#endif
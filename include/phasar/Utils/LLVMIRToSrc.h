@@ -17,7 +17,11 @@
 #ifndef PHASAR_UTILS_LLVMIRTOSRC_H_
 #define PHASAR_UTILS_LLVMIRTOSRC_H_
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 // Forward declaration of types for which we only use its pointer or ref type
 namespace llvm {
@@ -27,6 +31,7 @@ class Function;
 class Value;
 class GlobalVariable;
 class Module;
+class MemoryBuffer;
 } // namespace llvm
 
 namespace psr {
@@ -66,6 +71,68 @@ std::string llvmModuleToSrc(const llvm::Module *M);
  */
 std::string llvmValueToSrc(const llvm::Value *V, bool ScopeInfo = true);
 
+/**
+ * The source files referenced by the debug information are read only once.
+ * Every value is mapped as by llvmValueToSrc, including local and global
+ * variables that are described by their debug variables.
+ *
+ * @brief Maps all given llvm::Values to their corresponding source information,
+ * the i-th string belongs to the i-th value.
+ */
+std::vector<std::string>
+llvmValuesToSrc(const std::vector<const llvm::Value *> &Values,
+                bool ScopeInfo = true);
+
+/**
+ * Every file is read at most once (large files are memory-mapped, see
+ * llvm::MemoryBuffer) and indexed by the offsets at which its lines start.
+ * All subsequent lookups are served from memory.
+ *
+ * @brief Thread-safe cache of the source files referred to by debug
+ * information.
+ */
+class SourceFileCache {
+private:
+  struct File {
+    std::unique_ptr<llvm::MemoryBuffer> buffer;
+    /// Offsets of the first character of every line
+    std::vector<size_t> lines;
+  };
+
+  std::mutex mtx;
+  /// Files that cannot be read are mapped to nullptr
+  std::unordered_map<std::string, std::unique_ptr<File>> files;
+
+  SourceFileCache();
+  const File *load(const std::string &Path);
+
+public:
+  ~SourceFileCache();
+  SourceFileCache(const SourceFileCache &) = delete;
+  SourceFileCache &operator=(const SourceFileCache &) = delete;
+
+  static SourceFileCache &getInstance();
+
+  /**
+   * Lines are counted from 1, a line that does not exist is empty.
+   *
+   * @brief Stores the given line of the file without surrounding white space
+   * in Result.
+   * @return false if the file cannot be read.
+   */
+  bool getLine(const std::string &Path, unsigned Line, std::string &Result);
+
+  /**
+   * @brief Reads all given files that are not cached yet.
+   */
+  void preload(const std::vector<std::string> &Paths);
+
+  /**
+   * @brief Drops all cached files, e.g. after they were modified.
+   */
+  void clear();
+};
+
 } // namespace psr
 
 #endif
@@ -78,9 +78,9 @@ bool matchesSignature(const llvm::Function *F, const llvm::FunctionType *FType);
 
 /**
  * @brief Returns a string representation of a LLVM Value.
- * @note Expensive function (between 20 to 550 ms per call)
- *       avoid to do it often, it can kill the performances (c.f. warning in the
- * implementation)
+ * @note Rendering a value is expensive (between 20 to 550 ms per call), the
+ *       result is therefore cached by LLVMIRPrinter and every value is only
+ *       rendered once (c.f. warning in the implementation)
  */
 std::string llvmIRToString(const llvm::Value *V);
 
@@ -189,6 +189,16 @@ std::size_t computeModuleHash(llvm::Module *M, bool considerIdentifier);
  */
 std::size_t computeModuleHash(const llvm::Module *M);
 
+/**
+ * @brief Computes a hash value for a given LLVM Function's definition.
+ * @note Metadata attachments are ignored and references to numbered metadata
+ * are compared without their slot numbers, since the latter are module-wide
+ * and change whenever some other function of the module is edited.
+ * @param F LLVM Function.
+ * @return Hash value.
+ */
+std::size_t computeFunctionHash(const llvm::Function *F);
+
 } // namespace psr
 
 #endif
@@ -54,6 +54,21 @@ std::ostream &operator<<(std::ostream &os, enum severity_level l);
     computation;                                                               \
   }
 
+// Log statements below this severity are removed at compile time, it is set
+// by the PHASAR_LOG_LEVEL cmake variable
+#ifndef PHASAR_LOG_LEVEL
+#define PHASAR_LOG_LEVEL DEBUG
+#endif
+static constexpr severity_level PHASAR_CURR_LOG_LEVEL = PHASAR_LOG_LEVEL;
+
+// Same as LOG_IF_ENABLE(BOOST_LOG_SEV(LG, LEVEL) << MESSAGE), but compiled out
+// entirely if LEVEL is below PHASAR_CURR_LOG_LEVEL. Within templates, the
+// message is then not even instantiated, use this in the solvers' hot paths.
+#define LOG_SEV_IF_ENABLE(LG, LEVEL, MESSAGE)                                  \
+  if constexpr (LEVEL >= PHASAR_CURR_LOG_LEVEL) {                              \
+    LOG_IF_ENABLE(BOOST_LOG_SEV(LG, LEVEL) << MESSAGE);                        \
+  }
+
 // Register the logger and use it a singleton then, get the logger with:
 // bl::sources::severity_logger<severity_level>& lg = lg::get();
 BOOST_LOG_INLINE_GLOBAL_LOGGER_DEFAULT(
@@ -90,10 +105,17 @@ struct LoggerExceptionHandler {
 };
 
 /**
- * Initializes the logger.
+ * Initializes the logger. Records are formatted and written by a background
+ * thread, the calling threads only enqueue them. If the bounded queue is
+ * full, logging threads block until there is space again.
  */
 void initializeLogger(bool use_logger, std::string log_file = "");
 
+/**
+ * Writes all pending records and stops the logger's background thread.
+ */
+void shutdownLogger();
+
 } // namespace psr
 
 #endif
@@ -17,8 +17,12 @@
 #ifndef PHASAR_UTILS_PAMM_H_
 #define PHASAR_UTILS_PAMM_H_
 
+#include <array>         // array
+#include <atomic>        // atomic
 #include <chrono>        // high_resolution_clock::time_point, milliseconds
 #include <iosfwd>        // ostream
+#include <memory>        // unique_ptr
+#include <mutex>         // mutex
 #include <set>           // set
 #include <string>        // string
 #include <unordered_map> // unordered_map
@@ -42,6 +46,13 @@ namespace psr {
  * For better compile times it is advised to include @see PAMMMacros.h instead
  * of PAMM.h.
  *
+ * Every id is interned to an integer handle once, the macros do so once per
+ * call site. Counters, timers and histograms are kept per thread and are only
+ * aggregated when the data is printed or exported, hence the operations on
+ * handles neither hash strings nor contend for a lock and can be used from
+ * multiple threads. A timer is stopped per thread, so the same timer may be
+ * run by several threads or, one run after another, by the same thread.
+ *
  * @brief This class offers functionality to assist a performance analysis of
  * the PhASAR framework.
  * @note This class implements the Singleton Pattern - use the PAMM_GET_INSTANCE
@@ -49,21 +60,87 @@ namespace psr {
  * this class.
  */
 class PAMM {
+public:
+  using Handle = unsigned;
+  /// Maximal number of distinct ids (counters, timers and histograms)
+  static constexpr Handle MaxHandles = 1 << 20;
+
 private:
-  PAMM() = default;
-  ~PAMM() = default;
+  PAMM();
+  ~PAMM();
   using TimePoint_t = std::chrono::high_resolution_clock::time_point;
   using Duration_t = std::chrono::milliseconds;
-  std::unordered_map<std::string, TimePoint_t> RunningTimer;
-  std::unordered_map<std::string, std::pair<TimePoint_t, TimePoint_t>>
-      StoppedTimer;
-  std::unordered_map<std::string,
-                     std::vector<std::pair<TimePoint_t, TimePoint_t>>>
-      RepeatingTimer;
-  std::unordered_map<std::string, unsigned> Counter;
+  /// Slots indexed by handle. The table grows in chunks that are never moved,
+  /// hence a slot can be accessed without a lock while other threads intern
+  /// new ids.
+  template <typename T> class HandleTable {
+    static constexpr Handle ChunkSize = 256;
+    std::array<std::atomic<T *>, MaxHandles / ChunkSize> Chunks{};
+
+  public:
+    HandleTable() = default;
+    HandleTable(const HandleTable &) = delete;
+    HandleTable &operator=(const HandleTable &) = delete;
+    ~HandleTable() {
+      for (auto &Chunk : Chunks) {
+        delete[] Chunk.load();
+      }
+    }
+    T &operator[](Handle H) {
+      auto &Chunk = Chunks[H / ChunkSize];
+      T *Slots = Chunk.load(std::memory_order_acquire);
+      if (!Slots) {
+        T *New = new T[ChunkSize]();
+        if (Chunk.compare_exchange_strong(Slots, New,
+                                          std::memory_order_acq_rel)) {
+          Slots = New;
+        } else {
+          delete[] New;
+        }
+      }
+      return Slots[H % ChunkSize];
+    }
+  };
+  /// Measurements of a single thread
+  struct Shard {
+    /// Only written by the owning thread, hence no read-modify-write needed
+    HandleTable<std::atomic<long>> Counter;
+    /// Guards the members below, only contended while aggregating
+    std::mutex Mtx;
+    std::unordered_map<Handle, TimePoint_t> RunningTimer;
+    /// Last run of every stopped timer, a stopped timer may be started again
+    std::unordered_map<Handle, std::pair<TimePoint_t, TimePoint_t>>
+        StoppedTimer;
+    std::unordered_map<Handle,
+                       std::vector<std::pair<TimePoint_t, TimePoint_t>>>
+        RepeatingTimer;
+    std::unordered_map<Handle, std::unordered_map<std::string, unsigned long>>
+        Histogram;
+  };
+  /// Guards the ids, the shards and the counter bases
+  std::mutex Mtx;
+  std::unordered_map<std::string, Handle> Handles;
+  std::vector<std::string> Names;
+  /// Shards outlive their threads, thus counts of finished threads are kept
+  std::vector<std::unique_ptr<Shard>> Shards;
+  HandleTable<std::atomic<bool>> CounterRegistered;
+  HandleTable<std::atomic<bool>> HistogramRegistered;
+  std::unordered_map<Handle, long> CounterBase;
+
+  Shard &newShard();
+  Shard &getShard() {
+    thread_local Shard *Local = nullptr;
+    if (!Local) {
+      Local = &newShard();
+    }
+    return *Local;
+  }
+  void stopTimer(Shard &S, Handle TimerId, bool PauseTimer);
+  void stopAllTimers();
+  std::unordered_map<std::string, long> aggregateCounters();
   std::unordered_map<std::string,
                      std::unordered_map<std::string, unsigned long>>
-      Histogram;
+  aggregateHistograms();
 
 public:
   /// PAMM is used as singleton.
@@ -78,6 +155,15 @@ public:
    */
   static PAMM &getInstance();
 
+  /**
+   * Handles stay valid for the lifetime of the program, reset() does not
+   * release them.
+   *
+   * @brief Returns the handle of the given counter, timer or histogram id and
+   * interns the id if necessary.
+   */
+  Handle getHandle(const std::string &Id);
+
   /**
    * @brief Resets PAMM, i.e. discards all gathered information (timer, counter
    * etc.) - associated macro: RESET_PAMM.
@@ -86,11 +172,14 @@ public:
   void reset();
 
   /**
+   * A timer that has already been stopped by the calling thread starts a new
+   * run, which replaces the measurement of the previous one once stopped.
    * @brief Starts a timer under the given timer id - associated macro:
    * START_TIMER(TIMER_ID, SEV_LVL).
    * @param TimerId Unique timer id.
    */
   void startTimer(const std::string &TimerId);
+  void startTimer(Handle TimerId);
 
   /**
    * @brief Resets timer under the given timer id - associated macro:
@@ -116,8 +205,39 @@ public:
    * @param PauseTimer If true, timer will be paused instead of stopped.
    */
   void stopTimer(const std::string &TimerId, bool PauseTimer = false);
+  void stopTimer(Handle TimerId, bool PauseTimer = false);
 
   /**
+   * @brief Runs a timer for its own lifetime, such that the timer is also
+   * stopped if the enclosing block is left by an exception - associated
+   * macro: SCOPED_NAMED_TIMER(TIMER_ID, SEV_LVL).
+   */
+  class ScopedTimer {
+  private:
+    PAMM &Pamm;
+    Handle TimerId = 0;
+    bool Active;
+
+  public:
+    ScopedTimer(PAMM &Pamm, const std::string &TimerId, bool Active = true)
+        : Pamm(Pamm), Active(Active) {
+      if (Active) {
+        this->TimerId = Pamm.getHandle(TimerId);
+        Pamm.startTimer(this->TimerId);
+      }
+    }
+    ~ScopedTimer() {
+      if (Active) {
+        Pamm.stopTimer(TimerId);
+      }
+    }
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+  };
+
+  /**
+   * The timer of the calling thread is preferred, otherwise the longest run
+   * of any thread is reported.
    * @brief Computes the elapsed time of the given timer up until now or up to
    * the moment the timer was stopped - associated macro: GET_TIMER(TIMERID)
    * @param TimerId Unique timer id.
@@ -133,6 +253,13 @@ public:
   std::unordered_map<std::string, std::vector<unsigned long>>
   elapsedTimeOfRepeatingTimer();
 
+  /**
+   * A timer that has been run by several threads reports its longest run.
+   * @brief Computes the elapsed time for all stopped single timers.
+   * @return Map containing measured durations of all stopped single timers.
+   */
+  std::unordered_map<std::string, unsigned long> elapsedTimeOfSingleTimer();
+
   /**
    * A running timer will not be stopped. The precision for time computation
    * is set to milliseconds and the output is similar to a timestamp, e.g.
@@ -151,6 +278,18 @@ public:
    * @param CounterId Unique counter id.
    */
   void regCounter(const std::string &CounterId, unsigned IntialValue = 0);
+  void regCounter(Handle CounterId, unsigned IntialValue = 0);
+
+  /**
+   * A shared counter accumulates the counts of all components that register
+   * it, e.g. of several solvers that run within the same process, hence
+   * registering it again has no effect - associated macro:
+   * REG_SHARED_COUNTER(COUNTER_ID, SEV_LVL).
+   * @brief Registers a counter unless it has already been registered.
+   * @param CounterId Unique counter id.
+   */
+  void regSharedCounter(const std::string &CounterId);
+  void regSharedCounter(Handle CounterId);
 
   /**
    * @brief Increases the count for the given counter - associated macro:
@@ -159,6 +298,11 @@ public:
    * @param CValue to be added to the current counter.
    */
   void incCounter(const std::string &CounterId, unsigned CValue = 1);
+  void incCounter(Handle CounterId, unsigned CValue = 1) {
+    auto &Slot = getShard().Counter[CounterId];
+    Slot.store(Slot.load(std::memory_order_relaxed) + CValue,
+               std::memory_order_relaxed);
+  }
 
   /**
    * @brief Decreases the count for the given counter - associated macro:
@@ -167,6 +311,11 @@ public:
    * @param CValue to be subtracted from the current counter.
    */
   void decCounter(const std::string &CounterId, unsigned CValue = 1);
+  void decCounter(Handle CounterId, unsigned CValue = 1) {
+    auto &Slot = getShard().Counter[CounterId];
+    Slot.store(Slot.load(std::memory_order_relaxed) - CValue,
+               std::memory_order_relaxed);
+  }
 
   /**
    * The associated macro does not check PAMM's severity level explicitly.
@@ -175,6 +324,7 @@ public:
    * @param CounterId Unique counter id.
    */
   int getCounter(const std::string &CounterId);
+  int getCounter(Handle CounterId);
 
   /**
    * The associated macro does not check PAMM's severity level explicitly.
@@ -191,6 +341,14 @@ public:
    * @param HistogramId Unique hitogram id.
    */
   void regHistogram(const std::string &HistogramId);
+  void regHistogram(Handle HistogramId);
+
+  /**
+   * @brief Registers a histogram unless it has already been registered -
+   * associated macro: REG_SHARED_HISTOGRAM(HISTOGRAM_ID, SEV_LVL).
+   * @param HistogramId Unique hitogram id.
+   */
+  void regSharedHistogram(Handle HistogramId);
 
   /**
    * @brief Adds a new observed data point to the corresponding histogram -
@@ -203,6 +361,13 @@ public:
   void addToHistogram(const std::string &HistogramId,
                       const std::string &DataPointId,
                       unsigned long DataPointValue = 1);
+  void addToHistogram(Handle HistogramId, const std::string &DataPointId,
+                      unsigned long DataPointValue = 1);
+
+  /**
+   * @brief Returns the peak resident set size of the process in kilobytes.
+   */
+  static long peakResidentSetSize();
 
   void printTimers(std::ostream &os);
 
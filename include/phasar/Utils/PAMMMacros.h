@@ -38,9 +38,18 @@ static constexpr unsigned PAMM_CURR_SEV_LEVEL = 0;
 #define PAMM_GET_INSTANCE PAMM &pamm = PAMM::getInstance()
 #define PAMM_RESET pamm.reset()
 
+#define PAMM_CONCAT_IMPL(A, B) A##B
+#define PAMM_CONCAT(A, B) PAMM_CONCAT_IMPL(A, B)
+
+// The ids passed to the following macros are interned once per call site,
+// they must not change between executions of the same call site.
+#define PAMM_HANDLE(ID)                                                        \
+  static const PAMM::Handle pamm_handle = pamm.getHandle(ID)
+
 #define START_TIMER(TIMER_ID, SEV_LVL)                                         \
   if constexpr (PAMM_CURR_SEV_LEVEL >= SEV_LVL) {                              \
-    pamm.startTimer(TIMER_ID);                                                 \
+    PAMM_HANDLE(TIMER_ID);                                                     \
+    pamm.startTimer(pamm_handle);                                              \
   }
 #define RESET_TIMER(TIMER_ID, SEV_LVL)                                         \
   if constexpr (PAMM_CURR_SEV_LEVEL >= SEV_LVL) {                              \
@@ -48,40 +57,81 @@ static constexpr unsigned PAMM_CURR_SEV_LEVEL = 0;
   }
 #define PAUSE_TIMER(TIMER_ID, SEV_LVL)                                         \
   if constexpr (PAMM_CURR_SEV_LEVEL >= SEV_LVL) {                              \
-    pamm.stopTimer(TIMER_ID, true);                                            \
+    PAMM_HANDLE(TIMER_ID);                                                     \
+    pamm.stopTimer(pamm_handle, true);                                         \
   }
 #define STOP_TIMER(TIMER_ID, SEV_LVL)                                          \
+  if constexpr (PAMM_CURR_SEV_LEVEL >= SEV_LVL) {                              \
+    PAMM_HANDLE(TIMER_ID);                                                     \
+    pamm.stopTimer(pamm_handle);                                               \
+  }
+// Timers whose id is only known at run time, the id is interned on every use.
+#define START_NAMED_TIMER(TIMER_ID, SEV_LVL)                                   \
+  if constexpr (PAMM_CURR_SEV_LEVEL >= SEV_LVL) {                              \
+    pamm.startTimer(TIMER_ID);                                                 \
+  }
+#define STOP_NAMED_TIMER(TIMER_ID, SEV_LVL)                                    \
   if constexpr (PAMM_CURR_SEV_LEVEL >= SEV_LVL) {                              \
     pamm.stopTimer(TIMER_ID);                                                  \
   }
+// Times the rest of the enclosing block, see PAMM::ScopedTimer.
+#define SCOPED_NAMED_TIMER(TIMER_ID, SEV_LVL)                                  \
+  PAMM::ScopedTimer PAMM_CONCAT(pamm_scoped_timer_, __LINE__)(                 \
+      pamm, TIMER_ID, PAMM_CURR_SEV_LEVEL >= SEV_LVL)
 #define PRINT_TIMER(TIMER_ID)                                                  \
   pamm.getPrintableDuration(pamm.elapsedTime(TIMER_ID))
 
 #define REG_COUNTER(COUNTER_ID, INIT_VALUE, SEV_LVL)                           \
   if constexpr (PAMM_CURR_SEV_LEVEL >= SEV_LVL) {                              \
-    pamm.regCounter(COUNTER_ID, INIT_VALUE);                                   \
+    PAMM_HANDLE(COUNTER_ID);                                                   \
+    pamm.regCounter(pamm_handle, INIT_VALUE);                                  \
   }
 #define INC_COUNTER(COUNTER_ID, VALUE, SEV_LVL)                                \
   if constexpr (PAMM_CURR_SEV_LEVEL >= SEV_LVL) {                              \
-    pamm.incCounter(COUNTER_ID, VALUE);                                        \
+    PAMM_HANDLE(COUNTER_ID);                                                   \
+    pamm.incCounter(pamm_handle, VALUE);                                       \
   }
 #define DEC_COUNTER(COUNTER_ID, VALUE, SEV_LVL)                                \
   if constexpr (PAMM_CURR_SEV_LEVEL >= SEV_LVL) {                              \
-    pamm.decCounter(COUNTER_ID, VALUE);                                        \
+    PAMM_HANDLE(COUNTER_ID);                                                   \
+    pamm.decCounter(pamm_handle, VALUE);                                       \
+  }
+// Counters that several components contribute to, see PAMM::regSharedCounter.
+#define REG_SHARED_COUNTER(COUNTER_ID, SEV_LVL)                                \
+  if constexpr (PAMM_CURR_SEV_LEVEL >= SEV_LVL) {                              \
+    PAMM_HANDLE(COUNTER_ID);                                                   \
+    pamm.regSharedCounter(pamm_handle);                                        \
+  }
+// Shared counters whose id is only known at run time, the id is interned and
+// the counter is registered on every use.
+#define INC_NAMED_COUNTER(COUNTER_ID, VALUE, SEV_LVL)                          \
+  if constexpr (PAMM_CURR_SEV_LEVEL >= SEV_LVL) {                              \
+    const PAMM::Handle pamm_named_handle = pamm.getHandle(COUNTER_ID);         \
+    pamm.regSharedCounter(pamm_named_handle);                                  \
+    pamm.incCounter(pamm_named_handle, VALUE);                                 \
   }
 #define GET_COUNTER(COUNTER_ID) pamm.getCounter(COUNTER_ID)
 #define GET_SUM_COUNT(...) pamm.getSumCount(__VA_ARGS__)
 
 #define REG_HISTOGRAM(HISTOGRAM_ID, SEV_LVL)                                   \
   if constexpr (PAMM_CURR_SEV_LEVEL >= SEV_LVL) {                              \
-    pamm.regHistogram(HISTOGRAM_ID);                                           \
+    PAMM_HANDLE(HISTOGRAM_ID);                                                 \
+    pamm.regHistogram(pamm_handle);                                            \
+  }
+#define REG_SHARED_HISTOGRAM(HISTOGRAM_ID, SEV_LVL)                            \
+  if constexpr (PAMM_CURR_SEV_LEVEL >= SEV_LVL) {                              \
+    PAMM_HANDLE(HISTOGRAM_ID);                                                 \
+    pamm.regSharedHistogram(pamm_handle);                                      \
   }
 #define ADD_TO_HISTOGRAM(HISTOGRAM_ID, DATAPOINT_ID, DATAPOINT_VALUE, SEV_LVL) \
   if constexpr (PAMM_CURR_SEV_LEVEL >= SEV_LVL) {                              \
-    pamm.addToHistogram(HISTOGRAM_ID, std::to_string(DATAPOINT_ID),            \
+    PAMM_HANDLE(HISTOGRAM_ID);                                                 \
+    pamm.addToHistogram(pamm_handle, std::to_string(DATAPOINT_ID),             \
                         DATAPOINT_VALUE);                                      \
   }
 
+#define PEAK_RSS() PAMM::peakResidentSetSize()
+
 #define PRINT_MEASURED_DATA(OUTPUT_STREAM) pamm.printMeasuredData(OUTPUT_STREAM)
 #define EXPORT_MEASURED_DATA(PATH) pamm.exportMeasuredData(PATH)
 
@@ -92,10 +142,16 @@ static constexpr unsigned PAMM_CURR_SEV_LEVEL = 0;
 #define RESET_TIMER(TIMER_ID, SEV_LVL)
 #define PAUSE_TIMER(TIMER_ID, SEV_LVL)
 #define STOP_TIMER(TIMER_ID, SEV_LVL)
+#define START_NAMED_TIMER(TIMER_ID, SEV_LVL)
+#define STOP_NAMED_TIMER(TIMER_ID, SEV_LVL)
+#define SCOPED_NAMED_TIMER(TIMER_ID, SEV_LVL)
 #define REG_COUNTER(COUNTER_ID, INIT_VALUE, SEV_LVL)
 #define INC_COUNTER(COUNTER_ID, VALUE, SEV_LVL)
 #define DEC_COUNTER(COUNTER_ID, VALUE, SEV_LVL)
+#define REG_SHARED_COUNTER(COUNTER_ID, SEV_LVL)
+#define INC_NAMED_COUNTER(COUNTER_ID, VALUE, SEV_LVL)
 #define REG_HISTOGRAM(HISTOGRAM_ID, SEV_LVL)
+#define REG_SHARED_HISTOGRAM(HISTOGRAM_ID, SEV_LVL)
 #define ADD_TO_HISTOGRAM(HISTOGRAM_ID, DATAPOINT_ID, DATAPOINT_VALUE, SEV_LVL)
 #define PRINT_MEASURED_DATA(OUTPUT_STREAM)
 #define EXPORT_MEASURED_DATA(PATH)
@@ -104,6 +160,7 @@ static constexpr unsigned PAMM_CURR_SEV_LEVEL = 0;
 #define PRINT_TIMER(TIMER_ID) "-1"
 #define GET_COUNTER(COUNTER_ID) "-1"
 #define GET_SUM_COUNT(...) "-1"
+#define PEAK_RSS() "-1"
 #endif
 
 #endif
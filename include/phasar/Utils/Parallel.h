@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_PARALLEL_H_
+#define PHASAR_UTILS_PARALLEL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace psr {
+
+/**
+ * The calling thread is one of the Threads threads (0 uses one per hardware
+ * thread), the indices are handed out in ascending order whenever a thread
+ * becomes idle. An exception thrown by Fn does not stop the remaining calls,
+ * the exception of the lowest index is rethrown once all threads are done.
+ *
+ * @brief Calls Fn(i) for every i in [0, N) in parallel.
+ * @return The number of threads that have been used.
+ */
+template <typename FnT>
+std::size_t parallelForEach(std::size_t N, unsigned Threads, FnT Fn) {
+  std::vector<std::exception_ptr> Errors(N);
+  std::atomic<std::size_t> Next(0);
+  auto Worker = [&]() {
+    for (std::size_t i = Next++; i < N; i = Next++) {
+      try {
+        Fn(i);
+      } catch (...) {
+        Errors[i] = std::current_exception();
+      }
+    }
+  };
+  std::size_t NumThreads = std::min<std::size_t>(
+      Threads ? Threads : std::max(1u, std::thread::hardware_concurrency()),
+      N);
+  std::vector<std::thread> Workers;
+  for (std::size_t i = 1; i < NumThreads; ++i) {
+    Workers.emplace_back(Worker);
+  }
+  Worker();
+  for (auto &W : Workers) {
+    W.join();
+  }
+  for (auto &Error : Errors) {
+    if (Error) {
+      std::rethrow_exception(Error);
+    }
+  }
+  return NumThreads;
+}
+
+} // namespace psr
+
+#endif
@@ -0,0 +1,223 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_PROFILER_H_
+#define PHASAR_UTILS_PROFILER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace psr {
+
+/**
+ * Spans are opened and closed by the PROFILE_* macros below. Every thread
+ * records its spans in a calling-context tree of its own, such that the time
+ * spent in each distinct stack of spans is known. Spans that exceed the trace
+ * threshold are additionally recorded as trace events.
+ *
+ * Method spans are meant for the hot, possibly deeply recursive parts of the
+ * solvers: they do not nest into each other, only their self time (and the
+ * path edges counted while they are open) is attributed to a leaf frame below
+ * the enclosing scope span, named after the method they are attributed to.
+ *
+ * The results can be exported in the Chrome trace-event format (e.g. for
+ * chrome://tracing or Perfetto) and as folded stacks for flame graphs. Exports
+ * must not run concurrently with spans being opened or closed.
+ *
+ * When the profiler is disabled, a span costs a single relaxed atomic load.
+ *
+ * @brief Hierarchical, low-overhead profiler for analysis runs.
+ */
+class Profiler {
+public:
+  using Clock = std::chrono::steady_clock;
+
+private:
+  struct Node {
+    uint32_t parent;
+    uint32_t name;
+    uint32_t detail;
+    bool method;
+    uint64_t count = 0;
+    uint64_t inclusive_ns = 0;
+    uint64_t self_ns = 0;
+    uint64_t edges = 0;
+    std::unordered_map<uint64_t, uint32_t> children;
+    Node(uint32_t parent, uint32_t name, uint32_t detail, bool method)
+        : parent(parent), name(name), detail(detail), method(method) {}
+  };
+  struct Frame {
+    uint32_t name;
+    uint32_t detail;
+    bool method;
+    Clock::time_point begin;
+    uint64_t child_ns = 0;
+    uint64_t edges = 0;
+  };
+  struct Event {
+    uint32_t node;
+    uint64_t begin_ns;
+    uint64_t duration_ns;
+  };
+  /// Recordings of a single thread
+  struct ThreadData {
+    uint32_t tid;
+    std::vector<Node> nodes;
+    uint32_t current = 0;
+    std::vector<Frame> stack;
+    std::vector<Event> events;
+    std::unordered_map<const char *, uint32_t> name_cache;
+    std::unordered_map<std::string, uint32_t> detail_cache;
+    explicit ThreadData(uint32_t tid);
+  };
+
+  std::atomic<bool> enabled{false};
+  std::atomic<uint64_t> trace_threshold_ns{100000};
+  Clock::time_point epoch;
+  /// Guards the string table and the list of threads
+  std::mutex mtx;
+  std::unordered_map<std::string, uint32_t> string_ids;
+  std::vector<std::string> strings;
+  std::vector<std::unique_ptr<ThreadData>> threads;
+
+  Profiler();
+  ThreadData &newThreadData();
+  ThreadData &getThreadData() {
+    thread_local ThreadData *Local = nullptr;
+    if (!Local) {
+      Local = &newThreadData();
+    }
+    return *Local;
+  }
+  uint32_t intern(const std::string &S);
+  uint32_t getChild(ThreadData &T, uint32_t Parent, uint32_t Name,
+                    uint32_t Detail, bool Method);
+  std::string frameName(const Node &N);
+  std::string stackOf(const ThreadData &T, uint32_t Node);
+
+public:
+  ~Profiler();
+  Profiler(const Profiler &) = delete;
+  Profiler &operator=(const Profiler &) = delete;
+
+  static Profiler &getInstance();
+
+  bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+  void setEnabled(bool Enabled);
+
+  /**
+   * @brief Spans that take at least the given time are recorded as trace
+   * events, shorter ones only contribute to the aggregated stacks.
+   */
+  void setTraceThreshold(std::chrono::microseconds Threshold);
+
+  /**
+   * @brief Opens a span, Name must be a string literal.
+   * @param Method If set the span is a method span, see above.
+   */
+  void enter(const char *Name, const std::string &Detail = "",
+             bool Method = false);
+
+  /**
+   * @brief Closes the innermost open span of the calling thread.
+   */
+  void exit();
+
+  /**
+   * @brief Attributes the given number of path edges to the innermost open
+   * span of the calling thread.
+   */
+  void countEdges(uint64_t Edges = 1);
+
+  /**
+   * @brief Writes all spans longer than the trace threshold in the Chrome
+   * trace-event format.
+   */
+  void exportChromeTrace(std::ostream &OS);
+
+  /**
+   * @brief Writes the self time in microseconds (or the number of path edges)
+   * of every stack of spans as folded stacks, one stack per line.
+   */
+  void exportFoldedStacks(std::ostream &OS, bool Edges = false);
+
+  /**
+   * @brief Prints the spans with the highest self time, summed over all
+   * threads and stacks.
+   */
+  void printSummary(std::ostream &OS, size_t Limit = 20);
+
+  /**
+   * @brief Discards all recorded data, must not be called while spans are
+   * open.
+   */
+  void reset();
+};
+
+/**
+ * @brief Opens a span on construction and closes it on destruction.
+ */
+class ProfileScope {
+private:
+  bool active;
+
+public:
+  explicit ProfileScope(const char *Name)
+      : active(Profiler::getInstance().isEnabled()) {
+    if (active) {
+      Profiler::getInstance().enter(Name);
+    }
+  }
+  /// The detail is computed only if the profiler is enabled
+  template <typename DetailFn>
+  ProfileScope(const char *Name, DetailFn Detail, bool Method)
+      : active(Profiler::getInstance().isEnabled()) {
+    if (active) {
+      Profiler::getInstance().enter(Name, Detail(), Method);
+    }
+  }
+  ~ProfileScope() {
+    if (active) {
+      Profiler::getInstance().exit();
+    }
+  }
+  ProfileScope(const ProfileScope &) = delete;
+  ProfileScope &operator=(const ProfileScope &) = delete;
+};
+
+} // namespace psr
+
+#define PROFILE_CONCAT_IMPL(A, B) A##B
+#define PROFILE_CONCAT(A, B) PROFILE_CONCAT_IMPL(A, B)
+
+/// Profiles the rest of the enclosing block
+#define PROFILE_SCOPE(NAME)                                                    \
+  psr::ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(NAME)
+/// Same as PROFILE_SCOPE, DETAIL is only evaluated when profiling
+#define PROFILE_SCOPE_DETAIL(NAME, DETAIL)                                     \
+  psr::ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(                  \
+      NAME, [&]() { return DETAIL; }, false)
+/// Attributes the self time of the rest of the block to the method METHOD
+#define PROFILE_METHOD(NAME, METHOD)                                           \
+  psr::ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(                  \
+      NAME, [&]() { return METHOD; }, true)
+#define PROFILE_COUNT_EDGES(EDGES)                                             \
+  if (psr::Profiler::getInstance().isEnabled()) {                              \
+    psr::Profiler::getInstance().countEdges(EDGES);                            \
+  }
+
+#endif
@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_RESULTWRITER_H_
+#define PHASAR_UTILS_RESULTWRITER_H_
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace psr {
+
+/**
+ * Writes a json document incrementally to an output stream without building
+ * a document tree in memory. Commas and nesting are handled by the writer;
+ * the caller only has to emit the events in a valid order.
+ *
+ * @brief SAX-style json writer.
+ */
+class JsonStreamWriter {
+private:
+  std::ostream &os;
+  /// One entry per open object or array, true if no element was written yet
+  std::vector<bool> first;
+  bool after_key = false;
+
+  void separate();
+  void writeString(const std::string &s);
+
+public:
+  explicit JsonStreamWriter(std::ostream &os);
+  ~JsonStreamWriter();
+  JsonStreamWriter(const JsonStreamWriter &) = delete;
+  JsonStreamWriter &operator=(const JsonStreamWriter &) = delete;
+
+  void beginObject();
+  void endObject();
+  void beginArray();
+  void endArray();
+  void key(const std::string &k);
+  void value(const std::string &v);
+  void value(const char *v);
+  void value(std::int64_t v);
+  void value(bool v);
+  void null();
+};
+
+/**
+ * Writes analysis results in a compact binary format. Results are records of
+ * dictionary IDs for the node, the data-flow fact and the value. The strings
+ * the IDs stand for are written as separate symbol records, so that producers
+ * can render every distinct node, fact or value only once and only if string
+ * output is wanted at all. The node IDs are up to the producer; phasar uses
+ * the psr.id annotations of the instructions, which identify the nodes
+ * without the symbol records.
+ *
+ * The format is a 'PSRR' magic followed by a little-endian uint32 version and
+ * a sequence of records, each introduced by a one-byte tag:
+ *
+ *    'A' <string>              begins the results of an analysis
+ *    'R' <u32> <u32> <u32>     result: node, fact, value
+ *    'S' <u8> <u32> <string>   symbol: kind, id, text
+ *
+ * where <string> is a uint32 length followed by the raw bytes.
+ *
+ * @brief Streaming writer for binary analysis results.
+ */
+class BinaryResultWriter {
+public:
+  enum class SymbolKind : std::uint8_t { Node = 0, Fact = 1, Value = 2 };
+  static const std::uint32_t Version = 1;
+
+private:
+  std::ostream &os;
+
+  void writeU32(std::uint32_t v);
+  void writeString(const std::string &s);
+
+public:
+  explicit BinaryResultWriter(std::ostream &os);
+  BinaryResultWriter(const BinaryResultWriter &) = delete;
+  BinaryResultWriter &operator=(const BinaryResultWriter &) = delete;
+
+  void beginAnalysis(const std::string &Name);
+  void addResult(std::uint32_t Node, std::uint32_t Fact, std::uint32_t Value);
+  void addSymbol(SymbolKind Kind, std::uint32_t ID, const std::string &Text);
+};
+
+/**
+ * Streams the edges of an exploded super-graph to disk while it is being
+ * constructed, such that they do not have to be kept in memory. Nodes and
+ * facts are referred to by dictionary IDs whose strings are written as
+ * symbol records on first use.
+ *
+ * The format is a 'PSRE' magic followed by a little-endian uint32 version and
+ * a sequence of records, each introduced by a one-byte tag:
+ *
+ *    'E' <u8> <var> <var> <var> <var> <var>*   edges: kind (0 intra-, 1
+ *                                              inter-procedural), source
+ *                                              node, target node, source
+ *                                              fact, number of target facts,
+ *                                              target facts
+ *    'S' <u8> <var> <string>                   symbol: kind, id, text
+ *
+ * where <var> is an unsigned LEB128 number and <string> a <var> length
+ * followed by the raw bytes. The same edge may be logged more than once.
+ *
+ * @brief Streaming writer for binary exploded super-graph edges.
+ */
+class BinaryEdgeLogWriter {
+public:
+  using SymbolKind = BinaryResultWriter::SymbolKind;
+  static const std::uint32_t Version = 1;
+
+private:
+  std::ostream &os;
+
+  void writeVar(std::uint64_t v);
+  void writeString(const std::string &s);
+
+public:
+  explicit BinaryEdgeLogWriter(std::ostream &os);
+  BinaryEdgeLogWriter(const BinaryEdgeLogWriter &) = delete;
+  BinaryEdgeLogWriter &operator=(const BinaryEdgeLogWriter &) = delete;
+
+  void addEdges(bool Inter, std::uint32_t Source, std::uint32_t Target,
+                std::uint32_t SourceFact,
+                const std::vector<std::uint32_t> &TargetFacts);
+  void addSymbol(SymbolKind Kind, std::uint32_t ID, const std::string &Text);
+};
+
+} // namespace psr
+
+#endif
@@ -198,6 +198,11 @@ public:
     return table;
   }
 
+  const std::unordered_map<R, std::unordered_map<C, V>> &rowMapView() const {
+    // Returns a read-only reference to the rows, no copy is made.
+    return table;
+  }
+
   std::multiset<V> values() {
     // Returns a collection of all values, which may contain duplicates.
     std::multiset<V> s;
@@ -7,9 +7,14 @@
  *     Philipp Schubert and others
  *****************************************************************************/
 
+#include <chrono>
+#include <condition_variable>
+#include <exception>
 #include <fstream>
 #include <iostream>
 
+#include <unistd.h>
+
 #include <llvm/Analysis/AliasAnalysis.h>
 #include <llvm/Analysis/CFLSteensAliasAnalysis.h>
 #include <llvm/IR/IRBuilder.h>
@@ -20,6 +25,7 @@
 #include <llvm/Transforms/Scalar.h>
 
 #include <phasar/Controller/AnalysisController.h>
+#include <phasar/DB/GraphSnapshot.h>
 #include <phasar/DB/ProjectIRDB.h>
 #include <phasar/PhasarLLVM/ControlFlow/LLVMBasedCFG.h>
 #include <phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h>
@@ -48,6 +54,10 @@
 #include <phasar/PhasarLLVM/Plugins/PluginFactories.h>
 #include <phasar/PhasarLLVM/Pointer/LLVMTypeHierarchy.h>
 #include <phasar/PhasarLLVM/Pointer/VTable.h>
+#include <phasar/PhasarLLVM/SyncPDS/Solver/SyncPDSSolver.h>
+#include <phasar/Utils/LLVMShorthands.h>
+#include <phasar/Utils/Parallel.h>
+#include <phasar/Utils/ResultWriter.h>
 
 using namespace std;
 using namespace psr;
@@ -55,21 +65,581 @@ using namespace psr;
 namespace psr {
 
 const std::map<std::string, ExportType> StringToExportType = {
-    {"json", ExportType::JSON}};
+    {"json", ExportType::JSON}, {"binary", ExportType::BINARY}};
 
 const std::map<ExportType, std::string> ExportTypeToString = {
-    {ExportType::JSON, "json"}};
+    {ExportType::JSON, "json"}, {ExportType::BINARY, "binary"}};
 
 std::ostream &operator<<(std::ostream &os, const ExportType &E) {
   return os << ExportTypeToString.at(E);
 }
 
+/**
+ * Returns the psr.id annotation of an instruction, which keys its results in
+ * the binary export.
+ */
+static uint32_t annotationID(const llvm::Instruction *I) {
+  string ID = getMetaDataID(I);
+  if (ID == "-1") {
+    throw runtime_error("instruction without psr.id: " + llvmIRToString(I));
+  }
+  return stoul(ID);
+}
+
+template <typename SolverT>
+void AnalysisController::emitResults(SolverT &Solver,
+                                     DataFlowAnalysisType Analysis) {
+  lock_guard<mutex> Lock(ResultsMutex);
+  if (JsonResults && TagResults) {
+    JsonResults->beginObject();
+    JsonResults->key("Analysis");
+    JsonResults->value(DataFlowAnalysisTypeToString.at(Analysis));
+    JsonResults->key("Results");
+    Solver.emitResults(*JsonResults);
+    JsonResults->endObject();
+  } else if (JsonResults) {
+    Solver.emitResults(*JsonResults);
+  } else if (BinaryResults) {
+    BinaryResults->beginAnalysis(DataFlowAnalysisTypeToString.at(Analysis));
+    Solver.emitResults(*BinaryResults, ExportSymbols, annotationID);
+  }
+}
+
+template <typename SolverT>
+void AnalysisController::emitResults(SolverT &Solver,
+                                     DataFlowAnalysisType Analysis,
+                                     const string &EntryPoint, long Runtime) {
+  lock_guard<mutex> Lock(ResultsMutex);
+  if (JsonResults) {
+    JsonResults->beginObject();
+    JsonResults->key("Analysis");
+    JsonResults->value(DataFlowAnalysisTypeToString.at(Analysis));
+    JsonResults->key("EntryPoint");
+    JsonResults->value(EntryPoint);
+    JsonResults->key("Runtime (ms)");
+    JsonResults->value(static_cast<int64_t>(Runtime));
+    JsonResults->key("Results");
+    Solver.emitResults(*JsonResults);
+    JsonResults->endObject();
+  } else if (BinaryResults) {
+    BinaryResults->beginAnalysis(DataFlowAnalysisTypeToString.at(Analysis) +
+                                 "@" + EntryPoint);
+    Solver.emitResults(*BinaryResults, ExportSymbols, annotationID);
+  }
+}
+
+template <typename SolverT>
+void AnalysisController::solveIncrementally(SolverT &Solver,
+                                            DataFlowAnalysisType Analysis,
+                                            ProjectIRDB &IRDB) {
+  auto &lg = lg::get();
+  if (IncrementalPrefix.empty()) {
+    Solver.solve();
+    return;
+  }
+  string StatePath = IncrementalPrefix + "." +
+                     DataFlowAnalysisTypeToString.at(Analysis) + ".state";
+  if (ifstream(StatePath).good()) {
+    auto ChangedFunctions = Solver.restoreState(StatePath, IRDB);
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
+                  << "Restored the solver state " << StatePath
+                  << ", updating " << ChangedFunctions.size()
+                  << " changed function(s)");
+    Solver.update(ChangedFunctions);
+  } else {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
+                  << "No solver state " << StatePath
+                  << " yet, solving from scratch");
+    Solver.solve();
+  }
+  Solver.saveState(StatePath, IRDB);
+}
+
+template <typename SolverT, typename MakeProblemT>
+void AnalysisController::solvePerEntryPoint(DataFlowAnalysisType Analysis,
+                                            const vector<string> &EntryPoints,
+                                            MakeProblemT MakeProblem,
+                                            unsigned Threads,
+                                            const string &EdgeLogPrefix) {
+  auto &lg = lg::get();
+  // The problems are constructed up front and outlive all solvers, as the
+  // shared flow and edge functions may refer to the problem that built them.
+  vector<decltype(MakeProblem(EntryPoints))> Problems;
+  for (auto &EntryPoint : EntryPoints) {
+    Problems.push_back(MakeProblem({EntryPoint}));
+    Problems.back()->solver_config.collectFinishedMethods =
+        CollectFinishedMethods;
+    if (!EdgeLogPrefix.empty()) {
+      Problems.back()->solver_config.edgeLogFile =
+          EdgeLogPrefix + "." + EntryPoint + ".edges";
+    }
+  }
+  shared_ptr<typename SolverT::FlowEdgeFunctionStore> Store;
+  if (!Problems.empty() &&
+      Problems.front()->solver_config.shareFlowEdgeFunctions) {
+    Store = make_shared<typename SolverT::FlowEdgeFunctionStore>();
+  }
+  parallelForEach(Problems.size(), Threads, [&](size_t i) {
+    auto Start = chrono::steady_clock::now();
+    SolverT Solver(*Problems[i], false, false);
+    if (Store) {
+      Solver.shareFlowEdgeFunctions(Store);
+    }
+    // report the statistics of each entry point separately
+    Solver.setStatisticsScope(DataFlowAnalysisTypeToString.at(Analysis) + "@" +
+                              EntryPoints[i] + " ");
+    Solver.solve();
+    long Runtime = chrono::duration_cast<chrono::milliseconds>(
+                       chrono::steady_clock::now() - Start)
+                       .count();
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
+                  << "Solved " << Analysis << " for entry point '"
+                  << EntryPoints[i] << "' in " << Runtime << " ms");
+    emitResults(Solver, Analysis, EntryPoints[i], Runtime);
+  });
+}
+
+bool AnalysisController::fanOut(DataFlowAnalysisType Analysis,
+                                LLVMBasedICFG &ICFG, LLVMTypeHierarchy &CH,
+                                ProjectIRDB &IRDB,
+                                const vector<string> &EntryPoints,
+                                unsigned Threads,
+                                const string &EdgeLogPrefix) {
+  switch (Analysis) {
+  case DataFlowAnalysisType::IFDS_TaintAnalysis: {
+    TaintSensitiveFunctions TSF;
+    if (VariablesMap["swift"].as<bool>()) {
+      TSF.importSourceSinkFunctions(DefaultSourceSinkFunctionsPath);
+    }
+    // the oracles cache their results and are not shared between the solver
+    // threads, each problem gets one of its own that outlives all solvers
+    vector<unique_ptr<AliasOracle>> Oracles;
+    solvePerEntryPoint<LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &>>(
+        Analysis, EntryPoints,
+        [&](vector<string> EPs) {
+          auto Problem =
+              make_unique<IFDSTaintAnalysis>(ICFG, CH, IRDB, TSF, EPs);
+          if (auto Oracle = makeAliasOracle(ICFG)) {
+            Problem->setAliasOracle(*Oracle);
+            Oracles.push_back(move(Oracle));
+          }
+          return Problem;
+        },
+        Threads, EdgeLogPrefix);
+    return true;
+  }
+  case DataFlowAnalysisType::IDE_TaintAnalysis:
+    solvePerEntryPoint<LLVMIDESolver<const llvm::Value *, const llvm::Value *,
+                                     LLVMBasedICFG &>>(
+        Analysis, EntryPoints,
+        [&](vector<string> EPs) {
+          return make_unique<IDETaintAnalysis>(ICFG, CH, IRDB, EPs);
+        },
+        Threads, EdgeLogPrefix);
+    return true;
+  case DataFlowAnalysisType::IDE_TypeStateAnalysis: {
+    vector<unique_ptr<AliasOracle>> Oracles;
+    solvePerEntryPoint<
+        LLVMIDESolver<const llvm::Value *, State, LLVMBasedICFG &>>(
+        Analysis, EntryPoints,
+        [&](vector<string> EPs) {
+          auto Problem = make_unique<IDETypeStateAnalysis>(
+              ICFG, CH, IRDB, "struct._IO_FILE", EPs);
+          if (auto Oracle = makeAliasOracle(ICFG)) {
+            Problem->setAliasOracle(*Oracle);
+            Oracles.push_back(move(Oracle));
+          }
+          return Problem;
+        },
+        Threads, EdgeLogPrefix);
+    return true;
+  }
+  case DataFlowAnalysisType::IFDS_TypeAnalysis:
+    solvePerEntryPoint<LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &>>(
+        Analysis, EntryPoints,
+        [&](vector<string> EPs) {
+          return make_unique<IFDSTypeAnalysis>(ICFG, CH, IRDB, EPs);
+        },
+        Threads, EdgeLogPrefix);
+    return true;
+  case DataFlowAnalysisType::IFDS_UninitializedVariables:
+    solvePerEntryPoint<LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &>>(
+        Analysis, EntryPoints,
+        [&](vector<string> EPs) {
+          return make_unique<IFDSUnitializedVariables>(ICFG, CH, IRDB, EPs);
+        },
+        Threads, EdgeLogPrefix);
+    return true;
+  case DataFlowAnalysisType::IFDS_LinearConstantAnalysis:
+    solvePerEntryPoint<LLVMIFDSSolver<LCAPair, LLVMBasedICFG &>>(
+        Analysis, EntryPoints,
+        [&](vector<string> EPs) {
+          return make_unique<IFDSLinearConstantAnalysis>(ICFG, CH, IRDB, EPs);
+        },
+        Threads, EdgeLogPrefix);
+    return true;
+  case DataFlowAnalysisType::IDE_LinearConstantAnalysis:
+    solvePerEntryPoint<
+        LLVMIDESolver<const llvm::Value *, int64_t, LLVMBasedICFG &>>(
+        Analysis, EntryPoints,
+        [&](vector<string> EPs) {
+          return make_unique<IDELinearConstantAnalysis>(ICFG, CH, IRDB, EPs);
+        },
+        Threads, EdgeLogPrefix);
+    return true;
+  case DataFlowAnalysisType::IFDS_ConstAnalysis:
+    solvePerEntryPoint<LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &>>(
+        Analysis, EntryPoints,
+        [&](vector<string> EPs) {
+          return make_unique<IFDSConstAnalysis>(
+              ICFG, CH, IRDB, IRDB.getAllMemoryLocations(), EPs);
+        },
+        Threads, EdgeLogPrefix);
+    return true;
+  case DataFlowAnalysisType::IFDS_SolverTest:
+    solvePerEntryPoint<LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &>>(
+        Analysis, EntryPoints,
+        [&](vector<string> EPs) {
+          return make_unique<IFDSSolverTest>(ICFG, CH, IRDB, EPs);
+        },
+        Threads, EdgeLogPrefix);
+    return true;
+  case DataFlowAnalysisType::IDE_SolverTest:
+    solvePerEntryPoint<LLVMIDESolver<const llvm::Value *, const llvm::Value *,
+                                     LLVMBasedICFG &>>(
+        Analysis, EntryPoints,
+        [&](vector<string> EPs) {
+          return make_unique<IDESolverTest>(ICFG, CH, IRDB, EPs);
+        },
+        Threads, EdgeLogPrefix);
+    return true;
+  default:
+    // the monotone and plugin analyses are solved as usual
+    return false;
+  }
+}
+
+long AnalysisController::residentSetSize() {
+  ifstream Statm("/proc/self/statm");
+  long Pages, Resident;
+  if (!(Statm >> Pages >> Resident)) {
+    return -1;
+  }
+  return Resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+void AnalysisController::scheduleAnalyses(
+    const vector<DataFlowAnalysisType> &Analyses, unsigned ParallelAnalyses,
+    long MemoryBudget, const function<void(DataFlowAnalysisType)> &Run,
+    const function<long()> &ResidentSetSize) {
+  auto &lg = lg::get();
+  mutex Mtx;
+  condition_variable Finished;
+  size_t Running = 0;
+  parallelForEach(Analyses.size(), ParallelAnalyses, [&](size_t i) {
+    {
+      unique_lock<mutex> Lock(Mtx);
+      // an analysis is only started within the memory budget, unless no
+      // other analysis is running that could free memory
+      while (Running > 0 && MemoryBudget > 0 &&
+             ResidentSetSize() > MemoryBudget) {
+        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
+                      << "Memory budget exceeded, delaying analysis: "
+                      << Analyses[i]);
+        Finished.wait_for(Lock, chrono::milliseconds(100));
+      }
+      ++Running;
+    }
+    exception_ptr Error;
+    try {
+      Run(Analyses[i]);
+    } catch (...) {
+      Error = current_exception();
+    }
+    {
+      lock_guard<mutex> Lock(Mtx);
+      --Running;
+    }
+    Finished.notify_all();
+    if (Error) {
+      rethrow_exception(Error);
+    }
+  });
+}
+
+unique_ptr<AliasOracle>
+AnalysisController::makeAliasOracle(LLVMBasedICFG &ICFG) const {
+  if (!DemandDrivenAliases) {
+    return nullptr;
+  }
+  return make_unique<SyncPDSSolver>(ICFG);
+}
+
+string
+AnalysisController::statisticsScope(DataFlowAnalysisType Analysis) const {
+  return TagResults ? DataFlowAnalysisTypeToString.at(Analysis) + " " : "";
+}
+
+void AnalysisController::runAnalysis(DataFlowAnalysisType analysis,
+                                     LLVMBasedICFG &ICFG, LLVMTypeHierarchy &CH,
+                                     ProjectIRDB &IRDB, LLVMBasedCFG &CFG,
+                                     const vector<string> &EntryPoints,
+                                     const string &EdgeLogPrefix) {
+  auto &lg = lg::get();
+  // the exploded super-graph is streamed to disk if requested
+  string EdgeLogFile = EdgeLogPrefix.empty() ? "" : EdgeLogPrefix + ".edges";
+  // every entry point is analyzed on its own if requested
+  if (VariablesMap.count("fan-out") && VariablesMap["fan-out"].as<bool>() &&
+      fanOut(analysis, ICFG, CH, IRDB, EntryPoints,
+             VariablesMap.count("jobs") ? VariablesMap["jobs"].as<unsigned>()
+                                        : 0,
+             EdgeLogPrefix)) {
+    return;
+  }
+  // the solver state can only be stored for IFDS problems over LLVM values
+  // whose flow functions do not record anything while being solved
+  if (!IncrementalPrefix.empty() &&
+      analysis != DataFlowAnalysisType::IFDS_TypeAnalysis &&
+      analysis != DataFlowAnalysisType::IFDS_SolverTest) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
+                  << "Incremental solving is not supported by " << analysis
+                  << ", solving from scratch");
+  }
+  switch (analysis) {
+  case DataFlowAnalysisType::IFDS_TaintAnalysis: {
+    TaintSensitiveFunctions TSF;
+    if (VariablesMap["swift"].as<bool>())
+    {
+      //try {
+        TSF.importSourceSinkFunctions(DefaultSourceSinkFunctionsPath);
+      /*} catch (std::exception e)
+      {
+        cout << "Config source/sink file not found: " << DefaultSourceSinkFunctionsPath << endl;
+        cout << "IFDS Taint Analysis ended" << endl;
+        break;
+      }*/
+    }
+    IFDSTaintAnalysis TaintAnalysisProblem(ICFG, CH, IRDB, TSF,
+                                           EntryPoints);
+    auto Aliases = makeAliasOracle(ICFG);
+    if (Aliases) {
+      TaintAnalysisProblem.setAliasOracle(*Aliases);
+    }
+    TaintAnalysisProblem.solver_config.edgeLogFile = EdgeLogFile;
+    TaintAnalysisProblem.solver_config.collectFinishedMethods =
+        CollectFinishedMethods;
+    // the leaks are reported while the contexts are explored, the values are
+    // only computed if the contexts are kept, see collectFinishedMethods
+    TaintAnalysisProblem.solver_config.computeValues = !CollectFinishedMethods;
+    LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> LLVMTaintSolver(
+        TaintAnalysisProblem, false);
+    cout << "IFDS Taint Analysis ..." << endl;
+    LLVMTaintSolver.setStatisticsScope(statisticsScope(analysis));
+    LLVMTaintSolver.solve();
+    cout << "IFDS Taint Analysis ended" << endl;
+    // FinalResultsJson += LLVMTaintSolver.getAsJson();
+    break;
+  }
+  case DataFlowAnalysisType::IDE_TaintAnalysis: {
+    IDETaintAnalysis taintanalysisproblem(ICFG, CH, IRDB, EntryPoints);
+    taintanalysisproblem.solver_config.edgeLogFile = EdgeLogFile;
+    taintanalysisproblem.solver_config.collectFinishedMethods =
+        CollectFinishedMethods;
+    LLVMIDESolver<const llvm::Value *, const llvm::Value *, LLVMBasedICFG &>
+        llvmtaintsolver(taintanalysisproblem, true);
+    llvmtaintsolver.setStatisticsScope(statisticsScope(analysis));
+    llvmtaintsolver.solve();
+    emitResults(llvmtaintsolver, analysis);
+    break;
+  }
+  case DataFlowAnalysisType::IDE_TypeStateAnalysis: {
+    IDETypeStateAnalysis typestateproblem(ICFG, CH, IRDB, "struct._IO_FILE",
+                                          EntryPoints);
+    auto Aliases = makeAliasOracle(ICFG);
+    if (Aliases) {
+      typestateproblem.setAliasOracle(*Aliases);
+    }
+    typestateproblem.solver_config.edgeLogFile = EdgeLogFile;
+    typestateproblem.solver_config.collectFinishedMethods =
+        CollectFinishedMethods;
+    LLVMIDESolver<const llvm::Value *, State, LLVMBasedICFG &>
+        llvmtypestatesolver(typestateproblem, true);
+    llvmtypestatesolver.setStatisticsScope(statisticsScope(analysis));
+    llvmtypestatesolver.solve();
+    emitResults(llvmtypestatesolver, analysis);
+    break;
+  }
+  case DataFlowAnalysisType::IFDS_TypeAnalysis: {
+    IFDSTypeAnalysis typeanalysisproblem(ICFG, CH, IRDB, EntryPoints);
+    typeanalysisproblem.solver_config.edgeLogFile = EdgeLogFile;
+    typeanalysisproblem.solver_config.collectFinishedMethods =
+        CollectFinishedMethods;
+    typeanalysisproblem.solver_config.incremental = !IncrementalPrefix.empty();
+    LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> llvmtypesolver(
+        typeanalysisproblem, true);
+    llvmtypesolver.setStatisticsScope(statisticsScope(analysis));
+    solveIncrementally(llvmtypesolver, analysis, IRDB);
+    emitResults(llvmtypesolver, analysis);
+    break;
+  }
+  case DataFlowAnalysisType::IFDS_UninitializedVariables: {
+    IFDSUnitializedVariables uninitializedvarproblem(ICFG, CH, IRDB,
+                                                     EntryPoints);
+    uninitializedvarproblem.solver_config.edgeLogFile = EdgeLogFile;
+    uninitializedvarproblem.solver_config.collectFinishedMethods =
+        CollectFinishedMethods;
+    LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> llvmunivsolver(
+        uninitializedvarproblem, false);
+    cout << "IFDS UninitVar Analysis ..." << endl;
+    llvmunivsolver.setStatisticsScope(statisticsScope(analysis));
+    llvmunivsolver.solve();
+    cout << "IFDS UninitVar Analysis ended" << endl;
+    // FinalResultsJson += llvmunivsolver.getAsJson();
+    break;
+  }
+  case DataFlowAnalysisType::IFDS_LinearConstantAnalysis: {
+    IFDSLinearConstantAnalysis lcaproblem(ICFG, CH, IRDB, EntryPoints);
+    lcaproblem.solver_config.edgeLogFile = EdgeLogFile;
+    lcaproblem.solver_config.collectFinishedMethods =
+        CollectFinishedMethods;
+    LLVMIFDSSolver<LCAPair, LLVMBasedICFG &> llvmlcasolver(lcaproblem,
+                                                           true);
+    llvmlcasolver.setStatisticsScope(statisticsScope(analysis));
+    llvmlcasolver.solve();
+    emitResults(llvmlcasolver, analysis);
+    break;
+  }
+  case DataFlowAnalysisType::IDE_LinearConstantAnalysis: {
+    IDELinearConstantAnalysis lcaproblem(ICFG, CH, IRDB, EntryPoints);
+    lcaproblem.solver_config.edgeLogFile = EdgeLogFile;
+    lcaproblem.solver_config.collectFinishedMethods =
+        CollectFinishedMethods;
+    LLVMIDESolver<const llvm::Value *, int64_t, LLVMBasedICFG &>
+        llvmlcasolver(lcaproblem, true);
+    llvmlcasolver.setStatisticsScope(statisticsScope(analysis));
+    llvmlcasolver.solve();
+    emitResults(llvmlcasolver, analysis);
+    break;
+  }
+  case DataFlowAnalysisType::IFDS_ConstAnalysis: {
+    IFDSConstAnalysis constproblem(
+        ICFG, CH, IRDB, IRDB.getAllMemoryLocations(), EntryPoints);
+    constproblem.solver_config.edgeLogFile = EdgeLogFile;
+    constproblem.solver_config.collectFinishedMethods =
+        CollectFinishedMethods;
+    LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> llvmconstsolver(
+        constproblem, true);
+    llvmconstsolver.setStatisticsScope(statisticsScope(analysis));
+    llvmconstsolver.solve();
+    emitResults(llvmconstsolver, analysis);
+    break;
+  }
+  case DataFlowAnalysisType::IFDS_SolverTest: {
+    IFDSSolverTest ifdstest(ICFG, CH, IRDB, EntryPoints);
+    ifdstest.solver_config.edgeLogFile = EdgeLogFile;
+    ifdstest.solver_config.collectFinishedMethods =
+        CollectFinishedMethods;
+    ifdstest.solver_config.incremental = !IncrementalPrefix.empty();
+    LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> llvmifdstestsolver(
+        ifdstest, false);
+    cout << "IFDS Solvertest ..." << endl;
+    llvmifdstestsolver.setStatisticsScope(statisticsScope(analysis));
+    solveIncrementally(llvmifdstestsolver, analysis, IRDB);
+    cout << "IFDS Solvertest ended" << endl;
+    // FinalResultsJson += llvmifdstestsolver.getAsJson();
+    break;
+  }
+  case DataFlowAnalysisType::IDE_SolverTest: {
+    IDESolverTest idetest(ICFG, CH, IRDB, EntryPoints);
+    idetest.solver_config.edgeLogFile = EdgeLogFile;
+    idetest.solver_config.collectFinishedMethods =
+        CollectFinishedMethods;
+    LLVMIDESolver<const llvm::Value *, const llvm::Value *, LLVMBasedICFG &>
+        llvmidetestsolver(idetest, true);
+    llvmidetestsolver.setStatisticsScope(statisticsScope(analysis));
+    llvmidetestsolver.solve();
+    emitResults(llvmidetestsolver, analysis);
+    break;
+  }
+  case DataFlowAnalysisType::Intra_Mono_FullConstantPropagation: {
+    const llvm::Function *F = IRDB.getFunction(EntryPoints.front());
+    IntraMonoFullConstantPropagation intra(CFG, F);
+    LLVMIntraMonoSolver<pair<const llvm::Value *, unsigned>, LLVMBasedCFG &>
+        solver(intra, true);
+    solver.solve();
+    break;
+  }
+  case DataFlowAnalysisType::Intra_Mono_SolverTest: {
+    const llvm::Function *F = IRDB.getFunction(EntryPoints.front());
+    IntraMonoSolverTest intra(CFG, F);
+    LLVMIntraMonoSolver<const llvm::Value *, LLVMBasedCFG &> solver(intra,
+                                                                    true);
+    solver.solve();
+    break;
+  }
+  case DataFlowAnalysisType::Inter_Mono_SolverTest: {
+    const llvm::Function *F = IRDB.getFunction(EntryPoints.front());
+    InterMonoSolverTest inter(ICFG, EntryPoints);
+    CallString<typename InterMonoSolverTest::Node_t,
+               typename InterMonoSolverTest::Domain_t, 3>
+        Context(&inter, &inter);
+    auto solver = make_LLVMBasedIMS(inter, Context, F, true);
+    solver->solve();
+    break;
+  }
+  case DataFlowAnalysisType::Inter_Mono_TaintAnalysis: {
+    const llvm::Function *F = IRDB.getFunction(EntryPoints.front());
+    InterMonoTaintAnalysis inter(ICFG, EntryPoints);
+    CallString<typename InterMonoTaintAnalysis::Node_t,
+               typename InterMonoTaintAnalysis::Domain_t, 10>
+        Context(&inter, &inter);
+    auto solver = make_LLVMBasedIMS(inter, Context, F, true);
+    solver->solve();
+    solver->dumpResults();
+    break;
+  }
+  case DataFlowAnalysisType::Plugin: {
+    vector<string> AnalysisPlugins =
+        VariablesMap["analysis-plugin"].as<vector<string>>();
+#ifdef PHASAR_PLUGINS_ENABLED
+    AnalysisPluginController PluginController(
+        AnalysisPlugins, ICFG, EntryPoints,
+        [this](LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &>
+                   &Solver) {
+          emitResults(Solver, DataFlowAnalysisType::Plugin);
+        });
+#endif
+    break;
+  }
+  case DataFlowAnalysisType::None: {
+    break;
+  }
+  default:
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, CRITICAL)
+                  << "The analysis it not valid");
+    break;
+  }
+}
+
 AnalysisController::AnalysisController(
     ProjectIRDB &&IRDB, std::vector<DataFlowAnalysisType> Analyses,
-    bool WPA_MODE, bool PrintEdgeRecorder, std::string graph_id)
-    : FinalResultsJson() {
+    bool WPA_MODE, bool PrintEdgeRecorder, std::string graph_id,
+    std::string ResultsFile, ExportType Export) {
   PAMM_GET_INSTANCE;
   auto &lg = lg::get();
+  if (!ResultsFile.empty()) {
+    if (Export == ExportType::BINARY) {
+      ResultsStream.open(ResultsFile, ios::out | ios::binary);
+      BinaryResults.reset(new BinaryResultWriter(ResultsStream));
+    } else {
+      ResultsStream.open(ResultsFile);
+      JsonResults.reset(new JsonStreamWriter(ResultsStream));
+      JsonResults->beginArray();
+    }
+    if (!ResultsStream) {
+      throw runtime_error("could not open results file: " + ResultsFile);
+    }
+  }
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
                 << "Constructed the analysis controller.");
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
@@ -99,6 +669,8 @@ AnalysisController::AnalysisController(
       EntryPoints = VariablesMap["entry-points"].as<vector<string>>();
     }
   }
+  // bitcode loaded lazily: read only the function bodies that may be reached
+  IRDB.materializeReachable(EntryPoints);
   if (WPA_MODE) {
     // here we link every llvm module into a single module containing the entire
     // IR
@@ -120,10 +692,40 @@ AnalysisController::AnalysisController(
   // START_TIMER("DB Store IRDB", PAMM_SEVERITY_LEVEL::Full);
   // db.storeProjectIRDB("myphasarproject", IRDB);
   // STOP_TIMER("DB Store IRDB", PAMM_SEVERITY_LEVEL::Full);
+  // Call graph construction stategy
+  CallGraphAnalysisType CGType(
+      (VariablesMap.count("callgraph-analysis"))
+          ? StringToCallGraphAnalysisType.at(
+                VariablesMap["callgraph-analysis"].as<string>())
+          : CallGraphAnalysisType::OTF);
+  // The class hierarchy and the call graph of the whole program are restored
+  // from a snapshot if one has been taken of the very same module
+  string SnapshotPath = VariablesMap.count("snapshot")
+                            ? VariablesMap["snapshot"].as<string>()
+                            : "";
+  unique_ptr<GraphSnapshot> Snapshot;
+  IncrementalPrefix = VariablesMap.count("incremental")
+                          ? VariablesMap["incremental"].as<string>()
+                          : "";
+  CollectFinishedMethods = VariablesMap.count("release-finished") &&
+                           VariablesMap["release-finished"].as<bool>();
+  DemandDrivenAliases = VariablesMap.count("demand-aliases") &&
+                        VariablesMap["demand-aliases"].as<bool>();
+  ExportSymbols = !VariablesMap.count("export-symbols") ||
+                  VariablesMap["export-symbols"].as<bool>();
+  if (WPA_MODE && !SnapshotPath.empty()) {
+    START_TIMER("Snapshot Load", PAMM_SEVERITY_LEVEL::Core);
+    Snapshot = GraphSnapshot::load(SnapshotPath, *IRDB.getWPAModule(), CGType,
+                                   EntryPoints);
+    STOP_TIMER("Snapshot Load", PAMM_SEVERITY_LEVEL::Core);
+  }
   // Reconstruct the inter-modular class hierarchy and virtual function tables
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO) << "Reconstruct the class hierarchy.");
   START_TIMER("CH Construction", PAMM_SEVERITY_LEVEL::Core);
-  LLVMTypeHierarchy CH(IRDB);
+  unique_ptr<LLVMTypeHierarchy> CHPtr =
+      Snapshot ? Snapshot->getTypeHierarchy()
+               : make_unique<LLVMTypeHierarchy>(IRDB);
+  LLVMTypeHierarchy &CH = *CHPtr;
   STOP_TIMER("CH Construction", PAMM_SEVERITY_LEVEL::Core);
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
                 << "Reconstruction of class hierarchy completed.");
@@ -157,16 +759,17 @@ AnalysisController::AnalysisController(
   //   CH.printAsDot("ch.dot");
   // }
 
-  // Call graph construction stategy
-  CallGraphAnalysisType CGType(
-      (VariablesMap.count("callgraph-analysis"))
-          ? StringToCallGraphAnalysisType.at(
-                VariablesMap["callgraph-analysis"].as<string>())
-          : CallGraphAnalysisType::OTF);
   // Perform whole program analysis (WPA) analysis
   if (WPA_MODE) {
     START_TIMER("CG Construction", PAMM_SEVERITY_LEVEL::Core);
-    LLVMBasedICFG ICFG(CH, IRDB, CGType, EntryPoints);
+    unique_ptr<LLVMBasedICFG> ICFGPtr =
+        Snapshot ? Snapshot->getICFG(CH, IRDB)
+                 : make_unique<LLVMBasedICFG>(CH, IRDB, CGType, EntryPoints);
+    LLVMBasedICFG &ICFG = *ICFGPtr;
+    if (!Snapshot && !SnapshotPath.empty()) {
+      GraphSnapshot::store(SnapshotPath, *IRDB.getWPAModule(), CH, ICFG,
+                           EntryPoints);
+    }
 
     if (VariablesMap.count("callgraph-plugin")) {
       throw runtime_error("callgraph plugin not found");
@@ -187,201 +790,41 @@ AnalysisController::AnalysisController(
     // }
     // CFG is only needed for intra-procedural monotone framework
     LLVMBasedCFG CFG;
+    unsigned ParallelAnalyses =
+        VariablesMap.count("parallel-analyses")
+            ? VariablesMap["parallel-analyses"].as<unsigned>()
+            : 1;
+    long MemoryBudget =
+        VariablesMap.count("memory-budget")
+            ? static_cast<long>(VariablesMap["memory-budget"].as<unsigned>()) *
+                  1024
+            : 0;
+    // the order of the results no longer tells the analyses apart
+    TagResults = ParallelAnalyses != 1;
     START_TIMER("DFA Runtime", PAMM_SEVERITY_LEVEL::Core);
     /*
      * Perform all the analysis that the user has chosen.
      */
-    for (DataFlowAnalysisType analysis : Analyses) {
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
-                    << "Performing analysis: " << analysis);
-      switch (analysis) {
-      case DataFlowAnalysisType::IFDS_TaintAnalysis: {
-        TaintSensitiveFunctions TSF;
-        if (VariablesMap["swift"].as<bool>())
-        {
-          //try {
-            TSF.importSourceSinkFunctions(DefaultSourceSinkFunctionsPath);
-          /*} catch (std::exception e)
+    scheduleAnalyses(
+        Analyses, ParallelAnalyses, MemoryBudget,
+        [&](DataFlowAnalysisType analysis) {
+          LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
+                        << "Performing analysis: " << analysis);
+          string EdgeLogPrefix;
+          if (PrintEdgeRecorder) {
+            EdgeLogPrefix = (ResultsFile.empty() ? "phasar" : ResultsFile) +
+                            "." + DataFlowAnalysisTypeToString.at(analysis);
+          }
           {
-            cout << "Config source/sink file not found: " << DefaultSourceSinkFunctionsPath << endl;
-            cout << "IFDS Taint Analysis ended" << endl;
-            break;
-          }*/
-        }
-        IFDSTaintAnalysis TaintAnalysisProblem(ICFG, CH, IRDB, TSF,
-                                               EntryPoints);
-        LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> LLVMTaintSolver(
-            TaintAnalysisProblem, false);
-        cout << "IFDS Taint Analysis ..." << endl;
-        LLVMTaintSolver.solve();
-        cout << "IFDS Taint Analysis ended" << endl;
-        // FinalResultsJson += LLVMTaintSolver.getAsJson();
-        if (PrintEdgeRecorder) {
-          LLVMTaintSolver.exportJson(graph_id);
-        }
-        break;
-      }
-      case DataFlowAnalysisType::IDE_TaintAnalysis: {
-        IDETaintAnalysis taintanalysisproblem(ICFG, CH, IRDB, EntryPoints);
-        LLVMIDESolver<const llvm::Value *, const llvm::Value *, LLVMBasedICFG &>
-            llvmtaintsolver(taintanalysisproblem, true);
-        llvmtaintsolver.solve();
-        FinalResultsJson += llvmtaintsolver.getAsJson();
-        if (PrintEdgeRecorder) {
-          llvmtaintsolver.exportJson(graph_id);
-        }
-        break;
-      }
-      case DataFlowAnalysisType::IDE_TypeStateAnalysis: {
-        IDETypeStateAnalysis typestateproblem(ICFG, CH, IRDB, "struct._IO_FILE",
-                                              EntryPoints);
-        LLVMIDESolver<const llvm::Value *, State, LLVMBasedICFG &>
-            llvmtypestatesolver(typestateproblem, true);
-        llvmtypestatesolver.solve();
-        FinalResultsJson += llvmtypestatesolver.getAsJson();
-        if (PrintEdgeRecorder) {
-          llvmtypestatesolver.exportJson(graph_id);
-        }
-        break;
-      }
-      case DataFlowAnalysisType::IFDS_TypeAnalysis: {
-        IFDSTypeAnalysis typeanalysisproblem(ICFG, CH, IRDB, EntryPoints);
-        LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> llvmtypesolver(
-            typeanalysisproblem, true);
-        llvmtypesolver.solve();
-        FinalResultsJson += llvmtypesolver.getAsJson();
-        if (PrintEdgeRecorder) {
-          llvmtypesolver.exportJson(graph_id);
-        }
-        break;
-      }
-      case DataFlowAnalysisType::IFDS_UninitializedVariables: {
-        IFDSUnitializedVariables uninitializedvarproblem(ICFG, CH, IRDB,
-                                                         EntryPoints);
-        LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> llvmunivsolver(
-            uninitializedvarproblem, false);
-        cout << "IFDS UninitVar Analysis ..." << endl;
-        llvmunivsolver.solve();
-        cout << "IFDS UninitVar Analysis ended" << endl;
-        // FinalResultsJson += llvmunivsolver.getAsJson();
-        if (PrintEdgeRecorder) {
-          llvmunivsolver.exportJson(graph_id);
-        }
-        break;
-      }
-      case DataFlowAnalysisType::IFDS_LinearConstantAnalysis: {
-        IFDSLinearConstantAnalysis lcaproblem(ICFG, CH, IRDB, EntryPoints);
-        LLVMIFDSSolver<LCAPair, LLVMBasedICFG &> llvmlcasolver(lcaproblem,
-                                                               true);
-        llvmlcasolver.solve();
-        FinalResultsJson += llvmlcasolver.getAsJson();
-        if (PrintEdgeRecorder) {
-          llvmlcasolver.exportJson(graph_id);
-        }
-        break;
-      }
-      case DataFlowAnalysisType::IDE_LinearConstantAnalysis: {
-        IDELinearConstantAnalysis lcaproblem(ICFG, CH, IRDB, EntryPoints);
-        LLVMIDESolver<const llvm::Value *, int64_t, LLVMBasedICFG &>
-            llvmlcasolver(lcaproblem, true);
-        llvmlcasolver.solve();
-        FinalResultsJson += llvmlcasolver.getAsJson();
-        if (PrintEdgeRecorder) {
-          llvmlcasolver.exportJson(graph_id);
-        }
-        break;
-      }
-      case DataFlowAnalysisType::IFDS_ConstAnalysis: {
-        IFDSConstAnalysis constproblem(
-            ICFG, CH, IRDB, IRDB.getAllMemoryLocations(), EntryPoints);
-        LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> llvmconstsolver(
-            constproblem, true);
-        llvmconstsolver.solve();
-        FinalResultsJson += llvmconstsolver.getAsJson();
-        if (PrintEdgeRecorder) {
-          llvmconstsolver.exportJson(graph_id);
-        }
-        break;
-      }
-      case DataFlowAnalysisType::IFDS_SolverTest: {
-        IFDSSolverTest ifdstest(ICFG, CH, IRDB, EntryPoints);
-        LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> llvmifdstestsolver(
-            ifdstest, false);
-        cout << "IFDS Solvertest ..." << endl;
-        llvmifdstestsolver.solve();
-        cout << "IFDS Solvertest ended" << endl;
-        // FinalResultsJson += llvmifdstestsolver.getAsJson();
-        if (PrintEdgeRecorder) {
-          llvmifdstestsolver.exportJson(graph_id);
-        }
-        break;
-      }
-      case DataFlowAnalysisType::IDE_SolverTest: {
-        IDESolverTest idetest(ICFG, CH, IRDB, EntryPoints);
-        LLVMIDESolver<const llvm::Value *, const llvm::Value *, LLVMBasedICFG &>
-            llvmidetestsolver(idetest, true);
-        llvmidetestsolver.solve();
-        FinalResultsJson += llvmidetestsolver.getAsJson();
-        if (PrintEdgeRecorder) {
-          llvmidetestsolver.exportJson(graph_id);
-        }
-        break;
-      }
-      case DataFlowAnalysisType::Intra_Mono_FullConstantPropagation: {
-        const llvm::Function *F = IRDB.getFunction(EntryPoints.front());
-        IntraMonoFullConstantPropagation intra(CFG, F);
-        LLVMIntraMonoSolver<pair<const llvm::Value *, unsigned>, LLVMBasedCFG &>
-            solver(intra, true);
-        solver.solve();
-        break;
-      }
-      case DataFlowAnalysisType::Intra_Mono_SolverTest: {
-        const llvm::Function *F = IRDB.getFunction(EntryPoints.front());
-        IntraMonoSolverTest intra(CFG, F);
-        LLVMIntraMonoSolver<const llvm::Value *, LLVMBasedCFG &> solver(intra,
-                                                                        true);
-        solver.solve();
-        break;
-      }
-      case DataFlowAnalysisType::Inter_Mono_SolverTest: {
-        const llvm::Function *F = IRDB.getFunction(EntryPoints.front());
-        InterMonoSolverTest inter(ICFG, EntryPoints);
-        CallString<typename InterMonoSolverTest::Node_t,
-                   typename InterMonoSolverTest::Domain_t, 3>
-            Context(&inter, &inter);
-        auto solver = make_LLVMBasedIMS(inter, Context, F, true);
-        solver->solve();
-        break;
-      }
-      case DataFlowAnalysisType::Inter_Mono_TaintAnalysis: {
-        const llvm::Function *F = IRDB.getFunction(EntryPoints.front());
-        InterMonoTaintAnalysis inter(ICFG, EntryPoints);
-        CallString<typename InterMonoTaintAnalysis::Node_t,
-                   typename InterMonoTaintAnalysis::Domain_t, 10>
-            Context(&inter, &inter);
-        auto solver = make_LLVMBasedIMS(inter, Context, F, true);
-        solver->solve();
-        solver->dumpResults();
-        break;
-      }
-      case DataFlowAnalysisType::Plugin: {
-        vector<string> AnalysisPlugins =
-            VariablesMap["analysis-plugin"].as<vector<string>>();
-#ifdef PHASAR_PLUGINS_ENABLED
-        AnalysisPluginController PluginController(
-            AnalysisPlugins, ICFG, EntryPoints, FinalResultsJson);
-#endif
-        break;
-      }
-      case DataFlowAnalysisType::None: {
-        break;
-      }
-      default:
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg, CRITICAL)
-                      << "The analysis it not valid");
-        break;
-      }
-    }
+            SCOPED_NAMED_TIMER("DFA Runtime " +
+                                   DataFlowAnalysisTypeToString.at(analysis),
+                               PAMM_SEVERITY_LEVEL::Core);
+            runAnalysis(analysis, ICFG, CH, IRDB, CFG, EntryPoints,
+                        EdgeLogPrefix);
+          }
+          LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
+                        << "Finished analysis: " << analysis);
+        });
     STOP_TIMER("DFA Runtime", PAMM_SEVERITY_LEVEL::Core);
   }
   // Perform module-wise (MW) analysis
@@ -391,9 +834,10 @@ AnalysisController::AnalysisController(
   }
 }
 
-void AnalysisController::writeResults(std::string filename) {
-  std::ofstream ofs(filename);
-  ofs << FinalResultsJson.dump(1);
+AnalysisController::~AnalysisController() {
+  if (JsonResults) {
+    JsonResults->endArray();
+  }
 }
 
 } // namespace psr
@@ -0,0 +1,406 @@
+/******************************************************************************
+ * Copyright (c) 2018 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Instruction.h>
+
+#include <phasar/Controller/AnalysisServer.h>
+#include <phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h>
+#include <phasar/PhasarLLVM/IfdsIde/Problems/IDELinearConstantAnalysis.h>
+#include <phasar/PhasarLLVM/IfdsIde/Problems/IDESolverTest.h>
+#include <phasar/PhasarLLVM/IfdsIde/Problems/IDETaintAnalysis.h>
+#include <phasar/PhasarLLVM/IfdsIde/Problems/IDETypeStateAnalysis.h>
+#include <phasar/PhasarLLVM/IfdsIde/Problems/IFDSConstAnalysis.h>
+#include <phasar/PhasarLLVM/IfdsIde/Problems/IFDSLinearConstantAnalysis.h>
+#include <phasar/PhasarLLVM/IfdsIde/Problems/IFDSSolverTest.h>
+#include <phasar/PhasarLLVM/IfdsIde/Problems/IFDSTaintAnalysis.h>
+#include <phasar/PhasarLLVM/IfdsIde/Problems/IFDSTypeAnalysis.h>
+#include <phasar/PhasarLLVM/IfdsIde/Problems/IFDSUninitializedVariables.h>
+#include <phasar/PhasarLLVM/IfdsIde/Solver/LLVMIDESolver.h>
+#include <phasar/PhasarLLVM/IfdsIde/Solver/LLVMIFDSSolver.h>
+#include <phasar/PhasarLLVM/Pointer/LLVMTypeHierarchy.h>
+#include <phasar/Utils/LLVMShorthands.h>
+#include <phasar/Utils/Logger.h>
+#include <phasar/Utils/PAMMMacros.h>
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+using json = AnalysisServer::json;
+
+namespace {
+
+template <typename ProblemT> json leaksOf(ProblemT &) {
+  return nullptr;
+}
+
+json leaksOf(IFDSTaintAnalysis &Problem) {
+  json Leaks = json::array();
+  for (auto &Leak : Problem.Leaks) {
+    json Values = json::array();
+    for (auto Value : Leak.second) {
+      Values.push_back(Problem.DtoString(Value));
+    }
+    Leaks.push_back({{"Instruction", getMetaDataID(Leak.first)},
+                     {"Function", Leak.first->getFunction()->getName().str()},
+                     {"Values", Values}});
+  }
+  return Leaks;
+}
+
+/**
+ * Owns a problem along with the solver that has solved it.
+ */
+template <typename ProblemT, typename SolverT>
+class ResidentSolution : public AnalysisServer::ResidentResults {
+private:
+  unique_ptr<ProblemT> Problem;
+  SolverT Solver;
+
+public:
+  ResidentSolution(unique_ptr<ProblemT> Problem, const string &Scope)
+      : Problem(move(Problem)), Solver(*this->Problem, false, false) {
+    Solver.setStatisticsScope(Scope);
+    Solver.solve();
+  }
+
+  json factsAt(const llvm::Instruction *I) override {
+    return Solver.resultsAtAsJson(I);
+  }
+
+  json leaks() override { return leaksOf(*Problem); }
+};
+
+template <typename SolverT, typename ProblemT>
+unique_ptr<AnalysisServer::ResidentResults>
+makeSolution(unique_ptr<ProblemT> Problem, const string &Scope) {
+  return make_unique<ResidentSolution<ProblemT, SolverT>>(move(Problem),
+                                                          Scope);
+}
+
+} // namespace
+
+AnalysisServer::AnalysisServer(ProjectIRDB &&IRDB, vector<string> EntryPoints,
+                               CallGraphAnalysisType CGType,
+                               TaintSensitiveFunctions TSF)
+    : IRDB(move(IRDB)), EntryPoints(move(EntryPoints)), TSF(move(TSF)) {
+  auto &lg = lg::get();
+  PAMM_GET_INSTANCE;
+  REG_COUNTER("Server Requests", 0, PAMM_SEVERITY_LEVEL::Core);
+  REG_HISTOGRAM("Server Request Latency (log2 us)", PAMM_SEVERITY_LEVEL::Core);
+  for (auto &EntryPoint : this->EntryPoints) {
+    if (this->IRDB.getFunction(EntryPoint) == nullptr) {
+      throw logic_error("invalid entry point: " + EntryPoint);
+    }
+  }
+  // the ICFG and all analyses work on a single module
+  this->IRDB.materializeReachable(this->EntryPoints);
+  this->IRDB.linkForWPA();
+  this->IRDB.preprocessIR();
+  START_TIMER("CH Construction", PAMM_SEVERITY_LEVEL::Core);
+  CH = make_unique<LLVMTypeHierarchy>(this->IRDB);
+  STOP_TIMER("CH Construction", PAMM_SEVERITY_LEVEL::Core);
+  START_TIMER("CG Construction", PAMM_SEVERITY_LEVEL::Core);
+  ICFG = make_unique<LLVMBasedICFG>(*CH, this->IRDB, CGType,
+                                    this->EntryPoints);
+  STOP_TIMER("CG Construction", PAMM_SEVERITY_LEVEL::Core);
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
+                << "Analysis server holds the project resident.");
+}
+
+AnalysisServer::~AnalysisServer() = default;
+
+unique_ptr<AnalysisServer::ResidentResults>
+AnalysisServer::solve(DataFlowAnalysisType Analysis,
+                      const vector<string> &EntryPoints) {
+  auto &lg = lg::get();
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO) << "Solving analysis: " << Analysis);
+  // solving the same analysis again reuses its statistics ids
+  string Scope = DataFlowAnalysisTypeToString.at(Analysis);
+  if (EntryPoints != this->EntryPoints) {
+    for (auto &EntryPoint : EntryPoints) {
+      Scope += "@" + EntryPoint;
+    }
+  }
+  Scope += " ";
+  switch (Analysis) {
+  case DataFlowAnalysisType::IFDS_TaintAnalysis:
+    return makeSolution<LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &>>(
+        make_unique<IFDSTaintAnalysis>(*ICFG, *CH, IRDB, TSF, EntryPoints),
+        Scope);
+  case DataFlowAnalysisType::IDE_TaintAnalysis:
+    return makeSolution<LLVMIDESolver<const llvm::Value *, const llvm::Value *,
+                                      LLVMBasedICFG &>>(
+        make_unique<IDETaintAnalysis>(*ICFG, *CH, IRDB, EntryPoints), Scope);
+  case DataFlowAnalysisType::IDE_TypeStateAnalysis:
+    return makeSolution<
+        LLVMIDESolver<const llvm::Value *, State, LLVMBasedICFG &>>(
+        make_unique<IDETypeStateAnalysis>(*ICFG, *CH, IRDB, "struct._IO_FILE",
+                                          EntryPoints), Scope);
+  case DataFlowAnalysisType::IFDS_TypeAnalysis:
+    return makeSolution<LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &>>(
+        make_unique<IFDSTypeAnalysis>(*ICFG, *CH, IRDB, EntryPoints), Scope);
+  case DataFlowAnalysisType::IFDS_UninitializedVariables:
+    return makeSolution<LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &>>(
+        make_unique<IFDSUnitializedVariables>(*ICFG, *CH, IRDB, EntryPoints),
+        Scope);
+  case DataFlowAnalysisType::IFDS_LinearConstantAnalysis:
+    return makeSolution<LLVMIFDSSolver<LCAPair, LLVMBasedICFG &>>(
+        make_unique<IFDSLinearConstantAnalysis>(*ICFG, *CH, IRDB,
+                                                EntryPoints), Scope);
+  case DataFlowAnalysisType::IDE_LinearConstantAnalysis:
+    return makeSolution<
+        LLVMIDESolver<const llvm::Value *, int64_t, LLVMBasedICFG &>>(
+        make_unique<IDELinearConstantAnalysis>(*ICFG, *CH, IRDB,
+                                               EntryPoints), Scope);
+  case DataFlowAnalysisType::IFDS_ConstAnalysis:
+    return makeSolution<LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &>>(
+        make_unique<IFDSConstAnalysis>(*ICFG, *CH, IRDB,
+                                       IRDB.getAllMemoryLocations(),
+                                       EntryPoints), Scope);
+  case DataFlowAnalysisType::IFDS_SolverTest:
+    return makeSolution<LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &>>(
+        make_unique<IFDSSolverTest>(*ICFG, *CH, IRDB, EntryPoints), Scope);
+  case DataFlowAnalysisType::IDE_SolverTest:
+    return makeSolution<LLVMIDESolver<const llvm::Value *, const llvm::Value *,
+                                      LLVMBasedICFG &>>(
+        make_unique<IDESolverTest>(*ICFG, *CH, IRDB, EntryPoints), Scope);
+  default:
+    throw runtime_error("analysis cannot be served: " +
+                        DataFlowAnalysisTypeToString.at(Analysis));
+  }
+}
+
+AnalysisServer::ResidentResults &
+AnalysisServer::getSolution(DataFlowAnalysisType Analysis) {
+  auto Search = Solutions.find(Analysis);
+  if (Search != Solutions.end()) {
+    return *Search->second;
+  }
+  auto Solution = solve(Analysis, EntryPoints);
+  return *(Solutions[Analysis] = move(Solution));
+}
+
+DataFlowAnalysisType
+AnalysisServer::getAnalysis(const string &Name) const {
+  auto Search = StringToDataFlowAnalysisType.find(Name);
+  if (Search == StringToDataFlowAnalysisType.end()) {
+    throw runtime_error("unknown analysis: " + Name);
+  }
+  return Search->second;
+}
+
+json AnalysisServer::factsAt(DataFlowAnalysisType Analysis,
+                             size_t InstructionId) {
+  const llvm::Instruction *I = IRDB.getInstruction(InstructionId);
+  if (!I) {
+    throw runtime_error("unknown instruction: " +
+                        to_string(InstructionId));
+  }
+  return {{"Instruction", getMetaDataID(I)},
+          {"Function", I->getFunction()->getName().str()},
+          {"Facts", getSolution(Analysis).factsAt(I)}};
+}
+
+json AnalysisServer::leaksFor(const string &EntryPoint) {
+  auto Search = TaintSolutions.find(EntryPoint);
+  if (Search == TaintSolutions.end()) {
+    if (IRDB.getFunction(EntryPoint) == nullptr) {
+      throw runtime_error("unknown entry point: " + EntryPoint);
+    }
+    Search = TaintSolutions
+                 .emplace(EntryPoint,
+                          solve(DataFlowAnalysisType::IFDS_TaintAnalysis,
+                                {EntryPoint}))
+                 .first;
+  }
+  return {{"EntryPoint", EntryPoint}, {"Leaks", Search->second->leaks()}};
+}
+
+json AnalysisServer::rerun(DataFlowAnalysisType Analysis) {
+  auto Start = chrono::steady_clock::now();
+  auto Solution = solve(Analysis, EntryPoints);
+  Solutions[Analysis] = move(Solution);
+  if (Analysis == DataFlowAnalysisType::IFDS_TaintAnalysis) {
+    TaintSolutions.clear();
+  }
+  long Runtime = chrono::duration_cast<chrono::milliseconds>(
+                     chrono::steady_clock::now() - Start)
+                     .count();
+  return {{"Analysis", DataFlowAnalysisTypeToString.at(Analysis)},
+          {"Runtime (ms)", Runtime}};
+}
+
+json AnalysisServer::getStats() const {
+  json Requests = json::object();
+  for (auto &Latency : Latencies) {
+    Requests[Latency.first] = {
+        {"Count", Latency.second.Count},
+        {"Mean (us)", Latency.second.TotalMicros /
+                          static_cast<long>(Latency.second.Count)},
+        {"Max (us)", Latency.second.MaxMicros}};
+  }
+  json Resident = json::array();
+  for (auto &Solution : Solutions) {
+    Resident.push_back(DataFlowAnalysisTypeToString.at(Solution.first));
+  }
+  json ResidentLeaks = json::array();
+  for (auto &Solution : TaintSolutions) {
+    ResidentLeaks.push_back(Solution.first);
+  }
+  return {{"Requests", Requests},
+          {"Resident analyses", Resident},
+          {"Resident leaks", ResidentLeaks}};
+}
+
+string AnalysisServer::handleRequest(const string &Request) {
+  PAMM_GET_INSTANCE;
+  auto Start = chrono::steady_clock::now();
+  istringstream Words(Request);
+  string Command, Argument;
+  Words >> Command >> Argument;
+  json Response;
+  try {
+    if (Command == "facts") {
+      size_t InstructionId;
+      if (!(Words >> InstructionId)) {
+        throw runtime_error("usage: facts <analysis> <instruction id>");
+      }
+      Response = factsAt(getAnalysis(Argument), InstructionId);
+    } else if (Command == "leaks" && !Argument.empty()) {
+      Response = leaksFor(Argument);
+    } else if (Command == "run" && !Argument.empty()) {
+      Response = rerun(getAnalysis(Argument));
+    } else if (Command == "stats") {
+      Response = getStats();
+    } else if (Command == "shutdown") {
+      Serving = false;
+      Response = json::object();
+    } else {
+      throw runtime_error("invalid request: " + Request);
+    }
+    Response["Status"] = "ok";
+  } catch (exception &E) {
+    Response = {{"Status", "error"}, {"Message", E.what()}};
+  }
+  long Micros = chrono::duration_cast<chrono::microseconds>(
+                    chrono::steady_clock::now() - Start)
+                    .count();
+  auto &Latency = Latencies[Command.empty() ? "<empty>" : Command];
+  ++Latency.Count;
+  Latency.TotalMicros += Micros;
+  Latency.MaxMicros = max(Latency.MaxMicros, Micros);
+  unsigned Bucket = 0;
+  while ((Micros >> Bucket) > 1) {
+    ++Bucket;
+  }
+  INC_COUNTER("Server Requests", 1, PAMM_SEVERITY_LEVEL::Core);
+  ADD_TO_HISTOGRAM("Server Request Latency (log2 us)", Bucket, 1,
+                   PAMM_SEVERITY_LEVEL::Core);
+  return Response.dump();
+}
+
+void AnalysisServer::serveConnection(int Connection) {
+  string Buffer;
+  char Chunk[4096];
+  while (Serving) {
+    ssize_t Read = read(Connection, Chunk, sizeof(Chunk));
+    if (Read < 0 && errno == EINTR) {
+      continue;
+    }
+    if (Read <= 0) {
+      return;
+    }
+    Buffer.append(Chunk, Read);
+    size_t Begin = 0, End;
+    while (Serving && (End = Buffer.find('\n', Begin)) != string::npos) {
+      string Response =
+          handleRequest(Buffer.substr(Begin, End - Begin)) + '\n';
+      Begin = End + 1;
+      for (size_t Sent = 0; Sent < Response.size();) {
+        ssize_t Written = send(Connection, Response.data() + Sent,
+                               Response.size() - Sent, MSG_NOSIGNAL);
+        if (Written < 0 && errno == EINTR) {
+          continue;
+        }
+        if (Written < 0) {
+          // the client has gone away
+          return;
+        }
+        Sent += Written;
+      }
+    }
+    Buffer.erase(0, Begin);
+  }
+}
+
+void AnalysisServer::serve(const string &SocketPath) {
+  auto &lg = lg::get();
+  sockaddr_un Address;
+  memset(&Address, 0, sizeof(Address));
+  Address.sun_family = AF_UNIX;
+  if (SocketPath.size() >= sizeof(Address.sun_path)) {
+    throw runtime_error("socket path too long: " + SocketPath);
+  }
+  strncpy(Address.sun_path, SocketPath.c_str(), sizeof(Address.sun_path) - 1);
+  // only a stale socket may be replaced, never e.g. a mistyped results file
+  struct stat Status;
+  if (lstat(SocketPath.c_str(), &Status) == 0) {
+    if (!S_ISSOCK(Status.st_mode)) {
+      throw runtime_error("not a socket, refusing to replace: " + SocketPath);
+    }
+    unlink(SocketPath.c_str());
+  }
+  int Listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (Listener < 0) {
+    throw runtime_error(string("could not create socket: ") + strerror(errno));
+  }
+  if (::bind(Listener, reinterpret_cast<sockaddr *>(&Address),
+             sizeof(Address)) < 0 ||
+      listen(Listener, 16) < 0) {
+    string Error = strerror(errno);
+    close(Listener);
+    throw runtime_error("could not listen on " + SocketPath + ": " + Error);
+  }
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO) << "Serving on " << SocketPath);
+  Serving = true;
+  while (Serving) {
+    int Connection = accept(Listener, nullptr, nullptr);
+    if (Connection < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      string Error = strerror(errno);
+      close(Listener);
+      unlink(SocketPath.c_str());
+      throw runtime_error("could not accept connection: " + Error);
+    }
+    serveConnection(Connection);
+    close(Connection);
+  }
+  close(Listener);
+  unlink(SocketPath.c_str());
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
+                << "Stopped serving, request latencies: " << getStats().dump());
+}
+
+} // namespace psr
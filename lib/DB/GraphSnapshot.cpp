@@ -0,0 +1,367 @@
+/******************************************************************************
+ * Copyright (c) 2018 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <phasar/DB/GraphSnapshot.h>
+#include <phasar/DB/ProjectIRDB.h>
+#include <phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h>
+#include <phasar/PhasarLLVM/Pointer/LLVMTypeHierarchy.h>
+#include <phasar/Utils/Logger.h>
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+namespace {
+
+/// Feeds everything written to it into an MD5 hash.
+class MD5Stream : public llvm::raw_ostream {
+private:
+  llvm::MD5 &Hash;
+  uint64_t Pos = 0;
+
+  void write_impl(const char *Ptr, size_t Size) override {
+    Hash.update(llvm::StringRef(Ptr, Size));
+    Pos += Size;
+  }
+
+  uint64_t current_pos() const override { return Pos; }
+
+public:
+  MD5Stream(llvm::MD5 &Hash) : Hash(Hash) {}
+  ~MD5Stream() override { flush(); }
+};
+
+class SnapshotWriter {
+private:
+  ostream &os;
+
+public:
+  SnapshotWriter(ostream &os) : os(os) {}
+
+  void writeU8(uint8_t v) { os.put(static_cast<char>(v)); }
+
+  void writeU32(uint32_t v) {
+    char buf[4] = {static_cast<char>(v & 0xff),
+                   static_cast<char>(v >> 8 & 0xff),
+                   static_cast<char>(v >> 16 & 0xff),
+                   static_cast<char>(v >> 24 & 0xff)};
+    os.write(buf, 4);
+  }
+
+  void writeU64(uint64_t v) {
+    writeU32(v & 0xffffffff);
+    writeU32(v >> 32);
+  }
+
+  void writeString(const string &s) {
+    writeU32(s.size());
+    os.write(s.data(), s.size());
+  }
+};
+
+/// Reads a snapshot in place, throws if it is truncated.
+class SnapshotReader {
+private:
+  const unsigned char *Pos;
+  const unsigned char *End;
+
+  void need(size_t Size) {
+    if (static_cast<size_t>(End - Pos) < Size) {
+      throw runtime_error("truncated snapshot");
+    }
+  }
+
+public:
+  SnapshotReader(const char *Begin, const char *End)
+      : Pos(reinterpret_cast<const unsigned char *>(Begin)),
+        End(reinterpret_cast<const unsigned char *>(End)) {}
+
+  const char *position() const { return reinterpret_cast<const char *>(Pos); }
+
+  uint8_t readU8() {
+    need(1);
+    return *Pos++;
+  }
+
+  uint32_t readU32() {
+    need(4);
+    uint32_t v = Pos[0] | Pos[1] << 8 | Pos[2] << 16 |
+                 static_cast<uint32_t>(Pos[3]) << 24;
+    Pos += 4;
+    return v;
+  }
+
+  uint64_t readU64() {
+    uint64_t Low = readU32();
+    return Low | static_cast<uint64_t>(readU32()) << 32;
+  }
+
+  llvm::StringRef readBytes(size_t Size) {
+    need(Size);
+    llvm::StringRef s(reinterpret_cast<const char *>(Pos), Size);
+    Pos += Size;
+    return s;
+  }
+
+  llvm::StringRef readString() { return readBytes(readU32()); }
+
+  /// Reads an index that has to be less than Bound.
+  uint32_t readIndex(size_t Bound) {
+    uint32_t Index = readU32();
+    if (Index >= Bound) {
+      throw runtime_error("corrupt snapshot");
+    }
+    return Index;
+  }
+};
+
+} // namespace
+
+GraphSnapshot::GraphSnapshot(unique_ptr<llvm::MemoryBuffer> Buffer,
+                             const llvm::Module &M)
+    : Buffer(move(Buffer)), M(M) {}
+
+GraphSnapshot::~GraphSnapshot() = default;
+
+string GraphSnapshot::hashModule(const llvm::Module &M) {
+  llvm::MD5 Hash;
+  {
+    MD5Stream OS(Hash);
+    llvm::WriteBitcodeToFile(&M, OS);
+  }
+  llvm::MD5::MD5Result Result;
+  Hash.final(Result);
+  llvm::SmallString<32> Key;
+  llvm::MD5::stringifyResult(Result, Key);
+  return Key.str().str();
+}
+
+void GraphSnapshot::store(const string &Path, const llvm::Module &M,
+                          const LLVMTypeHierarchy &CH,
+                          const LLVMBasedICFG &ICFG,
+                          const vector<string> &EntryPoints) {
+  auto &lg = lg::get();
+  // written to a temporary file first, so that a concurrent run never maps
+  // an incomplete snapshot
+  string TmpPath = Path + ".tmp";
+  ofstream ofs(TmpPath, ios::binary);
+  if (!ofs) {
+    throw runtime_error("could not write snapshot: " + TmpPath);
+  }
+  SnapshotWriter W(ofs);
+  ofs.write("PSRG", 4);
+  W.writeU32(Version);
+  W.writeString(hashModule(M));
+  W.writeU8(static_cast<uint8_t>(ICFG.CGType));
+  W.writeU32(EntryPoints.size());
+  for (auto &EntryPoint : EntryPoints) {
+    W.writeString(EntryPoint);
+  }
+  // type hierarchy, vertices are written in the order of their index
+  W.writeU32(boost::num_vertices(CH.g));
+  for (auto V : boost::make_iterator_range(boost::vertices(CH.g))) {
+    W.writeString(CH.g[V].name);
+    W.writeU32(CH.g[V].reachableTypes.size());
+    for (auto &Reachable : CH.g[V].reachableTypes) {
+      W.writeU32(CH.type_vertex_map.at(Reachable));
+    }
+  }
+  W.writeU32(boost::num_edges(CH.g));
+  for (auto E : boost::make_iterator_range(boost::edges(CH.g))) {
+    W.writeU32(boost::source(E, CH.g));
+    W.writeU32(boost::target(E, CH.g));
+  }
+  W.writeU32(CH.type_vtbl_map.size());
+  for (auto &VTable : CH.type_vtbl_map) {
+    W.writeString(VTable.first);
+    W.writeU32(VTable.second.size());
+    for (auto &Entry : VTable.second) {
+      W.writeString(Entry);
+    }
+  }
+  // call graph
+  W.writeU32(boost::num_vertices(ICFG.cg));
+  for (auto V : boost::make_iterator_range(boost::vertices(ICFG.cg))) {
+    W.writeString(ICFG.cg[V].functionName);
+    W.writeU8(ICFG.cg[V].isDeclaration);
+  }
+  W.writeU32(boost::num_edges(ICFG.cg));
+  for (auto E : boost::make_iterator_range(boost::edges(ICFG.cg))) {
+    W.writeU32(boost::source(E, ICFG.cg));
+    W.writeU32(boost::target(E, ICFG.cg));
+    W.writeU64(ICFG.cg[E].id);
+  }
+  ofs.close();
+  if (!ofs || rename(TmpPath.c_str(), Path.c_str()) != 0) {
+    remove(TmpPath.c_str());
+    throw runtime_error("could not write snapshot: " + Path);
+  }
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO) << "Stored snapshot: " << Path);
+}
+
+unique_ptr<GraphSnapshot>
+GraphSnapshot::load(const string &Path, const llvm::Module &M,
+                    CallGraphAnalysisType CGType,
+                    const vector<string> &EntryPoints) {
+  auto &lg = lg::get();
+  // large files are mapped into memory
+  auto Buffer = llvm::MemoryBuffer::getFile(Path, -1, false);
+  if (!Buffer) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO) << "No snapshot found: " << Path);
+    return nullptr;
+  }
+  unique_ptr<GraphSnapshot> Snapshot(new GraphSnapshot(move(*Buffer), M));
+  const char *Begin = Snapshot->Buffer->getBufferStart();
+  SnapshotReader R(Begin, Snapshot->Buffer->getBufferEnd());
+  try {
+    if (R.readBytes(4) != "PSRG" || R.readU32() != Version) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
+                    << "Snapshot of another version: " << Path);
+      return nullptr;
+    }
+    if (R.readString() != hashModule(M)) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
+                    << "Snapshot of another module: " << Path);
+      return nullptr;
+    }
+    Snapshot->CGType = static_cast<CallGraphAnalysisType>(R.readU8());
+    uint32_t NumEntryPoints = R.readU32();
+    for (uint32_t i = 0; i < NumEntryPoints; ++i) {
+      Snapshot->EntryPoints.push_back(R.readString().str());
+    }
+    if (Snapshot->CGType != CGType || Snapshot->EntryPoints != EntryPoints) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
+                    << "Snapshot of another call-graph analysis or other "
+                       "entry points: "
+                    << Path);
+      return nullptr;
+    }
+    // skip the type hierarchy to find the call graph
+    Snapshot->TypeHierarchyOffset = R.position() - Begin;
+    uint32_t NumTypes = R.readU32();
+    for (uint32_t i = 0; i < NumTypes; ++i) {
+      R.readString();
+      uint32_t NumReachable = R.readU32();
+      for (uint32_t j = 0; j < NumReachable; ++j) {
+        R.readIndex(NumTypes);
+      }
+    }
+    uint32_t NumEdges = R.readU32();
+    for (uint32_t i = 0; i < NumEdges; ++i) {
+      R.readIndex(NumTypes);
+      R.readIndex(NumTypes);
+    }
+    uint32_t NumVTables = R.readU32();
+    for (uint32_t i = 0; i < NumVTables; ++i) {
+      R.readString();
+      uint32_t NumEntries = R.readU32();
+      for (uint32_t j = 0; j < NumEntries; ++j) {
+        R.readString();
+      }
+    }
+    Snapshot->CallGraphOffset = R.position() - Begin;
+  } catch (runtime_error &E) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, WARNING)
+                  << "Could not read snapshot " << Path << ": " << E.what());
+    return nullptr;
+  }
+  return Snapshot;
+}
+
+unique_ptr<LLVMTypeHierarchy> GraphSnapshot::getTypeHierarchy() const {
+  auto CH = make_unique<LLVMTypeHierarchy>();
+  SnapshotReader R(Buffer->getBufferStart() + TypeHierarchyOffset,
+                   Buffer->getBufferEnd());
+  uint32_t NumTypes = R.readU32();
+  vector<vector<uint32_t>> Reachable(NumTypes);
+  for (uint32_t i = 0; i < NumTypes; ++i) {
+    string Name = R.readString().str();
+    auto V = boost::add_vertex(CH->g);
+    CH->g[V] = LLVMTypeHierarchy::VertexProperties(M.getTypeByName(Name), Name);
+    CH->type_vertex_map[Name] = V;
+    uint32_t NumReachable = R.readU32();
+    for (uint32_t j = 0; j < NumReachable; ++j) {
+      Reachable[i].push_back(R.readIndex(NumTypes));
+    }
+  }
+  for (uint32_t i = 0; i < NumTypes; ++i) {
+    for (auto j : Reachable[i]) {
+      CH->g[i].reachableTypes.insert(CH->g[j].name);
+    }
+  }
+  uint32_t NumEdges = R.readU32();
+  for (uint32_t i = 0; i < NumEdges; ++i) {
+    uint32_t Source = R.readIndex(NumTypes);
+    boost::add_edge(Source, R.readIndex(NumTypes), CH->g);
+  }
+  uint32_t NumVTables = R.readU32();
+  for (uint32_t i = 0; i < NumVTables; ++i) {
+    string TypeName = R.readString().str();
+    uint32_t NumEntries = R.readU32();
+    auto &VTable = CH->type_vtbl_map[TypeName];
+    for (uint32_t j = 0; j < NumEntries; ++j) {
+      VTable.addEntry(R.readString().str());
+    }
+  }
+  CH->contained_modules.insert(&M);
+  return CH;
+}
+
+unique_ptr<LLVMBasedICFG> GraphSnapshot::getICFG(LLVMTypeHierarchy &CH,
+                                                 ProjectIRDB &IRDB) const {
+  auto ICFG = make_unique<LLVMBasedICFG>(CH, IRDB);
+  ICFG->CGType = CGType;
+  SnapshotReader R(Buffer->getBufferStart() + CallGraphOffset,
+                   Buffer->getBufferEnd());
+  uint32_t NumVertices = R.readU32();
+  for (uint32_t i = 0; i < NumVertices; ++i) {
+    string Name = R.readString().str();
+    bool IsDeclaration = R.readU8();
+    const llvm::Function *F = M.getFunction(Name);
+    if (!F) {
+      throw runtime_error("snapshot refers to unknown function: " + Name);
+    }
+    auto V = boost::add_vertex(ICFG->cg);
+    ICFG->cg[V] = LLVMBasedICFG::VertexProperties(F, IsDeclaration);
+    ICFG->function_vertex_map[Name] = V;
+    if (!F->isDeclaration()) {
+      ICFG->VisitedFunctions.insert(F);
+    }
+  }
+  uint32_t NumEdges = R.readU32();
+  for (uint32_t i = 0; i < NumEdges; ++i) {
+    uint32_t Source = R.readIndex(NumVertices);
+    uint32_t Target = R.readIndex(NumVertices);
+    uint64_t Id = R.readU64();
+    const llvm::Instruction *CallSite = IRDB.getInstruction(Id);
+    if (!CallSite) {
+      throw runtime_error("snapshot refers to unknown call-site: " +
+                          to_string(Id));
+    }
+    boost::add_edge(Source, Target, LLVMBasedICFG::EdgeProperties(CallSite),
+                    ICFG->cg);
+  }
+  ICFG->restoreWholeModulePTG(EntryPoints);
+  return ICFG;
+}
+
+} // namespace psr
@@ -7,103 +7,280 @@
  *     Philipp Schubert and others
  *****************************************************************************/
 
+#include <algorithm>
 #include <iostream>
+#include <stdexcept>
 
 #include <phasar/DB/Hexastore.h>
 
 using namespace psr;
 using namespace std;
-using namespace boost;
 
 namespace psr {
 
+const array<array<unsigned, 3>, 6> Hexastore::permutations = {{{{0, 1, 2}},
+                                                               {{0, 2, 1}},
+                                                               {{1, 0, 2}},
+                                                               {{1, 2, 0}},
+                                                               {{2, 0, 1}},
+                                                               {{2, 1, 0}}}};
+
+const array<array<unsigned, 3>, 6> Hexastore::inverse_permutations = {
+    {{{0, 1, 2}},
+     {{0, 2, 1}},
+     {{1, 0, 2}},
+     {{2, 0, 1}},
+     {{1, 2, 0}},
+     {{2, 1, 0}}}};
+
+namespace {
+
+hs_triple permute(const hs_triple &t, const array<unsigned, 3> &p) {
+  return {{t[p[0]], t[p[1]], t[p[2]]}};
+}
+
+/// Finalizes a prepared statement when going out of scope.
+struct StmtGuard {
+  sqlite3_stmt *stmt = nullptr;
+  ~StmtGuard() { sqlite3_finalize(stmt); }
+};
+
+} // anonymous namespace
+
 Hexastore::Hexastore(string filename) {
-  sqlite3_open(filename.c_str(), &hs_internal_db);
-  const string query = INIT;
-  char *err;
-  sqlite3_exec(hs_internal_db, query.c_str(), callback, 0, &err);
-  if (err != NULL)
-    cout << err << "\n\n";
+  if (sqlite3_open(filename.c_str(), &hs_internal_db) != SQLITE_OK) {
+    string msg = sqlite3_errmsg(hs_internal_db);
+    sqlite3_close(hs_internal_db);
+    throw runtime_error("could not open hexastore '" + filename + "': " + msg);
+  }
+  executeSQL(INIT);
+  load();
 }
 
-Hexastore::~Hexastore() { sqlite3_close(hs_internal_db); }
+Hexastore::~Hexastore() {
+  try {
+    flush();
+  } catch (const exception &e) {
+    cerr << e.what() << '\n';
+  }
+  sqlite3_close(hs_internal_db);
+}
 
-int Hexastore::callback(void *NotUsed, int argc, char **argv,
-                        char **azColName) {
-  for (int i = 0; i < argc; ++i) {
-    cout << azColName[i] << " " << (argv[i] ? argv[i] : "NULL") << endl;
+void Hexastore::executeSQL(const string &query) {
+  char *err = nullptr;
+  sqlite3_exec(hs_internal_db, query.c_str(), nullptr, nullptr, &err);
+  if (err != NULL) {
+    string msg = err;
+    sqlite3_free(err);
+    throw runtime_error(msg);
   }
-  return 0;
 }
 
-void Hexastore::put(array<string, 3> edge) {
-  doPut(SPO_INSERT, edge);
-  doPut(SOP_INSERT, edge);
-  doPut(PSO_INSERT, edge);
-  doPut(POS_INSERT, edge);
-  doPut(OSP_INSERT, edge);
-  doPut(OPS_INSERT, edge);
+void Hexastore::load() {
+  StmtGuard strings;
+  sqlite3_prepare_v2(hs_internal_db, SELECT_STRINGS.c_str(), -1,
+                     &strings.stmt, nullptr);
+  while (sqlite3_step(strings.stmt) == SQLITE_ROW) {
+    const char *name =
+        reinterpret_cast<const char *>(sqlite3_column_text(strings.stmt, 1));
+    auto it = string_to_id
+                  .emplace(name, static_cast<hs_id_t>(
+                                     sqlite3_column_int64(strings.stmt, 0)))
+                  .first;
+    if (it->second != id_to_string.size()) {
+      throw runtime_error("hexastore dictionary is not densely encoded");
+    }
+    id_to_string.push_back(&it->first);
+  }
+  persisted_strings = id_to_string.size();
+  StmtGuard triples;
+  sqlite3_prepare_v2(hs_internal_db, SELECT_TRIPLES.c_str(), -1,
+                     &triples.stmt, nullptr);
+  while (sqlite3_step(triples.stmt) == SQLITE_ROW) {
+    indexes[SPO].push_back(
+        {{static_cast<hs_id_t>(sqlite3_column_int64(triples.stmt, 0)),
+          static_cast<hs_id_t>(sqlite3_column_int64(triples.stmt, 1)),
+          static_cast<hs_id_t>(sqlite3_column_int64(triples.stmt, 2))}});
+  }
+  sort(indexes[SPO].begin(), indexes[SPO].end());
 }
 
-void Hexastore::doPut(string query, array<string, 3> edge) {
-  string compiled_query = str(format(query) % edge[0] % edge[1] % edge[2]);
-  char *err;
-  sqlite3_exec(hs_internal_db, compiled_query.c_str(), callback, 0, &err);
-  if (err != NULL)
-    cout << err;
+void Hexastore::mergeBatch() {
+  if (batch.empty()) {
+    return;
+  }
+  sort(batch.begin(), batch.end());
+  batch.erase(unique(batch.begin(), batch.end()), batch.end());
+  vector<hs_triple> fresh;
+  set_difference(batch.begin(), batch.end(), indexes[SPO].begin(),
+                 indexes[SPO].end(), back_inserter(fresh));
+  batch.clear();
+  unpersisted.insert(unpersisted.end(), fresh.begin(), fresh.end());
+  for (unsigned order = SPO; order <= OPS; ++order) {
+    if (!built[order] || fresh.empty()) {
+      continue;
+    }
+    auto &index = indexes[order];
+    auto mid = index.size();
+    for (auto &t : fresh) {
+      index.push_back(permute(t, permutations[order]));
+    }
+    if (order != SPO) {
+      sort(index.begin() + mid, index.end());
+    }
+    inplace_merge(index.begin(), index.begin() + mid, index.end());
+  }
+}
+
+void Hexastore::buildIndex(unsigned order) {
+  auto &index = indexes[order];
+  index.reserve(indexes[SPO].size());
+  for (auto &t : indexes[SPO]) {
+    index.push_back(permute(t, permutations[order]));
+  }
+  sort(index.begin(), index.end());
+  built[order] = true;
 }
 
-vector<hs_result> Hexastore::get(array<string, 3> edge_query,
+hs_id_range Hexastore::lookup(const hs_triple &query) {
+  mergeBatch();
+  bool s = query[0] != hs_wildcard;
+  bool p = query[1] != hs_wildcard;
+  bool o = query[2] != hs_wildcard;
+  // choose the index whose order starts with all bound positions
+  unsigned order = SPO;
+  if (!s && p) {
+    order = o ? POS : PSO;
+  } else if (!s && !p && o) {
+    order = OSP;
+  } else if (s && !p && o) {
+    order = SOP;
+  }
+  unsigned bound = s + p + o;
+  if (!built[order]) {
+    buildIndex(order);
+  }
+  const auto &index = indexes[order];
+  hs_triple key = permute(query, permutations[order]);
+  auto range = equal_range(index.begin(), index.end(), key,
+                           [bound](const hs_triple &lhs, const hs_triple &rhs) {
+                             return lexicographical_compare(
+                                 lhs.begin(), lhs.begin() + bound, rhs.begin(),
+                                 rhs.begin() + bound);
+                           });
+  return hs_id_range(index.data() + (range.first - index.begin()),
+                     index.data() + (range.second - index.begin()),
+                     &inverse_permutations[order]);
+}
+
+void Hexastore::put(const array<string, 3> &edge) {
+  put({{getID(edge[0]), getID(edge[1]), getID(edge[2])}});
+}
+
+void Hexastore::put(const hs_triple &edge) {
+  for (auto id : edge) {
+    if (id >= id_to_string.size()) {
+      throw invalid_argument("hexastore entry contains unknown id");
+    }
+  }
+  batch.push_back(edge);
+}
+
+vector<hs_result> Hexastore::get(const array<string, 3> &edge_query,
                                  size_t result_size_hint) {
   vector<hs_result> result;
   result.reserve(result_size_hint);
-  string querystring;
-  if (edge_query[0] == "?") {
-    if (edge_query[1] == "?") {
-      if (edge_query[2] == "?") {
-        querystring = SEARCH_XXX;
-      } else {
-        querystring = SEARCH_XXO;
-      }
-    } else {
-      if (edge_query[2] == "?") {
-        querystring = SEARCH_XPX;
-      } else {
-        querystring = SEARCH_XPO;
+  hs_triple query;
+  for (unsigned i = 0; i < 3; ++i) {
+    if (edge_query[i] == "?") {
+      query[i] = hs_wildcard;
+    } else if ((query[i] = findID(edge_query[i])) == hs_wildcard) {
+      // a string that is not encoded cannot be part of any entry
+      return result;
+    }
+  }
+  for (auto t : get(query)) {
+    result.emplace_back(getString(t[0]), getString(t[1]), getString(t[2]));
+  }
+  return result;
+}
+
+hs_id_range Hexastore::get(const hs_triple &edge_query) {
+  return lookup(edge_query);
+}
+
+hs_id_t Hexastore::getID(const string &s) {
+  auto search = string_to_id.find(s);
+  if (search != string_to_id.end()) {
+    return search->second;
+  }
+  if (id_to_string.size() >= hs_wildcard) {
+    throw length_error("hexastore dictionary is exhausted");
+  }
+  auto it =
+      string_to_id.emplace(s, static_cast<hs_id_t>(id_to_string.size())).first;
+  id_to_string.push_back(&it->first);
+  return it->second;
+}
+
+hs_id_t Hexastore::findID(const string &s) const {
+  auto search = string_to_id.find(s);
+  return search != string_to_id.end() ? search->second : hs_wildcard;
+}
+
+const string &Hexastore::getString(hs_id_t id) const {
+  return *id_to_string.at(id);
+}
+
+size_t Hexastore::size() {
+  mergeBatch();
+  return indexes[SPO].size();
+}
+
+void Hexastore::flush() {
+  mergeBatch();
+  if (persisted_strings == id_to_string.size() && unpersisted.empty()) {
+    return;
+  }
+  executeSQL("begin transaction;");
+  try {
+    StmtGuard strings;
+    if (sqlite3_prepare_v2(hs_internal_db, INSERT_STRING.c_str(), -1,
+                           &strings.stmt, nullptr) != SQLITE_OK) {
+      throw runtime_error(sqlite3_errmsg(hs_internal_db));
+    }
+    for (size_t id = persisted_strings; id < id_to_string.size(); ++id) {
+      const string &name = *id_to_string[id];
+      sqlite3_bind_int64(strings.stmt, 1, id);
+      sqlite3_bind_text(strings.stmt, 2, name.data(), name.size(),
+                        SQLITE_STATIC);
+      if (sqlite3_step(strings.stmt) != SQLITE_DONE) {
+        throw runtime_error(sqlite3_errmsg(hs_internal_db));
       }
+      sqlite3_reset(strings.stmt);
+    }
+    StmtGuard triples;
+    if (sqlite3_prepare_v2(hs_internal_db, INSERT_TRIPLE.c_str(), -1,
+                           &triples.stmt, nullptr) != SQLITE_OK) {
+      throw runtime_error(sqlite3_errmsg(hs_internal_db));
     }
-  } else {
-    if (edge_query[1] == "?") {
-      if (edge_query[2] == "?") {
-        querystring = SEARCH_SXX;
-      } else {
-        querystring = SEARCH_SXO;
+    for (auto &t : unpersisted) {
+      for (int i = 0; i < 3; ++i) {
+        sqlite3_bind_int64(triples.stmt, i + 1, t[i]);
       }
-    } else {
-      if (edge_query[2] == "?") {
-        querystring = SEARCH_SPX;
-      } else {
-        querystring = SEARCH_SPO;
+      if (sqlite3_step(triples.stmt) != SQLITE_DONE) {
+        throw runtime_error(sqlite3_errmsg(hs_internal_db));
       }
+      sqlite3_reset(triples.stmt);
     }
+    executeSQL("commit transaction;");
+  } catch (...) {
+    sqlite3_exec(hs_internal_db, "rollback transaction;", nullptr, nullptr,
+                 nullptr);
+    throw;
   }
-  string compiled_query =
-      str(format(querystring) % edge_query[0] % edge_query[1] % edge_query[2]);
-  // this lambda will collect all of our results, since it is called on every
-  // row of the result set
-  auto sqlite_cb_result_collector = [](void *cb, int argc, char **argv,
-                                       char **azColName) {
-    vector<hs_result> *res = static_cast<vector<hs_result> *>(cb);
-    res->emplace_back(argv[0], argv[1], argv[2]);
-    return 0;
-  };
-  char *err;
-  sqlite3_exec(hs_internal_db, compiled_query.c_str(),
-               sqlite_cb_result_collector, &result, &err);
-  if (err != NULL) {
-    cout << err;
-  }
-  return result;
+  persisted_strings = id_to_string.size();
+  unpersisted.clear();
 }
 
 } // namespace psr
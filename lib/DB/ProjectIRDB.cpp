@@ -8,8 +8,24 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <mutex>
+#include <sstream>
+
+#include <clang/Basic/Diagnostic.h>
+#include <clang/Basic/DiagnosticOptions.h>
+#include <clang/Basic/Version.h>
+#include <clang/CodeGen/CodeGenAction.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/CompilerInvocation.h>
+#include <clang/Frontend/FrontendActions.h>
+#include <clang/Frontend/TextDiagnosticPrinter.h>
+#include <clang/Frontend/Utils.h>
+#include <clang/Lex/Preprocessor.h>
 
 #include <llvm/Analysis/AliasAnalysis.h>
 #include <llvm/Analysis/BasicAliasAnalysis.h>
@@ -23,20 +39,27 @@
 #include <llvm/IR/Verifier.h>
 #include <llvm/IRReader/IRReader.h>
 #include <llvm/Linker/Linker.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
 #include <llvm/Transforms/Scalar.h>
 
 #include <boost/filesystem.hpp>
 
+#include <phasar/Config/Configuration.h>
 #include <phasar/DB/ProjectIRDB.h>
 #include <phasar/PhasarLLVM/IfdsIde/LLVMZeroValue.h>
 #include <phasar/PhasarLLVM/Passes/GeneralStatisticsPass.h>
 #include <phasar/PhasarLLVM/Passes/ValueAnnotationPass.h>
 #include <phasar/Utils/EnumFlags.h>
 #include <phasar/Utils/IO.h>
+#include <phasar/Utils/LLVMIRPrinter.h>
 #include <phasar/Utils/LLVMShorthands.h>
 #include <phasar/Utils/Logger.h>
 #include <phasar/Utils/Macros.h>
 #include <phasar/Utils/PAMMMacros.h>
+#include <phasar/Utils/Parallel.h>
+#include <phasar/Utils/Profiler.h>
 
 using namespace psr;
 using namespace std;
@@ -57,47 +80,509 @@ const std::set<std::string> ProjectIRDB::unknown_flags = {
     "-fstack-protector-all",
     "--param",
     "-fPIE",
-    "-fno-default-inline"
+    "-fno-default-inline",
     "-MF",
     "-fno-exceptions",
     "-fdiagnostics-color",
 };
 
+namespace {
+
+/// Parses the given .ll or .bc file into C. Function bodies of bitcode files
+/// are only read on demand if Lazy is set.
+std::unique_ptr<llvm::Module> loadIRFile(const std::string &File,
+                                         llvm::LLVMContext &C, bool Lazy,
+                                         bool Verify) {
+  llvm::SMDiagnostic Diag;
+  std::unique_ptr<llvm::Module> M = Lazy
+                                        ? llvm::getLazyIRFileModule(File, Diag, C)
+                                        : llvm::parseIRFile(File, Diag, C);
+  bool broken_debug_info = false;
+  if (M.get() == nullptr)
+    Diag.print(File.c_str(), llvm::errs());
+  /* Crash in presence of llvm-3.9.1 module (segfault) */
+  if (M.get() == nullptr ||
+      (Verify && llvm::verifyModule(*M, &llvm::errs(), &broken_debug_info))) {
+    throw std::runtime_error(File + " could not be parsed correctly");
+  }
+  if (broken_debug_info) {
+    std::cout << "caution: debug info is broken\n";
+  }
+  return M;
+}
+
+/// Re-loads M into the given context, this is only required for modules that
+/// have been parsed into a context of their own.
+std::unique_ptr<llvm::Module> reloadIntoContext(llvm::Module &M,
+                                                llvm::LLVMContext &C) {
+  std::string IRBuffer;
+  llvm::raw_string_ostream RSO(IRBuffer);
+  llvm::WriteBitcodeToFile(&M, RSO);
+  RSO.flush();
+  llvm::SMDiagnostic ErrorDiagnostics;
+  std::unique_ptr<llvm::MemoryBuffer> MemBuffer =
+      llvm::MemoryBuffer::getMemBuffer(IRBuffer);
+  std::unique_ptr<llvm::Module> TmpMod =
+      llvm::parseIR(*MemBuffer, ErrorDiagnostics, C);
+  bool broken_debug_info = false;
+  if (TmpMod.get() == nullptr ||
+      llvm::verifyModule(*TmpMod, &llvm::errs(), &broken_debug_info)) {
+    std::cout << "module is broken!\nabort!" << std::endl;
+    DIE_HARD;
+  }
+  if (broken_debug_info) {
+    std::cout << "debug info is broken" << std::endl;
+  }
+  return TmpMod;
+}
+
+void linkInto(llvm::Module &Dest, std::unique_ptr<llvm::Module> Src,
+              unsigned Flags) {
+  if (llvm::Linker::linkModules(Dest, std::move(Src), Flags)) {
+    std::cout << "ERROR when trying to link modules for WPA module!"
+              << std::endl;
+    DIE_HARD;
+  }
+}
+
+
+/// Ignored flags that are followed by an argument which has to be removed as
+/// well.
+const std::set<std::string> FlagsWithArgument = {"--param", "-MF"};
+
+/// Feeds the preprocessed main file, i.e. the source file together with
+/// every header that it includes after macro expansion, into a hash.
+class HashPreprocessedAction : public clang::PreprocessorFrontendAction {
+private:
+  llvm::MD5 &Hash;
+
+public:
+  HashPreprocessedAction(llvm::MD5 &Hash) : Hash(Hash) {}
+
+protected:
+  void ExecuteAction() override {
+    clang::Preprocessor &PP = getCompilerInstance().getPreprocessor();
+    clang::SourceManager &SM = getCompilerInstance().getSourceManager();
+    PP.EnterMainSourceFile();
+    clang::Token Tok;
+    for (PP.Lex(Tok); Tok.isNot(clang::tok::eof); PP.Lex(Tok)) {
+      // the line numbers end up in the debug information of the module
+      if (Tok.isAtStartOfLine()) {
+        Hash.update(
+            std::to_string(SM.getPresumedLineNumber(Tok.getLocation())));
+      }
+      Hash.update(PP.getSpelling(Tok));
+      Hash.update(" ");
+    }
+  }
+};
+
+/**
+ * Compiles the commands of a compilation database into modules. The driver
+ * may be used by several threads at once as long as every thread compiles
+ * into an LLVMContext of its own.
+ *
+ * @brief Compiles translation units using a bitcode and a PCH cache.
+ */
+class CompilationDriver {
+private:
+  const std::set<std::string> &IgnoredFlags;
+  std::vector<std::string> ExtraArgs;
+  std::string CacheDir;
+  std::mutex PCHMutex;
+  std::map<std::string, std::shared_future<std::string>> PCHs;
+  std::atomic<size_t> CacheHits;
+
+  /// Creates a diagnostics engine that prints to OS, such that the
+  /// diagnostics of concurrent compilations do not interleave.
+  static llvm::IntrusiveRefCntPtr<clang::DiagnosticsEngine>
+  createDiagnostics(llvm::raw_ostream &OS) {
+    llvm::IntrusiveRefCntPtr<clang::DiagnosticOptions> DiagOpts(
+        new clang::DiagnosticOptions);
+    return clang::CompilerInstance::createDiagnostics(
+        DiagOpts.get(), new clang::TextDiagnosticPrinter(OS, DiagOpts.get()));
+  }
+
+  static std::unique_ptr<clang::CompilerInvocation>
+  createInvocation(const std::vector<std::string> &Args,
+                   const std::string &Directory,
+                   llvm::IntrusiveRefCntPtr<clang::DiagnosticsEngine> Diags) {
+    std::vector<const char *> Argv;
+    for (const auto &Arg : Args) {
+      Argv.push_back(Arg.c_str());
+    }
+    std::unique_ptr<clang::CompilerInvocation> Invocation =
+        clang::createInvocationFromCommandLine(Argv, Diags);
+    if (Invocation) {
+      Invocation->getFileSystemOpts().WorkingDir = Directory;
+      // the build system has its own idea of the dependency files
+      Invocation->getDependencyOutputOpts() = clang::DependencyOutputOptions();
+    }
+    return Invocation;
+  }
+
+  static bool
+  runAction(const clang::CompilerInvocation &Invocation,
+            clang::FrontendAction &Action,
+            llvm::IntrusiveRefCntPtr<clang::DiagnosticsEngine> Diags) {
+    clang::CompilerInstance CI;
+    CI.setInvocation(std::make_shared<clang::CompilerInvocation>(Invocation));
+    CI.setDiagnostics(Diags.get());
+    return CI.ExecuteAction(Action) && !Diags->hasErrorOccurred();
+  }
+
+  /// Compiles Args into a module of C, returns nullptr on errors.
+  static std::unique_ptr<llvm::Module>
+  emitModule(const std::vector<std::string> &Args, const std::string &Directory,
+             llvm::LLVMContext &C,
+             llvm::IntrusiveRefCntPtr<clang::DiagnosticsEngine> Diags) {
+    std::unique_ptr<clang::CompilerInvocation> Invocation =
+        createInvocation(Args, Directory, Diags);
+    if (!Invocation) {
+      return nullptr;
+    }
+    clang::EmitLLVMOnlyAction Action(&C);
+    if (!runAction(*Invocation, Action, Diags)) {
+      return nullptr;
+    }
+    return Action.takeModule();
+  }
+
+  static std::string absolutePath(const std::string &Path,
+                                  const std::string &Directory) {
+    return boost::filesystem::absolute(Path, Directory).string();
+  }
+
+  /// Writes M to Path such that concurrent readers never see a partial file.
+  static void writeBitcode(const llvm::Module &M, const std::string &Path) {
+    std::string Tmp =
+        (boost::filesystem::path(Path).parent_path() /
+         boost::filesystem::unique_path("%%%%-%%%%-%%%%-%%%%.tmp"))
+            .string();
+    {
+      std::error_code EC;
+      llvm::raw_fd_ostream OS(Tmp, EC, llvm::sys::fs::F_None);
+      if (EC) {
+        throw std::runtime_error("could not write " + Tmp + ": " +
+                                 EC.message());
+      }
+      llvm::WriteBitcodeToFile(&M, OS);
+    }
+    boost::filesystem::rename(Tmp, Path);
+  }
+
+  /// Precompiles the given header using the flags of Args, whose source file
+  /// is at SourcePos. Returns the path of the PCH or an empty string if the
+  /// header cannot be precompiled.
+  std::string buildPCH(std::vector<std::string> Args, size_t SourcePos,
+                       const std::string &Header,
+                       const std::string &Directory, const std::string &Key) {
+    std::string Path = CacheDir + "/" + Key + ".pch";
+    bool IsC = boost::filesystem::path(Args[SourcePos]).extension() == ".c";
+    Args[SourcePos] = Header;
+    Args.insert(Args.begin() + SourcePos,
+                {"-x", IsC ? "c-header" : "c++-header"});
+    std::string Diagnostics;
+    llvm::raw_string_ostream DiagOS(Diagnostics);
+    auto Diags = createDiagnostics(DiagOS);
+    std::unique_ptr<clang::CompilerInvocation> Invocation =
+        createInvocation(Args, Directory, Diags);
+    if (!Invocation) {
+      return "";
+    }
+    std::string Tmp = Path + "." + boost::filesystem::unique_path().string();
+    Invocation->getFrontendOpts().ProgramAction = clang::frontend::GeneratePCH;
+    Invocation->getFrontendOpts().OutputFile = Tmp;
+    clang::GeneratePCHAction Action;
+    if (!runAction(*Invocation, Action, Diags)) {
+      auto &lg = lg::get();
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, WARNING)
+                    << "Could not precompile " << Header << ":\n"
+                    << DiagOS.str());
+      boost::system::error_code EC;
+      boost::filesystem::remove(Tmp, EC);
+      return "";
+    }
+    boost::filesystem::rename(Tmp, Path);
+    return Path;
+  }
+
+  /// Replaces the first header that is force-included by Args with a PCH
+  /// of it, the PCH is built on first use and shared by all commands with
+  /// the same flags.
+  void usePCH(std::vector<std::string> &Args, size_t SourcePos,
+              const std::string &Directory) {
+    if (CacheDir.empty() ||
+        std::find(Args.begin(), Args.end(), "-include-pch") != Args.end()) {
+      return;
+    }
+    auto Include = std::find(Args.begin(), Args.end(), "-include");
+    if (Include == Args.end() || Include + 1 == Args.end()) {
+      return;
+    }
+    size_t IncludePos = Include - Args.begin();
+    std::string Header = absolutePath(Args[IncludePos + 1], Directory);
+    // the flags that the PCH depends on, i.e. anything but the source file,
+    // the object file and the header itself
+    llvm::MD5 Hash;
+    Hash.update(Header);
+    for (size_t i = 0; i < Args.size(); ++i) {
+      if (i == SourcePos || i == IncludePos || i == IncludePos + 1 ||
+          Args[i] == "-o" || (i > 0 && Args[i - 1] == "-o")) {
+        continue;
+      }
+      Hash.update(Args[i]);
+      Hash.update(llvm::StringRef("\0", 1));
+    }
+    llvm::MD5::MD5Result Result;
+    Hash.final(Result);
+    llvm::SmallString<32> Key;
+    llvm::MD5::stringifyResult(Result, Key);
+    std::shared_future<std::string> PCH;
+    std::promise<std::string> Builder;
+    bool Build = false;
+    {
+      std::lock_guard<std::mutex> Lock(PCHMutex);
+      auto Search = PCHs.find(Key.str().str());
+      if (Search == PCHs.end()) {
+        PCH = Builder.get_future().share();
+        PCHs.insert(std::make_pair(Key.str().str(), PCH));
+        Build = true;
+      } else {
+        PCH = Search->second;
+      }
+    }
+    if (Build) {
+      std::vector<std::string> PCHArgs(Args);
+      PCHArgs.erase(PCHArgs.begin() + IncludePos,
+                    PCHArgs.begin() + IncludePos + 2);
+      try {
+        Builder.set_value(buildPCH(PCHArgs,
+                                   SourcePos > IncludePos ? SourcePos - 2
+                                                          : SourcePos,
+                                   Header, Directory, Key.str().str()));
+      } catch (...) {
+        Builder.set_value("");
+      }
+    }
+    if (!PCH.get().empty()) {
+      Args[IncludePos] = "-include-pch";
+      Args[IncludePos + 1] = PCH.get();
+    }
+  }
+
+public:
+  CompilationDriver(const std::set<std::string> &IgnoredFlags,
+                    const std::vector<std::string> &ExtraArgs,
+                    const std::string &CacheDir)
+      : IgnoredFlags(IgnoredFlags), ExtraArgs(ExtraArgs), CacheDir(CacheDir),
+        CacheHits(0) {}
+
+  size_t getNumCacheHits() const { return CacheHits; }
+
+  /// Compiles the given command into a module of C, or reads it from the
+  /// cache if it has been compiled before.
+  std::unique_ptr<llvm::Module>
+  compile(const clang::tooling::CompileCommand &Cmd,
+          const std::string &SourceFile, llvm::LLVMContext &C) {
+    PROFILE_SCOPE_DETAIL("CompilationDriver::compile", SourceFile);
+    std::vector<std::string> Args;
+    size_t SourcePos = 0;
+    for (size_t i = 0; i < Cmd.CommandLine.size(); ++i) {
+      const std::string &Arg = Cmd.CommandLine[i];
+      if (FlagsWithArgument.count(Arg)) {
+        ++i;
+        continue;
+      }
+      if (IgnoredFlags.count(Arg)) {
+        continue;
+      }
+      if (i > 0 && absolutePath(Arg, Cmd.Directory) == SourceFile) {
+        SourcePos = Args.size();
+        Args.push_back(SourceFile);
+      } else {
+        Args.push_back(Arg);
+      }
+    }
+    if (SourcePos == 0) {
+      throw std::runtime_error("the command for " + SourceFile +
+                               " does not compile it");
+    }
+    Args.insert(Args.end(), ExtraArgs.begin(), ExtraArgs.end());
+    std::string Diagnostics;
+    llvm::raw_string_ostream DiagOS(Diagnostics);
+    auto Diags = createDiagnostics(DiagOS);
+    auto fail = [&]() {
+      return std::runtime_error(SourceFile + " could not be compiled:\n" +
+                                DiagOS.str());
+    };
+    std::string CachedFile;
+    if (!CacheDir.empty()) {
+      // the key covers the compiler, the command line and the preprocessed
+      // source, which is much cheaper to compute than the module itself
+      std::unique_ptr<clang::CompilerInvocation> Invocation =
+          createInvocation(Args, Cmd.Directory, Diags);
+      if (!Invocation) {
+        throw fail();
+      }
+      llvm::MD5 Hash;
+      Hash.update(clang::getClangFullVersion());
+      for (const auto &Arg : Args) {
+        Hash.update(Arg);
+        Hash.update(llvm::StringRef("\0", 1));
+      }
+      HashPreprocessedAction Action(Hash);
+      if (!runAction(*Invocation, Action, Diags)) {
+        throw fail();
+      }
+      llvm::MD5::MD5Result Result;
+      Hash.final(Result);
+      llvm::SmallString<32> Key;
+      llvm::MD5::stringifyResult(Result, Key);
+      CachedFile = CacheDir + "/" + Key.str().str() + ".bc";
+      if (boost::filesystem::exists(CachedFile)) {
+        std::unique_ptr<llvm::Module> M =
+            loadIRFile(CachedFile, C, false, false);
+        M->setModuleIdentifier(SourceFile);
+        ++CacheHits;
+        return M;
+      }
+    }
+    std::unique_ptr<llvm::Module> M;
+    std::vector<std::string> PCHArgs(Args);
+    usePCH(PCHArgs, SourcePos, Cmd.Directory);
+    if (PCHArgs != Args) {
+      // the PCH is merely an optimization, the command is compiled as it is
+      // if the PCH turns out to be unusable
+      std::string PCHDiagnostics;
+      llvm::raw_string_ostream PCHDiagOS(PCHDiagnostics);
+      M = emitModule(PCHArgs, Cmd.Directory, C, createDiagnostics(PCHDiagOS));
+    }
+    if (!M) {
+      M = emitModule(Args, Cmd.Directory, C, Diags);
+    }
+    if (!M) {
+      throw fail();
+    }
+    M->setModuleIdentifier(SourceFile);
+    if (!CachedFile.empty()) {
+      writeBitcode(*M, CachedFile);
+    }
+    return M;
+  }
+};
+
+} // anonymous namespace
+
 ProjectIRDB::ProjectIRDB(enum IRDBOptions Opt) : Options(Opt) {}
 
 ProjectIRDB::ProjectIRDB(const std::vector<std::string> &IRFiles,
                          enum IRDBOptions Opt)
     : Options(Opt) {
+  PAMM_GET_INSTANCE;
+  PROFILE_SCOPE("ProjectIRDB::load");
   for (const auto &File : IRFiles) {
-    source_files.insert(File);
     // if we have a file that is already compiled to llvm ir
-    if (File.find(".ll") != File.npos && boost::filesystem::exists(File)) {
-      llvm::SMDiagnostic Diag;
-      std::unique_ptr<llvm::LLVMContext> C(new llvm::LLVMContext);
-      std::unique_ptr<llvm::Module> M = llvm::parseIRFile(File, Diag, *C);
-      bool broken_debug_info = false;
-      if (M.get() == nullptr)
-        Diag.print(File.c_str(), llvm::errs());
-      /* Crash in presence of llvm-3.9.1 module (segfault) */
-      if (M.get() == nullptr ||
-          llvm::verifyModule(*M, &llvm::errs(), &broken_debug_info)) {
-        throw std::runtime_error(File + " could not be parsed correctly");
-      }
-      if (broken_debug_info) {
-        std::cout << "caution: debug info is broken\n";
-      }
-
-      buildFunctionModuleMapping(M.get());
-      buildGlobalModuleMapping(M.get());
-      contexts.insert(std::make_pair(File, std::move(C)));
-      modules.insert(std::make_pair(File, std::move(M)));
-    } else {
+    if ((File.find(".ll") == File.npos && File.find(".bc") == File.npos) ||
+        !boost::filesystem::exists(File)) {
       throw std::invalid_argument(File + " is not a valid llvm module");
     }
+    source_files.insert(File);
+  }
+  bool Lazy = static_cast<bool>(Options & IRDBOptions::LAZY);
+  bool Verify = !(Options & IRDBOptions::NOVERIFY);
+  // For whole-program analysis all modules are parsed into a single context
+  // right away, linkForWPA() can then link them without re-serializing them.
+  // Module-wise analysis keeps a context per module.
+  bool SharedContext = static_cast<bool>(Options & IRDBOptions::WPA);
+  // the contexts are declared before the modules they own, such that the
+  // modules are destroyed first if a file cannot be parsed
+  std::vector<std::unique_ptr<llvm::LLVMContext>> Contexts(
+      SharedContext ? std::min<size_t>(1, IRFiles.size()) : IRFiles.size());
+  std::vector<std::unique_ptr<llvm::Module>> Modules(IRFiles.size());
+  if (SharedContext) {
+    START_TIMER("IRDB Parse Shared Context", PAMM_SEVERITY_LEVEL::Full);
+    // a context must not be used by several threads at once, so the modules
+    // are parsed one after another
+    if (!Contexts.empty()) {
+      Contexts.front().reset(new llvm::LLVMContext);
+    }
+    for (size_t i = 0; i < IRFiles.size(); ++i) {
+      Modules[i] = loadIRFile(IRFiles[i], *Contexts.front(), Lazy, Verify);
+    }
+    if (!IRFiles.empty()) {
+      contexts.insert(
+          std::make_pair(IRFiles.front(), std::move(Contexts.front())));
+    }
+    STOP_TIMER("IRDB Parse Shared Context", PAMM_SEVERITY_LEVEL::Full);
+  } else {
+    START_TIMER("IRDB Parse Module-wise", PAMM_SEVERITY_LEVEL::Full);
+    // every module has a context of its own, hence they can be parsed in
+    // parallel
+    parallelForEach(IRFiles.size(), 0, [&](size_t i) {
+      Contexts[i].reset(new llvm::LLVMContext);
+      Modules[i] = loadIRFile(IRFiles[i], *Contexts[i], Lazy, Verify);
+    });
+    for (size_t i = 0; i < IRFiles.size(); ++i) {
+      contexts.insert(std::make_pair(IRFiles[i], std::move(Contexts[i])));
+    }
+    STOP_TIMER("IRDB Parse Module-wise", PAMM_SEVERITY_LEVEL::Full);
+  }
+  for (size_t i = 0; i < IRFiles.size(); ++i) {
+    buildFunctionModuleMapping(Modules[i].get());
+    buildGlobalModuleMapping(Modules[i].get());
+    modules.insert(std::make_pair(IRFiles[i], std::move(Modules[i])));
   }
   cout << "All modules loaded\n";
 }
 
+ProjectIRDB::ProjectIRDB(const clang::tooling::CompilationDatabase &CompileDB,
+                         enum IRDBOptions Opt, unsigned Jobs,
+                         const std::string &CacheDir)
+    : Options(Opt) {
+  PAMM_GET_INSTANCE;
+  PROFILE_SCOPE("ProjectIRDB::compile");
+  auto &lg = lg::get();
+  setupHeaderSearchPaths();
+  // a source file may be compiled by several commands, e.g. for a static and
+  // a shared library, only the first of them is used
+  std::vector<clang::tooling::CompileCommand> Commands;
+  std::vector<std::string> SourceFiles;
+  for (auto &Cmd : CompileDB.getAllCompileCommands()) {
+    std::string SourceFile =
+        boost::filesystem::absolute(Cmd.Filename, Cmd.Directory).string();
+    if (source_files.insert(SourceFile).second) {
+      Commands.push_back(std::move(Cmd));
+      SourceFiles.push_back(SourceFile);
+    }
+  }
+  if (!CacheDir.empty()) {
+    boost::filesystem::create_directories(CacheDir);
+  }
+  START_TIMER("IRDB Compilation", PAMM_SEVERITY_LEVEL::Full);
+  CompilationDriver Driver(unknown_flags, header_search_paths, CacheDir);
+  // every module is compiled into a context of its own, as in the module-wise
+  // case of the IR file constructor
+  std::vector<std::unique_ptr<llvm::LLVMContext>> Contexts(Commands.size());
+  std::vector<std::unique_ptr<llvm::Module>> Modules(Commands.size());
+  size_t Threads = parallelForEach(Commands.size(), Jobs, [&](size_t i) {
+    Contexts[i].reset(new llvm::LLVMContext);
+    Modules[i] = Driver.compile(Commands[i], SourceFiles[i], *Contexts[i]);
+  });
+  for (size_t i = 0; i < Commands.size(); ++i) {
+    buildFunctionModuleMapping(Modules[i].get());
+    buildGlobalModuleMapping(Modules[i].get());
+    contexts.insert(std::make_pair(SourceFiles[i], std::move(Contexts[i])));
+    modules.insert(std::make_pair(SourceFiles[i], std::move(Modules[i])));
+  }
+  STOP_TIMER("IRDB Compilation", PAMM_SEVERITY_LEVEL::Full);
+  cached_modules = Driver.getNumCacheHits();
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
+                << "Compiled " << Commands.size() - cached_modules
+                << " of " << Commands.size() << " translation units using "
+                << Threads << " jobs");
+}
+
 ProjectIRDB::~ProjectIRDB() {
   // if the IRDB doesn't own the given pointers, they have to be released before
   // destruction
@@ -112,14 +597,30 @@ ProjectIRDB::~ProjectIRDB() {
       elem.second.release();
     }
   }
+  // cached strings may refer to values that are about to be destroyed
+  LLVMIRPrinter::getInstance().clear();
 }
 
 void ProjectIRDB::setupHeaderSearchPaths() {
-  header_search_paths = splitString(
-      readFile(ConfigurationDirectory + HeaderSearchPathsFileName), "\n");
-  for (auto &path : header_search_paths) {
-    path = std::string("-I") + path;
-  }
+  // the configuration does not change while phasar is running, the file is
+  // therefore read only once
+  static const std::vector<std::string> HeaderSearchPaths = []() {
+    std::vector<std::string> Paths;
+    const std::string File = ConfigurationDirectory + HeaderSearchPathsFileName;
+    if (!boost::filesystem::exists(File)) {
+      auto &lg = lg::get();
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, WARNING)
+                    << "No standard header search paths found in " << File);
+      return Paths;
+    }
+    for (auto &path : splitString(readFile(File), "\n")) {
+      if (!path.empty()) {
+        Paths.push_back(std::string("-I") + path);
+      }
+    }
+    return Paths;
+  }();
+  header_search_paths = HeaderSearchPaths;
 }
 
 void ProjectIRDB::preprocessModule(llvm::Module *M) {
@@ -127,6 +628,8 @@ void ProjectIRDB::preprocessModule(llvm::Module *M) {
   PAMM_GET_INSTANCE;
   auto &lg = lg::get();
   // add moduleID to timer name if performing MWA!
+  PROFILE_SCOPE_DETAIL("ProjectIRDB::preprocessModule",
+                       M->getModuleIdentifier());
   START_TIMER("LLVM Passes", PAMM_SEVERITY_LEVEL::Full);
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
                 << "Preprocess module: " << M->getModuleIdentifier());
@@ -241,45 +744,53 @@ void ProjectIRDB::preprocessModule(llvm::Module *M) {
 void ProjectIRDB::linkForWPA() {
   // Linking llvm modules:
   // Unfortunately linking between different contexts is currently not possible.
-  // Therefore we must load all modules into one single context and then perform
-  // the linkage. This is still very fast compared to compiling and
-  // pre-processing
-  // all modules.
+  // Modules that live in a context of their own are therefore re-loaded into
+  // the context of the main module first. When the IRDB has been constructed
+  // with IRDBOptions::WPA all modules already share a context and this step is
+  // skipped entirely.
   // auto &lg = lg::get();
+  PAMM_GET_INSTANCE;
+  PROFILE_SCOPE("ProjectIRDB::linkForWPA");
   if (modules.size() > 1) {
     llvm::Module *MainMod = getModuleDefiningFunction("main");
     assert(MainMod && "could not find main function");
+    bool SharedContext = true;
+    for (auto &entry : modules) {
+      SharedContext &= &entry.second->getContext() == &MainMod->getContext();
+    }
+    if (SharedContext) {
+      START_TIMER("WPA Linking Shared Context", PAMM_SEVERITY_LEVEL::Full);
+    } else {
+      START_TIMER("WPA Linking Reserialized", PAMM_SEVERITY_LEVEL::Full);
+    }
+    std::vector<std::unique_ptr<llvm::Module>> Pending;
     for (auto &entry : modules) {
       // we do not want to link a module with itself!
       if (MainMod != entry.second.get()) {
-        // reload the modules into the module containing the main function
-        std::string IRBuffer;
-        llvm::raw_string_ostream RSO(IRBuffer);
-        llvm::WriteBitcodeToFile(entry.second.get(), RSO);
-        RSO.flush();
-        llvm::SMDiagnostic ErrorDiagnostics;
-        std::unique_ptr<llvm::MemoryBuffer> MemBuffer =
-            llvm::MemoryBuffer::getMemBuffer(IRBuffer);
-        std::unique_ptr<llvm::Module> TmpMod =
-            llvm::parseIR(*MemBuffer, ErrorDiagnostics, MainMod->getContext());
-        bool broken_debug_info = false;
-        if (TmpMod.get() == nullptr ||
-            llvm::verifyModule(*TmpMod, &llvm::errs(), &broken_debug_info)) {
-          std::cout << "module is broken!\nabort!" << std::endl;
-          DIE_HARD;
-        }
-        if (broken_debug_info) {
-          std::cout << "debug info is broken" << std::endl;
-        }
-        // now we can safely perform the linking
-        if (llvm::Linker::linkModules(*MainMod, std::move(TmpMod),
-                                      llvm::Linker::LinkOnlyNeeded)) {
-          std::cout << "ERROR when trying to link modules for WPA module!"
-                    << std::endl;
-          DIE_HARD;
+        if (&entry.second->getContext() == &MainMod->getContext()) {
+          Pending.push_back(std::move(entry.second));
+        } else {
+          Pending.push_back(
+              reloadIntoContext(*entry.second, MainMod->getContext()));
         }
       }
     }
+    // Merge the remaining modules as a balanced tree, such that no module
+    // is moved by the linker more than log(n) times. The linker is bound to
+    // the (not thread-safe) context, the merges can therefore not run
+    // concurrently. Intermediate merges must keep every definition, as we do
+    // not know yet which of them are needed.
+    for (size_t Width = 1; Width < Pending.size(); Width *= 2) {
+      for (size_t i = 0; i + Width < Pending.size(); i += 2 * Width) {
+        linkInto(*Pending[i], std::move(Pending[i + Width]),
+                 llvm::Linker::Flags::None);
+      }
+    }
+    // now we can safely perform the linking
+    if (!Pending.empty()) {
+      linkInto(*MainMod, std::move(Pending.front()),
+               llvm::Linker::LinkOnlyNeeded);
+    }
     // Update the IRDB reflecting that we now only need 'MainMod' and its
     // corresponding context!
     // delete every other module
@@ -298,17 +809,21 @@ void ProjectIRDB::linkForWPA() {
         ++it;
       }
     }
-    // update functions
-    for (auto &entry : functionToModuleMap) {
-      entry.second = MainMod->getModuleIdentifier();
-    }
-    // update globals
-    for (auto &entry : globals) {
-      entry.second = MainMod->getModuleIdentifier();
+    // the linked modules have been destroyed, rebuild functions and globals
+    functions.clear();
+    functionToModuleMap.clear();
+    globals.clear();
+    buildFunctionModuleMapping(MainMod);
+    buildGlobalModuleMapping(MainMod);
+    if (SharedContext) {
+      STOP_TIMER("WPA Linking Shared Context", PAMM_SEVERITY_LEVEL::Full);
+    } else {
+      STOP_TIMER("WPA Linking Reserialized", PAMM_SEVERITY_LEVEL::Full);
     }
     std::cout << "remaining contexts: " << contexts.size() << std::endl;
     std::cout << "remaining modules: " << modules.size() << std::endl;
     WPAMOD = MainMod;
+    LLVMIRPrinter::getInstance().clear();
   } else if (modules.size() == 1) {
     // In this case we only have one module anyway, so we do not have
     // to link at all. But we have to update the WPAMOD pointer!
@@ -320,6 +835,100 @@ void ProjectIRDB::preprocessIR() {
   for (llvm::Module *M : getAllModules()) {
     preprocessModule(M);
   }
+  // the passes may have changed or annotated values that are already cached
+  LLVMIRPrinter::getInstance().clear();
+}
+
+void ProjectIRDB::materializeReachable(const vector<string> &EntryPoints) {
+  if (!(Options & IRDBOptions::LAZY)) {
+    return;
+  }
+  PAMM_GET_INSTANCE;
+  PROFILE_SCOPE("ProjectIRDB::materializeReachable");
+  START_TIMER("IRDB Materialize", PAMM_SEVERITY_LEVEL::Full);
+  set<llvm::Function *> Reached;
+  vector<llvm::Function *> Worklist;
+  set<const llvm::Constant *> VisitedConstants;
+  auto Reach = [&](llvm::Function *F) {
+    if (F && Reached.insert(F).second) {
+      Worklist.push_back(F);
+    }
+  };
+  // functions may be hidden in arbitrarily nested constant expressions
+  function<void(const llvm::Constant *)> VisitConstant =
+      [&](const llvm::Constant *C) {
+        if (!VisitedConstants.insert(C).second) {
+          return;
+        }
+        if (auto F = llvm::dyn_cast<llvm::Function>(C)) {
+          Reach(const_cast<llvm::Function *>(F));
+        } else if (!llvm::isa<llvm::GlobalValue>(C)) {
+          for (auto &Op : C->operands()) {
+            VisitConstant(llvm::cast<llvm::Constant>(Op));
+          }
+        }
+      };
+  for (auto &EntryPoint : EntryPoints) {
+    Reach(getFunction(EntryPoint));
+  }
+  // virtual function tables and the like are needed by the call-graph
+  // construction, whether they are used by reachable code or not
+  for (auto M : getAllModules()) {
+    for (auto &G : M->globals()) {
+      if (G.hasInitializer()) {
+        VisitConstant(G.getInitializer());
+      }
+    }
+  }
+  while (!Worklist.empty()) {
+    llvm::Function *F = Worklist.back();
+    Worklist.pop_back();
+    if (F->isMaterializable()) {
+      if (auto Err = F->materialize()) {
+        throw runtime_error("could not materialize " + F->getName().str() +
+                            ": " + llvm::toString(move(Err)));
+      }
+    }
+    if (F->isDeclaration()) {
+      // the function may be defined in another module
+      Reach(getFunction(F->getName().str()));
+      continue;
+    }
+    for (auto &BB : *F) {
+      for (auto &I : BB) {
+        for (auto &Op : I.operands()) {
+          if (auto C = llvm::dyn_cast<llvm::Constant>(Op)) {
+            VisitConstant(C);
+          }
+        }
+      }
+    }
+  }
+  size_t Skipped = 0;
+  functions.clear();
+  functionToModuleMap.clear();
+  for (auto M : getAllModules()) {
+    for (auto &F : *M) {
+      if (F.isMaterializable()) {
+        // a declaration neither has local linkage nor a comdat
+        F.deleteBody();
+        F.setComdat(nullptr);
+        ++Skipped;
+      }
+    }
+    bool broken_debug_info = false;
+    if (!(Options & IRDBOptions::NOVERIFY) &&
+        llvm::verifyModule(*M, &llvm::errs(), &broken_debug_info)) {
+      throw runtime_error(M->getModuleIdentifier() +
+                          " is broken after materialization");
+    }
+    buildFunctionModuleMapping(M);
+  }
+  STOP_TIMER("IRDB Materialize", PAMM_SEVERITY_LEVEL::Full);
+  auto &lg = lg::get();
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
+                << "Materialized " << Reached.size()
+                << " reachable functions, skipped " << Skipped);
 }
 
 llvm::Module *ProjectIRDB::getWPAModule() {
@@ -360,6 +969,9 @@ bool ProjectIRDB::containsSourceFile(const std::string &src) {
 llvm::LLVMContext *ProjectIRDB::getLLVMContext(const std::string &name) {
   if (contexts.count(name))
     return contexts[name].get();
+  // modules loaded for WPA share the context of the first module
+  if (modules.count(name))
+    return &modules[name]->getContext();
   return nullptr;
 }
 
@@ -379,30 +991,38 @@ std::set<llvm::Module *> ProjectIRDB::getAllModules() const {
 
 std::size_t ProjectIRDB::getNumberOfModules() { return modules.size(); }
 
+std::size_t ProjectIRDB::getNumberOfCachedModules() const {
+  return cached_modules;
+}
+
 llvm::Module *ProjectIRDB::getModuleDefiningFunction(const std::string &name) {
-  if (functionToModuleMap.count(name)) {
-    return modules[functionToModuleMap[name]].get();
+  auto search = functionToModuleMap.find(name);
+  if (search != functionToModuleMap.end()) {
+    return modules.at(search->second).get();
   }
   return nullptr;
 }
 
 llvm::Function *ProjectIRDB::getFunction(const std::string &name) {
-  if (functionToModuleMap.count(name))
-    return modules[functionToModuleMap[name]]->getFunction(name);
+  auto search = functionToModuleMap.find(name);
+  if (search != functionToModuleMap.end())
+    return modules.at(search->second)->getFunction(name);
   return nullptr;
 }
 
 llvm::GlobalVariable *ProjectIRDB::getGlobalVariable(const std::string &name) {
-  if (globals.count(name))
-    return modules[globals[name]]->getGlobalVariable(name);
+  auto search = globals.find(name);
+  if (search != globals.end())
+    return modules.at(search->second)->getGlobalVariable(name);
   return nullptr;
 }
 
 std::set<std::string> ProjectIRDB::getAllSourceFiles() { return source_files; }
 
 llvm::Instruction *ProjectIRDB::getInstruction(std::size_t id) {
-  if (instructions.count(id))
-    return instructions[id];
+  auto search = instructions.find(id);
+  if (search != instructions.end())
+    return search->second;
   return nullptr;
 }
 
@@ -608,4 +1228,41 @@ set<const llvm::Value *> ProjectIRDB::getAllMemoryLocations() {
   }
   return allMemoryLoc;
 }
+
+map<string, size_t> ProjectIRDB::getFunctionHashes() {
+  map<string, size_t> FunctionHashes;
+  for (auto F : getAllFunctions()) {
+    if (!F->isDeclaration()) {
+      FunctionHashes[F->getName().str()] = computeFunctionHash(F);
+    }
+  }
+  return FunctionHashes;
+}
+
+void ProjectIRDB::exportFunctionHashes(const string &Path) {
+  stringstream SS;
+  for (auto &Entry : getFunctionHashes()) {
+    SS << Entry.first << ' ' << Entry.second << '\n';
+  }
+  writeFile(Path, SS.str());
+}
+
+set<string> ProjectIRDB::getChangedFunctions(const string &Path) {
+  map<string, size_t> PreviousHashes;
+  stringstream SS(readFile(Path));
+  string FunctionName;
+  size_t Hash;
+  while (SS >> FunctionName >> Hash) {
+    PreviousHashes[FunctionName] = Hash;
+  }
+  set<string> ChangedFunctions;
+  for (auto &Entry : getFunctionHashes()) {
+    auto Search = PreviousHashes.find(Entry.first);
+    if (Search == PreviousHashes.end() || Search->second != Entry.second) {
+      ChangedFunctions.insert(Entry.first);
+    }
+  }
+  return ChangedFunctions;
+}
+
 } // namespace psr
@@ -0,0 +1,248 @@
+/******************************************************************************
+ * Copyright (c) 2018 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Instruction.h>
+#include <llvm/IR/Instructions.h>
+
+#include <boost/log/sources/record_ostream.hpp>
+
+#include <phasar/DB/ProjectIRDB.h>
+#include <phasar/PhasarLLVM/ControlFlow/LLVMBasedBiDiICFG.h>
+#include <phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h>
+#include <phasar/Utils/Logger.h>
+#include <phasar/Utils/Profiler.h>
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+LLVMBasedBiDiICFG::LLVMBasedBiDiICFG(LLVMBasedICFG &ICFG) : ICFG(ICFG) {
+  buildIndex();
+}
+
+void LLVMBasedBiDiICFG::buildIndex() {
+  PROFILE_SCOPE("LLVMBasedBiDiICFG::buildIndex");
+  auto &lg = lg::get();
+  // resolve the functions of the call-graph the way
+  // LLVMBasedICFG::getCalleesOfCallAt() does, i.e. prefer the definition
+  auto resolve = [&](LLVMBasedICFG::vertex_t V) -> const llvm::Function * {
+    if (auto F = ICFG.IRDB.getFunction(ICFG.cg[V].functionName)) {
+      return F;
+    }
+    return ICFG.cg[V].function;
+  };
+  LLVMBasedICFG::vertex_iterator vi, vi_end;
+  for (boost::tie(vi, vi_end) = boost::vertices(ICFG.cg); vi != vi_end; ++vi) {
+    const llvm::Function *F = resolve(*vi);
+    MethodsByName[ICFG.cg[*vi].functionName] = F;
+    MethodInfo &MI = Methods[F];
+    if (F->isDeclaration()) {
+      continue;
+    }
+    MI.StartPoints = ICFG.getStartPointsOf(F);
+    MI.ExitPoints = ICFG.getExitPointsOf(F);
+    for (auto &BB : *F) {
+      for (auto &I : BB) {
+        MI.Instructions.push_back(&I);
+        NodeInfo &NI = Nodes[&I];
+        NI.Succs = LLVMBasedCFG::getSuccsOf(&I);
+        for (auto Succ : NI.Succs) {
+          Nodes[Succ].Preds.push_back(&I);
+        }
+        for (auto &Op : I.operands()) {
+          if (llvm::isa<llvm::Argument>(Op)) {
+            MI.ParameterRefs.push_back(&I);
+            break;
+          }
+        }
+        bool IsCall = ICFG.isCallStmt(&I);
+        if (IsCall) {
+          MI.CallSites.insert(&I);
+          NI.ReturnSites = ICFG.getReturnSitesOfCallAt(&I);
+        }
+        if (!IsCall && !isStartPoint(&I)) {
+          NonCallStartNodes.insert(&I);
+        }
+        if (!IsCall && !isExitStmt(&I)) {
+          NonCallEndNodes.insert(&I);
+        }
+      }
+    }
+  }
+  boost::graph_traits<LLVMBasedICFG::bidigraph_t>::edge_iterator ei, ei_end;
+  for (boost::tie(ei, ei_end) = boost::edges(ICFG.cg); ei != ei_end; ++ei) {
+    const llvm::Instruction *CallSite = ICFG.cg[*ei].callsite;
+    const llvm::Function *Callee = resolve(boost::target(*ei, ICFG.cg));
+    Nodes[CallSite].Callees.insert(Callee);
+    Methods[Callee].Callers.insert(CallSite);
+  }
+  for (auto &Entry : Nodes) {
+    for (auto RetSite : Entry.second.ReturnSites) {
+      Nodes[RetSite].IsReturnSite = true;
+    }
+  }
+  // a statement is reachable if its method is part of the call-graph and a
+  // path from the method's start point leads to it
+  for (auto &Entry : Methods) {
+    vector<const llvm::Instruction *> WL(Entry.second.StartPoints.begin(),
+                                         Entry.second.StartPoints.end());
+    while (!WL.empty()) {
+      NodeInfo &NI = Nodes[WL.back()];
+      WL.pop_back();
+      if (!NI.IsReachable) {
+        NI.IsReachable = true;
+        WL.insert(WL.end(), NI.Succs.begin(), NI.Succs.end());
+      }
+    }
+  }
+  LOG_SEV_IF_ENABLE(lg, INFO, "Indexed " << Nodes.size()
+                              << " instructions of " << Methods.size()
+                              << " methods for the bidirectional ICFG");
+}
+
+vector<const llvm::Instruction *>
+LLVMBasedBiDiICFG::getPredsOf(const llvm::Instruction *stmt) {
+  auto Search = Nodes.find(stmt);
+  if (Search != Nodes.end()) {
+    return Search->second.Preds;
+  }
+  return LLVMBasedCFG::getPredsOf(stmt);
+}
+
+vector<const llvm::Instruction *>
+LLVMBasedBiDiICFG::getSuccsOf(const llvm::Instruction *stmt) {
+  auto Search = Nodes.find(stmt);
+  if (Search != Nodes.end()) {
+    return Search->second.Succs;
+  }
+  return LLVMBasedCFG::getSuccsOf(stmt);
+}
+
+vector<const llvm::Instruction *>
+LLVMBasedBiDiICFG::getAllInstructionsOf(const llvm::Function *fun) {
+  auto Search = Methods.find(fun);
+  if (Search != Methods.end()) {
+    return Search->second.Instructions;
+  }
+  return LLVMBasedCFG::getAllInstructionsOf(fun);
+}
+
+bool LLVMBasedBiDiICFG::isCallStmt(const llvm::Instruction *stmt) {
+  return ICFG.isCallStmt(stmt);
+}
+
+const llvm::Function *LLVMBasedBiDiICFG::getMethod(const string &fun) {
+  auto Search = MethodsByName.find(fun);
+  if (Search != MethodsByName.end()) {
+    return Search->second;
+  }
+  return ICFG.getMethod(fun);
+}
+
+set<const llvm::Instruction *> LLVMBasedBiDiICFG::allNonCallStartNodes() {
+  return NonCallStartNodes;
+}
+
+set<const llvm::Function *>
+LLVMBasedBiDiICFG::getCalleesOfCallAt(const llvm::Instruction *stmt) {
+  auto Search = Nodes.find(stmt);
+  if (Search != Nodes.end()) {
+    return Search->second.Callees;
+  }
+  return {};
+}
+
+set<const llvm::Instruction *>
+LLVMBasedBiDiICFG::getCallersOf(const llvm::Function *fun) {
+  // callers are recorded for the definition of a function
+  auto Name = MethodsByName.find(fun->getName().str());
+  if (Name != MethodsByName.end()) {
+    return Methods.at(Name->second).Callers;
+  }
+  return {};
+}
+
+set<const llvm::Instruction *>
+LLVMBasedBiDiICFG::getCallsFromWithin(const llvm::Function *fun) {
+  auto Search = Methods.find(fun);
+  if (Search != Methods.end()) {
+    return Search->second.CallSites;
+  }
+  return ICFG.getCallsFromWithin(fun);
+}
+
+set<const llvm::Instruction *>
+LLVMBasedBiDiICFG::getStartPointsOf(const llvm::Function *fun) {
+  auto Search = Methods.find(fun);
+  if (Search != Methods.end()) {
+    return Search->second.StartPoints;
+  }
+  return ICFG.getStartPointsOf(fun);
+}
+
+set<const llvm::Instruction *>
+LLVMBasedBiDiICFG::getExitPointsOf(const llvm::Function *fun) {
+  auto Search = Methods.find(fun);
+  if (Search != Methods.end()) {
+    return Search->second.ExitPoints;
+  }
+  return ICFG.getExitPointsOf(fun);
+}
+
+set<const llvm::Instruction *>
+LLVMBasedBiDiICFG::getReturnSitesOfCallAt(const llvm::Instruction *stmt) {
+  auto Search = Nodes.find(stmt);
+  if (Search != Nodes.end()) {
+    return Search->second.ReturnSites;
+  }
+  return ICFG.getReturnSitesOfCallAt(stmt);
+}
+
+set<const llvm::Instruction *>
+LLVMBasedBiDiICFG::getEndPointsOf(const llvm::Function *fun) {
+  return getExitPointsOf(fun);
+}
+
+vector<const llvm::Instruction *>
+LLVMBasedBiDiICFG::getPredsOfCallAt(const llvm::Instruction *stmt) {
+  auto Search = Nodes.find(stmt);
+  if (Search != Nodes.end() && isCallStmt(stmt)) {
+    return Search->second.Preds;
+  }
+  return {};
+}
+
+set<const llvm::Instruction *> LLVMBasedBiDiICFG::allNonCallEndNodes() {
+  return NonCallEndNodes;
+}
+
+vector<const llvm::Instruction *>
+LLVMBasedBiDiICFG::getParameterRefs(const llvm::Function *fun) {
+  auto Search = Methods.find(fun);
+  if (Search != Methods.end()) {
+    return Search->second.ParameterRefs;
+  }
+  return {};
+}
+
+bool LLVMBasedBiDiICFG::isReturnSite(const llvm::Instruction *stmt) {
+  auto Search = Nodes.find(stmt);
+  return Search != Nodes.end() && Search->second.IsReturnSite;
+}
+
+bool LLVMBasedBiDiICFG::isReachable(const llvm::Instruction *stmt) {
+  auto Search = Nodes.find(stmt);
+  return Search != Nodes.end() && Search->second.IsReachable;
+}
+
+json LLVMBasedBiDiICFG::getAsJson() { return ICFG.getAsJson(); }
+
+} // namespace psr
@@ -14,7 +14,10 @@
  *      Author: pdschbrt
  */
 
+#include <algorithm>
+#include <functional>
 #include <memory>
+#include <unordered_map>
 
 #include <llvm/IR/CallSite.h>
 #include <llvm/IR/Constants.h>
@@ -40,6 +43,8 @@
 #include <phasar/Utils/Logger.h>
 #include <phasar/Utils/Macros.h>
 #include <phasar/Utils/PAMMMacros.h>
+#include <phasar/Utils/Profiler.h>
+#include <phasar/Utils/ResultWriter.h>
 
 #include <phasar/DB/ProjectIRDB.h>
 #include <phasar/PhasarLLVM/Pointer/LLVMTypeHierarchy.h>
@@ -77,30 +82,12 @@ LLVMBasedICFG::LLVMBasedICFG(LLVMTypeHierarchy &STH, ProjectIRDB &IRDB,
                              const vector<string> &EntryPoints)
     : CGType(CGType), CH(STH), IRDB(IRDB) {
   PAMM_GET_INSTANCE;
+  PROFILE_SCOPE("LLVMBasedICFG::construct");
   auto &lg = lg::get();
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
                 << "Starting CallGraphAnalysisType: " << CGType);
   VisitedFunctions.reserve(IRDB.getAllFunctions().size());
-  unique_ptr<Resolver> resolver(
-      [CGType, &IRDB, &STH, this]() -> unique_ptr<Resolver> {
-        switch (CGType) {
-        case (CallGraphAnalysisType::CHA):
-          return make_unique<CHAResolver>(IRDB, STH);
-          break;
-        case (CallGraphAnalysisType::RTA):
-          return make_unique<RTAResolver>(IRDB, STH);
-          break;
-        case (CallGraphAnalysisType::DTA):
-          return make_unique<DTAResolver>(IRDB, STH);
-          break;
-        case (CallGraphAnalysisType::OTF):
-          return make_unique<OTFResolver>(IRDB, STH, WholeModulePTG);
-          break;
-        default:
-          throw runtime_error("Resolver strategy not properly instantiated");
-          break;
-        }
-      }());
+  unique_ptr<Resolver> resolver = makeResolver();
   for (auto &EntryPoint : EntryPoints) {
     llvm::Function *F = IRDB.getFunction(EntryPoint);
     if (F == nullptr) {
@@ -125,6 +112,7 @@ LLVMBasedICFG::LLVMBasedICFG(LLVMTypeHierarchy &STH, ProjectIRDB &IRDB,
                              CallGraphAnalysisType CGType,
                              vector<string> EntryPoints)
     : CGType(CGType), CH(STH), IRDB(IRDB) {
+  PROFILE_SCOPE_DETAIL("LLVMBasedICFG::construct", M.getModuleIdentifier());
   auto &lg = lg::get();
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
                 << "Starting CallGraphAnalysisType: " << CGType);
@@ -134,26 +122,7 @@ LLVMBasedICFG::LLVMBasedICFG(LLVMTypeHierarchy &STH, ProjectIRDB &IRDB,
       EntryPoints.push_back(F.getName().str());
     }
   }
-  unique_ptr<Resolver> resolver(
-      [CGType, &IRDB, &STH, this]() -> unique_ptr<Resolver> {
-        switch (CGType) {
-        case (CallGraphAnalysisType::CHA):
-          return make_unique<CHAResolver>(IRDB, STH);
-          break;
-        case (CallGraphAnalysisType::RTA):
-          return make_unique<RTAResolver>(IRDB, STH);
-          break;
-        case (CallGraphAnalysisType::DTA):
-          return make_unique<DTAResolver>(IRDB, STH);
-          break;
-        case (CallGraphAnalysisType::OTF):
-          return make_unique<OTFResolver>(IRDB, STH, WholeModulePTG);
-          break;
-        default:
-          throw runtime_error("Resolver strategy not properly instantiated");
-          break;
-        }
-      }());
+  unique_ptr<Resolver> resolver = makeResolver();
   for (auto &EntryPoint : EntryPoints) {
     llvm::Function *F = M.getFunction(EntryPoint);
     if (F && !F->isDeclaration()) {
@@ -165,9 +134,83 @@ LLVMBasedICFG::LLVMBasedICFG(LLVMTypeHierarchy &STH, ProjectIRDB &IRDB,
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO) << "Call graph has been constructed");
 }
 
+unique_ptr<Resolver> LLVMBasedICFG::makeResolver() {
+  switch (CGType) {
+  case (CallGraphAnalysisType::CHA):
+    return make_unique<CHAResolver>(IRDB, CH);
+    break;
+  case (CallGraphAnalysisType::RTA):
+    return make_unique<RTAResolver>(IRDB, CH);
+    break;
+  case (CallGraphAnalysisType::DTA):
+    return make_unique<DTAResolver>(IRDB, CH);
+    break;
+  case (CallGraphAnalysisType::OTF):
+    return make_unique<OTFResolver>(IRDB, CH, WholeModulePTG);
+    break;
+  default:
+    throw runtime_error("Resolver strategy not properly instantiated");
+    break;
+  }
+}
+
+void LLVMBasedICFG::restoreWholeModulePTG(const vector<string> &EntryPoints) {
+  // Replay the merges of the points-to graphs in the order of the call graph
+  // construction, the callee's points-to graph is merged at every call-site
+  // by the OTF resolver only.
+  unordered_set<const llvm::Function *> Walked;
+  function<void(const llvm::Function *)> Walk = [&](const llvm::Function *F) {
+    if (F->isDeclaration() || !Walked.insert(F).second) {
+      return;
+    }
+    auto Search = function_vertex_map.find(F->getName().str());
+    if (Search == function_vertex_map.end()) {
+      return;
+    }
+    unordered_map<const llvm::Instruction *, vector<const llvm::Function *>>
+        Targets;
+    for (auto E :
+         boost::make_iterator_range(boost::out_edges(Search->second, cg))) {
+      Targets[cg[E].callsite].push_back(cg[boost::target(E, cg)].function);
+    }
+    for (llvm::const_inst_iterator I = llvm::inst_begin(F),
+                                   End = llvm::inst_end(F);
+         I != End; ++I) {
+      auto CallTargets = Targets.find(&*I);
+      if (CallTargets == Targets.end()) {
+        continue;
+      }
+      // the construction walks the targets of a call-site in a std::set
+      std::sort(CallTargets->second.begin(), CallTargets->second.end());
+      if (CGType == CallGraphAnalysisType::OTF) {
+        for (auto Target : CallTargets->second) {
+          if (!Target->isDeclaration()) {
+            WholeModulePTG.mergeWith(
+                *IRDB.getPointsToGraph(Target->getName().str()),
+                llvm::ImmutableCallSite(&*I), Target);
+          }
+        }
+      }
+      for (auto Target : CallTargets->second) {
+        Walk(Target);
+      }
+    }
+  };
+  for (auto &EntryPoint : EntryPoints) {
+    const llvm::Function *F = IRDB.getFunction(EntryPoint);
+    if (!F) {
+      throw runtime_error("unknown entry point: " + EntryPoint);
+    }
+    WholeModulePTG.mergeWith(*IRDB.getPointsToGraph(EntryPoint), F);
+    Walk(F);
+  }
+}
+
 void LLVMBasedICFG::constructionWalker(const llvm::Function *F,
                                        Resolver *resolver) {
   PAMM_GET_INSTANCE;
+  // recursive, hence only the self time of each function is of interest
+  PROFILE_METHOD("LLVMBasedICFG::constructionWalker", F->getName().str());
   static bool first_function = true;
   auto &lg = lg::get();
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
@@ -316,10 +359,12 @@ LLVMBasedICFG::getCalleesOfCallAt(const llvm::Instruction *n) {
   if (llvm::isa<llvm::CallInst>(n) || llvm::isa<llvm::InvokeInst>(n)) {
     llvm::ImmutableCallSite CS(n);
     set<const llvm::Function *> Callees;
-    string CallerName = CS->getFunction()->getName().str();
+    auto Caller = function_vertex_map.find(CS->getFunction()->getName().str());
+    if (Caller == function_vertex_map.end()) {
+      return Callees;
+    }
     out_edge_iterator ei, ei_end;
-    for (boost::tie(ei, ei_end) =
-             boost::out_edges(function_vertex_map[CallerName], cg);
+    for (boost::tie(ei, ei_end) = boost::out_edges(Caller->second, cg);
          ei != ei_end; ++ei) {
       auto source = boost::source(*ei, cg);
       auto edge = cg[*ei];
@@ -351,9 +396,12 @@ LLVMBasedICFG::getCalleesOfCallAt(const llvm::Instruction *n) {
 set<const llvm::Instruction *>
 LLVMBasedICFG::getCallersOf(const llvm::Function *m) {
   set<const llvm::Instruction *> CallersOf;
+  auto Callee = function_vertex_map.find(m->getName().str());
+  if (Callee == function_vertex_map.end()) {
+    return CallersOf;
+  }
   in_edge_iterator ei, ei_end;
-  for (boost::tie(ei, ei_end) =
-           boost::in_edges(function_vertex_map[m->getName().str()], cg);
+  for (boost::tie(ei, ei_end) = boost::in_edges(Callee->second, cg);
        ei != ei_end; ++ei) {
     auto source = boost::source(*ei, cg);
     auto edge = cg[*ei];
@@ -528,6 +576,30 @@ void LLVMBasedICFG::mergeWith(const LLVMBasedICFG &other) {
   WholeModulePTG.mergeWith(other.WholeModulePTG, Calls);
 }
 
+void LLVMBasedICFG::updateFunctions(
+    const set<const llvm::Function *> &Functions) {
+  PROFILE_SCOPE("LLVMBasedICFG::updateFunctions");
+  auto &lg = lg::get();
+  unique_ptr<Resolver> resolver = makeResolver();
+  for (auto F : Functions) {
+    auto Search = function_vertex_map.find(F->getName().str());
+    if (Search != function_vertex_map.end()) {
+      boost::clear_out_edges(Search->second, cg);
+      cg[Search->second] = VertexProperties(F, F->isDeclaration());
+    }
+    VisitedFunctions.erase(F);
+  }
+  for (auto F : Functions) {
+    // functions that are not part of the call-graph are still unreachable,
+    // unless an edited caller reaches them which is handled by the walker
+    if (function_vertex_map.count(F->getName().str())) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, DEBUG)
+                    << "Updating call-graph for: " << F->getName().str());
+      constructionWalker(F, resolver.get());
+    }
+  }
+}
+
 bool LLVMBasedICFG::isPrimitiveFunction(const string &name) {
   for (auto &BB : *IRDB.getFunction(name)) {
     for (auto &I : BB) {
@@ -583,6 +655,30 @@ json LLVMBasedICFG::getAsJson() {
   return J;
 }
 
+void LLVMBasedICFG::emitAsJson(JsonStreamWriter &W) {
+  vertex_iterator vi_v, vi_v_end;
+  out_edge_iterator ei, ei_end;
+  W.beginObject();
+  W.key(JsonCallGraphID);
+  W.beginObject();
+  for (boost::tie(vi_v, vi_v_end) = boost::vertices(cg); vi_v != vi_v_end;
+       ++vi_v) {
+    W.key(cg[*vi_v].functionName);
+    boost::tie(ei, ei_end) = boost::out_edges(*vi_v, cg);
+    if (ei == ei_end) {
+      W.null();
+      continue;
+    }
+    W.beginArray();
+    for (; ei != ei_end; ++ei) {
+      W.value(cg[boost::target(*ei, cg)].functionName);
+    }
+    W.endArray();
+  }
+  W.endObject();
+  W.endObject();
+}
+
 PointsToGraph &LLVMBasedICFG::getWholeModulePTG() { return WholeModulePTG; }
 
 vector<string> LLVMBasedICFG::getDependencyOrderedFunctions() {
@@ -26,6 +26,7 @@
 #include <phasar/PhasarLLVM/Pointer/LLVMTypeHierarchy.h>
 #include <phasar/Utils/LLVMShorthands.h>
 #include <phasar/Utils/Logger.h>
+#include <phasar/Utils/Profiler.h>
 
 using namespace std;
 using namespace psr;
@@ -34,6 +35,8 @@ CHAResolver::CHAResolver(ProjectIRDB &irdb, LLVMTypeHierarchy &ch)
     : Resolver(irdb, ch) {}
 
 set<string> CHAResolver::resolveVirtualCall(const llvm::ImmutableCallSite &CS) {
+  PROFILE_METHOD("CHAResolver::resolveVirtualCall",
+                 CS.getCaller()->getName().str());
   set<string> possible_call_targets;
   auto &lg = lg::get();
 
@@ -28,6 +28,7 @@
 #include <phasar/Utils/LLVMShorthands.h>
 #include <phasar/Utils/Logger.h>
 #include <phasar/Utils/Macros.h>
+#include <phasar/Utils/Profiler.h>
 
 using namespace std;
 using namespace psr;
@@ -159,6 +160,8 @@ void DTAResolver::OtherInst(const llvm::Instruction *Inst) {
 }
 
 set<string> DTAResolver::resolveVirtualCall(const llvm::ImmutableCallSite &CS) {
+  PROFILE_METHOD("DTAResolver::resolveVirtualCall",
+                 CS.getCaller()->getName().str());
   set<string> possible_call_targets;
   auto &lg = lg::get();
 
@@ -27,6 +27,7 @@
 #include <phasar/Utils/LLVMShorthands.h>
 #include <phasar/Utils/Logger.h>
 #include <phasar/Utils/Macros.h>
+#include <phasar/Utils/Profiler.h>
 
 using namespace std;
 using namespace psr;
@@ -77,6 +78,8 @@ void OTFResolver::postCall(const llvm::Instruction *Inst) {
 void OTFResolver::OtherInst(const llvm::Instruction *Inst) {}
 
 set<string> OTFResolver::resolveVirtualCall(const llvm::ImmutableCallSite &CS) {
+  PROFILE_METHOD("OTFResolver::resolveVirtualCall",
+                 CS.getCaller()->getName().str());
   set<string> possible_call_targets;
   auto &lg = lg::get();
 
@@ -27,6 +27,7 @@
 #include <phasar/Utils/LLVMShorthands.h>
 #include <phasar/Utils/Logger.h>
 #include <phasar/Utils/Macros.h>
+#include <phasar/Utils/Profiler.h>
 
 using namespace std;
 using namespace psr;
@@ -48,6 +49,8 @@ void RTAResolver::firstFunction(const llvm::Function *F) {
 }
 
 set<string> RTAResolver::resolveVirtualCall(const llvm::ImmutableCallSite &CS) {
+  PROFILE_METHOD("RTAResolver::resolveVirtualCall",
+                 CS.getCaller()->getName().str());
   // throw runtime_error("RTA is currently unabled to deal with already built "
   //                     "library, it has been disable until this is fixed");
 
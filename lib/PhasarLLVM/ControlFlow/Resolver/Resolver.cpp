@@ -23,6 +23,7 @@
 #include <phasar/PhasarLLVM/Pointer/LLVMTypeHierarchy.h>
 #include <phasar/Utils/LLVMShorthands.h>
 #include <phasar/Utils/Logger.h>
+#include <phasar/Utils/Profiler.h>
 
 using namespace std;
 using namespace psr;
@@ -109,6 +110,8 @@ void Resolver::firstFunction(const llvm::Function *F) {}
 
 set<string>
 Resolver::resolveFunctionPointer(const llvm::ImmutableCallSite &CS) {
+  PROFILE_METHOD("Resolver::resolveFunctionPointer",
+                 CS.getCaller()->getName().str());
   // We may want to optimise the time of this function as it is in fact most of
   // the time spent in the ICFG construction and it grows rapidily
   auto &lg = lg::get();
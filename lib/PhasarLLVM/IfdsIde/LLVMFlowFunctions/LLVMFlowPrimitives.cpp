@@ -0,0 +1,52 @@
+/******************************************************************************
+ * Copyright (c) 2018 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <algorithm>
+
+#include <llvm/IR/Function.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+
+#include <phasar/PhasarLLVM/IfdsIde/LLVMFlowFunctions/LLVMFlowPrimitives.h>
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+CallSiteParameterMapping::CallSiteParameterMapping(
+    llvm::ImmutableCallSite CallSite, const llvm::Function *Callee)
+    : CallSite(CallSite), Callee(Callee) {
+  // Set up the actual parameters
+  ActualIndices.reserve(CallSite.getNumArgOperands());
+  for (unsigned Idx = 0; Idx < CallSite.getNumArgOperands(); ++Idx) {
+    ActualIndices.emplace_back(CallSite.getArgOperand(Idx), Idx);
+  }
+  std::sort(ActualIndices.begin(), ActualIndices.end());
+  // Set up the formal parameters
+  for (auto &Formal : Callee->args()) {
+    Formals.push_back(&Formal);
+  }
+  // Find the allocations of %struct.__va_list_tag
+  if (Callee->isVarArg() && !Callee->isDeclaration()) {
+    for (auto &I : llvm::instructions(Callee)) {
+      if (auto Alloc = llvm::dyn_cast<llvm::AllocaInst>(&I)) {
+        auto AllocType = Alloc->getAllocatedType();
+        if (AllocType->isArrayTy() && AllocType->getArrayNumElements() > 0 &&
+            AllocType->getArrayElementType()->isStructTy() &&
+            AllocType->getArrayElementType()->getStructName() ==
+                "struct.__va_list_tag") {
+          VarArgLists.push_back(Alloc);
+        }
+      }
+    }
+  }
+}
+
+} // namespace psr
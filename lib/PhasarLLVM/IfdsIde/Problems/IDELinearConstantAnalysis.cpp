@@ -40,9 +40,9 @@ using namespace psr;
 
 namespace psr {
 // Initialize debug counter for edge functions
-unsigned IDELinearConstantAnalysis::CurrGenConstant_Id = 0;
-unsigned IDELinearConstantAnalysis::CurrLCAID_Id = 0;
-unsigned IDELinearConstantAnalysis::CurrBinary_Id = 0;
+atomic<unsigned> IDELinearConstantAnalysis::CurrGenConstant_Id(0);
+atomic<unsigned> IDELinearConstantAnalysis::CurrLCAID_Id(0);
+atomic<unsigned> IDELinearConstantAnalysis::CurrBinary_Id(0);
 
 const IDELinearConstantAnalysis::v_t IDELinearConstantAnalysis::TOP =
     numeric_limits<IDELinearConstantAnalysis::v_t>::min();
@@ -56,6 +56,7 @@ IDELinearConstantAnalysis::IDELinearConstantAnalysis(
     : LLVMDefaultIDETabulationProblem(icfg, th, irdb),
       EntryPoints(EntryPoints) {
   LLVMDefaultIDETabulationProblem::zerovalue = createZeroValue();
+  solver_config.shareFlowEdgeFunctions = true;
 }
 
 IDELinearConstantAnalysis::~IDELinearConstantAnalysis() {
@@ -36,6 +36,7 @@ IDETaintAnalysis::IDETaintAnalysis(IDETaintAnalysis::i_t icfg,
     : LLVMDefaultIDETabulationProblem(icfg, th, irdb),
       EntryPoints(EntryPoints) {
   DefaultIDETabulationProblem::zerovalue = createZeroValue();
+  solver_config.shareFlowEdgeFunctions = true;
 }
 
 // start formulating our analysis by specifying the parts required for IFDS
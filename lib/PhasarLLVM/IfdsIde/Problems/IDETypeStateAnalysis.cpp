@@ -26,6 +26,7 @@
 #include <phasar/PhasarLLVM/IfdsIde/LLVMFlowFunctions/MapFactsToCaller.h>
 #include <phasar/PhasarLLVM/IfdsIde/LLVMZeroValue.h>
 #include <phasar/PhasarLLVM/IfdsIde/Problems/IDETypeStateAnalysis.h>
+#include <phasar/PhasarLLVM/Pointer/AliasOracle.h>
 
 #include <phasar/Utils/LLVMShorthands.h>
 
@@ -63,6 +64,10 @@ IDETypeStateAnalysis::IDETypeStateAnalysis(IDETypeStateAnalysis::i_t icfg,
   DefaultIDETabulationProblem::zerovalue = createZeroValue();
 }
 
+void IDETypeStateAnalysis::setAliasOracle(AliasOracle &Oracle) {
+  Aliases = &Oracle;
+}
+
 // start formulating our analysis by specifying the parts required for IFDS
 
 shared_ptr<FlowFunction<IDETypeStateAnalysis::d_t>>
@@ -313,7 +318,10 @@ IDETypeStateAnalysis::getCallToRetEdgeFunction(
         (llvm::isa<llvm::LoadInst>(CS.getArgOperand(0)) &&
          callNode == retSiteNode &&
          callNode == llvm::dyn_cast<llvm::LoadInst>(CS.getArgOperand(0))
-                         ->getPointerOperand())) {
+                         ->getPointerOperand()) ||
+        (Aliases && callNode == retSiteNode && !isZeroValue(callNode) &&
+         Aliases->getAliasesOf(CS.getArgOperand(0), callSite)
+             .count(callNode))) {
       cout << "fclose processing for: ";
       printDataFlowFact(cout, callNode);
       cout << endl;
@@ -42,9 +42,10 @@ IFDSConstAnalysis::IFDSConstAnalysis(IFDSConstAnalysis::i_t icfg,
       ptg(icfg.getWholeModulePTG()), AllMemLocs(AllMemLocs),
       EntryPoints(EntryPoints) {
   PAMM_GET_INSTANCE;
-  REG_HISTOGRAM("Context-relevant Pointer", PAMM_SEVERITY_LEVEL::Full);
-  REG_COUNTER("[Calls] getContextRelevantPointsToSet", 0,
-              PAMM_SEVERITY_LEVEL::Full);
+  // shared by all instances that run in parallel, e.g. one per entry point
+  REG_SHARED_HISTOGRAM("Context-relevant Pointer", PAMM_SEVERITY_LEVEL::Full);
+  REG_SHARED_COUNTER("[Calls] getContextRelevantPointsToSet",
+                     PAMM_SEVERITY_LEVEL::Full);
   IFDSConstAnalysis::zerovalue = createZeroValue();
 }
 
@@ -387,9 +388,11 @@ void IFDSConstAnalysis::printIFDSReport(
     os << "No immutable memory locations found!\n";
   } else {
     os << "Immutable/const stack and/or heap memory locations:\n";
-    for (auto memloc : AllMemLocs) {
-      os << "\nIR  : " << llvmIRToString(memloc) << '\n'
-         << llvmValueToSrc(memloc) << "\n";
+    vector<const llvm::Value *> MemLocs(AllMemLocs.begin(), AllMemLocs.end());
+    auto Src = llvmValuesToSrc(MemLocs);
+    for (size_t i = 0; i < MemLocs.size(); ++i) {
+      os << "\nIR  : " << llvmIRToString(MemLocs[i]) << '\n'
+         << Src[i] << "\n";
     }
   }
   os << "\n===================================================\n";
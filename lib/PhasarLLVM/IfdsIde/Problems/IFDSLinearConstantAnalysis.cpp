@@ -51,6 +51,7 @@ IFDSLinearConstantAnalysis::IFDSLinearConstantAnalysis(
     : LLVMDefaultIFDSTabulationProblem(icfg, th, irdb),
       EntryPoints(EntryPoints) {
   IFDSLinearConstantAnalysis::zerovalue = createZeroValue();
+  solver_config.shareFlowEdgeFunctions = true;
 }
 
 shared_ptr<FlowFunction<IFDSLinearConstantAnalysis::d_t>>
@@ -31,6 +31,7 @@ IFDSSolverTest::IFDSSolverTest(IFDSSolverTest::i_t icfg,
     : LLVMDefaultIFDSTabulationProblem(icfg, th, irdb),
       EntryPoints(EntryPoints) {
   IFDSSolverTest::zerovalue = createZeroValue();
+  solver_config.shareFlowEdgeFunctions = true;
 }
 
 shared_ptr<FlowFunction<IFDSSolverTest::d_t>>
@@ -26,6 +26,7 @@
 #include <phasar/PhasarLLVM/IfdsIde/LLVMZeroValue.h>
 #include <phasar/PhasarLLVM/IfdsIde/Problems/IFDSTaintAnalysis.h>
 #include <phasar/PhasarLLVM/IfdsIde/SpecialSummaries.h>
+#include <phasar/PhasarLLVM/Pointer/AliasOracle.h>
 
 #include <phasar/Utils/LLVMIRToSrc.h>
 #include <phasar/Utils/LLVMShorthands.h>
@@ -45,6 +46,10 @@ IFDSTaintAnalysis::IFDSTaintAnalysis(i_t icfg, const LLVMTypeHierarchy &th,
   IFDSTaintAnalysis::zerovalue = createZeroValue();
 }
 
+void IFDSTaintAnalysis::setAliasOracle(AliasOracle &Oracle) {
+  Aliases = &Oracle;
+}
+
 shared_ptr<FlowFunction<IFDSTaintAnalysis::d_t>>
 IFDSTaintAnalysis::getNormalFlowFunction(IFDSTaintAnalysis::n_t curr,
                                          IFDSTaintAnalysis::n_t succ) {
@@ -157,7 +162,8 @@ IFDSTaintAnalysis::getCallToRetFlowFunction(
         // Insert the value V that gets tainted
         ToGenerate.insert(V);
         // We also have to collect all aliases of V and generate them
-        auto PTS = icfg.getWholeModulePTG().getPointsToSet(V);
+        auto PTS = Aliases ? Aliases->getAliasesOf(V, callSite)
+                           : icfg.getWholeModulePTG().getPointsToSet(V);
         for (auto Alias : PTS) {
           ToGenerate.insert(Alias);
         }
@@ -27,6 +27,7 @@ IFDSTypeAnalysis::IFDSTypeAnalysis(IFDSTypeAnalysis::i_t icfg,
     : LLVMDefaultIFDSTabulationProblem(icfg, th, irdb),
       EntryPoints(EntryPoints) {
   IFDSTypeAnalysis::zerovalue = createZeroValue();
+  solver_config.shareFlowEdgeFunctions = true;
 }
 
 shared_ptr<FlowFunction<IFDSTypeAnalysis::d_t>>
@@ -22,7 +22,12 @@ ostream &operator<<(ostream &os, const SolverConfiguration &sc) {
             << "\tautoAddZero: " << sc.autoAddZero << "\n"
             << "\tcomputeValues: " << sc.computeValues << "\n"
             << "\trecordEdges: " << sc.recordEdges << "\n"
-            << "\tcomputePersistedSummaries: " << sc.computePersistedSummaries;
+            << "\tcomputePersistedSummaries: " << sc.computePersistedSummaries
+            << "\n"
+            << "\tcollectFinishedMethods: " << sc.collectFinishedMethods << "\n"
+            << "\tincremental: " << sc.incremental << "\n"
+            << "\tshareFlowEdgeFunctions: " << sc.shareFlowEdgeFunctions << "\n"
+            << "\tedgeLogFile: " << sc.edgeLogFile;
 }
 
 } // namespace psr
@@ -27,8 +27,8 @@ namespace psr {
 
 AnalysisPluginController::AnalysisPluginController(
     vector<string> AnalysisPlygins, LLVMBasedICFG &ICFG,
-    vector<string> EntryPoints, json &Results)
-    : FinalResultsJson(Results) {
+    vector<string> EntryPoints, ResultsExporter ExportResults)
+    : ExportResults(ExportResults) {
   auto &lg = lg::get();
   for (const auto &AnalysisPlugin : AnalysisPlygins) {
     SOL SharedLib(AnalysisPlugin);
@@ -48,7 +48,7 @@ AnalysisPluginController::AnalysisPluginController(
         LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> llvmifdstestsolver(
             *plugin, true);
         llvmifdstestsolver.solve();
-        FinalResultsJson += llvmifdstestsolver.getAsJson();
+        ExportResults(llvmifdstestsolver);
       }
     }
     if (!InterMonoProblemPluginFactory.empty()) {
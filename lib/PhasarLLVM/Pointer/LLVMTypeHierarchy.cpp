@@ -39,6 +39,7 @@
 #include <phasar/Utils/Logger.h>
 #include <phasar/Utils/Macros.h>
 #include <phasar/Utils/PAMMMacros.h>
+#include <phasar/Utils/Profiler.h>
 
 using namespace psr;
 using namespace std;
@@ -55,6 +56,7 @@ LLVMTypeHierarchy::VertexProperties::VertexProperties(llvm::StructType *Type,
 
 LLVMTypeHierarchy::LLVMTypeHierarchy(ProjectIRDB &IRDB) {
   PAMM_GET_INSTANCE;
+  PROFILE_SCOPE("LLVMTypeHierarchy::construct");
   auto &lg = lg::get();
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO) << "Construct type hierarchy");
   for (auto M : IRDB.getAllModules()) {
@@ -66,6 +68,8 @@ LLVMTypeHierarchy::LLVMTypeHierarchy(ProjectIRDB &IRDB) {
 
 LLVMTypeHierarchy::LLVMTypeHierarchy(const llvm::Module &M) {
   PAMM_GET_INSTANCE;
+  PROFILE_SCOPE_DETAIL("LLVMTypeHierarchy::construct",
+                       M.getModuleIdentifier());
   auto &lg = lg::get();
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO) << "Construct type hierarchy");
   buildLLVMTypeHierarchy(M);
@@ -79,6 +83,10 @@ void LLVMTypeHierarchy::buildLLVMTypeHierarchy(const llvm::Module &M) {
   // reconstruct all available vtables
   reconstructVTables(M);
   // cache the reachable types
+  computeReachableTypes();
+}
+
+void LLVMTypeHierarchy::computeReachableTypes() {
   bidigraph_t tc;
   boost::transitive_closure(g, tc);
   for (auto V : boost::make_iterator_range(boost::vertices(g))) {
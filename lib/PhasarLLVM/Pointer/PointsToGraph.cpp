@@ -30,10 +30,12 @@
 #include <phasar/PhasarLLVM/Pointer/PointsToGraph.h>
 
 #include <phasar/Utils/GraphExtensions.h>
+#include <phasar/Utils/LLVMIRPrinter.h>
 #include <phasar/Utils/LLVMShorthands.h>
 #include <phasar/Utils/Logger.h>
 #include <phasar/Utils/Macros.h>
 #include <phasar/Utils/PAMMMacros.h>
+#include <phasar/Utils/ResultWriter.h>
 
 using namespace std;
 using namespace psr;
@@ -374,10 +376,15 @@ PointsToGraph::getPointersEscapingThroughReturnsForFunction(
 set<const llvm::Value *> PointsToGraph::getReachableAllocationSites(
     const llvm::Value *V, vector<const llvm::Instruction *> CallStack) {
   set<const llvm::Value *> alloc_sites;
+  // look up without inserting, the graph may be queried concurrently
+  auto Vertex = value_vertex_map.find(V);
+  if (Vertex == value_vertex_map.end()) {
+    return alloc_sites;
+  }
   allocation_site_dfs_visitor alloc_vis(alloc_sites, CallStack);
   vector<boost::default_color_type> color_map(boost::num_vertices(ptg));
   boost::depth_first_visit(
-      ptg, value_vertex_map[V], alloc_vis,
+      ptg, Vertex->second, alloc_vis,
       boost::make_iterator_property_map(color_map.begin(),
                                         boost::get(boost::vertex_index, ptg),
                                         color_map[0]));
@@ -419,16 +426,21 @@ PointsToGraph::computeTypesFromAllocationSites(set<const llvm::Value *> AS) {
 set<const llvm::Value *> PointsToGraph::getPointsToSet(const llvm::Value *V) {
   PAMM_GET_INSTANCE;
   INC_COUNTER("[Calls] getPointsToSet", 1, PAMM_SEVERITY_LEVEL::Full);
+  set<const llvm::Value *> result;
+  // look up without inserting, the graph may be queried concurrently
+  auto Vertex = value_vertex_map.find(V);
+  if (Vertex == value_vertex_map.end()) {
+    return result;
+  }
   START_TIMER("PointsTo-Set Computation", PAMM_SEVERITY_LEVEL::Full);
   set<vertex_t> reachable_vertices;
   reachability_dfs_visitor vis(reachable_vertices);
   vector<boost::default_color_type> color_map(boost::num_vertices(ptg));
   boost::depth_first_visit(
-      ptg, value_vertex_map[V], vis,
+      ptg, Vertex->second, vis,
       boost::make_iterator_property_map(color_map.begin(),
                                         boost::get(boost::vertex_index, ptg),
                                         color_map[0]));
-  set<const llvm::Value *> result;
   for (auto vertex : reachable_vertices) {
     result.insert(ptg[vertex].value);
   }
@@ -488,6 +500,43 @@ json PointsToGraph::getAsJson() {
   return J;
 }
 
+void PointsToGraph::emitAsJson(JsonStreamWriter &W) {
+  auto &Printer = LLVMIRPrinter::getInstance();
+  vector<const llvm::Value *> values;
+  values.reserve(boost::num_vertices(ptg));
+  vertex_iterator vi_v, vi_v_end;
+  for (boost::tie(vi_v, vi_v_end) = boost::vertices(ptg); vi_v != vi_v_end;
+       ++vi_v) {
+    values.push_back(ptg[*vi_v].value);
+  }
+  // render all vertices in parallel up-front, the lookups below are hits
+  // unless the printer's cache overflows
+  Printer.render(values);
+  auto label = [&](vertex_t v) {
+    return Printer.getString(ptg[v].value);
+  };
+  out_edge_iterator ei, ei_end;
+  W.beginObject();
+  W.key(JsonPointToGraphID);
+  W.beginObject();
+  for (boost::tie(vi_v, vi_v_end) = boost::vertices(ptg); vi_v != vi_v_end;
+       ++vi_v) {
+    W.key(label(*vi_v));
+    boost::tie(ei, ei_end) = boost::out_edges(*vi_v, ptg);
+    if (ei == ei_end) {
+      W.null();
+      continue;
+    }
+    W.beginArray();
+    for (; ei != ei_end; ++ei) {
+      W.value(label(boost::target(*ei, ptg)));
+    }
+    W.endArray();
+  }
+  W.endObject();
+  W.endObject();
+}
+
 void PointsToGraph::printValueVertexMap() {
   for (const auto &entry : value_vertex_map) {
     cout << entry.first << " <---> " << entry.second << endl;
@@ -0,0 +1,177 @@
+/******************************************************************************
+ * Copyright (c) 2018 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <fstream>
+#include <utility>
+
+#include <llvm/IR/DerivedTypes.h>
+
+#include <phasar/PhasarLLVM/Pointer/TypeGraphs/IncrementalTypeGraph.h>
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+unsigned IncrementalTypeGraph::addType(const llvm::StructType *new_type) {
+  auto search = type_ids.find(new_type);
+  if (search != type_ids.end()) {
+    return search->second;
+  }
+  unsigned id = id_types.size();
+  type_ids[new_type] = id;
+  id_types.push_back(new_type);
+  parent.push_back(id);
+  types.emplace_back();
+  types.back().set(id);
+  succs.emplace_back();
+  preds.emplace_back();
+  return id;
+}
+
+unsigned IncrementalTypeGraph::find(unsigned id) {
+  unsigned root = id;
+  while (parent[root] != root) {
+    root = parent[root];
+  }
+  // path compression
+  while (parent[id] != root) {
+    unsigned next = parent[id];
+    parent[id] = root;
+    id = next;
+  }
+  return root;
+}
+
+void IncrementalTypeGraph::collapseCycle(unsigned from, unsigned to) {
+  // the cycle consists of all nodes that are reachable from 'to' and reach
+  // 'from', i.e. whose types contain 'from'
+  set<unsigned> members;
+  for (unsigned id : types[to]) {
+    unsigned rep = find(id);
+    if (types[rep].test(from)) {
+      members.insert(rep);
+    }
+  }
+  type_set_t merged;
+  set<unsigned> merged_succs, merged_preds;
+  for (unsigned member : members) {
+    merged |= types[member];
+    merged_succs.insert(succs[member].begin(), succs[member].end());
+    merged_preds.insert(preds[member].begin(), preds[member].end());
+    parent[member] = from;
+    if (member != from) {
+      types[member].clear();
+      succs[member].clear();
+      preds[member].clear();
+    }
+  }
+  // drop the edges within the cycle
+  succs[from].clear();
+  for (unsigned succ : merged_succs) {
+    if (find(succ) != from) {
+      succs[from].insert(find(succ));
+    }
+  }
+  preds[from].clear();
+  for (unsigned pred : merged_preds) {
+    if (find(pred) != from) {
+      preds[from].insert(find(pred));
+    }
+  }
+  types[from] = merged;
+  for (unsigned pred : preds[from]) {
+    propagate(pred, merged);
+  }
+}
+
+void IncrementalTypeGraph::propagate(unsigned id, const type_set_t &delta) {
+  vector<pair<unsigned, type_set_t>> worklist;
+  worklist.emplace_back(id, delta);
+  while (!worklist.empty()) {
+    unsigned node = find(worklist.back().first);
+    type_set_t fresh;
+    fresh.intersectWithComplement(worklist.back().second, types[node]);
+    worklist.pop_back();
+    if (fresh.empty()) {
+      continue;
+    }
+    types[node] |= fresh;
+    // only the types that are new to this node are pushed further
+    for (unsigned pred : preds[node]) {
+      worklist.emplace_back(pred, fresh);
+    }
+  }
+}
+
+bool IncrementalTypeGraph::addLink(const llvm::StructType *from,
+                                   const llvm::StructType *to) {
+  unsigned from_id = find(addType(from));
+  unsigned to_id = find(addType(to));
+  if (from_id == to_id || !succs[from_id].insert(to_id).second) {
+    return false;
+  }
+  preds[to_id].insert(from_id);
+  if (types[to_id].test(from_id)) {
+    collapseCycle(from_id, to_id);
+  } else {
+    type_set_t delta = types[to_id];
+    propagate(from_id, delta);
+  }
+  return true;
+}
+
+void IncrementalTypeGraph::printAsDot(const std::string &path) const {
+  auto rep = [&](unsigned id) {
+    while (parent[id] != id) {
+      id = parent[id];
+    }
+    return id;
+  };
+  ofstream ofs(path);
+  ofs << "digraph G {\n";
+  for (unsigned id = 0; id < id_types.size(); ++id) {
+    if (rep(id) != id) {
+      continue;
+    }
+    ofs << id << "[label=\"";
+    bool first = true;
+    for (unsigned member = 0; member < id_types.size(); ++member) {
+      if (rep(member) == id) {
+        ofs << (first ? "" : ", ") << id_types[member]->getName().str();
+        first = false;
+      }
+    }
+    ofs << "\"];\n";
+  }
+  for (unsigned id = 0; id < id_types.size(); ++id) {
+    if (rep(id) != id) {
+      continue;
+    }
+    set<unsigned> targets;
+    for (unsigned succ : succs[id]) {
+      targets.insert(rep(succ));
+    }
+    for (unsigned target : targets) {
+      ofs << id << "->" << target << ";\n";
+    }
+  }
+  ofs << "}\n";
+}
+
+set<const llvm::StructType *>
+IncrementalTypeGraph::getTypes(const llvm::StructType *struct_type) {
+  set<const llvm::StructType *> result;
+  for (unsigned id : types[find(addType(struct_type))]) {
+    result.insert(id_types[id]);
+  }
+  return result;
+}
+
+} // namespace psr
@@ -1,28 +1,486 @@
-// /******************************************************************************
-//  * Copyright (c) 2018 Philipp Schubert.
-//  * All rights reserved. This program and the accompanying materials are made
-//  * available under the terms of LICENSE.txt.
-//  *
-//  * Contributors:
-//  *     Philipp Schubert and others
-//  *****************************************************************************/
-
-// #include <phasar/PhasarLLVM/SPDS/Solver/SyncPDSSolver.h>
-// #include <phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h>
-// #include <phasar/PhasarLLVM/WPDS/Solver/LLVMWPDSSolver.h>
-// #include <phasar/PhasarLLVM/WPDS/Problems/WPDSAliasCollector.h>
-// #include <phasar/PhasarLLVM/Utils/BinaryDomain.h>
-
-// namespace psr {
-
-// SyncPDSSolver::SyncPDSSolver(LLVMBasedICFG &I) : I(I) {}
-
-// std::set<const llvm::Value *> SyncPDSSolver::getAliasesOf(const llvm::Value
-// *V)
-// {
-//   WPDSAliasCollector AC(I, WPDSType::FWPDS, SearchDirection::FORWARD);
-//   LLVMWPDSSolver<const llvm::Value *, BinaryDomain, LLVMBasedICFG&>
-//   WpdsSolver(AC); return {V};
-// }
-
-// }
+/******************************************************************************
+ * Copyright (c) 2018 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <tuple>
+
+#include <llvm/IR/CallSite.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/GetElementPtrTypeIterator.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Operator.h>
+
+#include <phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h>
+#include <phasar/PhasarLLVM/SyncPDS/Solver/SyncPDSSolver.h>
+#include <phasar/Utils/Logger.h>
+#include <phasar/Utils/Profiler.h>
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+namespace {
+
+/// Returns the struct fields a GEP descends into, array indices are ignored
+SyncPDSSolver::FieldPath getFieldPath(const llvm::GEPOperator *GEP) {
+  SyncPDSSolver::FieldPath Path;
+  for (auto GTI = llvm::gep_type_begin(GEP), E = llvm::gep_type_end(GEP);
+       GTI != E; ++GTI) {
+    if (GTI.getStructTypeOrNull()) {
+      Path.push_back(
+          llvm::cast<llvm::ConstantInt>(GTI.getOperand())->getZExtValue());
+    }
+  }
+  return Path;
+}
+
+bool isCast(const llvm::Value *V) {
+  if (auto Op = llvm::dyn_cast<llvm::Operator>(V)) {
+    return Op->getOpcode() == llvm::Instruction::BitCast ||
+           Op->getOpcode() == llvm::Instruction::AddrSpaceCast;
+  }
+  return false;
+}
+
+bool isVisibleIn(const llvm::Value *V, const llvm::Function *F) {
+  if (llvm::isa<llvm::GlobalValue>(V)) {
+    return true;
+  }
+  if (auto I = llvm::dyn_cast<llvm::Instruction>(V)) {
+    return !F || I->getFunction() == F;
+  }
+  if (auto A = llvm::dyn_cast<llvm::Argument>(V)) {
+    return !F || A->getParent() == F;
+  }
+  return false;
+}
+
+} // anonymous namespace
+
+bool SyncPDSSolver::Node::operator<(const Node &Other) const {
+  return tie(value, cell, context) <
+         tie(Other.value, Other.cell, Other.context);
+}
+
+SyncPDSSolver::SyncPDSSolver(LLVMBasedICFG &ICFG, unsigned ContextDepth,
+                             unsigned FieldDepth)
+    : ICFG(ICFG), ContextDepth(ContextDepth), FieldDepth(FieldDepth) {}
+
+SyncPDSSolver::~SyncPDSSolver() = default;
+
+unsigned SyncPDSSolver::getNode(const llvm::Value *V, const Context &C) {
+  Node N{V, C, 0};
+  auto search = node_ids.find(N);
+  if (search != node_ids.end()) {
+    return search->second;
+  }
+  unsigned Id = nodes.size();
+  node_ids[N] = Id;
+  nodes.push_back(N);
+  data.emplace_back();
+  return Id;
+}
+
+unsigned SyncPDSSolver::getCell(unsigned Object) {
+  Node N{nullptr, {}, Object};
+  auto search = node_ids.find(N);
+  if (search != node_ids.end()) {
+    return search->second;
+  }
+  unsigned Id = nodes.size();
+  node_ids[N] = Id;
+  nodes.push_back(N);
+  data.emplace_back();
+  return Id;
+}
+
+unsigned SyncPDSSolver::getObject(const llvm::Value *Site,
+                                  const FieldPath &Path) {
+  Object O(Site, Path);
+  if (O.second.size() > FieldDepth) {
+    O.second.resize(FieldDepth);
+  }
+  auto search = object_ids.find(O);
+  if (search != object_ids.end()) {
+    return search->second;
+  }
+  unsigned Id = objects.size();
+  object_ids[O] = Id;
+  objects.push_back(O);
+  site_objects[Site].insert(Id);
+  return Id;
+}
+
+unsigned SyncPDSSolver::extend(unsigned Object, const FieldPath &Path) {
+  if (Path.empty() || objects[Object].second.size() >= FieldDepth) {
+    return Object;
+  }
+  FieldPath Extended = objects[Object].second;
+  Extended.insert(Extended.end(), Path.begin(), Path.end());
+  return getObject(objects[Object].first, Extended);
+}
+
+SyncPDSSolver::Context
+SyncPDSSolver::push(const Context &C, const llvm::Instruction *CallSite) const {
+  if (ContextDepth == 0) {
+    return {};
+  }
+  Context Pushed(C);
+  Pushed.push_back(CallSite);
+  if (Pushed.size() > ContextDepth) {
+    Pushed.erase(Pushed.begin());
+  }
+  return Pushed;
+}
+
+vector<pair<const llvm::Instruction *, SyncPDSSolver::Context>>
+SyncPDSSolver::getReturnSites(const llvm::Function *F, const Context &C) {
+  vector<pair<const llvm::Instruction *, Context>> Sites;
+  if (!C.empty()) {
+    Sites.emplace_back(C.back(), Context(C.begin(), C.end() - 1));
+    return Sites;
+  }
+  // the call string has been truncated or the search started in F, in
+  // both cases all callers are possible
+  for (auto CallSite : ICFG.getCallersOf(F)) {
+    Sites.emplace_back(CallSite, Context());
+  }
+  return Sites;
+}
+
+void SyncPDSSolver::addFact(unsigned N, unsigned Object) {
+  if (data[N].points_to.insert(Object).second) {
+    ++num_facts;
+    worklist.emplace_back(N, Object);
+  }
+}
+
+void SyncPDSSolver::addCopy(unsigned From, unsigned To, const FieldPath &Path) {
+  if (data[From].copies.emplace(To, Path).second) {
+    for (auto Object : set<unsigned>(data[From].points_to)) {
+      addFact(To, extend(Object, Path));
+    }
+  }
+}
+
+void SyncPDSSolver::addLoad(unsigned Pointer, unsigned Target) {
+  bool New = data[Pointer].loads.insert(Target).second;
+  auto Objects = data[Pointer].points_to;
+  // whatever is stored into the objects is only known after searching for
+  // all of their pointers
+  if (data[Target].backward) {
+    for (auto Object : Objects) {
+      demandForward(objects[Object].first);
+    }
+  }
+  if (New) {
+    for (auto Object : Objects) {
+      addCopy(getCell(Object), Target);
+    }
+  }
+}
+
+void SyncPDSSolver::addStore(unsigned Value, unsigned Pointer) {
+  bool New = data[Pointer].stores.insert(Value).second;
+  auto Objects = data[Pointer].points_to;
+  // whoever loads from the objects obtains an alias of the stored value
+  if (data[Value].forward) {
+    for (auto Object : Objects) {
+      demandForward(objects[Object].first);
+    }
+  }
+  if (New) {
+    for (auto Object : Objects) {
+      addCopy(Value, getCell(Object));
+    }
+  }
+}
+
+void SyncPDSSolver::demandBackward(unsigned N) {
+  if (!data[N].backward) {
+    data[N].backward = true;
+    backward_worklist.push_back(N);
+  }
+}
+
+void SyncPDSSolver::demandForward(const llvm::Value *Site) {
+  if (!forward_sites.insert(Site).second) {
+    return;
+  }
+  for (auto Object : site_objects[Site]) {
+    for (auto N : pointers[Object]) {
+      scheduleForward(N);
+    }
+  }
+}
+
+void SyncPDSSolver::scheduleForward(unsigned N) {
+  if (!data[N].forward) {
+    data[N].forward = true;
+    forward_worklist.push_back(N);
+  }
+}
+
+void SyncPDSSolver::searchBackward(unsigned N) {
+  const llvm::Value *V = nodes[N].value;
+  Context C = nodes[N].context;
+  auto addSource = [&](const llvm::Value *Source, const Context &SourceC,
+                       const FieldPath &Path) {
+    unsigned S = getNode(Source, SourceC);
+    addCopy(S, N, Path);
+    demandBackward(S);
+  };
+  if (llvm::isa<llvm::ConstantPointerNull>(V) ||
+      llvm::isa<llvm::UndefValue>(V)) {
+    return;
+  }
+  if (auto GEP = llvm::dyn_cast<llvm::GEPOperator>(V)) {
+    addSource(GEP->getPointerOperand(), C, getFieldPath(GEP));
+  } else if (isCast(V)) {
+    addSource(llvm::cast<llvm::User>(V)->getOperand(0), C, {});
+  } else if (auto Phi = llvm::dyn_cast<llvm::PHINode>(V)) {
+    for (auto &Incoming : Phi->incoming_values()) {
+      addSource(Incoming, C, {});
+    }
+  } else if (auto Select = llvm::dyn_cast<llvm::SelectInst>(V)) {
+    addSource(Select->getTrueValue(), C, {});
+    addSource(Select->getFalseValue(), C, {});
+  } else if (auto Load = llvm::dyn_cast<llvm::LoadInst>(V)) {
+    unsigned Pointer = getNode(Load->getPointerOperand(), C);
+    demandBackward(Pointer);
+    addLoad(Pointer, N);
+  } else if (auto Arg = llvm::dyn_cast<llvm::Argument>(V)) {
+    auto Sites = getReturnSites(Arg->getParent(), C);
+    for (auto &Site : Sites) {
+      llvm::ImmutableCallSite CS(Site.first);
+      if (CS.getInstruction() && Arg->getArgNo() < CS.arg_size()) {
+        addSource(CS.getArgument(Arg->getArgNo()), Site.second, {});
+      }
+    }
+    if (Sites.empty()) {
+      addFact(N, getObject(V, {}));
+    }
+  } else if (llvm::isa<llvm::CallInst>(V) || llvm::isa<llvm::InvokeInst>(V)) {
+    auto CallSite = llvm::cast<llvm::Instruction>(V);
+    bool External = true;
+    for (auto Callee : ICFG.getCalleesOfCallAt(CallSite)) {
+      if (!Callee || Callee->isDeclaration()) {
+        continue;
+      }
+      External = false;
+      for (auto &BB : *Callee) {
+        if (auto Ret = llvm::dyn_cast<llvm::ReturnInst>(BB.getTerminator())) {
+          if (Ret->getReturnValue()) {
+            addSource(Ret->getReturnValue(), push(C, CallSite), {});
+          }
+        }
+      }
+    }
+    // e.g. malloc(), the call site is the allocation site
+    if (External) {
+      addFact(N, getObject(V, {}));
+    }
+  } else {
+    // allocas, globals and everything we cannot see through
+    addFact(N, getObject(V, {}));
+  }
+}
+
+void SyncPDSSolver::searchForward(unsigned N) {
+  const llvm::Value *V = nodes[N].value;
+  Context C = nodes[N].context;
+  if (auto Global = llvm::dyn_cast<llvm::GlobalVariable>(V)) {
+    if (Global->hasInitializer()) {
+      unsigned Value = getNode(Global->getInitializer(), {});
+      demandBackward(Value);
+      addStore(Value, N);
+    }
+  }
+  for (auto User : V->users()) {
+    if (auto GEP = llvm::dyn_cast<llvm::GEPOperator>(User)) {
+      if (GEP->getPointerOperand() == V) {
+        addCopy(N, getNode(GEP, C), getFieldPath(GEP));
+      }
+    } else if (isCast(User) || llvm::isa<llvm::PHINode>(User)) {
+      addCopy(N, getNode(User, C));
+    } else if (auto Select = llvm::dyn_cast<llvm::SelectInst>(User)) {
+      if (Select->getCondition() != V) {
+        addCopy(N, getNode(Select, C));
+      }
+    } else if (auto Store = llvm::dyn_cast<llvm::StoreInst>(User)) {
+      if (Store->getValueOperand() == V) {
+        unsigned Pointer = getNode(Store->getPointerOperand(), C);
+        demandBackward(Pointer);
+        addStore(N, Pointer);
+      }
+      if (Store->getPointerOperand() == V) {
+        unsigned Value = getNode(Store->getValueOperand(), C);
+        demandBackward(Value);
+        addStore(Value, N);
+      }
+    } else if (auto Load = llvm::dyn_cast<llvm::LoadInst>(User)) {
+      addLoad(N, getNode(Load, C));
+    } else if (llvm::isa<llvm::CallInst>(User) ||
+               llvm::isa<llvm::InvokeInst>(User)) {
+      auto CallSite = llvm::cast<llvm::Instruction>(User);
+      llvm::ImmutableCallSite CS(CallSite);
+      for (auto Callee : ICFG.getCalleesOfCallAt(CallSite)) {
+        if (!Callee || Callee->isDeclaration()) {
+          continue;
+        }
+        for (auto &Formal : Callee->args()) {
+          if (Formal.getArgNo() < CS.arg_size() &&
+              CS.getArgument(Formal.getArgNo()) == V) {
+            addCopy(N, getNode(&Formal, push(C, CallSite)));
+          }
+        }
+      }
+    } else if (auto Ret = llvm::dyn_cast<llvm::ReturnInst>(User)) {
+      for (auto &Site : getReturnSites(Ret->getFunction(), C)) {
+        addCopy(N, getNode(Site.first, Site.second));
+      }
+    } else if (auto Global = llvm::dyn_cast<llvm::GlobalVariable>(User)) {
+      // V initializes the global
+      unsigned Pointer = getNode(Global, {});
+      demandBackward(Pointer);
+      addStore(N, Pointer);
+    }
+  }
+}
+
+void SyncPDSSolver::process(unsigned N, unsigned Object) {
+  // the sets may grow while they are traversed, e.g. for p = p + 1
+  auto Copies = data[N].copies;
+  for (auto &Copy : Copies) {
+    addFact(Copy.first, extend(Object, Copy.second));
+  }
+  auto Loads = data[N].loads;
+  for (auto Target : Loads) {
+    if (data[Target].backward) {
+      demandForward(objects[Object].first);
+    }
+    addCopy(getCell(Object), Target);
+  }
+  auto Stores = data[N].stores;
+  for (auto Value : Stores) {
+    if (data[Value].forward) {
+      demandForward(objects[Object].first);
+    }
+    addCopy(Value, getCell(Object));
+  }
+  if (nodes[N].value) {
+    pointers[Object].insert(N);
+    if (forward_sites.count(objects[Object].first)) {
+      scheduleForward(N);
+    }
+  }
+}
+
+void SyncPDSSolver::solve() {
+  while (!worklist.empty() || !backward_worklist.empty() ||
+         !forward_worklist.empty()) {
+    if (!backward_worklist.empty()) {
+      unsigned N = backward_worklist.front();
+      backward_worklist.pop_front();
+      searchBackward(N);
+    } else if (!worklist.empty()) {
+      auto Fact = worklist.front();
+      worklist.pop_front();
+      process(Fact.first, Fact.second);
+    } else {
+      unsigned N = forward_worklist.front();
+      forward_worklist.pop_front();
+      searchForward(N);
+    }
+  }
+}
+
+const set<unsigned> &SyncPDSSolver::query(const llvm::Value *V) {
+  PROFILE_SCOPE("SyncPDSSolver::query");
+  size_t Facts = num_facts;
+  unsigned N = getNode(V, {});
+  demandBackward(N);
+  solve();
+  // searching forwards may reveal further objects of V, e.g. if V has been
+  // loaded from memory
+  size_t Known;
+  do {
+    Known = data[N].points_to.size();
+    for (auto Object : set<unsigned>(data[N].points_to)) {
+      demandForward(objects[Object].first);
+    }
+    solve();
+  } while (Known != data[N].points_to.size());
+  // cached results might have become incomplete
+  if (Facts != num_facts) {
+    alias_cache.clear();
+  }
+  return data[N].points_to;
+}
+
+set<const llvm::Value *> SyncPDSSolver::getAliasesOf(const llvm::Value *V,
+                                                     const llvm::Instruction *I) {
+  auto &lg = lg::get();
+  auto search = alias_cache.find(V);
+  if (search == alias_cache.end()) {
+    set<const llvm::Value *> Aliases{V};
+    for (auto Object : query(V)) {
+      for (auto Pointer : pointers[Object]) {
+        if (isVisibleIn(nodes[Pointer].value, nullptr)) {
+          Aliases.insert(nodes[Pointer].value);
+        }
+      }
+    }
+    LOG_SEV_IF_ENABLE(lg, DEBUG,
+                      "SyncPDSSolver found " << Aliases.size()
+                                             << " aliases, "
+                                             << nodes.size()
+                                             << " nodes are known");
+    search = alias_cache.emplace(V, move(Aliases)).first;
+  }
+  if (!I) {
+    return search->second;
+  }
+  set<const llvm::Value *> Visible;
+  for (auto Alias : search->second) {
+    if (Alias == V || isVisibleIn(Alias, I->getFunction())) {
+      Visible.insert(Alias);
+    }
+  }
+  return Visible;
+}
+
+set<const llvm::Value *>
+SyncPDSSolver::getAllocationSitesOf(const llvm::Value *V) {
+  set<const llvm::Value *> Sites;
+  for (auto Object : query(V)) {
+    Sites.insert(objects[Object].first);
+  }
+  return Sites;
+}
+
+void SyncPDSSolver::clear() {
+  node_ids.clear();
+  nodes.clear();
+  data.clear();
+  object_ids.clear();
+  objects.clear();
+  site_objects.clear();
+  pointers.clear();
+  forward_sites.clear();
+  worklist.clear();
+  backward_worklist.clear();
+  forward_worklist.clear();
+  num_facts = 0;
+  alias_cache.clear();
+}
+
+} // namespace psr
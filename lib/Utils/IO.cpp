@@ -45,6 +45,7 @@ void writeFile(const string &path, const string &content) {
   ofstream ofs(path, ios::binary);
   if (ofs.is_open()) {
     ofs.write(content.data(), content.size());
+    return;
   }
   throw ios_base::failure("could not write file: " + path);
 }
@@ -0,0 +1,332 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <algorithm>
+#include <thread>
+
+#include <llvm/IR/Argument.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalValue.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/Instruction.h>
+#include <llvm/IR/Metadata.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/ModuleSlotTracker.h>
+#include <llvm/IR/Value.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <boost/algorithm/string/trim.hpp>
+
+#include <phasar/Utils/LLVMIRPrinter.h>
+#include <phasar/Utils/LLVMShorthands.h>
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+namespace {
+
+const string NoID = "-1";
+
+const llvm::Function *getFunctionOf(const llvm::Value *V) {
+  if (auto I = llvm::dyn_cast<llvm::Instruction>(V)) {
+    return I->getFunction();
+  }
+  if (auto A = llvm::dyn_cast<llvm::Argument>(V)) {
+    return A->getParent();
+  }
+  return nullptr;
+}
+
+const llvm::Module *getModuleOf(const llvm::Value *V) {
+  if (auto F = getFunctionOf(V)) {
+    return F->getParent();
+  }
+  if (auto G = llvm::dyn_cast<llvm::GlobalValue>(V)) {
+    return G->getParent();
+  }
+  return nullptr;
+}
+
+/// Mirrors the cases in which llvm::Value::print() numbers all metadata
+bool needsAllMetadata(const llvm::Value *V) {
+  if (llvm::isa<llvm::Function>(V) || llvm::isa<llvm::MetadataAsValue>(V)) {
+    return true;
+  }
+  if (auto I = llvm::dyn_cast<llvm::Instruction>(V)) {
+    for (auto &Op : I->operands()) {
+      if (auto MD = llvm::dyn_cast_or_null<llvm::MetadataAsValue>(Op)) {
+        if (llvm::isa<llvm::MDNode>(MD->getMetadata())) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+/// Prints V exactly like llvmIRToString() used to, but re-uses the slot
+/// numbering of MST if given.
+string print(const llvm::Value *V, llvm::ModuleSlotTracker *MST,
+             const string &ID) {
+  string IRBuffer;
+  llvm::raw_string_ostream RSO(IRBuffer);
+  if (MST) {
+    V->print(RSO, *MST);
+  } else {
+    V->print(RSO);
+  }
+  RSO << ", ID: " << ID;
+  RSO.flush();
+  boost::trim_left(IRBuffer);
+  return IRBuffer;
+}
+
+} // anonymous namespace
+
+// Metadata slots are numbered in the order in which functions are
+// incorporated and are never released. To render exactly what a stand-alone
+// print would, every function gets a fresh tracker, only the module-level
+// numbering of globals is shared. Values for which a stand-alone print
+// numbers all metadata of the module are printed stand-alone.
+llvm::ModuleSlotTracker *
+LLVMIRPrinter::SlotTrackers::get(const llvm::Value *V) {
+  if (needsAllMetadata(V)) {
+    return nullptr;
+  }
+  if (auto F = getFunctionOf(V)) {
+    if (F != function) {
+      function = F;
+      function_tracker.reset(new llvm::ModuleSlotTracker(F->getParent(),
+                                                         false));
+    }
+    return function_tracker.get();
+  }
+  if (auto M = getModuleOf(V)) {
+    auto &Tracker = module_trackers[M];
+    if (!Tracker) {
+      Tracker.reset(new llvm::ModuleSlotTracker(M, false));
+    }
+    return Tracker.get();
+  }
+  return nullptr;
+}
+
+LLVMIRPrinter::LLVMIRPrinter() = default;
+
+LLVMIRPrinter::~LLVMIRPrinter() = default;
+
+LLVMIRPrinter &LLVMIRPrinter::getInstance() {
+  static LLVMIRPrinter instance;
+  return instance;
+}
+
+const size_t LLVMIRPrinter::DefaultCapacity;
+
+const LLVMIRPrinter::Entry *LLVMIRPrinter::find(const llvm::Value *V,
+                                                const string &ID) {
+  if (ID != NoID) {
+    auto search = by_id.find(ID);
+    // IDs are re-used by different IRDBs, make sure it is the same value
+    if (search != by_id.end() && search->second->value == V) {
+      return search->second;
+    }
+    return nullptr;
+  }
+  auto search = by_value.find(V);
+  return search != by_value.end() ? search->second : nullptr;
+}
+
+const string &LLVMIRPrinter::insert(const llvm::Value *V, const string &ID,
+                                    string Text) {
+  if (arena.size() >= max_entries) {
+    by_id.clear();
+    by_value.clear();
+    arena.clear();
+  }
+  arena.push_back({V, move(Text)});
+  const Entry *E = &arena.back();
+  if (ID != NoID) {
+    by_id[ID] = E;
+  } else {
+    by_value[V] = E;
+  }
+  return E->text;
+}
+
+string LLVMIRPrinter::getString(const llvm::Value *V) {
+  string ID = getMetaDataID(V);
+  SlotTrackers Trackers;
+  size_t Generation;
+  {
+    lock_guard<mutex> lock(mtx);
+    if (auto E = find(V, ID)) {
+      return E->text;
+    }
+    if (!idle_trackers.empty()) {
+      Trackers = move(idle_trackers.back());
+      idle_trackers.pop_back();
+    }
+    Generation = generation;
+  }
+  string Text = print(V, Trackers.get(V), ID);
+  lock_guard<mutex> lock(mtx);
+  // the IR may have changed while printing if the printer has been cleared
+  if (Generation == generation) {
+    idle_trackers.push_back(move(Trackers));
+    if (!find(V, ID)) {
+      insert(V, ID, Text);
+    }
+  }
+  return Text;
+}
+
+string LLVMIRPrinter::getReference(const llvm::Value *V) {
+  string ID = getMetaDataID(V);
+  string Reference;
+  if (llvm::isa<llvm::Instruction>(V) && ID != NoID) {
+    Reference = getFunctionOf(V)->getName().str() + "." + ID;
+  } else if (auto A = llvm::dyn_cast<llvm::Argument>(V)) {
+    Reference = A->getParent()->getName().str() + ".arg" +
+                to_string(getFunctionArgumentNr(A));
+  } else if (llvm::isa<llvm::GlobalVariable>(V) && ID != NoID) {
+    Reference = "@" + ID;
+  } else {
+    return getString(V);
+  }
+  lock_guard<mutex> lock(mtx);
+  references.emplace(Reference, V);
+  return Reference;
+}
+
+string LLVMIRPrinter::resolve(const string &Reference) {
+  const llvm::Value *V;
+  {
+    lock_guard<mutex> lock(mtx);
+    auto search = references.find(Reference);
+    if (search == references.end()) {
+      return Reference;
+    }
+    V = search->second;
+  }
+  return getString(V);
+}
+
+void LLVMIRPrinter::render(const vector<const llvm::Value *> &Values,
+                           unsigned Threads) {
+  // Determining the IDs may register metadata kinds in the LLVMContext, which
+  // is not thread-safe, so do it up-front.
+  vector<pair<const llvm::Value *, string>> Todo;
+  size_t Generation;
+  {
+    lock_guard<mutex> lock(mtx);
+    Generation = generation;
+    for (auto V : Values) {
+      string ID = getMetaDataID(V);
+      if (!find(V, ID)) {
+        Todo.emplace_back(V, move(ID));
+      }
+    }
+  }
+  if (Todo.empty()) {
+    return;
+  }
+  // Keep the values of a function together, so that every worker numbers
+  // the slots of a function only once.
+  stable_sort(Todo.begin(), Todo.end(),
+              [](const pair<const llvm::Value *, string> &A,
+                 const pair<const llvm::Value *, string> &B) {
+                return getFunctionOf(A.first) < getFunctionOf(B.first);
+              });
+  vector<string> Texts(Todo.size());
+  if (Threads == 0) {
+    Threads = max(1u, thread::hardware_concurrency());
+  }
+  Threads = min<size_t>(Threads, Todo.size());
+  auto Worker = [&Todo, &Texts](size_t Begin, size_t End) {
+    SlotTrackers LocalTrackers;
+    for (size_t i = Begin; i < End; ++i) {
+      Texts[i] = print(Todo[i].first, LocalTrackers.get(Todo[i].first),
+                       Todo[i].second);
+    }
+  };
+  // Split into chunks that do not cut through a function
+  vector<size_t> Bounds = {0};
+  size_t Chunk = (Todo.size() + Threads - 1) / Threads;
+  while (Bounds.back() < Todo.size()) {
+    size_t End = min(Bounds.back() + Chunk, Todo.size());
+    while (End < Todo.size() && getFunctionOf(Todo[End].first) ==
+                                    getFunctionOf(Todo[End - 1].first)) {
+      ++End;
+    }
+    Bounds.push_back(End);
+  }
+  vector<thread> Workers;
+  for (size_t i = 1; i + 1 < Bounds.size(); ++i) {
+    Workers.emplace_back(Worker, Bounds[i], Bounds[i + 1]);
+  }
+  Worker(Bounds[0], Bounds[1]);
+  for (auto &W : Workers) {
+    W.join();
+  }
+  lock_guard<mutex> lock(mtx);
+  if (Generation != generation) {
+    return;
+  }
+  for (size_t i = 0; i < Todo.size(); ++i) {
+    if (!find(Todo[i].first, Todo[i].second)) {
+      insert(Todo[i].first, Todo[i].second, move(Texts[i]));
+    }
+  }
+}
+
+void LLVMIRPrinter::renderReferences(unsigned Threads) {
+  vector<const llvm::Value *> Values;
+  {
+    lock_guard<mutex> lock(mtx);
+    Values.reserve(references.size());
+    for (auto &Reference : references) {
+      Values.push_back(Reference.second);
+    }
+  }
+  render(Values, Threads);
+}
+
+void LLVMIRPrinter::clear() {
+  lock_guard<mutex> lock(mtx);
+  by_id.clear();
+  by_value.clear();
+  references.clear();
+  idle_trackers.clear();
+  arena.clear();
+  ++generation;
+}
+
+void LLVMIRPrinter::setCapacity(size_t Capacity) {
+  lock_guard<mutex> lock(mtx);
+  max_entries = max<size_t>(Capacity, 1);
+  if (arena.size() > max_entries) {
+    by_id.clear();
+    by_value.clear();
+    arena.clear();
+  }
+}
+
+size_t LLVMIRPrinter::capacity() {
+  lock_guard<mutex> lock(mtx);
+  return max_entries;
+}
+
+size_t LLVMIRPrinter::size() {
+  lock_guard<mutex> lock(mtx);
+  return arena.size();
+}
+
+} // namespace psr
@@ -7,9 +7,9 @@
  *     Philipp Schubert and others
  *****************************************************************************/
 
-#include <fstream>
+#include <algorithm>
+#include <cstring>
 #include <iostream>
-#include <limits>
 
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/filesystem.hpp>
@@ -22,6 +22,7 @@
 #include <llvm/IR/Metadata.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Value.h>
+#include <llvm/Support/MemoryBuffer.h>
 
 #include <phasar/Utils/LLVMIRToSrc.h>
 
@@ -29,32 +30,90 @@ using namespace psr;
 
 namespace psr {
 
-std::string getSrcCodeLine(const std::string &Dir, const std::string &File,
-                           unsigned int num) {
-  boost::filesystem::path FilePath;
+SourceFileCache::SourceFileCache() = default;
+
+SourceFileCache::~SourceFileCache() = default;
+
+SourceFileCache &SourceFileCache::getInstance() {
+  static SourceFileCache instance;
+  return instance;
+}
+
+const SourceFileCache::File *SourceFileCache::load(const std::string &Path) {
+  auto search = files.find(Path);
+  if (search != files.end()) {
+    return search->second.get();
+  }
+  auto &Entry = files[Path];
+  if (!boost::filesystem::exists(Path) ||
+      boost::filesystem::is_directory(Path)) {
+    return nullptr;
+  }
+  auto Buffer = llvm::MemoryBuffer::getFile(Path, -1, false);
+  if (!Buffer) {
+    return nullptr;
+  }
+  Entry.reset(new File);
+  Entry->buffer = std::move(*Buffer);
+  const char *Begin = Entry->buffer->getBufferStart();
+  const char *End = Entry->buffer->getBufferEnd();
+  Entry->lines.push_back(0);
+  const char *It = Begin;
+  while ((It = static_cast<const char *>(std::memchr(It, '\n', End - It)))) {
+    Entry->lines.push_back(++It - Begin);
+  }
+  return Entry.get();
+}
+
+bool SourceFileCache::getLine(const std::string &Path, unsigned Line,
+                              std::string &Result) {
+  std::lock_guard<std::mutex> lock(mtx);
+  const File *F = load(Path);
+  if (!F) {
+    return false;
+  }
+  Result.clear();
+  if (Line == 0 || Line > F->lines.size()) {
+    return true;
+  }
+  size_t Begin = F->lines[Line - 1];
+  size_t End = Line < F->lines.size() ? F->lines[Line]
+                                       : F->buffer->getBufferSize();
+  Result.assign(F->buffer->getBufferStart() + Begin, End - Begin);
+  boost::algorithm::trim(Result);
+  return true;
+}
+
+void SourceFileCache::preload(const std::vector<std::string> &Paths) {
+  std::lock_guard<std::mutex> lock(mtx);
+  for (auto &Path : Paths) {
+    load(Path);
+  }
+}
+
+void SourceFileCache::clear() {
+  std::lock_guard<std::mutex> lock(mtx);
+  files.clear();
+}
+
+std::string getSrcFilePath(const std::string &Dir, const std::string &File) {
   // Its possible that File holds the complete path
   if (File.find("/home/") == std::string::npos) {
     boost::filesystem::path DirPath(Dir);
     boost::filesystem::path FileName(File);
-    FilePath = DirPath / FileName;
-  } else {
-    FilePath = File;
-  }
-  if (boost::filesystem::exists(FilePath) &&
-      !boost::filesystem::is_directory(FilePath)) {
-    std::ifstream ifs(FilePath.string(), std::ios::binary);
-    if (ifs.is_open()) {
-      ifs.seekg(std::ios::beg);
-      std::string line;
-      for (unsigned int i = 0; i < num - 1; ++i) {
-        ifs.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-      }
-      std::getline(ifs, line);
-      boost::algorithm::trim(line);
-      return line;
-    }
+    return (DirPath / FileName).string();
   }
-  return "file does not exist: " + FilePath.string();
+  return File;
+}
+
+std::string getSrcCodeLine(const std::string &Dir, const std::string &File,
+                           unsigned int num) {
+  std::string FilePath = getSrcFilePath(Dir, File);
+  std::string Line;
+  if (SourceFileCache::getInstance().getLine(FilePath, num, Line)) {
+    return Line;
+  }
+  return "file does not exist: " + FilePath;
 }
 
 llvm::DILocalVariable *getDILocVarFromValue(const llvm::Value *V) {
@@ -169,4 +228,33 @@ std::string llvmValueToSrc(const llvm::Value *V, bool ScopeInfo) {
   return "No source information available!";
 }
 
+std::vector<std::string>
+llvmValuesToSrc(const std::vector<const llvm::Value *> &Values,
+                bool ScopeInfo) {
+  // Read every source file only once, before the lines are looked up. Only
+  // instructions without a debug variable print a source line, all other
+  // values, e.g. local and global variables, are resolved from their debug
+  // information by llvmValueToSrc exactly as a single value would be.
+  std::vector<std::string> Paths;
+  for (auto V : Values) {
+    auto I = llvm::dyn_cast<llvm::Instruction>(V);
+    if (I && !I->isUsedByMetadata() &&
+        I->getMetadata(llvm::LLVMContext::MD_dbg)) {
+      if (auto Scope = I->getDebugLoc()->getScope()) {
+        Paths.push_back(getSrcFilePath(Scope->getDirectory().str(),
+                                       Scope->getFilename().str()));
+      }
+    }
+  }
+  std::sort(Paths.begin(), Paths.end());
+  Paths.erase(std::unique(Paths.begin(), Paths.end()), Paths.end());
+  SourceFileCache::getInstance().preload(Paths);
+  std::vector<std::string> Src;
+  Src.reserve(Values.size());
+  for (auto V : Values) {
+    Src.push_back(llvmValueToSrc(V, ScopeInfo));
+  }
+  return Src;
+}
+
 } // namespace psr
@@ -14,6 +14,9 @@
  *      Author: philipp
  */
 
+#include <cctype>
+#include <sstream>
+
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
@@ -30,6 +33,7 @@
 #include <phasar/PhasarLLVM/IfdsIde/LLVMZeroValue.h>
 
 #include <phasar/Config/Configuration.h>
+#include <phasar/Utils/LLVMIRPrinter.h>
 #include <phasar/Utils/LLVMShorthands.h>
 #include <phasar/Utils/Macros.h>
 
@@ -145,17 +149,13 @@ bool matchesSignature(const llvm::Function *F,
 }
 
 std::string llvmIRToString(const llvm::Value *V) {
-  // WARNING: Expensive function, cause is the V->print(RSO)
+  // WARNING: Printing a value from scratch is expensive, cause is the
+  //         numbering of all slots of its module in V->print(RSO)
   //         (20ms on a medium size code (phasar without debug)
   //          80ms on a huge size code (clang without debug),
-  //          can be multiplied by times 3 to 5 if passes are enabled)
-  std::string IRBuffer;
-  llvm::raw_string_ostream RSO(IRBuffer);
-  V->print(RSO);
-  RSO << ", ID: " << getMetaDataID(V);
-  RSO.flush();
-  boost::trim_left(IRBuffer);
-  return IRBuffer;
+  //          can be multiplied by times 3 to 5 if passes are enabled).
+  //         The printer re-uses the numbering and caches the result.
+  return LLVMIRPrinter::getInstance().getString(V);
 }
 
 std::vector<const llvm::Value *>
@@ -292,6 +292,66 @@ std::size_t computeModuleHash(const llvm::Module *M) {
   return std::hash<std::string>{}(SourceCode);
 }
 
+/**
+ * Removes the metadata attachments, e.g. '!dbg !7', from a line of printed IR
+ * and drops the slot numbers of the remaining references to metadata nodes,
+ * e.g. in 'metadata !12'. String constants are left untouched.
+ */
+static std::string stripMetadata(const std::string &Line) {
+  std::string Stripped;
+  Stripped.reserve(Line.size());
+  bool InString = false;
+  int Depth = 0;
+  for (std::size_t Idx = 0; Idx < Line.size(); ++Idx) {
+    char C = Line[Idx];
+    if (InString) {
+      InString = C != '"';
+    } else if (C == '"') {
+      InString = true;
+    } else if (C == '(' || C == '[' || C == '{') {
+      ++Depth;
+    } else if (C == ')' || C == ']' || C == '}') {
+      --Depth;
+    } else if (C == '!') {
+      if (Depth <= 0 && Idx + 1 < Line.size() &&
+          std::isalpha(static_cast<unsigned char>(Line[Idx + 1]))) {
+        // attachments trail an instruction or precede a function's body
+        while (!Stripped.empty() &&
+               (Stripped.back() == ' ' || Stripped.back() == ',')) {
+          Stripped.pop_back();
+        }
+        if (Line.back() == '{') {
+          Stripped += " {";
+        }
+        return Stripped;
+      }
+      Stripped += C;
+      while (Idx + 1 < Line.size() &&
+             std::isdigit(static_cast<unsigned char>(Line[Idx + 1]))) {
+        ++Idx;
+      }
+      continue;
+    }
+    Stripped += C;
+  }
+  return Stripped;
+}
+
+std::size_t computeFunctionHash(const llvm::Function *F) {
+  std::string IR;
+  llvm::raw_string_ostream RSO(IR);
+  F->print(RSO);
+  RSO.flush();
+  std::string StrippedIR;
+  StrippedIR.reserve(IR.size());
+  std::istringstream ISS(IR);
+  for (std::string Line; std::getline(ISS, Line);) {
+    StrippedIR += stripMetadata(Line);
+    StrippedIR += '\n';
+  }
+  return std::hash<std::string>{}(StrippedIR);
+}
+
 const llvm::TerminatorInst *getNthTermInstruction(const llvm::Function *F,
                                                   unsigned termInstNo) {
   unsigned current = 1;
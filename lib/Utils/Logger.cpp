@@ -25,6 +25,9 @@
 #include <boost/shared_ptr.hpp>
 
 #include <boost/log/attributes.hpp>
+#include <boost/log/sinks/async_frontend.hpp>
+#include <boost/log/sinks/block_on_overflow.hpp>
+#include <boost/log/sinks/bounded_fifo_queue.hpp>
 #include <boost/log/utility/exception_handler.hpp>
 
 #include <phasar/Utils/Logger.h>
@@ -33,6 +36,18 @@ using namespace psr;
 
 namespace psr {
 
+namespace {
+
+// The records only carry the attribute values and the message, the formatting
+// into text happens on the sink's feeding thread.
+using text_sink = bl::sinks::asynchronous_sink<
+    bl::sinks::text_ostream_backend,
+    bl::sinks::bounded_fifo_queue<4096, bl::sinks::block_on_overflow>>;
+
+boost::shared_ptr<text_sink> Sink;
+
+} // anonymous namespace
+
 const map<string, severity_level> StringToSeverityLevel = {
     {"DEBUG", DEBUG},
     {"INFO", INFO},
@@ -73,9 +88,9 @@ void LoggerExceptionHandler::operator()(const std::exception &ex) const {
 void initializeLogger(bool use_logger, string log_file) {
   // Using this call, logging can be enabled or disabled
   bl::core::get()->set_logging_enabled(use_logger);
+  // some tools initialize the logger more than once
+  shutdownLogger();
   // if (log_file == "") {
-  typedef bl::sinks::synchronous_sink<bl::sinks::text_ostream_backend>
-      text_sink;
   boost::shared_ptr<text_sink> sink = boost::make_shared<text_sink>();
   // the easiest way is to write the logs to std::clog
   boost::shared_ptr<std::ostream> stream(&std::clog, boost::null_deleter{});
@@ -98,6 +113,7 @@ void initializeLogger(bool use_logger, string log_file) {
   sink->set_filter(&LogFilter);
   sink->set_formatter(&LogFormatter);
   bl::core::get()->add_sink(sink);
+  Sink = sink;
   bl::core::get()->add_global_attribute("LineCounter",
                                         bl::attributes::counter<int>{});
   bl::core::get()->add_global_attribute("Timestamp",
@@ -105,4 +121,14 @@ void initializeLogger(bool use_logger, string log_file) {
   bl::core::get()->set_exception_handler(
       bl::make_exception_handler<std::exception>(LoggerExceptionHandler()));
 }
+
+void shutdownLogger() {
+  if (!Sink) {
+    return;
+  }
+  bl::core::get()->remove_sink(Sink);
+  Sink->stop();
+  Sink->flush();
+  Sink.reset();
+}
 } // namespace psr
@@ -14,92 +14,180 @@
  *      Author: rleer
  */
 
+#include <algorithm>
 #include <boost/filesystem.hpp>
 #include <cassert>
 #include <iomanip>
+#include <stdexcept>
 #include <json.hpp>
 #include <phasar/Config/Configuration.h>
 #include <phasar/Utils/PAMM.h>
 #include <sstream>
+#include <sys/resource.h>
 
 using namespace psr;
 using json = nlohmann::json;
 
 namespace psr {
 
+PAMM::PAMM() = default;
+
+PAMM::~PAMM() = default;
+
 PAMM &PAMM::getInstance() {
   static PAMM instance;
   return instance;
 }
 
+PAMM::Handle PAMM::getHandle(const std::string &Id) {
+  std::lock_guard<std::mutex> lock(Mtx);
+  auto search = Handles.find(Id);
+  if (search != Handles.end()) {
+    return search->second;
+  }
+  if (Names.size() == MaxHandles) {
+    throw std::runtime_error("PAMM: too many ids, cannot register " + Id);
+  }
+  Handles[Id] = Names.size();
+  Names.push_back(Id);
+  return Names.size() - 1;
+}
+
+PAMM::Shard &PAMM::newShard() {
+  std::lock_guard<std::mutex> lock(Mtx);
+  Shards.emplace_back(new Shard);
+  return *Shards.back();
+}
+
 void PAMM::startTimer(const std::string &TimerId) {
-  bool validTimerId =
-      !RunningTimer.count(TimerId) && !StoppedTimer.count(TimerId);
-  assert(validTimerId && "startTimer failed due to an invalid timer id");
+  startTimer(getHandle(TimerId));
+}
+
+void PAMM::startTimer(Handle TimerId) {
+  Shard &S = getShard();
+  std::lock_guard<std::mutex> shard_lock(S.Mtx);
+  bool validTimerId = !S.RunningTimer.count(TimerId);
+  assert(validTimerId && "startTimer failed due to a running timer");
   if (validTimerId) {
     PAMM::TimePoint_t start = std::chrono::high_resolution_clock::now();
-    RunningTimer[TimerId] = start;
+    S.RunningTimer[TimerId] = start;
   }
 }
 
 void PAMM::resetTimer(const std::string &TimerId) {
-  assert((RunningTimer.count(TimerId) && !StoppedTimer.count(TimerId)) ||
-         (!RunningTimer.count(TimerId) && StoppedTimer.count(TimerId)) &&
-             "resetTimer failed due to an invalid timer id");
-  if (RunningTimer.count(TimerId)) {
-    RunningTimer.erase(RunningTimer.find(TimerId));
-  } else if (StoppedTimer.count(TimerId)) {
-    StoppedTimer.erase(StoppedTimer.find(TimerId));
-  }
+  Handle H = getHandle(TimerId);
+  Shard &S = getShard();
+  std::lock_guard<std::mutex> shard_lock(S.Mtx);
+  bool validTimerId = S.RunningTimer.erase(H) || S.StoppedTimer.erase(H);
+  assert(validTimerId && "resetTimer failed due to an invalid timer id");
 }
 
 void PAMM::stopTimer(const std::string &TimerId, bool PauseTimer) {
-  bool runningTimer = RunningTimer.count(TimerId);
-  bool validTimerId = runningTimer || StoppedTimer.count(TimerId);
-  assert(validTimerId && "stopTimer failed due to an invalid timer id or timer "
-                         "was already stopped");
-  assert(runningTimer && "stopTimer failed because timer was already stopped");
-  if (validTimerId) {
-    auto timer = RunningTimer.find(TimerId);
-    PAMM::TimePoint_t end = std::chrono::high_resolution_clock::now();
-    PAMM::TimePoint_t start = timer->second;
-    RunningTimer.erase(timer);
-    auto p = make_pair(start, end);
-    if (PauseTimer) {
-      RepeatingTimer[TimerId].push_back(p);
-    } else {
-      StoppedTimer[TimerId] = p;
+  stopTimer(getHandle(TimerId), PauseTimer);
+}
+
+void PAMM::stopTimer(Handle TimerId, bool PauseTimer) {
+  stopTimer(getShard(), TimerId, PauseTimer);
+}
+
+void PAMM::stopTimer(Shard &S, Handle TimerId, bool PauseTimer) {
+  PAMM::TimePoint_t end = std::chrono::high_resolution_clock::now();
+  std::lock_guard<std::mutex> shard_lock(S.Mtx);
+  auto timer = S.RunningTimer.find(TimerId);
+  bool runningTimer = timer != S.RunningTimer.end();
+  assert(runningTimer && "stopTimer failed due to an invalid timer id or "
+                         "timer was already stopped");
+  if (!runningTimer) {
+    return;
+  }
+  auto p = make_pair(timer->second, end);
+  S.RunningTimer.erase(timer);
+  if (PauseTimer) {
+    S.RepeatingTimer[TimerId].push_back(p);
+  } else {
+    S.StoppedTimer[TimerId] = p;
+  }
+}
+
+void PAMM::stopAllTimers() {
+  std::vector<Shard *> AllShards;
+  {
+    std::lock_guard<std::mutex> lock(Mtx);
+    for (auto &S : Shards) {
+      AllShards.push_back(S.get());
+    }
+  }
+  for (auto S : AllShards) {
+    std::vector<Handle> Running;
+    {
+      std::lock_guard<std::mutex> shard_lock(S->Mtx);
+      for (auto &timer : S->RunningTimer) {
+        Running.push_back(timer.first);
+      }
+    }
+    for (auto H : Running) {
+      stopTimer(*S, H, false);
     }
   }
 }
 
 unsigned long PAMM::elapsedTime(const std::string &TimerId) {
-  assert((RunningTimer.count(TimerId) || StoppedTimer.count(TimerId)) &&
+  Handle H = getHandle(TimerId);
+  Shard &S = getShard();
+  {
+    std::lock_guard<std::mutex> shard_lock(S.Mtx);
+    auto timer = S.RunningTimer.find(H);
+    if (timer != S.RunningTimer.end()) {
+      PAMM::TimePoint_t end = std::chrono::high_resolution_clock::now();
+      auto duration =
+          std::chrono::duration_cast<Duration_t>(end - timer->second);
+      return duration.count();
+    }
+    auto stopped = S.StoppedTimer.find(H);
+    if (stopped != S.StoppedTimer.end()) {
+      auto duration = std::chrono::duration_cast<Duration_t>(
+          stopped->second.second - stopped->second.first);
+      return duration.count();
+    }
+  }
+  // the timer has been run by other threads only
+  auto Times = elapsedTimeOfSingleTimer();
+  auto timer = Times.find(TimerId);
+  assert(timer != Times.end() &&
          "elapsedTime failed due to an invalid timer id");
-  if (RunningTimer.count(TimerId)) {
-    PAMM::TimePoint_t end = std::chrono::high_resolution_clock::now();
-    PAMM::TimePoint_t start = RunningTimer[TimerId];
-    auto duration = std::chrono::duration_cast<Duration_t>(end - start);
-    return duration.count();
-  } else if (StoppedTimer.count(TimerId)) {
-    auto duration = std::chrono::duration_cast<Duration_t>(
-        StoppedTimer[TimerId].second - StoppedTimer[TimerId].first);
-    return duration.count();
+  return timer != Times.end() ? timer->second : 0;
+}
+
+std::unordered_map<std::string, unsigned long>
+PAMM::elapsedTimeOfSingleTimer() {
+  std::unordered_map<std::string, unsigned long> Times;
+  std::lock_guard<std::mutex> lock(Mtx);
+  for (auto &S : Shards) {
+    std::lock_guard<std::mutex> shard_lock(S->Mtx);
+    for (auto &timer : S->StoppedTimer) {
+      auto duration = std::chrono::duration_cast<Duration_t>(
+          timer.second.second - timer.second.first);
+      auto &Time = Times[Names[timer.first]];
+      Time = std::max<unsigned long>(Time, duration.count());
+    }
   }
-  return 0;
+  return Times;
 }
 
 std::unordered_map<std::string, std::vector<unsigned long>>
 PAMM::elapsedTimeOfRepeatingTimer() {
   std::unordered_map<std::string, std::vector<unsigned long>> accTimes;
-  for (auto timer : RepeatingTimer) {
-    std::vector<unsigned long> accTimeVec;
-    for (auto timepair : timer.second) {
-      auto duration = std::chrono::duration_cast<PAMM::Duration_t>(
-          timepair.second - timepair.first);
-      accTimeVec.push_back(duration.count());
+  std::lock_guard<std::mutex> lock(Mtx);
+  for (auto &S : Shards) {
+    std::lock_guard<std::mutex> shard_lock(S->Mtx);
+    for (auto &timer : S->RepeatingTimer) {
+      auto &accTimeVec = accTimes[Names[timer.first]];
+      for (auto &timepair : timer.second) {
+        auto duration = std::chrono::duration_cast<PAMM::Duration_t>(
+            timepair.second - timepair.first);
+        accTimeVec.push_back(duration.count());
+      }
     }
-    accTimes[timer.first] = accTimeVec;
   }
   return accTimes;
 }
@@ -126,34 +214,65 @@ std::string PAMM::getPrintableDuration(unsigned long Duration) {
 }
 
 void PAMM::regCounter(const std::string &CounterId, unsigned IntialValue) {
-  bool validCounterId = !Counter.count(CounterId);
+  regCounter(getHandle(CounterId), IntialValue);
+}
+
+void PAMM::regCounter(Handle CounterId, unsigned IntialValue) {
+  std::lock_guard<std::mutex> lock(Mtx);
+  bool validCounterId = !CounterRegistered[CounterId].load();
   assert(validCounterId && "regCounter failed due to an invalid counter id");
   if (validCounterId) {
-    Counter[CounterId] = IntialValue;
+    CounterBase[CounterId] = IntialValue;
+    for (auto &S : Shards) {
+      S->Counter[CounterId].store(0, std::memory_order_relaxed);
+    }
+    CounterRegistered[CounterId] = true;
   }
 }
 
-void PAMM::incCounter(const std::string &CounterId, unsigned CValue) {
-  bool validCounterId = Counter.count(CounterId);
-  assert(validCounterId && "incCounter failed due to an invalid counter id");
-  if (validCounterId) {
-    Counter[CounterId] += CValue;
+void PAMM::regSharedCounter(const std::string &CounterId) {
+  regSharedCounter(getHandle(CounterId));
+}
+
+void PAMM::regSharedCounter(Handle CounterId) {
+  std::lock_guard<std::mutex> lock(Mtx);
+  if (!CounterRegistered[CounterId].load()) {
+    CounterBase[CounterId] = 0;
+    for (auto &S : Shards) {
+      S->Counter[CounterId].store(0, std::memory_order_relaxed);
+    }
+    CounterRegistered[CounterId] = true;
   }
 }
 
+void PAMM::incCounter(const std::string &CounterId, unsigned CValue) {
+  Handle H = getHandle(CounterId);
+  assert(CounterRegistered[H].load() &&
+         "incCounter failed due to an invalid counter id");
+  incCounter(H, CValue);
+}
+
 void PAMM::decCounter(const std::string &CounterId, unsigned CValue) {
-  bool validCounterId = Counter.count(CounterId);
-  assert(validCounterId && "decCounter failed due to an invalid counter id");
-  if (validCounterId) {
-    Counter[CounterId] -= CValue;
-  }
+  Handle H = getHandle(CounterId);
+  assert(CounterRegistered[H].load() &&
+         "decCounter failed due to an invalid counter id");
+  decCounter(H, CValue);
 }
 
 int PAMM::getCounter(const std::string &CounterId) {
-  bool validCounterId = Counter.count(CounterId);
+  return getCounter(getHandle(CounterId));
+}
+
+int PAMM::getCounter(Handle CounterId) {
+  bool validCounterId = CounterRegistered[CounterId].load();
   assert(validCounterId && "getCounter failed due to an invalid counter id");
   if (validCounterId) {
-    return Counter[CounterId];
+    std::lock_guard<std::mutex> lock(Mtx);
+    long count = CounterBase[CounterId];
+    for (auto &S : Shards) {
+      count += S->Counter[CounterId].load(std::memory_order_relaxed);
+    }
+    return count;
   }
   return -1;
 }
@@ -173,46 +292,89 @@ int PAMM::getSumCount(const std::set<std::string> &CounterIds) {
 }
 
 void PAMM::regHistogram(const std::string &HistogramId) {
-  bool validHID = !Histogram.count(HistogramId);
+  regHistogram(getHandle(HistogramId));
+}
+
+void PAMM::regHistogram(Handle HistogramId) {
+  bool validHID = !HistogramRegistered[HistogramId].exchange(true);
   assert(validHID && "failed to register new histogram due to an invalid id");
-  if (validHID) {
-    std::unordered_map<std::string, unsigned long> H;
-    Histogram[HistogramId] = H;
-  }
+}
+
+void PAMM::regSharedHistogram(Handle HistogramId) {
+  HistogramRegistered[HistogramId] = true;
 }
 
 void PAMM::addToHistogram(const std::string &HistogramId,
                           const std::string &DataPointId,
                           unsigned long DataPointValue) {
-  bool validHistoID = Histogram.count(HistogramId);
-  assert(validHistoID &&
+  addToHistogram(getHandle(HistogramId), DataPointId, DataPointValue);
+}
+
+void PAMM::addToHistogram(Handle HistogramId, const std::string &DataPointId,
+                          unsigned long DataPointValue) {
+  assert(HistogramRegistered[HistogramId].load() &&
          "adding data point to histogram failed due to invalid id");
-  if (Histogram[HistogramId].count(DataPointId)) {
-    Histogram[HistogramId][DataPointId] += DataPointValue;
-  } else {
-    Histogram[HistogramId][DataPointId] = DataPointValue;
+  Shard &S = getShard();
+  std::lock_guard<std::mutex> shard_lock(S.Mtx);
+  S.Histogram[HistogramId][DataPointId] += DataPointValue;
+}
+
+std::unordered_map<std::string, long> PAMM::aggregateCounters() {
+  std::unordered_map<std::string, long> Counter;
+  std::lock_guard<std::mutex> lock(Mtx);
+  for (Handle H = 0; H < Names.size(); ++H) {
+    if (CounterRegistered[H].load()) {
+      long count = CounterBase[H];
+      for (auto &S : Shards) {
+        count += S->Counter[H].load(std::memory_order_relaxed);
+      }
+      Counter[Names[H]] = count;
+    }
   }
+  return Counter;
+}
+
+std::unordered_map<std::string, std::unordered_map<std::string, unsigned long>>
+PAMM::aggregateHistograms() {
+  std::unordered_map<std::string,
+                     std::unordered_map<std::string, unsigned long>>
+      Histogram;
+  std::lock_guard<std::mutex> lock(Mtx);
+  for (Handle H = 0; H < Names.size(); ++H) {
+    if (HistogramRegistered[H].load()) {
+      Histogram[Names[H]];
+    }
+  }
+  for (auto &S : Shards) {
+    std::lock_guard<std::mutex> shard_lock(S->Mtx);
+    for (auto &H : S->Histogram) {
+      auto &Aggregated = Histogram[Names[H.first]];
+      for (auto &entry : H.second) {
+        Aggregated[entry.first] += entry.second;
+      }
+    }
+  }
+  return Histogram;
 }
 
 void PAMM::printTimers(std::ostream &os) {
   // stop all running timer
-  while (!RunningTimer.empty()) {
-    stopTimer(RunningTimer.begin()->first);
-  }
+  stopAllTimers();
   os << "Single Timer\n";
   os << "------------\n";
-  for (auto timer : StoppedTimer) {
-    unsigned long time = elapsedTime(timer.first);
-    os << timer.first << " : " << getPrintableDuration(time) << '\n';
+  auto Stopped = elapsedTimeOfSingleTimer();
+  for (auto timer : Stopped) {
+    os << timer.first << " : " << getPrintableDuration(timer.second) << '\n';
   }
-  if (StoppedTimer.empty()) {
+  if (Stopped.empty()) {
     os << "No single Timer started!\n\n";
   } else {
     os << "\n";
   }
   os << "Repeating Timer\n";
   os << "---------------\n";
-  for (auto timer : elapsedTimeOfRepeatingTimer()) {
+  auto Repeating = elapsedTimeOfRepeatingTimer();
+  for (auto timer : Repeating) {
     unsigned long sum = 0;
     os << timer.first << " Timer:\n";
     for (auto duration : timer.second) {
@@ -221,7 +383,7 @@ void PAMM::printTimers(std::ostream &os) {
     }
     os << "===\n" << sum << "\n\n";
   }
-  if (RepeatingTimer.empty()) {
+  if (Repeating.empty()) {
     os << "No repeating Timer found!\n";
   } else {
     os << '\n';
@@ -231,6 +393,7 @@ void PAMM::printTimers(std::ostream &os) {
 void PAMM::printCounters(std::ostream &os) {
   os << "\nCounter\n";
   os << "-------\n";
+  auto Counter = aggregateCounters();
   for (auto counter : Counter) {
     os << counter.first << " : " << counter.second << '\n';
   }
@@ -244,6 +407,7 @@ void PAMM::printCounters(std::ostream &os) {
 void PAMM::printHistograms(std::ostream &os) {
   os << "\nHistograms\n";
   os << "--------------\n";
+  auto Histogram = aggregateHistograms();
   for (auto H : Histogram) {
     os << H.first << " Histogram\n";
     os << "Value : #Occurrences\n";
@@ -257,11 +421,25 @@ void PAMM::printHistograms(std::ostream &os) {
   }
 }
 
+long PAMM::peakResidentSetSize() {
+  struct rusage Usage;
+  if (getrusage(RUSAGE_SELF, &Usage) != 0) {
+    return 0;
+  }
+  // ru_maxrss is reported in kilobytes on Linux, but in bytes on macOS
+#ifdef __APPLE__
+  return Usage.ru_maxrss / 1024;
+#else
+  return Usage.ru_maxrss;
+#endif
+}
+
 void PAMM::printMeasuredData(std::ostream &os) {
   os << "\n----- START OF EVALUATION DATA -----\n\n";
   printTimers(os);
   printCounters(os);
   printHistograms(os);
+  os << "\nPeak RSS: " << peakResidentSetSize() << " KB\n";
   os << "\n----- END OF EVALUATION DATA -----\n\n";
 }
 
@@ -270,13 +448,10 @@ void PAMM::exportMeasuredData(std::string OutputPath) {
   json jsonData;
 
   // add timer data
-  while (!RunningTimer.empty()) {
-    stopTimer(RunningTimer.begin()->first);
-  }
+  stopAllTimers();
   json jTimer;
-  for (auto timer : StoppedTimer) {
-    unsigned long time = elapsedTime(timer.first);
-    jTimer[timer.first] = time;
+  for (auto timer : elapsedTimeOfSingleTimer()) {
+    jTimer[timer.first] = timer.second;
   }
   for (auto timer : elapsedTimeOfRepeatingTimer()) {
     jTimer[timer.first] = timer.second;
@@ -285,7 +460,7 @@ void PAMM::exportMeasuredData(std::string OutputPath) {
 
   // add histogram data if available
   json jHistogram;
-  for (auto H : Histogram) {
+  for (auto H : aggregateHistograms()) {
     json jSetH;
     for (auto entry : H.second) {
       jSetH[entry.first] = entry.second;
@@ -297,10 +472,11 @@ void PAMM::exportMeasuredData(std::string OutputPath) {
   }
   // add counter data
   json jCounter;
-  for (auto counter : Counter) {
+  for (auto counter : aggregateCounters()) {
     jCounter[counter.first] = counter.second;
   }
   jsonData["Counter"] = jCounter;
+  jsonData["Peak RSS (KB)"] = peakResidentSetSize();
 
   // add analysis/project/source file information if available
   json jInfo;
@@ -333,10 +509,21 @@ void PAMM::exportMeasuredData(std::string OutputPath) {
 }
 
 void PAMM::reset() {
-  RunningTimer.clear();
-  StoppedTimer.clear();
-  RepeatingTimer.clear();
-  Counter.clear();
-  Histogram.clear();
+  std::lock_guard<std::mutex> lock(Mtx);
+  for (auto &S : Shards) {
+    std::lock_guard<std::mutex> shard_lock(S->Mtx);
+    for (Handle H = 0; H < Names.size(); ++H) {
+      S->Counter[H].store(0, std::memory_order_relaxed);
+    }
+    S->RunningTimer.clear();
+    S->StoppedTimer.clear();
+    S->RepeatingTimer.clear();
+    S->Histogram.clear();
+  }
+  CounterBase.clear();
+  for (Handle H = 0; H < Names.size(); ++H) {
+    CounterRegistered[H] = false;
+    HistogramRegistered[H] = false;
+  }
 }
 } // namespace psr
@@ -0,0 +1,277 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <tuple>
+
+#include <phasar/Utils/Profiler.h>
+#include <phasar/Utils/ResultWriter.h>
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+namespace {
+
+uint64_t toNanoseconds(Profiler::Clock::duration D) {
+  return chrono::duration_cast<chrono::nanoseconds>(D).count();
+}
+
+} // anonymous namespace
+
+Profiler::ThreadData::ThreadData(uint32_t tid) : tid(tid) {
+  nodes.emplace_back(0, 0, 0, false);
+}
+
+Profiler::Profiler() : epoch(Clock::now()) {
+  // id 0 is the empty string, used for spans without detail
+  intern("");
+}
+
+Profiler::~Profiler() = default;
+
+Profiler &Profiler::getInstance() {
+  static Profiler instance;
+  return instance;
+}
+
+void Profiler::setEnabled(bool Enabled) { enabled = Enabled; }
+
+void Profiler::setTraceThreshold(chrono::microseconds Threshold) {
+  trace_threshold_ns = chrono::duration_cast<chrono::nanoseconds>(Threshold)
+                           .count();
+}
+
+Profiler::ThreadData &Profiler::newThreadData() {
+  lock_guard<mutex> lock(mtx);
+  threads.emplace_back(new ThreadData(threads.size() + 1));
+  return *threads.back();
+}
+
+uint32_t Profiler::intern(const string &S) {
+  lock_guard<mutex> lock(mtx);
+  auto search = string_ids.find(S);
+  if (search != string_ids.end()) {
+    return search->second;
+  }
+  string_ids[S] = strings.size();
+  strings.push_back(S);
+  return strings.size() - 1;
+}
+
+uint32_t Profiler::getChild(ThreadData &T, uint32_t Parent, uint32_t Name,
+                            uint32_t Detail, bool Method) {
+  uint64_t Key = (uint64_t(Name) << 32 | Detail) << 1 | Method;
+  auto search = T.nodes[Parent].children.find(Key);
+  if (search != T.nodes[Parent].children.end()) {
+    return search->second;
+  }
+  uint32_t Child = T.nodes.size();
+  T.nodes.emplace_back(Parent, Name, Detail, Method);
+  T.nodes[Parent].children[Key] = Child;
+  return Child;
+}
+
+void Profiler::enter(const char *Name, const string &Detail, bool Method) {
+  ThreadData &T = getThreadData();
+  auto NameSearch = T.name_cache.find(Name);
+  if (NameSearch == T.name_cache.end()) {
+    NameSearch = T.name_cache.emplace(Name, intern(Name)).first;
+  }
+  uint32_t DetailId = 0;
+  if (!Detail.empty()) {
+    auto DetailSearch = T.detail_cache.find(Detail);
+    if (DetailSearch == T.detail_cache.end()) {
+      DetailSearch = T.detail_cache.emplace(Detail, intern(Detail)).first;
+    }
+    DetailId = DetailSearch->second;
+  }
+  uint32_t NameId = NameSearch->second;
+  if (!Method) {
+    T.current = getChild(T, T.current, NameId, DetailId, false);
+  }
+  Frame F;
+  F.name = NameId;
+  F.detail = DetailId;
+  F.method = Method;
+  F.begin = Clock::now();
+  T.stack.push_back(F);
+}
+
+void Profiler::exit() {
+  auto End = Clock::now();
+  ThreadData &T = getThreadData();
+  if (T.stack.empty()) {
+    return;
+  }
+  Frame F = T.stack.back();
+  T.stack.pop_back();
+  uint64_t Duration = toNanoseconds(End - F.begin);
+  uint64_t Self = Duration > F.child_ns ? Duration - F.child_ns : 0;
+  if (!T.stack.empty()) {
+    T.stack.back().child_ns += Duration;
+  }
+  uint32_t N;
+  if (F.method) {
+    // method spans may recurse, only their self time is meaningful
+    N = getChild(T, T.current, F.name, F.detail, true);
+    T.nodes[N].inclusive_ns += Self;
+  } else {
+    N = T.current;
+    T.nodes[N].inclusive_ns += Duration;
+    T.current = T.nodes[N].parent;
+  }
+  T.nodes[N].count++;
+  T.nodes[N].self_ns += Self;
+  T.nodes[N].edges += F.edges;
+  if (Duration >= trace_threshold_ns.load(memory_order_relaxed)) {
+    T.events.push_back({N, toNanoseconds(F.begin - epoch), Duration});
+  }
+}
+
+void Profiler::countEdges(uint64_t Edges) {
+  ThreadData &T = getThreadData();
+  if (!T.stack.empty()) {
+    T.stack.back().edges += Edges;
+  }
+}
+
+string Profiler::frameName(const Node &N) {
+  string Frame = strings[N.name];
+  if (N.detail) {
+    Frame += "(" + strings[N.detail] + ")";
+  }
+  // ';' separates the frames of folded stacks
+  replace(Frame.begin(), Frame.end(), ';', ':');
+  return Frame;
+}
+
+string Profiler::stackOf(const ThreadData &T, uint32_t Node) {
+  vector<uint32_t> Path;
+  for (; Node != 0; Node = T.nodes[Node].parent) {
+    Path.push_back(Node);
+  }
+  string Stack;
+  for (auto it = Path.rbegin(); it != Path.rend(); ++it) {
+    if (!Stack.empty()) {
+      Stack += ';';
+    }
+    Stack += frameName(T.nodes[*it]);
+  }
+  return Stack;
+}
+
+void Profiler::exportChromeTrace(ostream &OS) {
+  lock_guard<mutex> lock(mtx);
+  JsonStreamWriter W(OS);
+  W.beginObject();
+  W.key("traceEvents");
+  W.beginArray();
+  for (auto &T : threads) {
+    for (auto &E : T->events) {
+      const Node &N = T->nodes[E.node];
+      W.beginObject();
+      W.key("name");
+      W.value(strings[N.name]);
+      W.key("cat");
+      W.value(N.method ? "method" : "scope");
+      W.key("ph");
+      W.value("X");
+      W.key("ts");
+      W.value(static_cast<int64_t>(E.begin_ns / 1000));
+      W.key("dur");
+      W.value(static_cast<int64_t>(E.duration_ns / 1000));
+      W.key("pid");
+      W.value(static_cast<int64_t>(1));
+      W.key("tid");
+      W.value(static_cast<int64_t>(T->tid));
+      if (N.detail) {
+        W.key("args");
+        W.beginObject();
+        W.key("detail");
+        W.value(strings[N.detail]);
+        W.endObject();
+      }
+      W.endObject();
+    }
+  }
+  W.endArray();
+  W.key("displayTimeUnit");
+  W.value("ms");
+  W.endObject();
+}
+
+void Profiler::exportFoldedStacks(ostream &OS, bool Edges) {
+  lock_guard<mutex> lock(mtx);
+  map<string, uint64_t> Folded;
+  for (auto &T : threads) {
+    for (uint32_t i = 1; i < T->nodes.size(); ++i) {
+      uint64_t Weight =
+          Edges ? T->nodes[i].edges : T->nodes[i].self_ns / 1000;
+      if (Weight) {
+        Folded[stackOf(*T, i)] += Weight;
+      }
+    }
+  }
+  for (auto &Stack : Folded) {
+    OS << Stack.first << ' ' << Stack.second << '\n';
+  }
+}
+
+void Profiler::printSummary(ostream &OS, size_t Limit) {
+  lock_guard<mutex> lock(mtx);
+  struct Total {
+    uint64_t self_ns = 0;
+    uint64_t count = 0;
+    uint64_t edges = 0;
+  };
+  map<string, Total> Totals;
+  for (auto &T : threads) {
+    for (uint32_t i = 1; i < T->nodes.size(); ++i) {
+      auto &Sum = Totals[frameName(T->nodes[i])];
+      Sum.self_ns += T->nodes[i].self_ns;
+      Sum.count += T->nodes[i].count;
+      Sum.edges += T->nodes[i].edges;
+    }
+  }
+  vector<pair<string, Total>> Sorted(Totals.begin(), Totals.end());
+  sort(Sorted.begin(), Sorted.end(),
+       [](const pair<string, Total> &A, const pair<string, Total> &B) {
+         return tie(B.second.self_ns, A.first) <
+                tie(A.second.self_ns, B.first);
+       });
+  OS << "\nProfile (self time)\n";
+  OS << "-------------------\n";
+  OS << setw(12) << "self [ms]" << setw(12) << "calls" << setw(14)
+     << "path edges"
+     << "  span\n";
+  for (size_t i = 0; i < Sorted.size() && i < Limit; ++i) {
+    OS << setw(12) << Sorted[i].second.self_ns / 1000000 << setw(12)
+       << Sorted[i].second.count << setw(14) << Sorted[i].second.edges << "  "
+       << Sorted[i].first << '\n';
+  }
+}
+
+void Profiler::reset() {
+  lock_guard<mutex> lock(mtx);
+  for (auto &T : threads) {
+    T->nodes.clear();
+    T->nodes.emplace_back(0, 0, 0, false);
+    T->current = 0;
+    T->stack.clear();
+    T->events.clear();
+  }
+  epoch = Clock::now();
+}
+
+} // namespace psr
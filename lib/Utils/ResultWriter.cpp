@@ -0,0 +1,206 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <cstdio>
+#include <ostream>
+
+#include <phasar/Utils/ResultWriter.h>
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+JsonStreamWriter::JsonStreamWriter(ostream &os) : os(os) {}
+
+JsonStreamWriter::~JsonStreamWriter() { os.flush(); }
+
+void JsonStreamWriter::separate() {
+  if (after_key) {
+    after_key = false;
+    return;
+  }
+  if (!first.empty()) {
+    if (!first.back()) {
+      os << ',';
+    }
+    first.back() = false;
+  }
+}
+
+void JsonStreamWriter::writeString(const string &s) {
+  os << '"';
+  for (char c : s) {
+    switch (c) {
+    case '"':
+      os << "\\\"";
+      break;
+    case '\\':
+      os << "\\\\";
+      break;
+    case '\n':
+      os << "\\n";
+      break;
+    case '\t':
+      os << "\\t";
+      break;
+    case '\r':
+      os << "\\r";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        char buf[7];
+        snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+        os << buf;
+      } else {
+        os << c;
+      }
+    }
+  }
+  os << '"';
+}
+
+void JsonStreamWriter::beginObject() {
+  separate();
+  os << '{';
+  first.push_back(true);
+}
+
+void JsonStreamWriter::endObject() {
+  first.pop_back();
+  os << '}';
+}
+
+void JsonStreamWriter::beginArray() {
+  separate();
+  os << '[';
+  first.push_back(true);
+}
+
+void JsonStreamWriter::endArray() {
+  first.pop_back();
+  os << ']';
+}
+
+void JsonStreamWriter::key(const string &k) {
+  separate();
+  writeString(k);
+  os << ':';
+  after_key = true;
+}
+
+void JsonStreamWriter::value(const string &v) {
+  separate();
+  writeString(v);
+}
+
+void JsonStreamWriter::value(const char *v) { value(string(v)); }
+
+void JsonStreamWriter::value(int64_t v) {
+  separate();
+  os << v;
+}
+
+void JsonStreamWriter::value(bool v) {
+  separate();
+  os << (v ? "true" : "false");
+}
+
+void JsonStreamWriter::null() {
+  separate();
+  os << "null";
+}
+
+const uint32_t BinaryResultWriter::Version;
+
+BinaryResultWriter::BinaryResultWriter(ostream &os) : os(os) {
+  os.write("PSRR", 4);
+  writeU32(Version);
+}
+
+void BinaryResultWriter::writeU32(uint32_t v) {
+  char buf[4] = {static_cast<char>(v & 0xff), static_cast<char>(v >> 8 & 0xff),
+                 static_cast<char>(v >> 16 & 0xff),
+                 static_cast<char>(v >> 24 & 0xff)};
+  os.write(buf, 4);
+}
+
+void BinaryResultWriter::writeString(const string &s) {
+  writeU32(s.size());
+  os.write(s.data(), s.size());
+}
+
+void BinaryResultWriter::beginAnalysis(const string &Name) {
+  os.put('A');
+  writeString(Name);
+}
+
+void BinaryResultWriter::addResult(uint32_t Node, uint32_t Fact,
+                                   uint32_t Value) {
+  os.put('R');
+  writeU32(Node);
+  writeU32(Fact);
+  writeU32(Value);
+}
+
+void BinaryResultWriter::addSymbol(SymbolKind Kind, uint32_t ID,
+                                   const string &Text) {
+  os.put('S');
+  os.put(static_cast<char>(Kind));
+  writeU32(ID);
+  writeString(Text);
+}
+
+const uint32_t BinaryEdgeLogWriter::Version;
+
+BinaryEdgeLogWriter::BinaryEdgeLogWriter(ostream &os) : os(os) {
+  os.write("PSRE", 4);
+  char buf[4] = {static_cast<char>(Version & 0xff),
+                 static_cast<char>(Version >> 8 & 0xff),
+                 static_cast<char>(Version >> 16 & 0xff),
+                 static_cast<char>(Version >> 24 & 0xff)};
+  os.write(buf, 4);
+}
+
+void BinaryEdgeLogWriter::writeVar(uint64_t v) {
+  do {
+    char byte = v & 0x7f;
+    v >>= 7;
+    os.put(v ? (byte | 0x80) : byte);
+  } while (v);
+}
+
+void BinaryEdgeLogWriter::writeString(const string &s) {
+  writeVar(s.size());
+  os.write(s.data(), s.size());
+}
+
+void BinaryEdgeLogWriter::addEdges(bool Inter, uint32_t Source,
+                                   uint32_t Target, uint32_t SourceFact,
+                                   const vector<uint32_t> &TargetFacts) {
+  os.put('E');
+  os.put(Inter ? 1 : 0);
+  writeVar(Source);
+  writeVar(Target);
+  writeVar(SourceFact);
+  writeVar(TargetFacts.size());
+  for (auto Fact : TargetFacts) {
+    writeVar(Fact);
+  }
+}
+
+void BinaryEdgeLogWriter::addSymbol(SymbolKind Kind, uint32_t ID,
+                                    const string &Text) {
+  os.put('S');
+  os.put(static_cast<char>(Kind));
+  writeVar(ID);
+  writeString(Text);
+}
+
+} // namespace psr
@@ -0,0 +1,17 @@
+void callee(int a) {
+	int b = a;
+}
+
+void other() {
+	int c = 1;
+	callee(c);
+	c = 2;
+}
+
+int main() {
+	int a = 0;
+	callee(a);
+	a = 1;
+	callee(a);
+	return 0;
+}
@@ -0,0 +1,18 @@
+#include <cstdarg>
+
+int sum(int n, ...) {
+  va_list args;
+  va_start(args, n);
+  int s = 0;
+  for (int i = 0; i < n; ++i) {
+    s += va_arg(args, int);
+  }
+  va_end(args);
+  return s;
+}
+
+int main() {
+  int i;
+  i = sum(3, 2, 2, 2);
+  return 0;
+}
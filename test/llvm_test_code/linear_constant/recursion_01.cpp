@@ -0,0 +1,19 @@
+int odd(int n);
+
+int even(int n) {
+  if (n == 0)
+    return 1;
+  return odd(n - 1);
+}
+
+int odd(int n) {
+  if (n == 0)
+    return 0;
+  return even(n - 1);
+}
+
+int main() {
+  int i = 42;
+  int j = even(4);
+  return i + j;
+}
@@ -0,0 +1,6 @@
+int g = 42;
+
+int main() {
+  int i = g;
+  return i;
+}
@@ -0,0 +1,11 @@
+int *id(int *p) { return p; }
+
+int main() {
+  int a = 1;
+  int b = 2;
+  int *p = id(&a);
+  int *q = id(&b);
+  *p = 3;
+  *q = 4;
+  return a + b;
+}
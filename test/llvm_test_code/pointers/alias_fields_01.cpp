@@ -0,0 +1,15 @@
+struct Pair {
+  int *first;
+  int *second;
+};
+
+int main() {
+  int a = 1;
+  int b = 2;
+  Pair P;
+  P.first = &a;
+  P.second = &b;
+  int *x = P.first;
+  *x = 3;
+  return a + b;
+}
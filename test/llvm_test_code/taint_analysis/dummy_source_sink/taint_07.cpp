@@ -0,0 +1,18 @@
+struct Pair {
+	int *first;
+	int *second;
+};
+
+void source(int *p) { *p = 42; } // dummy source, taints the pointee of p
+void sink(int p) { int b = p; }  // dummy sink
+
+int main(int argc, char **argv) {
+	int a = 0, b = 0;
+	Pair P;
+	P.first = &a;
+	P.second = &b;
+	source(P.first);
+	sink(a);
+	sink(b);
+	return 0;
+}
@@ -35,6 +35,7 @@ int main(int argc, char **argv) {
   DB.preprocessIR();
   LLVMTypeHierarchy H(DB);
   LLVMBasedICFG ICFG(H, DB, CallGraphAnalysisType::OTF, {"main"});
+  SyncPDSSolver SPDS(ICFG);
   for (auto &F : *DB.getWPAModule()) {
     if (F.isDeclaration()) { continue; }
     llvm::outs() << "ANALYZE FUNCTION: " << F.getName() << '\n';
@@ -58,12 +59,12 @@ int main(int argc, char **argv) {
             Load->getPointerOperand()->print(llvm::outs());
             llvm::outs() << '\n';
             // query SPDS solver to find the aliases
-            // SyncPDSSolver SPDS(ICFG);
-            // set<const llvm::Value *> Aliases = SPDS.getAliasesOf(Load->getPointerOperand());
-            // llvm::outs() << "Found aliases:";
-            // for (auto A : Aliases) {
-            //   A->print(llvm::outs() << '\n');
-            // }
+            set<const llvm::Value *> Aliases =
+                SPDS.getAliasesOf(Load->getPointerOperand(), Store);
+            llvm::outs() << "Found aliases:";
+            for (auto A : Aliases) {
+              A->print(llvm::outs() << '\n');
+            }
             llvm::outs() << '\n';
           } else {
             llvm::outs() << "Ups!\n";
@@ -7,6 +7,7 @@
  *     Philipp Schubert and others
  *****************************************************************************/
 
+#include <fstream>
 #include <stdexcept>
 
 #include <boost/filesystem.hpp>
@@ -21,6 +22,7 @@
 
 #include <phasar/Config/Configuration.h>
 #include <phasar/Controller/AnalysisController.h>
+#include <phasar/Controller/AnalysisServer.h>
 #include <phasar/DB/ProjectIRDB.h>
 #include <phasar/PhasarClang/ClangController.h>
 #include <phasar/PhasarLLVM/ControlFlow/ICFG.h>
@@ -33,6 +35,7 @@
 #include <phasar/Utils/EnumFlags.h>
 #include <phasar/Utils/Logger.h>
 #include <phasar/Utils/PAMMMacros.h>
+#include <phasar/Utils/Profiler.h>
 
 namespace bpo = boost::program_options;
 namespace bfs = boost::filesystem;
@@ -232,6 +235,9 @@ int main(int argc, const char **argv) {
       ("swift,s", bpo::value<bool>()->default_value(0),"Swift-aware analysis mode (1 or 0)")
 			("function,f", bpo::value<std::string>(), "Function under analysis (a mangled function name)")
 			("module,m", bpo::value<std::vector<std::string>>()->multitoken()->zero_tokens()->composing()->notifier(validateParamModule), "Path to the module(s) under analysis")
+			("project,p", bpo::value<std::string>()->notifier(validateParamProject), "Path to the project under analysis, its compile_commands.json is compiled instead of reading modules")
+			("jobs,j", bpo::value<unsigned>()->default_value(0), "Number of parallel jobs for --project and --fan-out (0 uses one per hardware thread)")
+			("bitcode-cache", bpo::value<std::string>(), "Directory in which the bitcode and precompiled headers of --project are cached")
       ("entry-points,E", bpo::value<std::vector<std::string>>()->multitoken()->zero_tokens()->composing(), "Set the entry point(s) to be used")
       ("output,O", bpo::value<std::string>()->notifier(validateParamOutput)->default_value("results.json"), "Filename for the results")
 			("data-flow-analysis,D", bpo::value<std::vector<std::string>>()->multitoken()->zero_tokens()->composing()->notifier(validateParamDataFlowAnalysis), "Set the analysis to be run")
@@ -240,10 +246,22 @@ int main(int argc, const char **argv) {
 			("classhierachy-analysis,H", bpo::value<bool>(), "Class-hierarchy analysis")
 			("vtable-analysis,V", bpo::value<bool>(), "Virtual function table analysis")
 			("statistical-analysis,S", bpo::value<bool>(), "Statistics")
-			//("export,E", bpo::value<std::string>()->notifier(validateParamExport), "Export mode (TODO: yet to implement!)")
+			("export", bpo::value<std::string>()->notifier(validateParamExport)->default_value("json"), "Export format of the results (json, binary)")
+			("export-symbols", bpo::value<bool>()->default_value(1), "Write the strings of the nodes, facts and values along with the binary results, the nodes are keyed by their psr.id (1 or 0)")
 			("wpa,W", bpo::value<bool>()->default_value(1), "Whole-program analysis mode (1 or 0)")
 			("mem2reg,M", bpo::value<bool>()->default_value(1), "Promote memory to register pass (1 or 0)")
 			("printedgerec,R", bpo::value<bool>()->default_value(0), "Print exploded-super-graph edge recorder (1 or 0)")
+			("lazy", bpo::value<bool>()->default_value(0), "Read function bodies of bitcode modules on demand (1 or 0)")
+			("fan-out", bpo::value<bool>()->default_value(0), "Solve the data-flow analyses for every entry point on its own, in parallel over a shared ICFG (1 or 0)")
+			("parallel-analyses", bpo::value<unsigned>()->default_value(1), "Number of data-flow analyses that run at the same time over the shared ICFG (0 uses one per hardware thread)")
+			("memory-budget", bpo::value<unsigned>()->default_value(0), "Do not start further analyses while the process uses more than this many MB (0 is unlimited)")
+			("release-finished", bpo::value<bool>()->default_value(0), "Release the jump functions and incoming edges of calling contexts once they have been explored completely, lowers the peak memory of IFDS_TaintAnalysis and of IFDS problems that do not compute values, has no effect on IDE problems (1 or 0)")
+			("demand-aliases", bpo::value<bool>()->default_value(0), "Answer the alias queries of IFDS_TaintAnalysis and IDE_TypeStateAnalysis on demand with the SyncPDS solver instead of the whole-module points-to graph (1 or 0)")
+			("incremental", bpo::value<std::string>(), "Restore the solver state stored under the given prefix by a previous run, update it for the functions edited since and store it again (IFDS_TypeAnalysis, IFDS_SolverTest)")
+			("snapshot", bpo::value<std::string>(), "Restore the class hierarchy and call graph from the given snapshot file if it matches the module, otherwise construct them and write the snapshot")
+			("serve", bpo::value<std::string>(), "Keep the project resident and answer queries on the Unix domain socket at the given path")
+			("verify", bpo::value<bool>()->default_value(1), "Verify the modules under analysis (1 or 0)")
+			("profile", bpo::value<std::string>(), "Profile the run, writes <prefix>.trace.json (Chrome trace) and <prefix>.folded, <prefix>.edges.folded (folded stacks)")
       #ifdef PHASAR_PLUGINS_ENABLED
 			("analysis-plugin", bpo::value<std::vector<std::string>>()->notifier(validateParamAnalysisPlugin), "Analysis plugin(s) (absolute path to the shared object file(s))")
       ("callgraph-plugin", bpo::value<std::string>()->notifier(validateParamICFGPlugin), "ICFG plugin (absolute path to the shared object file)")
@@ -332,6 +350,10 @@ int main(int argc, const char **argv) {
                     << VariablesMap["module"].as<std::vector<std::string>>()
                     << '\n';
         }
+        if (VariablesMap.count("project")) {
+          std::cout << "Project: " << VariablesMap["project"].as<std::string>()
+                    << '\n';
+        }
         if (VariablesMap.count("data-flow-analysis")) {
           std::cout << "Data-flow analysis: "
                     << VariablesMap["data-flow-analysis"]
@@ -371,6 +393,10 @@ int main(int argc, const char **argv) {
           std::cout << "Export: " << VariablesMap["export"].as<std::string>()
                     << '\n';
         }
+        if (VariablesMap.count("export-symbols")) {
+          std::cout << "Export symbols: "
+                    << VariablesMap["export-symbols"].as<bool>() << '\n';
+        }
         if (VariablesMap.count("wpa")) {
           std::cout << "WPA: " << VariablesMap["wpa"].as<bool>() << '\n';
         }
@@ -382,6 +408,44 @@ int main(int argc, const char **argv) {
           std::cout << "Print edge recorder: "
                     << VariablesMap["printedgerec"].as<bool>() << '\n';
         }
+        if (VariablesMap.count("lazy")) {
+          std::cout << "Lazy: " << VariablesMap["lazy"].as<bool>() << '\n';
+        }
+        if (VariablesMap.count("fan-out")) {
+          std::cout << "Fan-out: " << VariablesMap["fan-out"].as<bool>()
+                    << '\n';
+        }
+        if (VariablesMap.count("parallel-analyses")) {
+          std::cout << "Parallel analyses: "
+                    << VariablesMap["parallel-analyses"].as<unsigned>() << '\n';
+        }
+        if (VariablesMap.count("memory-budget")) {
+          std::cout << "Memory budget: "
+                    << VariablesMap["memory-budget"].as<unsigned>() << " MB\n";
+        }
+        if (VariablesMap.count("release-finished")) {
+          std::cout << "Release finished: "
+                    << VariablesMap["release-finished"].as<bool>() << '\n';
+        }
+        if (VariablesMap.count("demand-aliases")) {
+          std::cout << "Demand-driven aliases: "
+                    << VariablesMap["demand-aliases"].as<bool>() << '\n';
+        }
+        if (VariablesMap.count("snapshot")) {
+          std::cout << "Snapshot: "
+                    << VariablesMap["snapshot"].as<std::string>() << '\n';
+        }
+        if (VariablesMap.count("serve")) {
+          std::cout << "Serve: " << VariablesMap["serve"].as<std::string>()
+                    << '\n';
+        }
+        if (VariablesMap.count("verify")) {
+          std::cout << "Verify: " << VariablesMap["verify"].as<bool>() << '\n';
+        }
+        if (VariablesMap.count("profile")) {
+          std::cout << "Profile: " << VariablesMap["profile"].as<std::string>()
+                    << '\n';
+        }
         if (VariablesMap.count("analysis-plugin")) {
           std::cout << "Analysis plugin(s): \n";
           for (const auto &analysis_plugin :
@@ -405,8 +469,8 @@ int main(int argc, const char **argv) {
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
                     << "Check program options for logical errors.");
       // validate the logic of the command-line arguments
-      if (!VariablesMap.count("module")) {
-        std::cerr << "A module must be specified for an analysis.\n";
+      if (!VariablesMap.count("module") && !VariablesMap.count("project")) {
+        std::cerr << "A module or project must be specified for an analysis.\n";
         return 1;
       }
 
@@ -460,30 +524,77 @@ int main(int argc, const char **argv) {
     }
 #endif
 
-    // At this point we have set-up all the parameters and can start the actual
-    // analyses that have been choosen.
-    AnalysisController Controller(
-        [&lg]() {
-          PAMM_GET_INSTANCE;
-          START_TIMER("IRDB Construction", PAMM_SEVERITY_LEVEL::Full);
-          LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO) << "Set-up IR database.");
-          IRDBOptions Opt = IRDBOptions::NONE;
-          if (VariablesMap["wpa"].as<bool>()) {
-            Opt |= IRDBOptions::WPA;
-          }
-          if (VariablesMap["mem2reg"].as<bool>()) {
-            Opt |= IRDBOptions::MEM2REG;
-          }
-            ProjectIRDB IRDB(
-                VariablesMap["module"].as<std::vector<std::string>>(), Opt);
-            STOP_TIMER("IRDB Construction", PAMM_SEVERITY_LEVEL::Full);
-            return IRDB;
-        }(),
-        ChosenDataFlowAnalyses, VariablesMap["wpa"].as<bool>(),
-        VariablesMap["printedgerec"].as<bool>(),
-        VariablesMap["graph-id"].as<std::string>());
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO) << "Write results to file");
-    Controller.writeResults(VariablesMap["output"].as<std::string>());
+    if (VariablesMap.count("profile")) {
+      Profiler::getInstance().setEnabled(true);
+    }
+    auto MakeIRDB = [&lg]() {
+      PAMM_GET_INSTANCE;
+      START_TIMER("IRDB Construction", PAMM_SEVERITY_LEVEL::Full);
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO) << "Set-up IR database.");
+      IRDBOptions Opt = IRDBOptions::NONE;
+      if (VariablesMap["wpa"].as<bool>()) {
+        Opt |= IRDBOptions::WPA;
+      }
+      if (VariablesMap["mem2reg"].as<bool>()) {
+        Opt |= IRDBOptions::MEM2REG;
+      }
+      if (VariablesMap["lazy"].as<bool>()) {
+        Opt |= IRDBOptions::LAZY;
+      }
+      if (!VariablesMap["verify"].as<bool>()) {
+        Opt |= IRDBOptions::NOVERIFY;
+      }
+      if (VariablesMap.count("project")) {
+        std::string ErrorMsg;
+        std::unique_ptr<clang::tooling::CompilationDatabase> CompileDB =
+            clang::tooling::CompilationDatabase::loadFromDirectory(
+                VariablesMap["project"].as<std::string>(), ErrorMsg);
+        if (!CompileDB) {
+          throw std::runtime_error(ErrorMsg);
+        }
+        ProjectIRDB IRDB(*CompileDB, Opt,
+                         VariablesMap["jobs"].as<unsigned>(),
+                         VariablesMap.count("bitcode-cache")
+                             ? VariablesMap["bitcode-cache"].as<std::string>()
+                             : "");
+        STOP_TIMER("IRDB Construction", PAMM_SEVERITY_LEVEL::Full);
+        return IRDB;
+      }
+      ProjectIRDB IRDB(VariablesMap["module"].as<std::vector<std::string>>(),
+                       Opt);
+      STOP_TIMER("IRDB Construction", PAMM_SEVERITY_LEVEL::Full);
+      return IRDB;
+    };
+    if (VariablesMap.count("serve")) {
+      // Keep the project resident and answer queries until shut down.
+      std::vector<std::string> EntryPoints = {"main"};
+      if (VariablesMap.count("entry-points") &&
+          !VariablesMap["entry-points"].as<std::vector<std::string>>().empty()) {
+        EntryPoints = VariablesMap["entry-points"].as<std::vector<std::string>>();
+      }
+      // the taint analyses use the same sources and sinks as in batch mode
+      TaintSensitiveFunctions TSF;
+      if (VariablesMap["swift"].as<bool>()) {
+        TSF.importSourceSinkFunctions(DefaultSourceSinkFunctionsPath);
+      }
+      AnalysisServer Server(
+          MakeIRDB(), EntryPoints,
+          VariablesMap.count("callgraph-analysis")
+              ? StringToCallGraphAnalysisType.at(
+                    VariablesMap["callgraph-analysis"].as<std::string>())
+              : CallGraphAnalysisType::OTF,
+          TSF);
+      Server.serve(VariablesMap["serve"].as<std::string>());
+    } else {
+      // At this point we have set-up all the parameters and can start the
+      // actual analyses that have been choosen.
+      AnalysisController Controller(
+          MakeIRDB(), ChosenDataFlowAnalyses, VariablesMap["wpa"].as<bool>(),
+          VariablesMap["printedgerec"].as<bool>(),
+          VariablesMap["graph-id"].as<std::string>(),
+          VariablesMap["output"].as<std::string>(),
+          StringToExportType.at(VariablesMap["export"].as<std::string>()));
+    }
   } else {
     // -- Clang mode ---
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg, INFO)
@@ -553,10 +664,21 @@ int main(int argc, const char **argv) {
                 << "Shutdown llvm and the analysis framework.");
   // free all resources handled by llvm
   llvm::llvm_shutdown();
-  // flush the log core at last (performs flush() on all registered sinks)
-  bl::core::get()->flush();
+  // write the pending log records at last and stop the logger's thread
+  shutdownLogger();
   STOP_TIMER("Phasar Runtime", PAMM_SEVERITY_LEVEL::Core);
   // PRINT_MEASURED_DATA(std::cout);
   EXPORT_MEASURED_DATA(VariablesMap["pamm-out"].as<std::string>());
+  if (VariablesMap.count("profile")) {
+    auto &P = Profiler::getInstance();
+    const std::string Prefix = VariablesMap["profile"].as<std::string>();
+    std::ofstream Trace(Prefix + ".trace.json");
+    P.exportChromeTrace(Trace);
+    std::ofstream Folded(Prefix + ".folded");
+    P.exportFoldedStacks(Folded);
+    std::ofstream EdgesFolded(Prefix + ".edges.folded");
+    P.exportFoldedStacks(EdgesFolded, true);
+    P.printSummary(std::cout);
+  }
   return 0;
 }
@@ -29,7 +29,8 @@ int main(int argc, char **argv) {
   initializeLogger(false);
   auto &lg = lg::get();
   if (argc < 4 || !bfs::exists(argv[1]) || bfs::is_directory(argv[1])) {
-    std::cerr << "usage: <prog> <ir file> <ID or LCA> <DIRECTION>\n";
+    std::cerr << "usage: <prog> <ir file> <ID or LCA> <DIRECTION> "
+                 "[WPDS, EWPDS, FWPDS or SWPDS]\n";
     return 1;
   }
   string DFA(argv[2]);
@@ -42,6 +43,14 @@ int main(int argc, char **argv) {
     std::cerr << "analysis direction must be FORWARD or BACKWARD\n";
     return 1;
   }
+  WPDSType WPDSTy = WPDSType::FWPDS;
+  if (argc > 4) {
+    if (!StringToWPDSType.count(argv[4])) {
+      std::cerr << "WPDS type is not valid!\n";
+      return 1;
+    }
+    WPDSTy = StringToWPDSType.at(argv[4]);
+  }
   initializeLogger(false);
   ProjectIRDB DB({argv[1]}, IRDBOptions::WPA);
   DB.preprocessIR();
@@ -51,7 +60,7 @@ int main(int argc, char **argv) {
     LLVMBasedICFG I(H, DB, CallGraphAnalysisType::OTF, {"main"});
     auto Ret = &F->back().back();
     if (DFA == "ID") {
-      WPDSSolverTest T(I, H, DB, WPDSType::FWPDS, SearchDirection::FORWARD);
+      WPDSSolverTest T(I, H, DB, WPDSTy, SearchDirection::FORWARD);
       LLVMWPDSSolver<const llvm::Value *, BinaryDomain, LLVMBasedICFG &> S(T);
       S.solve();
       auto Results = S.resultsAt(Ret);
@@ -62,7 +71,7 @@ int main(int argc, char **argv) {
       }
     } else if (DFA == "LCA") {
       std::cout << "LCA" << std::endl;
-      WPDSLinearConstantAnalysis L(I, H, DB, WPDSType::FWPDS, [DIRECTION]() {
+      WPDSLinearConstantAnalysis L(I, H, DB, WPDSTy, [DIRECTION]() {
         if (DIRECTION == "FORWARD") {
           return SearchDirection::FORWARD;
         }
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <phasar/Controller/AnalysisController.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class AnalysisControllerTest : public ::testing::Test {
+protected:
+  const std::vector<DataFlowAnalysisType> Analyses = {
+      DataFlowAnalysisType::IFDS_TaintAnalysis,
+      DataFlowAnalysisType::IFDS_ConstAnalysis,
+      DataFlowAnalysisType::IFDS_TypeAnalysis,
+      DataFlowAnalysisType::IFDS_SolverTest,
+      DataFlowAnalysisType::IDE_TaintAnalysis,
+      DataFlowAnalysisType::IDE_SolverTest,
+      DataFlowAnalysisType::IFDS_LinearConstantAnalysis,
+      DataFlowAnalysisType::IDE_LinearConstantAnalysis};
+
+  std::atomic<unsigned> Running{0};
+  std::atomic<unsigned> MaxRunning{0};
+  std::atomic<unsigned> Finished{0};
+
+  AnalysisControllerTest() = default;
+  virtual ~AnalysisControllerTest() = default;
+
+  // pretends to analyze for a while and records how many analyses overlap
+  void run(DataFlowAnalysisType) {
+    unsigned Now = ++Running;
+    unsigned Max = MaxRunning;
+    while (Now > Max && !MaxRunning.compare_exchange_weak(Max, Now)) {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    --Running;
+    ++Finished;
+  }
+}; // Test Fixture
+
+TEST_F(AnalysisControllerTest, RespectsParallelismLimit) {
+  AnalysisController::scheduleAnalyses(
+      Analyses, 3, 0, [this](DataFlowAnalysisType A) { run(A); });
+  EXPECT_EQ(Analyses.size(), Finished);
+  EXPECT_LE(MaxRunning, 3u);
+  EXPECT_GE(MaxRunning, 2u);
+}
+
+TEST_F(AnalysisControllerTest, RunsSequentially) {
+  AnalysisController::scheduleAnalyses(
+      Analyses, 1, 0, [this](DataFlowAnalysisType A) { run(A); });
+  EXPECT_EQ(Analyses.size(), Finished);
+  EXPECT_EQ(1u, MaxRunning);
+}
+
+TEST_F(AnalysisControllerTest, DelaysAnalysesOverMemoryBudget) {
+  // the budget of 1 MB is always exceeded, so an analysis is only started
+  // once no other analysis is running
+  AnalysisController::scheduleAnalyses(
+      Analyses, 4, 1024, [this](DataFlowAnalysisType A) { run(A); },
+      []() { return 2048l; });
+  EXPECT_EQ(Analyses.size(), Finished);
+  EXPECT_EQ(1u, MaxRunning);
+}
+
+TEST_F(AnalysisControllerTest, RunsInParallelWithinMemoryBudget) {
+  AnalysisController::scheduleAnalyses(
+      Analyses, 4, 1024, [this](DataFlowAnalysisType A) { run(A); },
+      []() { return 512l; });
+  EXPECT_EQ(Analyses.size(), Finished);
+  EXPECT_LE(MaxRunning, 4u);
+  EXPECT_GE(MaxRunning, 2u);
+}
+
+TEST_F(AnalysisControllerTest, RethrowsAfterAllAnalyses) {
+  EXPECT_THROW(AnalysisController::scheduleAnalyses(
+                   Analyses, 2, 0,
+                   [this](DataFlowAnalysisType A) {
+                     run(A);
+                     if (A == DataFlowAnalysisType::IFDS_ConstAnalysis) {
+                       throw std::runtime_error("analysis failed");
+                     }
+                   }),
+               std::runtime_error);
+  EXPECT_EQ(Analyses.size(), Finished);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
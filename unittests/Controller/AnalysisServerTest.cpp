@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <phasar/Controller/AnalysisServer.h>
+#include <phasar/DB/ProjectIRDB.h>
+#include <phasar/PhasarLLVM/Passes/ValueAnnotationPass.h>
+#include <phasar/Utils/Logger.h>
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+
+#include <json.hpp>
+
+using namespace psr;
+using json = nlohmann::json;
+
+/* ============== TEST FIXTURE ============== */
+class AnalysisServerTest : public ::testing::Test {
+protected:
+  const std::string pathToLLFiles =
+      PhasarDirectory + "build/test/llvm_test_code/taint_analysis/";
+
+  AnalysisServerTest() = default;
+  virtual ~AnalysisServerTest() = default;
+
+  void SetUp() override {
+    bl::core::get()->set_logging_enabled(false);
+    ValueAnnotationPass::resetValueID();
+  }
+
+  // int a = source(); sink(a);
+  std::unique_ptr<AnalysisServer>
+  makeServer(TaintSensitiveFunctions TSF = TaintSensitiveFunctions(true)) {
+    return std::make_unique<AnalysisServer>(
+        ProjectIRDB({pathToLLFiles + "dummy_source_sink/taint_01_cpp_dbg.ll"}),
+        std::vector<std::string>{"main"}, CallGraphAnalysisType::OTF, TSF);
+  }
+
+  json request(AnalysisServer &Server, const std::string &Request) {
+    return json::parse(Server.handleRequest(Request));
+  }
+}; // Test Fixture
+
+TEST_F(AnalysisServerTest, LeaksUseConfiguredSourcesAndSinks) {
+  auto Server = makeServer();
+  json Response = request(*Server, "leaks main");
+  ASSERT_EQ("ok", Response["Status"]);
+  ASSERT_EQ(1u, Response["Leaks"].size());
+  EXPECT_EQ("13", Response["Leaks"][0]["Instruction"]);
+  EXPECT_EQ("main", Response["Leaks"][0]["Function"]);
+}
+
+TEST_F(AnalysisServerTest, NoLeaksWithoutSourcesAndSinks) {
+  auto Server = makeServer(TaintSensitiveFunctions());
+  json Response = request(*Server, "leaks main");
+  ASSERT_EQ("ok", Response["Status"]);
+  EXPECT_TRUE(Response["Leaks"].empty());
+}
+
+TEST_F(AnalysisServerTest, AnswersRepeatedQueries) {
+  auto Server = makeServer();
+  json First = request(*Server, "facts ifds-taint 13");
+  ASSERT_EQ("ok", First["Status"]);
+  EXPECT_EQ("13", First["Instruction"]);
+  // solving again yields the same facts
+  ASSERT_EQ("ok", request(*Server, "run ifds-taint")["Status"]);
+  ASSERT_EQ("ok", request(*Server, "run ifds-taint")["Status"]);
+  json Second = request(*Server, "facts ifds-taint 13");
+  ASSERT_EQ("ok", Second["Status"]);
+  EXPECT_EQ(First["Facts"], Second["Facts"]);
+  json Stats = request(*Server, "stats");
+  EXPECT_EQ(2, Stats["Requests"]["facts"]["Count"]);
+  EXPECT_EQ(2, Stats["Requests"]["run"]["Count"]);
+  EXPECT_EQ(json::array({"IFDS_TaintAnalysis"}), Stats["Resident analyses"]);
+}
+
+TEST_F(AnalysisServerTest, ReportsInvalidRequests) {
+  auto Server = makeServer();
+  EXPECT_EQ("error", request(*Server, "facts no-such-analysis 1")["Status"]);
+  EXPECT_EQ("error", request(*Server, "facts ifds-taint")["Status"]);
+  EXPECT_EQ("error", request(*Server, "facts ifds-taint 100000")["Status"]);
+  EXPECT_EQ("error", request(*Server, "leaks no_such_function")["Status"]);
+  EXPECT_EQ("error", request(*Server, "run intra-mono-solvertest")["Status"]);
+  EXPECT_EQ("error", request(*Server, "bogus")["Status"]);
+  EXPECT_EQ("ok", request(*Server, "shutdown")["Status"]);
+}
+
+TEST_F(AnalysisServerTest, RefusesToReplaceRegularFile) {
+  auto Server = makeServer();
+  const std::string Path = "AnalysisServerTest.results.json";
+  {
+    std::ofstream Results(Path);
+    Results << "[]\n";
+  }
+  EXPECT_THROW(Server->serve(Path), std::runtime_error);
+  std::ifstream Results(Path);
+  std::string Content;
+  std::getline(Results, Content);
+  EXPECT_EQ("[]", Content);
+  std::remove(Path.c_str());
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,7 +1,17 @@
-/*
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+
 #include <gtest/gtest.h>
+#include <llvm/IR/Function.h>
+#include <phasar/Config/Configuration.h>
 #include <phasar/DB/DBConn.h>
 #include <phasar/DB/ProjectIRDB.h>
+#include <phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h>
+#include <phasar/PhasarLLVM/Pointer/LLVMTypeHierarchy.h>
+#include <phasar/Utils/LLVMShorthands.h>
 
 using namespace std;
 using namespace psr;
@@ -9,66 +19,104 @@ using namespace psr;
 class DBConnTest : public ::testing::Test {
 protected:
   const string pathToLLFiles = PhasarDirectory + "build/test/llvm_test_code/";
-};
-
-TEST_F(DBConnTest, HandleLTHStoreWithMultipleProjects) {
-  ProjectIRDB firstIRDB(
-      {pathToLLFiles + "module_wise/module_wise_13/src1_cpp.ll",
-       pathToLLFiles + "module_wise/module_wise_13/src2_cpp.ll",
-       pathToLLFiles + "module_wise/module_wise_13/main_cpp.ll"});
-  ProjectIRDB secondIRDB(
-      {pathToLLFiles + "module_wise/module_wise_14/src1_cpp.ll",
-       pathToLLFiles + "module_wise/module_wise_14/src2_cpp.ll",
-       pathToLLFiles + "module_wise/module_wise_14/main_cpp.ll"});
-
-  DBConn &db = DBConn::getInstance();
-  LLVMTypeHierarchy TH1(firstIRDB);
-  LLVMTypeHierarchy TH2(secondIRDB);
-  cout << "\n\n";
-  TH1.print();
-  cout << "\n\n";
-  TH2.print();
-  db.storeProjectIRDB("first_project", firstIRDB);
-  db.storeProjectIRDB("second_project", secondIRDB);
-}
+  const string dbFile = "dbconn_test.sqlite";
 
-// TEST_F(DBConnTest, HandleLTHWriteToHex) {
-//   ProjectIRDB IRDB({pathToLLFiles + "module_wise/module_wise_9/src1_cpp.ll",
-//                     pathToLLFiles + "module_wise/module_wise_9/src2_cpp.ll",
-//                     pathToLLFiles +
-//                     "module_wise/module_wise_9/src3_cpp.ll"});
-//   DBConn &db = DBConn::getInstance();
-//   db.storeProjectIRDB("phasardbtest", IRDB);
-//   LLVMTypeHierarchy TH(IRDB);
-//   cout << "\n\n";
-//   TH.print();
-//   cout << '\n';
-//   db.storeLLVMTypeHierarchy(TH, "phasardbtest", true);
-// }
+  void SetUp() override { remove(dbFile.c_str()); }
+  void TearDown() override { remove(dbFile.c_str()); }
+};
 
-TEST_F(DBConnTest, HandleLTHWriteToDot) {
+TEST_F(DBConnTest, StoreAndLoadProjectIRDB) {
   ProjectIRDB IRDB({pathToLLFiles + "module_wise/module_wise_9/src1_cpp.ll",
                     pathToLLFiles + "module_wise/module_wise_9/src2_cpp.ll",
                     pathToLLFiles + "module_wise/module_wise_9/src3_cpp.ll"});
-  DBConn &db = DBConn::getInstance();
+  DBConn db(dbFile);
   db.storeProjectIRDB("phasardbtest", IRDB);
-  LLVMTypeHierarchy TH(IRDB);
-  cout << '\n';
-  TH.print();
-  cout << '\n';
-  db.storeLLVMTypeHierarchy(TH, "phasardbtest", false);
+  // storing unchanged modules again must not duplicate them
+  db.storeProjectIRDB("phasardbtest", IRDB);
+  ProjectIRDB Loaded = db.loadProjectIRDB("phasardbtest");
+  ASSERT_EQ(Loaded.getNumberOfModules(), IRDB.getNumberOfModules());
+  for (auto F : IRDB.getAllFunctions()) {
+    if (!F->isDeclaration()) {
+      EXPECT_EQ(db.getFunctionHash(F->getName().str()), computeFunctionHash(F));
+    }
+  }
 }
 
-TEST_F(DBConnTest, StoreProjectIRDBTest) {
+TEST_F(DBConnTest, StoreAndLoadTypeHierarchy) {
   ProjectIRDB IRDB({pathToLLFiles + "module_wise/module_wise_9/src1_cpp.ll",
                     pathToLLFiles + "module_wise/module_wise_9/src2_cpp.ll",
                     pathToLLFiles + "module_wise/module_wise_9/src3_cpp.ll"});
-  DBConn &db = DBConn::getInstance();
-  db.storeProjectIRDB("phasardbtest", IRDB);
+  LLVMTypeHierarchy TH(IRDB);
+  DBConn db(dbFile);
+  db.storeLLVMTypeHierarchy(TH, "phasardbtest");
+  EXPECT_EQ(db.loadGraphAsJson("phasardbtest", JsonTypeHierarchyID),
+            TH.getAsJson());
+  auto Loaded = db.loadLLVMTypeHierarchy("phasardbtest", IRDB);
+  EXPECT_EQ(Loaded->getAsJson(), TH.getAsJson());
+  EXPECT_EQ(Loaded->getNumOfEdges(), TH.getNumOfEdges());
+}
+
+TEST_F(DBConnTest, StoreAndLoadICFG) {
+  ProjectIRDB IRDB({pathToLLFiles + "call_graphs/virtual_call_7_cpp.ll"},
+                   IRDBOptions::WPA);
+  IRDB.preprocessIR();
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMBasedICFG ICFG(TH, IRDB, CallGraphAnalysisType::OTF, {"main"});
+  DBConn db(dbFile);
+  db.storeLLVMTypeHierarchy(TH, "phasardbtest");
+  db.storeLLVMBasedICFG(ICFG, "phasardbtest", {"main"});
+  auto LoadedTH = db.loadLLVMTypeHierarchy("phasardbtest", IRDB);
+  EXPECT_TRUE(LoadedTH->hasSubType("struct.A", "struct.B"));
+  EXPECT_EQ(LoadedTH->getType("struct.B"), TH.getType("struct.B"));
+  EXPECT_EQ(LoadedTH->getVTableEntry("struct.B", 0),
+            TH.getVTableEntry("struct.B", 0));
+  auto LoadedICFG = db.loadLLVMBasedICFG("phasardbtest", *LoadedTH, IRDB);
+  EXPECT_EQ(LoadedICFG->getAsJson(), ICFG.getAsJson());
+  EXPECT_EQ(LoadedICFG->getWholeModulePTG().getNumOfVertices(),
+            ICFG.getWholeModulePTG().getNumOfVertices());
+  llvm::Function *F = IRDB.getFunction("main");
+  for (auto I : {getNthInstruction(F, 19), getNthInstruction(F, 25)}) {
+    set<const llvm::Function *> Callees = LoadedICFG->getCalleesOfCallAt(I);
+    EXPECT_EQ(Callees, ICFG.getCalleesOfCallAt(I));
+    EXPECT_EQ(Callees.size(), 2);
+  }
+  EXPECT_THROW(db.loadLLVMBasedICFG("unknown", *LoadedTH, IRDB),
+               runtime_error);
+}
+
+// Compares batched writes against one transaction per row.
+TEST_F(DBConnTest, StoreThroughput) {
+  ProjectIRDB IRDB({pathToLLFiles + "module_wise/module_wise_13/src1_cpp.ll",
+                    pathToLLFiles + "module_wise/module_wise_13/src2_cpp.ll",
+                    pathToLLFiles + "module_wise/module_wise_13/main_cpp.ll"});
+  IRDB.preprocessIR();
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMBasedICFG ICFG(TH, IRDB, CallGraphAnalysisType::CHA, {"main"});
+  auto store = [&](bool Batched) {
+    remove(dbFile.c_str());
+    DBConn db(dbFile);
+    db.setTransactionBatching(Batched);
+    auto Start = chrono::steady_clock::now();
+    db.storeProjectIRDB("throughput", IRDB);
+    db.storeLLVMBasedICFG(ICFG, "throughput");
+    db.storeLLVMTypeHierarchy(TH, "throughput");
+    auto End = chrono::steady_clock::now();
+    cout << (Batched ? "batched: " : "per-row: ")
+         << chrono::duration_cast<chrono::microseconds>(End - Start).count()
+         << " us\n";
+    EXPECT_EQ(db.loadGraphAsJson("throughput", JsonCallGraphID),
+              ICFG.getAsJson());
+    return db.getNumberOfTransactions();
+  };
+  auto PerRow = store(false);
+  auto Batched = store(true);
+  // every store operation is a single transaction, which is synced to disk
+  // once instead of once per row
+  EXPECT_EQ(3u, Batched);
+  EXPECT_GT(PerRow, Batched);
 }
 
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
 }
-*/
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <string>
+
+#include <llvm/IR/CallSite.h>
+#include <llvm/IR/Function.h>
+
+#include <phasar/Config/Configuration.h>
+#include <phasar/DB/GraphSnapshot.h>
+#include <phasar/DB/ProjectIRDB.h>
+#include <phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h>
+#include <phasar/PhasarLLVM/Pointer/LLVMTypeHierarchy.h>
+#include <phasar/Utils/LLVMShorthands.h>
+
+using namespace std;
+using namespace psr;
+
+class GraphSnapshotTest : public ::testing::Test {
+protected:
+  const string pathToLLFiles = PhasarDirectory + "build/test/llvm_test_code/";
+  const string SnapshotFile = "GraphSnapshotTest.snapshot";
+
+  void TearDown() override { remove(SnapshotFile.c_str()); }
+};
+
+TEST_F(GraphSnapshotTest, StoreAndLoad) {
+  ProjectIRDB IRDB({pathToLLFiles + "call_graphs/virtual_call_7_cpp.ll"},
+                   IRDBOptions::WPA);
+  IRDB.preprocessIR();
+  llvm::Module &M = *IRDB.getWPAModule();
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMBasedICFG ICFG(TH, IRDB, CallGraphAnalysisType::OTF, {"main"});
+  GraphSnapshot::store(SnapshotFile, M, TH, ICFG, {"main"});
+
+  auto Snapshot = GraphSnapshot::load(SnapshotFile, M,
+                                      CallGraphAnalysisType::OTF, {"main"});
+  ASSERT_TRUE(Snapshot);
+  auto RestoredTH = Snapshot->getTypeHierarchy();
+  EXPECT_EQ(RestoredTH->getNumOfVertices(), TH.getNumOfVertices());
+  EXPECT_EQ(RestoredTH->getNumOfEdges(), TH.getNumOfEdges());
+  EXPECT_TRUE(RestoredTH->hasSubType("struct.A", "struct.B"));
+  EXPECT_EQ(RestoredTH->getVTableEntry("struct.B", 0),
+            TH.getVTableEntry("struct.B", 0));
+  auto RestoredICFG = Snapshot->getICFG(*RestoredTH, IRDB);
+  EXPECT_EQ(RestoredICFG->getNumOfVertices(), ICFG.getNumOfVertices());
+  EXPECT_EQ(RestoredICFG->getNumOfEdges(), ICFG.getNumOfEdges());
+  EXPECT_EQ(RestoredICFG->getWholeModulePTG().getNumOfVertices(),
+            ICFG.getWholeModulePTG().getNumOfVertices());
+  llvm::Function *F = IRDB.getFunction("main");
+  for (auto I : {getNthInstruction(F, 19), getNthInstruction(F, 25)}) {
+    set<const llvm::Function *> Callees = RestoredICFG->getCalleesOfCallAt(I);
+    EXPECT_EQ(Callees, ICFG.getCalleesOfCallAt(I));
+    EXPECT_EQ(Callees.size(), 2);
+  }
+}
+
+TEST_F(GraphSnapshotTest, FallBackOnMismatch) {
+  ProjectIRDB IRDB({pathToLLFiles + "call_graphs/virtual_call_7_cpp.ll"},
+                   IRDBOptions::WPA);
+  IRDB.preprocessIR();
+  llvm::Module &M = *IRDB.getWPAModule();
+  EXPECT_FALSE(GraphSnapshot::load(SnapshotFile, M,
+                                   CallGraphAnalysisType::OTF, {"main"}));
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMBasedICFG ICFG(TH, IRDB, CallGraphAnalysisType::OTF, {"main"});
+  GraphSnapshot::store(SnapshotFile, M, TH, ICFG, {"main"});
+  // another call-graph analysis
+  EXPECT_FALSE(GraphSnapshot::load(SnapshotFile, M,
+                                   CallGraphAnalysisType::CHA, {"main"}));
+  // another module
+  ProjectIRDB OtherIRDB(
+      {pathToLLFiles + "call_graphs/virtual_call_8_cpp.ll"}, IRDBOptions::WPA);
+  OtherIRDB.preprocessIR();
+  EXPECT_FALSE(GraphSnapshot::load(SnapshotFile, *OtherIRDB.getWPAModule(),
+                                   CallGraphAnalysisType::OTF, {"main"}));
+  // a truncated snapshot
+  {
+    ofstream ofs(SnapshotFile, ios::binary | ios::trunc);
+    ofs.write("PSRG", 4);
+  }
+  EXPECT_FALSE(GraphSnapshot::load(SnapshotFile, M,
+                                   CallGraphAnalysisType::OTF, {"main"}));
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -2,6 +2,7 @@
 #include <phasar/DB/Hexastore.h>
 
 #include <algorithm>
+#include <cstdio>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/graph_utility.hpp>
 #include <boost/graph/isomorphism.hpp>
@@ -264,6 +265,54 @@ TEST(HexastoreTest, StoreGraphWithEdgeLabels) {
   ASSERT_TRUE(boost::isomorphism(I, J));
 }
 
+TEST(HexastoreTest, IDQueries) {
+  Hexastore H("IDQueries.sqlite");
+  hs_id_t Mary = H.getID("mary");
+  hs_id_t Peter = H.getID("peter");
+  hs_id_t Likes = H.getID("likes");
+  hs_id_t Apples = H.getID("apples");
+  hs_id_t Oranges = H.getID("oranges");
+  H.put({{Mary, Likes, Apples}});
+  H.put({{Mary, Likes, Oranges}});
+  H.put({{Peter, Likes, Apples}});
+  H.put({{Peter, Likes, Apples}});
+  ASSERT_EQ(H.size(), 3);
+  ASSERT_EQ(H.getString(Oranges), "oranges");
+  ASSERT_EQ(H.findID("bananas"), hs_wildcard);
+
+  auto Result = H.get(hs_triple{{hs_wildcard, Likes, Apples}});
+  ASSERT_EQ(Result.size(), 2);
+  vector<hs_triple> Triples(Result.begin(), Result.end());
+  ASSERT_EQ(Triples[0], (hs_triple{{Mary, Likes, Apples}}));
+  ASSERT_EQ(Triples[1], (hs_triple{{Peter, Likes, Apples}}));
+
+  Result = H.get(hs_triple{{Mary, hs_wildcard, hs_wildcard}});
+  ASSERT_EQ(Result.size(), 2);
+  Result = H.get(hs_triple{{Peter, hs_wildcard, Oranges}});
+  ASSERT_TRUE(Result.empty());
+}
+
+TEST(HexastoreTest, PersistBatch) {
+  remove("PersistBatch.sqlite");
+  {
+    Hexastore H("PersistBatch.sqlite");
+    for (unsigned I = 0; I < 100000; ++I) {
+      H.put({{"n" + to_string(I), "succ", "n" + to_string(I + 1)}});
+    }
+    H.flush();
+    H.put({{"n0", "pred", "n-1"}});
+  }
+  Hexastore H("PersistBatch.sqlite");
+  ASSERT_EQ(H.size(), 100001);
+  auto Result = H.get({{"n41", "?", "?"}});
+  ASSERT_EQ(Result.size(), 1);
+  ASSERT_EQ(Result[0], hs_result("n41", "succ", "n42"));
+  Result = H.get({{"?", "?", "n-1"}});
+  ASSERT_EQ(Result.size(), 1);
+  ASSERT_EQ(Result[0], hs_result("n0", "pred", "n-1"));
+  ASSERT_EQ(H.get({{"?", "succ", "?"}}).size(), 100000);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
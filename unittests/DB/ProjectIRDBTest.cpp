@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <clang/Tooling/JSONCompilationDatabase.h>
+
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <boost/filesystem.hpp>
+
+#include <phasar/Config/Configuration.h>
+#include <phasar/DB/ProjectIRDB.h>
+#include <phasar/Utils/EnumFlags.h>
+
+using namespace std;
+using namespace psr;
+
+class ProjectIRDBTest : public ::testing::Test {
+protected:
+  const string pathToLLFiles = PhasarDirectory + "build/test/llvm_test_code/";
+  const vector<string> Files = {
+      pathToLLFiles + "module_wise/module_wise_9/main_cpp.ll",
+      pathToLLFiles + "module_wise/module_wise_9/src1_cpp.ll",
+      pathToLLFiles + "module_wise/module_wise_9/src2_cpp.ll",
+      pathToLLFiles + "module_wise/module_wise_9/src3_cpp.ll"};
+
+  set<string> definedFunctions(llvm::Module *M) {
+    set<string> Defined;
+    for (auto &F : *M) {
+      if (!F.isDeclaration()) {
+        Defined.insert(F.getName().str());
+      }
+    }
+    return Defined;
+  }
+};
+
+TEST_F(ProjectIRDBTest, LinkForWPASharedContext) {
+  ProjectIRDB IRDB(Files, IRDBOptions::WPA);
+  // all modules have been parsed into the same context
+  for (auto M : IRDB.getAllModules()) {
+    ASSERT_EQ(&M->getContext(), IRDB.getLLVMContext(Files.front()));
+  }
+  llvm::Module *WPAMod = IRDB.getWPAModule();
+  ASSERT_NE(WPAMod, nullptr);
+  EXPECT_EQ(IRDB.getNumberOfModules(), 1u);
+  auto Defined = definedFunctions(WPAMod);
+  EXPECT_TRUE(Defined.count("main"));
+  EXPECT_TRUE(Defined.count("_Z7give_mev"));
+  // only reachable through the vtable of OtherConcrete created in give_me()
+  EXPECT_TRUE(Defined.count("_ZN13OtherConcrete3fooERi"));
+  for (auto F : IRDB.getAllFunctions()) {
+    EXPECT_EQ(F->getParent(), WPAMod);
+  }
+}
+
+TEST_F(ProjectIRDBTest, LinkForWPAModuleWise) {
+  ProjectIRDB Shared(Files, IRDBOptions::WPA);
+  ProjectIRDB ModuleWise(Files, IRDBOptions::NONE);
+  EXPECT_NE(ModuleWise.getLLVMContext(Files[0]),
+            ModuleWise.getLLVMContext(Files[1]));
+  // both ways of linking have to produce the same program
+  EXPECT_EQ(definedFunctions(Shared.getWPAModule()),
+            definedFunctions(ModuleWise.getWPAModule()));
+  EXPECT_EQ(ModuleWise.getNumberOfModules(), 1u);
+}
+
+TEST_F(ProjectIRDBTest, ThrowOnMalformedModule) {
+  const string Malformed = "malformed_module.ll";
+  {
+    std::ofstream OS(Malformed);
+    OS << "define i32 @main() {\n  ret i32 %undefined\n";
+  }
+  // the valid module is already parsed when the malformed one is rejected
+  const vector<string> IRFiles = {Files.front(), Malformed};
+  EXPECT_THROW(ProjectIRDB(IRFiles, IRDBOptions::WPA), std::runtime_error);
+  EXPECT_THROW(ProjectIRDB(IRFiles, IRDBOptions::NONE), std::runtime_error);
+  remove(Malformed.c_str());
+}
+
+TEST_F(ProjectIRDBTest, LazyBitcodeLoading) {
+  vector<string> BCFiles;
+  {
+    ProjectIRDB IRDB(Files);
+    for (auto &File : Files) {
+      string BCFile = boost::filesystem::path(File).stem().string() + ".bc";
+      error_code EC;
+      llvm::raw_fd_ostream OS(BCFile, EC, llvm::sys::fs::F_None);
+      ASSERT_FALSE(EC);
+      llvm::WriteBitcodeToFile(IRDB.getModule(File), OS);
+      BCFiles.push_back(BCFile);
+    }
+  }
+  ProjectIRDB IRDB(BCFiles, IRDBOptions::WPA | IRDBOptions::LAZY);
+  IRDB.materializeReachable({"main"});
+  // other() is never called, its body must not have been read
+  EXPECT_EQ(IRDB.getFunction("_Z5otherv"), nullptr);
+  auto Defined = definedFunctions(IRDB.getWPAModule());
+  EXPECT_FALSE(Defined.count("_Z5otherv"));
+  EXPECT_TRUE(Defined.count("main"));
+  EXPECT_TRUE(Defined.count("_Z9make_callR8Abstract"));
+  EXPECT_TRUE(Defined.count("_ZN13OtherConcrete3fooERi"));
+  for (auto &BCFile : BCFiles) {
+    remove(BCFile.c_str());
+  }
+}
+
+TEST_F(ProjectIRDBTest, CompileWithBitcodeCache) {
+  const string SrcDir =
+      PhasarDirectory + "test/llvm_test_code/module_wise/module_wise_9/";
+  const vector<string> Sources = {"main.cpp", "src1.cpp", "src2.cpp",
+                                  "src3.cpp"};
+  string JSON = "[";
+  for (auto &Src : Sources) {
+    JSON += string(JSON.size() > 1 ? "," : "") + "{\"directory\": \"" +
+            SrcDir + "\", \"command\": \"clang++ -std=c++14 -c " + Src +
+            "\", \"file\": \"" + Src + "\"}";
+  }
+  JSON += "]";
+  string ErrorMsg;
+  auto CompileDB = clang::tooling::JSONCompilationDatabase::loadFromBuffer(
+      JSON, ErrorMsg, clang::tooling::JSONCommandLineSyntax::AutoDetect);
+  ASSERT_TRUE(CompileDB) << ErrorMsg;
+  const boost::filesystem::path CacheDir =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path();
+  set<string> Defined;
+  {
+    ProjectIRDB IRDB(*CompileDB, IRDBOptions::NONE, 2, CacheDir.string());
+    EXPECT_EQ(IRDB.getNumberOfModules(), Sources.size());
+    EXPECT_EQ(IRDB.getNumberOfCachedModules(), 0u);
+    for (auto M : IRDB.getAllModules()) {
+      auto D = definedFunctions(M);
+      Defined.insert(D.begin(), D.end());
+    }
+  }
+  EXPECT_TRUE(Defined.count("main"));
+  EXPECT_TRUE(Defined.count("_Z7give_mev"));
+  size_t Cached = 0;
+  for (auto &Entry : boost::filesystem::directory_iterator(CacheDir)) {
+    Cached += Entry.path().extension() == ".bc";
+  }
+  EXPECT_EQ(Cached, Sources.size());
+  map<string, time_t> WriteTimes;
+  for (auto &Entry : boost::filesystem::directory_iterator(CacheDir)) {
+    WriteTimes[Entry.path().string()] =
+        boost::filesystem::last_write_time(Entry.path());
+  }
+  // the second construction is served by the cache, nothing is recompiled
+  ProjectIRDB IRDB(*CompileDB, IRDBOptions::WPA, 2, CacheDir.string());
+  EXPECT_EQ(IRDB.getNumberOfModules(), Sources.size());
+  EXPECT_EQ(IRDB.getNumberOfCachedModules(), Sources.size());
+  for (auto &WriteTime : WriteTimes) {
+    EXPECT_EQ(WriteTime.second,
+              boost::filesystem::last_write_time(WriteTime.first));
+  }
+  EXPECT_NE(IRDB.getFunction("main"), nullptr);
+  Defined = definedFunctions(IRDB.getWPAModule());
+  EXPECT_TRUE(Defined.count("main"));
+  EXPECT_TRUE(Defined.count("_Z7give_mev"));
+  boost::filesystem::remove_all(CacheDir);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,222 @@
+#include <gtest/gtest.h>
+#include <phasar/DB/ProjectIRDB.h>
+#include <phasar/PhasarLLVM/ControlFlow/BackwardsBiDiICFG.h>
+#include <phasar/PhasarLLVM/ControlFlow/LLVMBasedBiDiICFG.h>
+#include <phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h>
+#include <phasar/PhasarLLVM/IfdsIde/DefaultIFDSTabulationProblem.h>
+#include <phasar/PhasarLLVM/IfdsIde/FlowFunctions/Identity.h>
+#include <phasar/PhasarLLVM/IfdsIde/FlowFunctions/KillAll.h>
+#include <phasar/PhasarLLVM/IfdsIde/LLVMZeroValue.h>
+#include <phasar/PhasarLLVM/IfdsIde/Solver/BiDiIFDSSolver.h>
+#include <phasar/PhasarLLVM/Pointer/LLVMTypeHierarchy.h>
+#include <phasar/Utils/LLVMShorthands.h>
+#include <phasar/Utils/PAMMMacros.h>
+
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+
+using namespace psr;
+
+using BiDi = BiDiICFG<const llvm::Instruction *, const llvm::Function *>;
+
+/* Propagates the zero value from a seed, optionally killing it when returning
+ * to a given call site. */
+class ReachabilityProblem
+    : public DefaultIFDSTabulationProblem<const llvm::Instruction *,
+                                          const llvm::Value *,
+                                          const llvm::Function *, BiDi &> {
+private:
+  const llvm::Instruction *Seed;
+  const llvm::Instruction *KillAt;
+
+public:
+  ReachabilityProblem(BiDi &ICFG, const llvm::Instruction *Seed,
+                      const llvm::Instruction *KillAt = nullptr)
+      : DefaultIFDSTabulationProblem(ICFG), Seed(Seed), KillAt(KillAt) {
+    solver_config.followReturnsPastSeeds = true;
+    solver_config.autoAddZero = false;
+    zerovalue = createZeroValue();
+  }
+
+  const llvm::Value *createZeroValue() override {
+    return LLVMZeroValue::getInstance();
+  }
+
+  std::shared_ptr<FlowFunction<const llvm::Value *>>
+  getNormalFlowFunction(const llvm::Instruction *curr,
+                        const llvm::Instruction *succ) override {
+    return Identity<const llvm::Value *>::getInstance();
+  }
+
+  std::shared_ptr<FlowFunction<const llvm::Value *>>
+  getCallFlowFunction(const llvm::Instruction *callStmt,
+                      const llvm::Function *destMthd) override {
+    return Identity<const llvm::Value *>::getInstance();
+  }
+
+  std::shared_ptr<FlowFunction<const llvm::Value *>>
+  getRetFlowFunction(const llvm::Instruction *callSite,
+                     const llvm::Function *calleeMthd,
+                     const llvm::Instruction *exitStmt,
+                     const llvm::Instruction *retSite) override {
+    if (callSite && callSite == KillAt) {
+      return KillAll<const llvm::Value *>::getInstance();
+    }
+    return Identity<const llvm::Value *>::getInstance();
+  }
+
+  std::shared_ptr<FlowFunction<const llvm::Value *>>
+  getCallToRetFlowFunction(const llvm::Instruction *callSite,
+                           const llvm::Instruction *retSite,
+                           std::set<const llvm::Function *> callees) override {
+    return Identity<const llvm::Value *>::getInstance();
+  }
+
+  std::map<const llvm::Instruction *, std::set<const llvm::Value *>>
+  initialSeeds() override {
+    return {{Seed, {zeroValue()}}};
+  }
+
+  bool isZeroValue(const llvm::Value *d) const override {
+    return isLLVMZeroValue(d);
+  }
+
+  void printNode(std::ostream &os, const llvm::Instruction *n) const override {
+    os << llvmIRToString(n);
+  }
+
+  void printDataFlowFact(std::ostream &os,
+                         const llvm::Value *d) const override {
+    os << llvmIRToString(d);
+  }
+
+  void printMethod(std::ostream &os, const llvm::Function *m) const override {
+    os << m->getName().str();
+  }
+};
+
+/* ============== TEST FIXTURE ============== */
+class BiDiIFDSSolverTest : public ::testing::Test {
+protected:
+  const std::string pathToLLFiles =
+      PhasarDirectory + "build/test/llvm_test_code/control_flow/";
+  const std::vector<std::string> EntryPoints = {"main", "_Z5otherv"};
+
+  ProjectIRDB *IRDB;
+  LLVMTypeHierarchy *TH;
+  LLVMBasedICFG *ICFG;
+  LLVMBasedBiDiICFG *BiDiICFG;
+
+  BiDiIFDSSolverTest() = default;
+  virtual ~BiDiIFDSSolverTest() = default;
+
+  void Initialize(const std::vector<std::string> &IRFiles) {
+    IRDB = new ProjectIRDB(IRFiles);
+    IRDB->preprocessIR();
+    TH = new LLVMTypeHierarchy(*IRDB);
+    ICFG =
+        new LLVMBasedICFG(*TH, *IRDB, CallGraphAnalysisType::OTF, EntryPoints);
+    BiDiICFG = new LLVMBasedBiDiICFG(*ICFG);
+  }
+
+  void SetUp() override { bl::core::get()->set_logging_enabled(false); }
+
+  void TearDown() override {
+    delete IRDB;
+    delete TH;
+    delete ICFG;
+    delete BiDiICFG;
+  }
+
+  std::vector<const llvm::Instruction *> getCalls(const llvm::Function *F) {
+    std::vector<const llvm::Instruction *> Calls;
+    for (auto &I : llvm::instructions(F)) {
+      if (llvm::isa<llvm::CallInst>(&I)) {
+        Calls.push_back(&I);
+      }
+    }
+    return Calls;
+  }
+}; // Test Fixture
+
+TEST_F(BiDiIFDSSolverTest, HandleIndex) {
+  Initialize({pathToLLFiles + "bidi_calls_cpp.ll"});
+  const llvm::Function *Main = IRDB->getFunction("main");
+  const llvm::Function *Callee = IRDB->getFunction("_Z6calleei");
+  auto Calls = getCalls(Main);
+  ASSERT_EQ(2, Calls.size());
+  for (auto Call : Calls) {
+    EXPECT_EQ(ICFG->getSuccsOf(Call), BiDiICFG->getSuccsOf(Call));
+    EXPECT_EQ(ICFG->getPredsOf(Call), BiDiICFG->getPredsOf(Call));
+    EXPECT_EQ(ICFG->getCalleesOfCallAt(Call),
+              BiDiICFG->getCalleesOfCallAt(Call));
+    EXPECT_TRUE(BiDiICFG->isReturnSite(Call->getNextNode()));
+    EXPECT_EQ(BiDiICFG->getPredsOf(Call), BiDiICFG->getPredsOfCallAt(Call));
+  }
+  EXPECT_EQ(3, BiDiICFG->getCallersOf(Callee).size());
+  BackwardsBiDiICFG<const llvm::Instruction *, const llvm::Function *> Bw(
+      *BiDiICFG);
+  EXPECT_EQ(BiDiICFG->getExitPointsOf(Callee), Bw.getStartPointsOf(Callee));
+  EXPECT_EQ(BiDiICFG->getStartPointsOf(Callee), Bw.getExitPointsOf(Callee));
+  std::set<const llvm::Instruction *> Preds = {Calls[0]->getPrevNode()};
+  EXPECT_EQ(Preds, Bw.getReturnSitesOfCallAt(Calls[0]));
+}
+
+TEST_F(BiDiIFDSSolverTest, HandleLeaks) {
+  Initialize({pathToLLFiles + "bidi_calls_cpp.ll"});
+  const llvm::Function *Main = IRDB->getFunction("main");
+  const llvm::Function *Other = IRDB->getFunction("_Z5otherv");
+  const llvm::Instruction *Seed =
+      getNthStoreInstruction(IRDB->getFunction("_Z6calleei"), 1);
+  auto MainCalls = getCalls(Main);
+  auto OtherCalls = getCalls(Other);
+  ASSERT_EQ(2, MainCalls.size());
+  ASSERT_EQ(1, OtherCalls.size());
+  BackwardsBiDiICFG<const llvm::Instruction *, const llvm::Function *>
+      BackwardICFG(*BiDiICFG);
+  ReachabilityProblem ForwardProblem(*BiDiICFG, Seed);
+  // the backward analysis does not leave the callee towards other()
+  ReachabilityProblem BackwardProblem(BackwardICFG, Seed, OtherCalls[0]);
+  BiDiIFDSSolver<const llvm::Instruction *, const llvm::Value *,
+                 const llvm::Function *, BiDi &>
+      Solver(ForwardProblem, BackwardProblem);
+  Solver.solve();
+  auto Zero = LLVMZeroValue::getInstance();
+  for (auto Call : MainCalls) {
+    EXPECT_EQ(1, Solver.ifdsForwardResultsAt(Call->getNextNode()).count(Zero));
+    EXPECT_EQ(1, Solver.ifdsBackwardResultsAt(Call->getPrevNode()).count(Zero));
+  }
+  // the forward leak into other() is paused until it is dropped
+  EXPECT_EQ(
+      0, Solver.ifdsForwardResultsAt(OtherCalls[0]->getNextNode()).count(Zero));
+  EXPECT_EQ(
+      0, Solver.ifdsBackwardResultsAt(OtherCalls[0]->getPrevNode()).count(Zero));
+}
+
+TEST_F(BiDiIFDSSolverTest, HandleStatisticsScopes) {
+  Initialize({pathToLLFiles + "bidi_calls_cpp.ll"});
+  const llvm::Instruction *Seed =
+      getNthStoreInstruction(IRDB->getFunction("_Z6calleei"), 1);
+  BackwardsBiDiICFG<const llvm::Instruction *, const llvm::Function *>
+      BackwardICFG(*BiDiICFG);
+  ReachabilityProblem ForwardProblem(*BiDiICFG, Seed);
+  ReachabilityProblem BackwardProblem(BackwardICFG, Seed);
+  BiDiIFDSSolver<const llvm::Instruction *, const llvm::Value *,
+                 const llvm::Function *, BiDi &>
+      Solver(ForwardProblem, BackwardProblem);
+  // with PAMM_FULL, the statistics of each direction print the timers of
+  // its phases, which have to be those the direction started
+  Solver.solve();
+#if defined(PAMM_FULL) || defined(PAMM_CORE)
+  PAMM_GET_INSTANCE;
+  // each direction counts its own edges
+  EXPECT_GT(GET_COUNTER("Forward Intra Path Edges"), 0);
+  EXPECT_GT(GET_COUNTER("Backward Intra Path Edges"), 0);
+#endif
+}
+
+// main function for the test case
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <phasar/DB/ProjectIRDB.h>
+#include <phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h>
+#include <phasar/PhasarLLVM/IfdsIde/Problems/IFDSTaintAnalysis.h>
+#include <phasar/PhasarLLVM/IfdsIde/Solver/LLVMIFDSSolver.h>
+#include <phasar/PhasarLLVM/Passes/ValueAnnotationPass.h>
+#include <phasar/PhasarLLVM/Pointer/LLVMTypeHierarchy.h>
+#include <phasar/PhasarLLVM/Utils/TaintSensitiveFunctions.h>
+#include <phasar/Utils/Logger.h>
+
+using namespace psr;
+
+/* Counts the edges regardless of PAMM's severity level and exposes the
+ * online statistics. */
+class CountingSolver
+    : public LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> {
+public:
+  using LLVMIFDSSolver::LLVMIFDSSolver;
+
+  void saveEdges(const llvm::Instruction *sourceNode,
+                 const llvm::Instruction *sinkStmt,
+                 const llvm::Value *sourceVal,
+                 const std::set<const llvm::Value *> &destVals,
+                 bool interP) override {
+    this->countEdges(sourceNode, sinkStmt, sourceVal, destVals, interP);
+    LLVMIFDSSolver::saveEdges(sourceNode, sinkStmt, sourceVal, destVals,
+                              interP);
+  }
+
+  std::size_t genFacts() const { return this->GenFacts; }
+  std::size_t killFacts() const { return this->KillFacts; }
+  std::size_t intraPathEdges() const { return this->IntraPathEdges; }
+  std::size_t interPathEdges() const { return this->InterPathEdges; }
+  std::size_t countedEdges() const { return this->CountedEdges.size(); }
+  std::size_t entries() const { return this->statisticsEntries(); }
+
+  /* Number of recorded edges and of their distinct sources. */
+  std::pair<std::size_t, std::size_t> recordedEdges(bool Inter) {
+    auto &Table =
+        Inter ? this->computedInterPathEdges : this->computedIntraPathEdges;
+    std::size_t Edges = 0, Sources = 0;
+    for (auto &Cell : Table.cellVec()) {
+      for (auto &Source : Cell.v) {
+        Edges += Source.second.size();
+        ++Sources;
+      }
+    }
+    return {Edges, Sources};
+  }
+};
+
+/* ============== TEST FIXTURE ============== */
+class IDESolverStatisticsTest : public ::testing::Test {
+protected:
+  const std::string pathToLLFiles =
+      PhasarDirectory + "build/test/llvm_test_code/taint_analysis/";
+  const std::vector<std::string> EntryPoints = {"main"};
+
+  ProjectIRDB *IRDB = nullptr;
+  LLVMTypeHierarchy *TH = nullptr;
+  LLVMBasedICFG *ICFG = nullptr;
+  TaintSensitiveFunctions TSF = TaintSensitiveFunctions(true);
+
+  IDESolverStatisticsTest() = default;
+  virtual ~IDESolverStatisticsTest() = default;
+
+  void Initialize(const std::vector<std::string> &IRFiles) {
+    IRDB = new ProjectIRDB(IRFiles);
+    IRDB->preprocessIR();
+    TH = new LLVMTypeHierarchy(*IRDB);
+    ICFG =
+        new LLVMBasedICFG(*TH, *IRDB, CallGraphAnalysisType::OTF, EntryPoints);
+  }
+
+  void SetUp() override {
+    bl::core::get()->set_logging_enabled(false);
+    ValueAnnotationPass::resetValueID();
+  }
+
+  void TearDown() override {
+    delete IRDB;
+    delete TH;
+    delete ICFG;
+  }
+}; // Test Fixture
+
+TEST_F(IDESolverStatisticsTest, OnlineCountsMatchRecordedEdges) {
+  // void someFunction(int i, int &j) { j = i; } ... someFunction(argc, x);
+  Initialize({pathToLLFiles + "taint_4_cpp.ll"});
+  IFDSTaintAnalysis Problem(*ICFG, *TH, *IRDB, TSF, EntryPoints);
+  Problem.solver_config.recordEdges = true;
+  CountingSolver Solver(Problem, false, false);
+  Solver.solve();
+  auto Intra = Solver.recordedEdges(false);
+  auto Inter = Solver.recordedEdges(true);
+  ASSERT_GT(Intra.first, 0u);
+  ASSERT_GT(Inter.first, 0u);
+  // every recorded edge is counted exactly once
+  EXPECT_EQ(Intra.first, Solver.intraPathEdges());
+  EXPECT_EQ(Inter.first, Solver.interPathEdges());
+  EXPECT_GE(Solver.genFacts(), Solver.killFacts());
+  EXPECT_GT(Solver.killFacts(), 0u);
+  // the bookkeeping holds one entry per distinct edge source, it does not
+  // keep the target facts of the recorded edges
+  EXPECT_EQ(Intra.second + Inter.second, Solver.countedEdges());
+  EXPECT_LE(Solver.entries(),
+            Solver.countedEdges() + Intra.first + Inter.first);
+}
+
+TEST_F(IDESolverStatisticsTest, CountsDoNotDependOnRecording) {
+  Initialize({pathToLLFiles + "taint_4_cpp.ll"});
+  IFDSTaintAnalysis RecordingProblem(*ICFG, *TH, *IRDB, TSF, EntryPoints);
+  RecordingProblem.solver_config.recordEdges = true;
+  CountingSolver Recording(RecordingProblem, false, false);
+  Recording.solve();
+  IFDSTaintAnalysis Problem(*ICFG, *TH, *IRDB, TSF, EntryPoints);
+  CountingSolver Solver(Problem, false, false);
+  Solver.solve();
+  EXPECT_EQ(Recording.genFacts(), Solver.genFacts());
+  EXPECT_EQ(Recording.killFacts(), Solver.killFacts());
+  EXPECT_EQ(Recording.intraPathEdges(), Solver.intraPathEdges());
+  EXPECT_EQ(Recording.interPathEdges(), Solver.interPathEdges());
+  EXPECT_EQ(Recording.entries(), Solver.entries());
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
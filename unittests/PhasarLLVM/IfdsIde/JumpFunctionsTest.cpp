@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include <phasar/DB/ProjectIRDB.h>
+#include <phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h>
+#include <phasar/PhasarLLVM/IfdsIde/EdgeFunctions/AllBottom.h>
+#include <phasar/PhasarLLVM/IfdsIde/EdgeFunctions/EdgeIdentity.h>
+#include <phasar/PhasarLLVM/IfdsIde/Problems/IDELinearConstantAnalysis.h>
+#include <phasar/PhasarLLVM/IfdsIde/Solver/JumpFunctions.h>
+#include <phasar/PhasarLLVM/Pointer/LLVMTypeHierarchy.h>
+#include <phasar/Utils/Table.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#include <llvm/IR/InstIterator.h>
+
+using namespace psr;
+
+using JF = JumpFunctions<const llvm::Instruction *, const llvm::Value *,
+                         const llvm::Function *, int64_t, LLVMBasedICFG &>;
+
+/* Counts the bytes that are live on the heap, the size of each allocation is
+ * stored in front of the returned memory. The counter is atomic since gtest and
+ * the libraries may allocate from other threads. */
+static std::atomic<std::size_t> LiveBytes(0);
+
+void *operator new(std::size_t Size) {
+  void *Block = std::malloc(Size + alignof(std::max_align_t));
+  if (!Block)
+    throw std::bad_alloc();
+  *static_cast<std::size_t *>(Block) = Size;
+  LiveBytes.fetch_add(Size, std::memory_order_relaxed);
+  return static_cast<char *>(Block) + alignof(std::max_align_t);
+}
+
+void operator delete(void *Ptr) noexcept {
+  if (!Ptr)
+    return;
+  void *Block = static_cast<char *>(Ptr) - alignof(std::max_align_t);
+  LiveBytes.fetch_sub(*static_cast<std::size_t *>(Block),
+                      std::memory_order_relaxed);
+  std::free(Block);
+}
+
+/* The layout JumpFunctions used to have, every jump function is kept in a
+ * reverse, a forward and a by-target index. */
+class ThreeIndexJumpFunctions {
+public:
+  using EF = std::shared_ptr<EdgeFunction<int64_t>>;
+  Table<const llvm::Instruction *, const llvm::Value *,
+        std::map<const llvm::Value *, EF>>
+      nonEmptyReverseLookup;
+  Table<const llvm::Value *, const llvm::Instruction *,
+        std::map<const llvm::Value *, EF>>
+      nonEmptyForwardLookup;
+  std::unordered_map<const llvm::Instruction *,
+                     Table<const llvm::Value *, const llvm::Value *, EF>>
+      nonEmptyLookupByTargetNode;
+
+  void addFunction(const llvm::Value *sourceVal,
+                   const llvm::Instruction *target,
+                   const llvm::Value *targetVal, EF function) {
+    nonEmptyReverseLookup.get(target, targetVal).insert({sourceVal, function});
+    nonEmptyForwardLookup.get(sourceVal, target).insert({targetVal, function});
+    nonEmptyLookupByTargetNode[target].insert(sourceVal, targetVal, function);
+  }
+
+  std::map<const llvm::Value *, EF>
+  reverseLookup(const llvm::Instruction *target, const llvm::Value *targetVal) {
+    if (!nonEmptyReverseLookup.contains(target, targetVal))
+      return {};
+    return nonEmptyReverseLookup.get(target, targetVal);
+  }
+};
+
+/* ============== TEST FIXTURE ============== */
+class JumpFunctionsTest : public ::testing::Test {
+protected:
+  const std::string pathToLLFiles =
+      PhasarDirectory + "build/test/llvm_test_code/linear_constant/";
+  const std::vector<std::string> EntryPoints = {"main"};
+
+  ProjectIRDB *IRDB;
+  LLVMTypeHierarchy *TH;
+  LLVMBasedICFG *ICFG;
+  IDELinearConstantAnalysis *LCAProblem;
+  std::vector<const llvm::Instruction *> Insts;
+
+  JumpFunctionsTest() = default;
+  virtual ~JumpFunctionsTest() = default;
+
+  void SetUp() override {
+    bl::core::get()->set_logging_enabled(false);
+    IRDB = new ProjectIRDB({pathToLLFiles + "basic_01_cpp_dbg.ll"});
+    IRDB->preprocessIR();
+    TH = new LLVMTypeHierarchy(*IRDB);
+    ICFG =
+        new LLVMBasedICFG(*TH, *IRDB, CallGraphAnalysisType::OTF, EntryPoints);
+    LCAProblem = new IDELinearConstantAnalysis(*ICFG, *TH, *IRDB, EntryPoints);
+    for (auto &I : llvm::instructions(IRDB->getFunction("main"))) {
+      Insts.push_back(&I);
+    }
+  }
+
+  void TearDown() override {
+    delete IRDB;
+    delete TH;
+    delete ICFG;
+    delete LCAProblem;
+  }
+}; // Test Fixture
+
+TEST_F(JumpFunctionsTest, HandleLookups) {
+  ASSERT_GE(Insts.size(), 3);
+  JF J(LCAProblem->allTopFunction(), *LCAProblem);
+  std::shared_ptr<EdgeFunction<int64_t>> Id =
+      EdgeIdentity<int64_t>::getInstance();
+  const llvm::Value *Zero = LCAProblem->zeroValue();
+  J.addFunction(Zero, Insts[1], Zero, Id);
+  J.addFunction(Zero, Insts[1], Insts[0], Id);
+  J.addFunction(Insts[0], Insts[1], Insts[0], Id);
+  // the all-top function is not stored
+  J.addFunction(Zero, Insts[2], Zero, LCAProblem->allTopFunction());
+  EXPECT_EQ(3, J.size());
+  EXPECT_EQ(2, J.forwardLookup(Zero, Insts[1]).size());
+  EXPECT_EQ(2, J.reverseLookup(Insts[1], Insts[0]).size());
+  EXPECT_EQ(2, J.lookupByTarget(Insts[1]).size());
+  EXPECT_TRUE(J.lookupByTarget(Insts[2]).empty());
+  EXPECT_EQ(Id, J.getFunction(Zero, Insts[1], Insts[0]));
+  EXPECT_EQ(nullptr, J.getFunction(Insts[0], Insts[1], Zero));
+  // replacing a function updates the reverse index that has been built
+  std::shared_ptr<EdgeFunction<int64_t>> Bottom =
+      std::make_shared<AllBottom<int64_t>>(LCAProblem->bottomElement());
+  J.addFunction(Zero, Insts[1], Insts[0], Bottom);
+  EXPECT_EQ(3, J.size());
+  EXPECT_EQ(Bottom, J.reverseLookup(Insts[1], Insts[0]).at(Zero));
+  EXPECT_EQ(Bottom, J.forwardLookup(Zero, Insts[1]).at(Insts[0]));
+  EXPECT_TRUE(J.removeFunction(Zero, Insts[1], Insts[0]));
+  EXPECT_FALSE(J.removeFunction(Zero, Insts[1], Insts[0]));
+  EXPECT_EQ(2, J.size());
+  EXPECT_EQ(1, J.reverseLookup(Insts[1], Insts[0]).size());
+  J.compactFunctionsAt(Insts[1]);
+  EXPECT_EQ(1, J.reverseLookup(Insts[1], Insts[0]).size());
+  J.removeFunctionsFrom(Insts[0], Insts[1]);
+  EXPECT_EQ(1, J.size());
+  EXPECT_TRUE(J.reverseLookup(Insts[1], Insts[0]).empty());
+  J.removeFunctionsAt(Insts[1]);
+  EXPECT_EQ(0, J.size());
+  EXPECT_TRUE(J.forwardLookup(Zero, Insts[1]).empty());
+}
+
+/* Measures the heap use per jump function of the single index layout and of
+ * the three index layout JumpFunctions used to have. The jump functions are
+ * spread over 2000 target nodes with 16 source and 8 target values each, the
+ * reverse lookup is queried at every tenth target node. The nodes and values
+ * are never dereferenced, hence they are made up. */
+TEST_F(JumpFunctionsTest, MemoryPerFunction) {
+  const std::size_t Targets = 2000, SourceVals = 16, TargetVals = 8;
+  const std::size_t Functions = Targets * SourceVals * TargetVals;
+  auto Node = [](std::uintptr_t N) {
+    return reinterpret_cast<const llvm::Instruction *>((N + 1) << 4);
+  };
+  auto Fact = [](std::uintptr_t D) {
+    return reinterpret_cast<const llvm::Value *>((D + 1) << 4);
+  };
+  std::shared_ptr<EdgeFunction<int64_t>> Id =
+      EdgeIdentity<int64_t>::getInstance();
+  auto measure = [&](auto &J) {
+    std::size_t Before = LiveBytes.load();
+    for (std::size_t N = 0; N < Targets; ++N) {
+      for (std::size_t S = 0; S < SourceVals; ++S) {
+        for (std::size_t T = 0; T < TargetVals; ++T) {
+          J.addFunction(Fact(S), Node(N), Fact(SourceVals + T), Id);
+        }
+      }
+    }
+    for (std::size_t N = 0; N < Targets; N += 10) {
+      EXPECT_EQ(SourceVals, J.reverseLookup(Node(N), Fact(SourceVals)).size());
+    }
+    return static_cast<double>(LiveBytes.load() - Before) / Functions;
+  };
+  JF Single(LCAProblem->allTopFunction(), *LCAProblem);
+  double SingleIndex = measure(Single);
+  EXPECT_EQ(Functions, Single.size());
+  ThreeIndexJumpFunctions Three;
+  double ThreeIndex = measure(Three);
+  std::cout << "bytes per jump function over " << Functions
+            << " functions: three indexes " << ThreeIndex
+            << ", single index " << SingleIndex << '\n';
+  EXPECT_LT(SingleIndex, ThreeIndex / 2);
+}
+
+// main function for the test case
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
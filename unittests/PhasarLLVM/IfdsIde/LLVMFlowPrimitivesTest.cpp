@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include <phasar/DB/ProjectIRDB.h>
+#include <phasar/PhasarLLVM/IfdsIde/LLVMFlowFunctions/LLVMFlowPrimitives.h>
+#include <phasar/PhasarLLVM/IfdsIde/LLVMFlowFunctions/MapFactsToCallee.h>
+#include <phasar/PhasarLLVM/IfdsIde/LLVMFlowFunctions/MapFactsToCaller.h>
+#include <phasar/PhasarLLVM/IfdsIde/LLVMZeroValue.h>
+#include <phasar/Utils/Logger.h>
+
+#include <llvm/IR/InstIterator.h>
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class LLVMFlowPrimitivesTest : public ::testing::Test {
+protected:
+  const std::string pathToLLFiles =
+      PhasarDirectory + "build/test/llvm_test_code/linear_constant/";
+
+  ProjectIRDB *IRDB = nullptr;
+  const llvm::CallInst *CallSite = nullptr;
+  const llvm::Function *Callee = nullptr;
+  const llvm::ReturnInst *Exit = nullptr;
+
+  LLVMFlowPrimitivesTest() = default;
+  virtual ~LLVMFlowPrimitivesTest() = default;
+
+  void Initialize(const std::string &IRFile) {
+    IRDB = new ProjectIRDB({IRFile});
+    for (auto &I : llvm::instructions(IRDB->getFunction("main"))) {
+      if (auto Call = llvm::dyn_cast<llvm::CallInst>(&I)) {
+        if (Call->getCalledFunction() &&
+            !Call->getCalledFunction()->isDeclaration()) {
+          CallSite = Call;
+          Callee = Call->getCalledFunction();
+        }
+      }
+    }
+    ASSERT_TRUE(CallSite);
+    for (auto &I : llvm::instructions(Callee)) {
+      if (auto Ret = llvm::dyn_cast<llvm::ReturnInst>(&I)) {
+        Exit = Ret;
+      }
+    }
+    ASSERT_TRUE(Exit);
+  }
+
+  void SetUp() override { bl::core::get()->set_logging_enabled(false); }
+
+  void TearDown() override { delete IRDB; }
+}; // Test Fixture
+
+TEST_F(LLVMFlowPrimitivesTest, MapParameters) {
+  // int foo(int a) { return a + 40; } ... i = foo(2);
+  Initialize(pathToLLFiles + "call_02_cpp_dbg.ll");
+  CallSiteParameterMapping Mapping(llvm::ImmutableCallSite(CallSite), Callee);
+  const llvm::Value *Actual = CallSite->getArgOperand(0);
+  const llvm::Value *Formal = &*Callee->arg_begin();
+  llvm::SmallVector<const llvm::Value *, 4> Targets;
+  Mapping.mapToCallee(Actual, Targets);
+  ASSERT_EQ(1, Targets.size());
+  EXPECT_EQ(Formal, Targets[0]);
+  Targets.clear();
+  Mapping.mapToCaller(Formal, Exit, Targets);
+  ASSERT_EQ(1, Targets.size());
+  EXPECT_EQ(Actual, Targets[0]);
+  Targets.clear();
+  Mapping.mapToCaller(Exit->getReturnValue(), Exit, Targets);
+  ASSERT_EQ(1, Targets.size());
+  EXPECT_EQ(CallSite, Targets[0]);
+  Targets.clear();
+  Mapping.mapToCallee(Actual, Targets,
+                      [](const llvm::Value *) { return false; });
+  EXPECT_TRUE(Targets.empty());
+  Mapping.mapToCallee(LLVMZeroValue::getInstance(), Targets);
+  ASSERT_EQ(1, Targets.size());
+  EXPECT_TRUE(isLLVMZeroValue(Targets[0]));
+}
+
+TEST_F(LLVMFlowPrimitivesTest, AdaptersMatchPrimitives) {
+  Initialize(pathToLLFiles + "call_02_cpp_dbg.ll");
+  CallSiteParameterMapping Mapping(llvm::ImmutableCallSite(CallSite), Callee);
+  MapFactsToCallee ToCallee(llvm::ImmutableCallSite(CallSite), Callee);
+  MapFactsToCaller ToCaller(llvm::ImmutableCallSite(CallSite), Callee, Exit);
+  std::vector<const llvm::Value *> Sources = {
+      CallSite->getArgOperand(0), &*Callee->arg_begin(),
+      Exit->getReturnValue(), LLVMZeroValue::getInstance()};
+  for (auto Source : Sources) {
+    llvm::SmallVector<const llvm::Value *, 4> Targets;
+    Mapping.mapToCallee(Source, Targets);
+    EXPECT_EQ(ToCallee.computeTargets(Source),
+              std::set<const llvm::Value *>(Targets.begin(), Targets.end()));
+    Targets.clear();
+    Mapping.mapToCaller(Source, Exit, Targets);
+    EXPECT_EQ(ToCaller.computeTargets(Source),
+              std::set<const llvm::Value *>(Targets.begin(), Targets.end()));
+  }
+}
+
+TEST_F(LLVMFlowPrimitivesTest, ComposeLoadAndStore) {
+  Initialize(pathToLLFiles + "call_02_cpp_dbg.ll");
+  const llvm::StoreInst *Store = nullptr;
+  const llvm::LoadInst *Load = nullptr;
+  // a is stored into its stack slot and loaded again for the addition
+  for (auto &I : llvm::instructions(Callee)) {
+    if (auto S = llvm::dyn_cast<llvm::StoreInst>(&I)) {
+      Store = S;
+    } else if (auto L = llvm::dyn_cast<llvm::LoadInst>(&I)) {
+      Load = L;
+    }
+  }
+  ASSERT_TRUE(Store && Load);
+  ASSERT_EQ(Store->getPointerOperand(), Load->getPointerOperand());
+  auto StoreThenLoad = composePrimitives<const llvm::Value *>(
+      StorePrimitive<const llvm::Value *>(Store),
+      LoadPrimitive<const llvm::Value *>(Load));
+  const llvm::Value *Formal = &*Callee->arg_begin();
+  std::vector<const llvm::Value *> Sources = {Formal, Load};
+  llvm::SmallVector<const llvm::Value *, 8> Targets;
+  computeTargetsOf(StoreThenLoad, Sources, Targets);
+  std::set<const llvm::Value *> Expected = {Formal, Store->getPointerOperand(),
+                                            Load};
+  EXPECT_EQ(Expected,
+            std::set<const llvm::Value *>(Targets.begin(), Targets.end()));
+}
+
+TEST_F(LLVMFlowPrimitivesTest, MapVariadicParameters) {
+  // int sum(int n, ...) { va_list args; ... } ... i = sum(3, 2, 2, 2);
+  Initialize(pathToLLFiles + "call_09_cpp_dbg.ll");
+  ASSERT_TRUE(Callee->isVarArg());
+  ASSERT_EQ(4, CallSite->getNumArgOperands());
+  const llvm::AllocaInst *VaList = nullptr;
+  for (auto &I : llvm::instructions(Callee)) {
+    if (auto Alloc = llvm::dyn_cast<llvm::AllocaInst>(&I)) {
+      if (Alloc->getAllocatedType()->isArrayTy()) {
+        VaList = Alloc;
+      }
+    }
+  }
+  ASSERT_TRUE(VaList);
+  CallSiteParameterMapping Mapping(llvm::ImmutableCallSite(CallSite), Callee);
+  const llvm::Value *Count = CallSite->getArgOperand(0);
+  const llvm::Value *VarArg = CallSite->getArgOperand(1);
+  const llvm::Value *Formal = &*Callee->arg_begin();
+  llvm::SmallVector<const llvm::Value *, 4> Targets;
+  Mapping.mapToCallee(Count, Targets);
+  ASSERT_EQ(1, Targets.size());
+  EXPECT_EQ(Formal, Targets[0]);
+  Targets.clear();
+  // the constant is passed three times, but the va_list is generated once
+  Mapping.mapToCallee(VarArg, Targets);
+  ASSERT_EQ(1, Targets.size());
+  EXPECT_EQ(VaList, Targets[0]);
+  Targets.clear();
+  Mapping.mapToCaller(VaList, Exit, Targets);
+  EXPECT_EQ(3, Targets.size());
+  EXPECT_EQ(3, llvm::count(Targets, VarArg));
+  Targets.clear();
+  Mapping.mapToCaller(Formal, Exit, Targets);
+  ASSERT_EQ(1, Targets.size());
+  EXPECT_EQ(Count, Targets[0]);
+  Targets.clear();
+  Mapping.mapToCaller(Exit->getReturnValue(), Exit, Targets);
+  ASSERT_EQ(1, Targets.size());
+  EXPECT_EQ(CallSite, Targets[0]);
+  // the adapters agree with the primitives on the variadic part
+  MapFactsToCallee ToCallee(llvm::ImmutableCallSite(CallSite), Callee);
+  MapFactsToCaller ToCaller(llvm::ImmutableCallSite(CallSite), Callee, Exit);
+  EXPECT_EQ(std::set<const llvm::Value *>{VaList},
+            ToCallee.computeTargets(VarArg));
+  EXPECT_EQ(std::set<const llvm::Value *>{VarArg},
+            ToCaller.computeTargets(VaList));
+  EXPECT_EQ(std::set<const llvm::Value *>{Count},
+            ToCaller.computeTargets(Formal));
+  // an exit statement that is no return instruction does not map the return
+  // value, but still maps the va_list
+  MapFactsToCaller NoReturn(llvm::ImmutableCallSite(CallSite), Callee,
+                            &*llvm::inst_begin(Callee));
+  EXPECT_TRUE(NoReturn.computeTargets(Exit->getReturnValue()).empty());
+  EXPECT_EQ(std::set<const llvm::Value *>{VarArg},
+            NoReturn.computeTargets(VaList));
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <phasar/DB/ProjectIRDB.h>
+#include <phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h>
+#include <phasar/PhasarLLVM/IfdsIde/DefaultIFDSTabulationProblem.h>
+#include <phasar/PhasarLLVM/IfdsIde/FlowFunctions/Identity.h>
+#include <phasar/PhasarLLVM/IfdsIde/FlowFunctions/LambdaFlow.h>
+#include <phasar/PhasarLLVM/IfdsIde/IFDSSummaryPool.h>
+#include <phasar/PhasarLLVM/IfdsIde/LLVMFlowFunctions/MapFactsToCallee.h>
+#include <phasar/PhasarLLVM/IfdsIde/LLVMFlowFunctions/MapFactsToCaller.h>
+#include <phasar/PhasarLLVM/IfdsIde/LLVMIFDSSummaryGenerator.h>
+#include <phasar/PhasarLLVM/IfdsIde/LLVMZeroValue.h>
+#include <phasar/PhasarLLVM/Pointer/LLVMTypeHierarchy.h>
+#include <phasar/Utils/LLVMShorthands.h>
+#include <phasar/Utils/Logger.h>
+
+#include <llvm/IR/CallSite.h>
+#include <llvm/IR/Instructions.h>
+
+using namespace psr;
+
+/* Propagates the def-use chains of the facts, a fact generates every
+ * instruction that uses it and the memory it is stored to. */
+class DefUseProblem
+    : public DefaultIFDSTabulationProblem<const llvm::Instruction *,
+                                          const llvm::Value *,
+                                          const llvm::Function *,
+                                          LLVMBasedICFG &> {
+public:
+  DefUseProblem(LLVMBasedICFG &ICFG) : DefaultIFDSTabulationProblem(ICFG) {
+    zerovalue = createZeroValue();
+  }
+
+  const llvm::Value *createZeroValue() override {
+    return LLVMZeroValue::getInstance();
+  }
+
+  std::shared_ptr<FlowFunction<const llvm::Value *>>
+  getNormalFlowFunction(const llvm::Instruction *curr,
+                        const llvm::Instruction *succ) override {
+    return std::make_shared<LambdaFlow<const llvm::Value *>>(
+        [curr](const llvm::Value *source) {
+          std::set<const llvm::Value *> targets = {source};
+          if (auto Store = llvm::dyn_cast<llvm::StoreInst>(curr)) {
+            if (Store->getValueOperand() == source) {
+              targets.insert(Store->getPointerOperand());
+            }
+          } else if (llvm::is_contained(curr->operands(), source)) {
+            targets.insert(curr);
+          }
+          return targets;
+        });
+  }
+
+  std::shared_ptr<FlowFunction<const llvm::Value *>>
+  getCallFlowFunction(const llvm::Instruction *callStmt,
+                      const llvm::Function *destMthd) override {
+    return std::make_shared<MapFactsToCallee>(
+        llvm::ImmutableCallSite(callStmt), destMthd);
+  }
+
+  std::shared_ptr<FlowFunction<const llvm::Value *>>
+  getRetFlowFunction(const llvm::Instruction *callSite,
+                     const llvm::Function *calleeMthd,
+                     const llvm::Instruction *exitStmt,
+                     const llvm::Instruction *retSite) override {
+    return std::make_shared<MapFactsToCaller>(
+        llvm::ImmutableCallSite(callSite), calleeMthd, exitStmt);
+  }
+
+  std::shared_ptr<FlowFunction<const llvm::Value *>>
+  getCallToRetFlowFunction(const llvm::Instruction *callSite,
+                           const llvm::Instruction *retSite,
+                           std::set<const llvm::Function *> callees) override {
+    return Identity<const llvm::Value *>::getInstance();
+  }
+
+  std::map<const llvm::Instruction *, std::set<const llvm::Value *>>
+  initialSeeds() override {
+    return {};
+  }
+
+  bool isZeroValue(const llvm::Value *d) const override {
+    return isLLVMZeroValue(d);
+  }
+
+  void printNode(std::ostream &os, const llvm::Instruction *n) const override {
+    os << llvmIRToString(n);
+  }
+
+  void printDataFlowFact(std::ostream &os,
+                         const llvm::Value *d) const override {
+    os << llvmIRToString(d);
+  }
+
+  void printMethod(std::ostream &os, const llvm::Function *m) const override {
+    os << m->getName().str();
+  }
+};
+
+using Generator = LLVMIFDSSummaryGenerator<LLVMBasedICFG &, DefUseProblem>;
+using Pool = IFDSSummaryPool<const llvm::Value *, const llvm::Instruction *>;
+
+/* Makes the direct solve of a context accessible. */
+class DirectSummaryGenerator : public Generator {
+public:
+  using Generator::Generator;
+
+  std::set<const llvm::Value *> solveContext(std::set<const llvm::Value *> C) {
+    return this->solveFor(C);
+  }
+};
+
+/* ============== TEST FIXTURE ============== */
+class LLVMIFDSSummaryGeneratorTest : public ::testing::Test {
+protected:
+  const std::string pathToLLFiles =
+      PhasarDirectory + "build/test/llvm_test_code/summary_generation/";
+
+  ProjectIRDB *IRDB = nullptr;
+  LLVMTypeHierarchy *TH = nullptr;
+  LLVMBasedICFG *ICFG = nullptr;
+
+  LLVMIFDSSummaryGeneratorTest() = default;
+  virtual ~LLVMIFDSSummaryGeneratorTest() = default;
+
+  void Initialize(const std::vector<std::string> &IRFiles,
+                  const std::vector<std::string> &EntryPoints) {
+    IRDB = new ProjectIRDB(IRFiles);
+    IRDB->preprocessIR();
+    TH = new LLVMTypeHierarchy(*IRDB);
+    ICFG =
+        new LLVMBasedICFG(*TH, *IRDB, CallGraphAnalysisType::OTF, EntryPoints);
+  }
+
+  void SetUp() override { bl::core::get()->set_logging_enabled(false); }
+
+  void TearDown() override {
+    delete IRDB;
+    delete TH;
+    delete ICFG;
+  }
+
+  std::vector<const llvm::Function *> getDefinedFunctions() {
+    std::vector<const llvm::Function *> Functions;
+    for (auto F : IRDB->getAllFunctions()) {
+      if (!F->isDeclaration()) {
+        Functions.push_back(F);
+      }
+    }
+    return Functions;
+  }
+}; // Test Fixture
+
+TEST_F(LLVMIFDSSummaryGeneratorTest, ComposedSummaryMatchesDirectSolve) {
+  // int function(int i, int j) { int k = i + j; return k; }
+  Initialize({pathToLLFiles + "summary_2_cpp.ll"}, {"_Z8functionii"});
+  const llvm::Function *F = IRDB->getFunction("_Z8functionii");
+  ASSERT_TRUE(F);
+  Pool SummaryPool;
+  Generator::generateSummaries({F}, *ICFG, SummaryGenerationStrategy::powerset,
+                               SummaryPool, 1);
+  const llvm::Instruction *Start = *ICFG->getStartPointsOf(F).begin();
+  ASSERT_TRUE(SummaryPool.containsSummary(Start));
+  const llvm::Value *I = &*F->arg_begin();
+  const llvm::Value *J = &*std::next(F->arg_begin());
+  DirectSummaryGenerator Direct(F, *ICFG, SummaryGenerationStrategy::powerset);
+  std::set<const llvm::Value *> Both = Direct.solveContext({I, J});
+  // the returned value depends on both inputs, so every single input
+  // contributes facts that the other one does not generate
+  std::set<const llvm::Value *> OnlyI = Direct.solveContext({I});
+  std::set<const llvm::Value *> OnlyJ = Direct.solveContext({J});
+  EXPECT_NE(OnlyI, OnlyJ);
+  EXPECT_LT(OnlyI.size(), Both.size());
+  EXPECT_EQ(Both, SummaryPool.getSummary(Start, {true, true}));
+  EXPECT_EQ(OnlyI, SummaryPool.getSummary(Start, {true, false}));
+  EXPECT_EQ(OnlyJ, SummaryPool.getSummary(Start, {false, true}));
+  EXPECT_EQ(Direct.solveContext({}),
+            SummaryPool.getSummary(Start, {false, false}));
+}
+
+TEST_F(LLVMIFDSSummaryGeneratorTest, ParallelGenerationMatchesSingleThread) {
+  Initialize({pathToLLFiles + "summary_class_3_cpp.ll"},
+             {"_Z11pseudo_userv"});
+  auto Functions = getDefinedFunctions();
+  ASSERT_GT(Functions.size(), 4u);
+  Pool Sequential, Parallel;
+  Generator::generateSummaries(Functions, *ICFG,
+                               SummaryGenerationStrategy::powerset, Sequential,
+                               1);
+  Generator::generateSummaries(Functions, *ICFG,
+                               SummaryGenerationStrategy::powerset, Parallel,
+                               4);
+  for (auto F : Functions) {
+    const llvm::Instruction *Start = *ICFG->getStartPointsOf(F).begin();
+    ASSERT_TRUE(Parallel.containsSummary(Start));
+    // the context of all arguments, and of none
+    std::vector<bool> All(F->arg_size(), true), None(F->arg_size(), false);
+    EXPECT_EQ(Sequential.getSummary(Start, All),
+              Parallel.getSummary(Start, All));
+    EXPECT_EQ(Sequential.getSummary(Start, None),
+              Parallel.getSummary(Start, None));
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,3 +1,6 @@
+#include <sstream>
+#include <thread>
+
 #include <gtest/gtest.h>
 #include <phasar/DB/ProjectIRDB.h>
 #include <phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h>
@@ -5,9 +8,24 @@
 #include <phasar/PhasarLLVM/IfdsIde/Solver/LLVMIDESolver.h>
 #include <phasar/PhasarLLVM/Passes/ValueAnnotationPass.h>
 #include <phasar/PhasarLLVM/Pointer/LLVMTypeHierarchy.h>
+#include <phasar/Utils/ResultWriter.h>
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
 
 using namespace psr;
 
+/* Exposes the number of calling contexts released by the solver. */
+class ReleasingLCASolver
+    : public LLVMIDESolver<const llvm::Value *, int64_t, LLVMBasedICFG &> {
+public:
+  using LLVMIDESolver::LLVMIDESolver;
+
+  std::size_t releasedContexts() const { return this->ReleasedContexts; }
+  std::size_t jumpFunctions() const { return this->jumpFn->size(); }
+};
+
 /* ============== TEST FIXTURE ============== */
 class IDELinearConstantAnalysisTest : public ::testing::Test {
 protected:
@@ -260,6 +278,163 @@ TEST_F(IDELinearConstantAnalysisTest, HandleCallTest_05) {
   compareResults(gt, llvmlcasolver);
 }
 
+/* ============== INCREMENTAL TESTS ============== */
+TEST_F(IDELinearConstantAnalysisTest, HandleIncrementalUpdate_01) {
+  // void foo(int a) { int b = a; } ... foo(42);
+  Initialize({pathToLLFiles + "call_01_cpp_dbg.ll"});
+  LCAProblem->solver_config.incremental = true;
+  LLVMIDESolver<const llvm::Value *, int64_t, LLVMBasedICFG &> llvmlcasolver(
+      *LCAProblem, true, true);
+  llvmlcasolver.solve();
+  const std::map<std::string, int64_t> gt = {
+      {"0", 42}, {"1", 42},  {"5", 42},        {"8", 0},
+      {"9", 42}, {"13", 42}, {"_Z3fooi.0", 42}};
+  compareResults(gt, llvmlcasolver);
+  // edit foo to int b = 13
+  llvm::Function *Foo = IRDB->getFunction("_Z3fooi");
+  llvm::StoreInst *Store = nullptr;
+  for (auto &I : llvm::instructions(Foo)) {
+    if (auto S = llvm::dyn_cast<llvm::StoreInst>(&I)) {
+      if (llvm::isa<llvm::LoadInst>(S->getValueOperand())) {
+        Store = S;
+      }
+    }
+  }
+  ASSERT_TRUE(Store);
+  Store->setOperand(
+      0, llvm::ConstantInt::get(Store->getValueOperand()->getType(), 13));
+  ICFG->updateFunctions({Foo});
+  // invalidating a callee must also invalidate its caller and yield the
+  // results of a from-scratch run
+  llvmlcasolver.update({Foo});
+  const std::map<std::string, int64_t> updatedgt = {
+      {"0", 42}, {"1", 13},  {"5", 42},        {"8", 0},
+      {"9", 42}, {"13", 42}, {"_Z3fooi.0", 42}};
+  compareResults(updatedgt, llvmlcasolver);
+  IDELinearConstantAnalysis FreshProblem(*ICFG, *TH, *IRDB, EntryPoints);
+  LLVMIDESolver<const llvm::Value *, int64_t, LLVMBasedICFG &> freshsolver(
+      FreshProblem, false, false);
+  freshsolver.solve();
+  compareResults(updatedgt, freshsolver);
+}
+
+/* ============== MEMORY PRESSURE TESTS ============== */
+TEST_F(IDELinearConstantAnalysisTest, HandleFinishedMethods_01) {
+  Initialize({pathToLLFiles + "call_02_cpp_dbg.ll"});
+  // phase II evaluates the jump functions at every node, so no context is
+  // released if the values are computed
+  LCAProblem->solver_config.collectFinishedMethods = true;
+  ReleasingLCASolver llvmlcasolver(*LCAProblem, false, false);
+  llvmlcasolver.solve();
+  EXPECT_EQ(0u, llvmlcasolver.releasedContexts());
+  const std::map<std::string, int64_t> gt = {
+      {"0", 2},  {"3", 2},   {"4", 42},       {"6", 0},
+      {"7", 42}, {"10", 42}, {"_Z3fooi.0", 2}};
+  compareResults(gt, llvmlcasolver);
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleFinishedMethods_02) {
+  // even() and odd() call each other, hence their contexts form a single
+  // component that is released once the exploration of even() returns
+  Initialize({pathToLLFiles + "recursion_01_cpp_dbg.ll"});
+  LCAProblem->solver_config.computeValues = false;
+  ReleasingLCASolver keepingsolver(*LCAProblem, false, false);
+  keepingsolver.solve();
+  IDELinearConstantAnalysis ReleasingProblem(*ICFG, *TH, *IRDB, EntryPoints);
+  ReleasingProblem.solver_config.computeValues = false;
+  ReleasingProblem.solver_config.collectFinishedMethods = true;
+  ReleasingLCASolver releasingsolver(ReleasingProblem, false, false);
+  releasingsolver.solve();
+  EXPECT_EQ(0u, keepingsolver.releasedContexts());
+  EXPECT_GE(releasingsolver.releasedContexts(), 2u);
+  EXPECT_LT(releasingsolver.jumpFunctions(), keepingsolver.jumpFunctions());
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleSharedFlowEdgeFunctions_01) {
+  Initialize({pathToLLFiles + "call_02_cpp_dbg.ll"});
+  // two solvers of separate problem instances share their flow and edge
+  // functions while running in parallel over the same ICFG
+  IDELinearConstantAnalysis OtherProblem(*ICFG, *TH, *IRDB, EntryPoints);
+  using Solver_t = LLVMIDESolver<const llvm::Value *, int64_t, LLVMBasedICFG &>;
+  Solver_t llvmlcasolver(*LCAProblem, false, false);
+  Solver_t othersolver(OtherProblem, false, false);
+  auto Store = std::make_shared<Solver_t::FlowEdgeFunctionStore>();
+  llvmlcasolver.shareFlowEdgeFunctions(Store);
+  othersolver.shareFlowEdgeFunctions(Store);
+  std::thread Other([&]() { othersolver.solve(); });
+  llvmlcasolver.solve();
+  Other.join();
+  const std::map<std::string, int64_t> gt = {
+      {"0", 2},  {"3", 2},   {"4", 42},       {"6", 0},
+      {"7", 42}, {"10", 42}, {"_Z3fooi.0", 2}};
+  compareResults(gt, llvmlcasolver);
+  compareResults(gt, othersolver);
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleStreamingExport_01) {
+  Initialize({pathToLLFiles + "call_01_cpp_dbg.ll"});
+  LLVMIDESolver<const llvm::Value *, int64_t, LLVMBasedICFG &> llvmlcasolver(
+      *LCAProblem, false, false);
+  llvmlcasolver.solve();
+  std::ostringstream OS;
+  {
+    JsonStreamWriter W(OS);
+    llvmlcasolver.emitResults(W);
+  }
+  EXPECT_EQ(json::parse(OS.str()), llvmlcasolver.getAsJson());
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleBinaryExport_01) {
+  Initialize({pathToLLFiles + "call_01_cpp_dbg.ll"});
+  LLVMIDESolver<const llvm::Value *, int64_t, LLVMBasedICFG &> llvmlcasolver(
+      *LCAProblem, false, false);
+  llvmlcasolver.solve();
+  std::ostringstream OS;
+  {
+    BinaryResultWriter W(OS);
+    llvmlcasolver.emitResults(W, false, [](const llvm::Instruction *I) {
+      return static_cast<uint32_t>(std::stoul(getMetaDataID(I)));
+    });
+  }
+  // without symbols there are only result records, which are keyed by the
+  // psr.id of their nodes
+  const std::string Out = OS.str();
+  ASSERT_EQ(0u, (Out.size() - 8) % 13);
+  auto readU32 = [&Out](std::size_t Pos) {
+    uint32_t V = 0;
+    for (int i = 3; i >= 0; --i) {
+      V = V << 8 | static_cast<unsigned char>(Out[Pos + i]);
+    }
+    return V;
+  };
+  std::set<uint32_t> Nodes;
+  std::set<uint32_t> ValueIDs;
+  for (std::size_t Pos = 8; Pos < Out.size(); Pos += 13) {
+    ASSERT_EQ('R', Out[Pos]);
+    Nodes.insert(readU32(Pos + 1));
+    ValueIDs.insert(readU32(Pos + 9));
+  }
+  std::set<uint32_t> Expected;
+  std::set<int64_t> Values;
+  for (auto F : IRDB->getAllFunctions()) {
+    for (auto &I : llvm::instructions(F)) {
+      auto Results = llvmlcasolver.resultsAt(&I);
+      if (!Results.empty()) {
+        Expected.insert(std::stoul(getMetaDataID(&I)));
+      }
+      for (auto &Result : Results) {
+        Values.insert(Result.second);
+      }
+    }
+  }
+  EXPECT_FALSE(Expected.empty());
+  EXPECT_EQ(Expected, Nodes);
+  // every distinct value is interned once, the IDs are numbered densely
+  ASSERT_FALSE(ValueIDs.empty());
+  EXPECT_EQ(Values.size(), ValueIDs.size());
+  EXPECT_EQ(ValueIDs.size() - 1, *ValueIDs.rbegin());
+}
+
 // main function for the test case
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
@@ -1,3 +1,5 @@
+#include <cstdio>
+
 #include <gtest/gtest.h>
 #include <phasar/DB/ProjectIRDB.h>
 #include <phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h>
@@ -5,10 +7,25 @@
 #include <phasar/PhasarLLVM/IfdsIde/Solver/LLVMIFDSSolver.h>
 #include <phasar/PhasarLLVM/Passes/ValueAnnotationPass.h>
 #include <phasar/PhasarLLVM/Pointer/LLVMTypeHierarchy.h>
+#include <phasar/PhasarLLVM/SyncPDS/Solver/SyncPDSSolver.h>
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
 
 using namespace std;
 using namespace psr;
 
+/* Exposes the bookkeeping of the released calling contexts. */
+class ReleasingSolver
+    : public LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> {
+public:
+  using LLVMIFDSSolver::LLVMIFDSSolver;
+
+  size_t releasedContexts() const { return this->ReleasedContexts; }
+  size_t jumpFunctions() const { return this->jumpFn->size(); }
+};
+
 /* ============== TEST FIXTURE ============== */
 
 class IFDSTaintAnalysisTest : public ::testing::Test {
@@ -62,6 +79,17 @@ protected:
     }
     EXPECT_EQ(FoundLeaks, GroundTruth);
   }
+
+  map<const llvm::Instruction *, set<const llvm::Value *>>
+  collectResults(LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> &Solver) {
+    map<const llvm::Instruction *, set<const llvm::Value *>> Results;
+    for (auto F : IRDB->getAllFunctions()) {
+      for (auto &I : llvm::instructions(F)) {
+        Results[&I] = Solver.ifdsResultsAt(&I);
+      }
+    }
+    return Results;
+  }
 }; // Test Fixture
 
 TEST_F(IFDSTaintAnalysisTest, TaintTest_01) {
@@ -135,6 +163,120 @@ TEST_F(IFDSTaintAnalysisTest, TaintTest_06) {
   compareResults(GroundTruth);
 }
 
+TEST_F(IFDSTaintAnalysisTest, TaintTest_07_AliasOracle) {
+  // P.first = &a; P.second = &b; source(P.first); sink(a); sink(b);
+  Initialize({pathToLLFiles + "dummy_source_sink/taint_07_cpp_dbg.ll"});
+  TSF->Sources.insert(make_pair(
+      "source(int*)",
+      TaintSensitiveFunctions::SourceFunction("source(int*)", {0}, false)));
+  IFDSTaintAnalysis OracleProblem(*ICFG, *TH, *IRDB, *TSF, EntryPoints);
+  SyncPDSSolver SPDS(*ICFG);
+  OracleProblem.setAliasOracle(SPDS);
+  LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> TaintSolver(
+      OracleProblem, false, false);
+  TaintSolver.solve();
+  vector<const llvm::Instruction *> Sinks;
+  for (auto &I : llvm::instructions(IRDB->getFunction("main"))) {
+    if (auto Call = llvm::dyn_cast<llvm::CallInst>(&I)) {
+      if (Call->getCalledFunction() &&
+          Call->getCalledFunction()->getName() == "_Z4sinki") {
+        Sinks.push_back(Call);
+      }
+    }
+  }
+  ASSERT_EQ(2, Sinks.size());
+  // the oracle tells the fields of P apart, only a is tainted through the
+  // pointer that is handed to the source
+  EXPECT_TRUE(OracleProblem.Leaks.count(Sinks[0]));
+  EXPECT_FALSE(OracleProblem.Leaks.count(Sinks[1]));
+}
+
+/* ============== MEMORY PRESSURE TESTS ============== */
+TEST_F(IFDSTaintAnalysisTest, TaintTest_05_ReleaseFinished) {
+  // void sink(int p) { int b = p; } ... int a = source(); sink(a);
+  Initialize({pathToLLFiles + "dummy_source_sink/taint_05_cpp_dbg.ll"});
+  TaintProblem->solver_config.computeValues = false;
+  ReleasingSolver KeepingSolver(*TaintProblem, false, false);
+  KeepingSolver.solve();
+  IFDSTaintAnalysis ReleasingProblem(*ICFG, *TH, *IRDB, *TSF, EntryPoints);
+  ReleasingProblem.solver_config.computeValues = false;
+  ReleasingProblem.solver_config.collectFinishedMethods = true;
+  ReleasingSolver TaintSolver(ReleasingProblem, false, false);
+  TaintSolver.solve();
+  EXPECT_EQ(0u, KeepingSolver.releasedContexts());
+  EXPECT_GT(TaintSolver.releasedContexts(), 0u);
+  // without values to compute, the jump functions of the finished contexts
+  // are removed rather than compacted
+  EXPECT_LT(TaintSolver.jumpFunctions(), KeepingSolver.jumpFunctions());
+  // the leaks are reported while the contexts are still being explored
+  EXPECT_EQ(TaintProblem->Leaks, ReleasingProblem.Leaks);
+  map<int, set<string>> GroundTruth;
+  GroundTruth[22] = set<string>{"21"};
+  compareResults(GroundTruth);
+}
+
+/* ============== INCREMENTAL TESTS ============== */
+TEST_F(IFDSTaintAnalysisTest, TaintStateRoundTrip_4) {
+  // void someFunction(int i, int &j) { j = i; } ... someFunction(argc, x);
+  Initialize({pathToLLFiles + "taint_4_cpp.ll"});
+  const string StatePath = "IFDSTaintAnalysisTest.state";
+  TaintProblem->solver_config.incremental = true;
+  LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> TaintSolver(
+      *TaintProblem, false, false);
+  TaintSolver.solve();
+  TaintSolver.saveState(StatePath, *IRDB);
+  // the leaks are not part of the state, only the facts are restored
+  IFDSTaintAnalysis RestoredProblem(*ICFG, *TH, *IRDB, *TSF, EntryPoints);
+  RestoredProblem.solver_config.incremental = true;
+  LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> RestoredSolver(
+      RestoredProblem, false, false);
+  EXPECT_TRUE(RestoredSolver.restoreState(StatePath, *IRDB).empty());
+  RestoredSolver.update({});
+  EXPECT_EQ(collectResults(TaintSolver), collectResults(RestoredSolver));
+  std::remove(StatePath.c_str());
+}
+
+TEST_F(IFDSTaintAnalysisTest, TaintStateAfterEdit_4) {
+  Initialize({pathToLLFiles + "taint_4_cpp.ll"});
+  const string StatePath = "IFDSTaintAnalysisTest.edit.state";
+  TaintProblem->solver_config.incremental = true;
+  LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> TaintSolver(
+      *TaintProblem, false, false);
+  TaintSolver.solve();
+  auto Before = collectResults(TaintSolver);
+  TaintSolver.saveState(StatePath, *IRDB);
+  // edit someFunction to j = 0, such that x is not tainted anymore
+  llvm::Function *F = IRDB->getFunction("_Z12someFunctioniRi");
+  ASSERT_TRUE(F);
+  llvm::StoreInst *Store = nullptr;
+  for (auto &I : llvm::instructions(F)) {
+    if (auto S = llvm::dyn_cast<llvm::StoreInst>(&I)) {
+      if (llvm::isa<llvm::LoadInst>(S->getValueOperand())) {
+        Store = S;
+      }
+    }
+  }
+  ASSERT_TRUE(Store);
+  Store->setOperand(
+      0, llvm::ConstantInt::get(Store->getValueOperand()->getType(), 0));
+  ICFG->updateFunctions({F});
+  IFDSTaintAnalysis RestoredProblem(*ICFG, *TH, *IRDB, *TSF, EntryPoints);
+  RestoredProblem.solver_config.incremental = true;
+  LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> RestoredSolver(
+      RestoredProblem, false, false);
+  auto Changed = RestoredSolver.restoreState(StatePath, *IRDB);
+  EXPECT_EQ(set<const llvm::Function *>({F}), Changed);
+  RestoredSolver.update(Changed);
+  IFDSTaintAnalysis FreshProblem(*ICFG, *TH, *IRDB, *TSF, EntryPoints);
+  LLVMIFDSSolver<const llvm::Value *, LLVMBasedICFG &> FreshSolver(
+      FreshProblem, false, false);
+  FreshSolver.solve();
+  auto After = collectResults(RestoredSolver);
+  EXPECT_NE(Before, After);
+  EXPECT_EQ(collectResults(FreshSolver), After);
+  std::remove(StatePath.c_str());
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
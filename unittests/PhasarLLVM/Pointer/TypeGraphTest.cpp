@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <phasar/DB/ProjectIRDB.h>
 #include <phasar/PhasarLLVM/Pointer/TypeGraphs/CachedTypeGraph.h>
+#include <phasar/PhasarLLVM/Pointer/TypeGraphs/IncrementalTypeGraph.h>
 #include <phasar/PhasarLLVM/Pointer/TypeGraphs/LazyTypeGraph.h>
 
 #include <boost/graph/isomorphism.hpp>
@@ -390,6 +391,56 @@ TEST_F(TypeGraphTest, TypeAggregation) {
               tg.g[vertexE].types.count(structD));
   ASSERT_TRUE(tg.g[vertexE].types.size() == 4);
 }
+
+TEST_F(TypeGraphTest, IncrementalTypePropagation) {
+  ProjectIRDB IRDB({pathToLLFiles + "basic/seven_structs_cpp.ll"});
+  llvm::Module *M =
+      IRDB.getModule(pathToLLFiles + "basic/seven_structs_cpp.ll");
+
+  vector<llvm::StructType *> structs;
+  for (auto struct_type : M->getIdentifiedStructTypes()) {
+    if (struct_type) {
+      structs.push_back(struct_type);
+    }
+  }
+  ASSERT_TRUE(structs.size() >= 5);
+  auto structA = structs[0], structB = structs[1], structC = structs[2],
+       structD = structs[3], structE = structs[4];
+
+  IncrementalTypeGraph tg;
+
+  ASSERT_TRUE(tg.addLink(structA, structB));
+  ASSERT_TRUE(tg.addLink(structB, structC));
+  ASSERT_TRUE(tg.addLink(structC, structD));
+  ASSERT_TRUE(tg.addLink(structE, structB));
+  ASSERT_FALSE(tg.addLink(structE, structB));
+
+  set<const llvm::StructType *> typesA = {structA, structB, structC, structD};
+  set<const llvm::StructType *> typesB = {structB, structC, structD};
+  set<const llvm::StructType *> typesD = {structD};
+  set<const llvm::StructType *> typesE = {structB, structC, structD, structE};
+  ASSERT_EQ(tg.getTypes(structA), typesA);
+  ASSERT_EQ(tg.getTypes(structB), typesB);
+  ASSERT_EQ(tg.getTypes(structD), typesD);
+  ASSERT_EQ(tg.getTypes(structE), typesE);
+
+  // closing the cycle B -> C -> D -> B collapses it
+  ASSERT_TRUE(tg.addLink(structD, structB));
+  ASSERT_FALSE(tg.addLink(structC, structB));
+  ASSERT_EQ(tg.getTypes(structA), typesA);
+  ASSERT_EQ(tg.getTypes(structB), typesB);
+  ASSERT_EQ(tg.getTypes(structC), typesB);
+  ASSERT_EQ(tg.getTypes(structD), typesB);
+  ASSERT_EQ(tg.getTypes(structE), typesE);
+
+  // new types reach the whole cycle and its predecessors
+  ASSERT_TRUE(tg.addLink(structC, structE));
+  set<const llvm::StructType *> typesCycle = {structB, structC, structD,
+                                              structE};
+  ASSERT_EQ(tg.getTypes(structB), typesCycle);
+  ASSERT_EQ(tg.getTypes(structE), typesCycle);
+  ASSERT_EQ(tg.getTypes(structA).size(), 5);
+}
 } // namespace psr
 
 int main(int argc, char **argv) {
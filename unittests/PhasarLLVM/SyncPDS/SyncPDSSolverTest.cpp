@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <phasar/DB/ProjectIRDB.h>
+#include <phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h>
+#include <phasar/PhasarLLVM/Pointer/LLVMTypeHierarchy.h>
+#include <phasar/PhasarLLVM/SyncPDS/Solver/SyncPDSSolver.h>
+#include <phasar/Utils/LLVMShorthands.h>
+
+#include <llvm/IR/CallSite.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class SyncPDSSolverTest : public ::testing::Test {
+protected:
+  const std::string pathToLLFiles =
+      PhasarDirectory + "build/test/llvm_test_code/pointers/";
+  const std::vector<std::string> EntryPoints = {"main"};
+
+  ProjectIRDB *IRDB;
+  LLVMTypeHierarchy *TH;
+  LLVMBasedICFG *ICFG;
+
+  SyncPDSSolverTest() = default;
+  virtual ~SyncPDSSolverTest() = default;
+
+  void Initialize(const std::vector<std::string> &IRFiles) {
+    IRDB = new ProjectIRDB(IRFiles);
+    IRDB->preprocessIR();
+    TH = new LLVMTypeHierarchy(*IRDB);
+    ICFG =
+        new LLVMBasedICFG(*TH, *IRDB, CallGraphAnalysisType::OTF, EntryPoints);
+  }
+
+  void SetUp() override { bl::core::get()->set_logging_enabled(false); }
+
+  void TearDown() override {
+    delete IRDB;
+    delete TH;
+    delete ICFG;
+  }
+
+  std::vector<const llvm::Instruction *> getCallsTo(const llvm::Function *F,
+                                                    const std::string &Name) {
+    std::vector<const llvm::Instruction *> Calls;
+    for (auto &I : llvm::instructions(F)) {
+      llvm::ImmutableCallSite CS(&I);
+      if (CS && CS.getCalledFunction() &&
+          CS.getCalledFunction()->getName() == Name) {
+        Calls.push_back(&I);
+      }
+    }
+    return Calls;
+  }
+}; // Test Fixture
+
+TEST_F(SyncPDSSolverTest, HandleContexts) {
+  Initialize({pathToLLFiles + "alias_context_01_cpp_m2r_dbg.ll"});
+  auto Main = IRDB->getFunction("main");
+  auto Calls = getCallsTo(Main, "_Z2idPi");
+  ASSERT_EQ(2, Calls.size());
+  const llvm::Value *A = llvm::ImmutableCallSite(Calls[0]).getArgument(0);
+  const llvm::Value *B = llvm::ImmutableCallSite(Calls[1]).getArgument(0);
+  SyncPDSSolver SPDS(*ICFG);
+  EXPECT_EQ(std::set<const llvm::Value *>{A},
+            SPDS.getAllocationSitesOf(Calls[0]));
+  auto Aliases = SPDS.getAliasesOf(Calls[0], Calls[0]);
+  EXPECT_TRUE(Aliases.count(A));
+  EXPECT_TRUE(Aliases.count(Calls[0]));
+  EXPECT_FALSE(Aliases.count(B));
+  EXPECT_FALSE(Aliases.count(Calls[1]));
+  // the formal of id() is visible in id() only
+  auto Id = IRDB->getFunction("_Z2idPi");
+  EXPECT_FALSE(Aliases.count(&*Id->arg_begin()));
+  EXPECT_TRUE(SPDS.getAliasesOf(Calls[0], nullptr).count(&*Id->arg_begin()));
+  // without any context both calls are merged
+  SyncPDSSolver Insensitive(*ICFG, 0);
+  EXPECT_TRUE(Insensitive.getAliasesOf(Calls[0], Calls[0]).count(B));
+}
+
+TEST_F(SyncPDSSolverTest, HandleFields) {
+  Initialize({pathToLLFiles + "alias_fields_01_cpp_m2r_dbg.ll"});
+  auto Main = IRDB->getFunction("main");
+  // P.first = &a; P.second = &b; int *x = P.first; *x = 3;
+  const llvm::Value *A = getNthStoreInstruction(Main, 3)->getValueOperand();
+  const llvm::Value *B = getNthStoreInstruction(Main, 4)->getValueOperand();
+  const llvm::Value *X = getNthStoreInstruction(Main, 5)->getPointerOperand();
+  SyncPDSSolver SPDS(*ICFG);
+  EXPECT_EQ(std::set<const llvm::Value *>{A}, SPDS.getAllocationSitesOf(X));
+  auto Aliases = SPDS.getAliasesOf(A, getNthStoreInstruction(Main, 5));
+  EXPECT_TRUE(Aliases.count(X));
+  EXPECT_FALSE(Aliases.count(B));
+  // cached and fresh results agree
+  EXPECT_EQ(Aliases, SPDS.getAliasesOf(A, getNthStoreInstruction(Main, 5)));
+  SPDS.clear();
+  EXPECT_EQ(Aliases, SPDS.getAliasesOf(A, getNthStoreInstruction(Main, 5)));
+}
+
+// main function for the test case
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
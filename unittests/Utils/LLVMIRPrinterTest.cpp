@@ -0,0 +1,135 @@
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <llvm/IR/InstIterator.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <phasar/DB/ProjectIRDB.h>
+#include <phasar/Utils/LLVMIRPrinter.h>
+#include <phasar/Utils/LLVMShorthands.h>
+
+using namespace std;
+using namespace psr;
+
+class LLVMIRPrinterTest : public ::testing::Test {
+protected:
+  const std::string pathToLLFiles =
+      PhasarDirectory + "build/test/llvm_test_code/";
+
+  // the uncached rendering llvmIRToString() used to perform
+  static string printUncached(const llvm::Value *V) {
+    string IRBuffer;
+    llvm::raw_string_ostream RSO(IRBuffer);
+    V->print(RSO);
+    RSO << ", ID: " << getMetaDataID(V);
+    RSO.flush();
+    IRBuffer.erase(0, IRBuffer.find_first_not_of(" \t"));
+    return IRBuffer;
+  }
+
+  void TearDown() override {
+    LLVMIRPrinter::getInstance().clear();
+    LLVMIRPrinter::getInstance().setCapacity(LLVMIRPrinter::DefaultCapacity);
+  }
+};
+
+TEST_F(LLVMIRPrinterTest, RendersLikeUncachedPrint) {
+  ProjectIRDB IRDB({pathToLLFiles + "control_flow/if_else_cpp.ll"});
+  IRDB.preprocessIR();
+  auto F = IRDB.getFunction("main");
+  auto &Printer = LLVMIRPrinter::getInstance();
+  for (auto &I : llvm::instructions(F)) {
+    size_t Cached = Printer.size();
+    EXPECT_EQ(Printer.getString(&I), printUncached(&I));
+    EXPECT_EQ(Cached + 1, Printer.size());
+    // the second lookup must be served from the cache
+    EXPECT_EQ(Printer.getString(&I), printUncached(&I));
+    EXPECT_EQ(Cached + 1, Printer.size());
+  }
+  for (auto &A : F->args()) {
+    EXPECT_EQ(llvmIRToString(&A), printUncached(&A));
+  }
+}
+
+TEST_F(LLVMIRPrinterTest, ParallelRenderAndReferences) {
+  ProjectIRDB IRDB({pathToLLFiles + "control_flow/if_else_cpp.ll"});
+  IRDB.preprocessIR();
+  auto &Printer = LLVMIRPrinter::getInstance();
+  vector<const llvm::Value *> Values;
+  vector<string> References;
+  for (auto F : IRDB.getAllFunctions()) {
+    for (auto &I : llvm::instructions(F)) {
+      Values.push_back(&I);
+      References.push_back(Printer.getReference(&I));
+    }
+  }
+  ASSERT_FALSE(Values.empty());
+  EXPECT_NE(References[0].find('.'), string::npos);
+  Printer.renderReferences(4);
+  for (size_t i = 0; i < Values.size(); ++i) {
+    EXPECT_EQ(Printer.resolve(References[i]), printUncached(Values[i]));
+  }
+  Printer.clear();
+  Printer.render(Values, 4);
+  for (auto V : Values) {
+    EXPECT_EQ(Printer.getString(V), printUncached(V));
+  }
+  EXPECT_EQ(Printer.resolve("unknown.1"), "unknown.1");
+}
+
+TEST_F(LLVMIRPrinterTest, ConcurrentLookups) {
+  ProjectIRDB IRDB({pathToLLFiles + "control_flow/if_else_cpp.ll"});
+  IRDB.preprocessIR();
+  auto &Printer = LLVMIRPrinter::getInstance();
+  vector<const llvm::Value *> Values;
+  vector<string> Expected;
+  for (auto F : IRDB.getAllFunctions()) {
+    for (auto &I : llvm::instructions(F)) {
+      Values.push_back(&I);
+      Expected.push_back(printUncached(&I));
+    }
+  }
+  // the values are printed outside of the printer's lock
+  vector<vector<string>> Found(4);
+  vector<thread> Workers;
+  for (auto &Strings : Found) {
+    Workers.emplace_back([&Printer, &Values, &Strings]() {
+      for (auto V : Values) {
+        Strings.push_back(Printer.getString(V));
+      }
+    });
+  }
+  for (auto &W : Workers) {
+    W.join();
+  }
+  for (auto &Strings : Found) {
+    EXPECT_EQ(Expected, Strings);
+  }
+  EXPECT_EQ(Values.size(), Printer.size());
+}
+
+TEST_F(LLVMIRPrinterTest, BoundedCache) {
+  ProjectIRDB IRDB({pathToLLFiles + "control_flow/if_else_cpp.ll"});
+  IRDB.preprocessIR();
+  auto &Printer = LLVMIRPrinter::getInstance();
+  Printer.setCapacity(4);
+  vector<const llvm::Value *> Values;
+  for (auto F : IRDB.getAllFunctions()) {
+    for (auto &I : llvm::instructions(F)) {
+      Values.push_back(&I);
+    }
+  }
+  ASSERT_GT(Values.size(), 4u);
+  Printer.render(Values, 2);
+  EXPECT_LE(Printer.size(), 4u);
+  for (auto V : Values) {
+    EXPECT_EQ(Printer.getString(V), printUncached(V));
+    EXPECT_LE(Printer.size(), 4u);
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <gtest/gtest.h>
 #include <iostream>
 #include <llvm/IR/IntrinsicInst.h>
@@ -89,6 +92,67 @@ TEST_F(LLVMIRToSrcTest, HandleAlloca) {
   }
 }
 
+TEST_F(LLVMIRToSrcTest, HandleBatch) {
+  Initialize({pathToLLFiles + "function_call_cpp_dbg.ll"});
+  auto Fmain = ICFG->getMethod("main");
+  std::vector<const llvm::Value *> Values;
+  for (auto &BB : *Fmain) {
+    for (auto &I : BB) {
+      Values.push_back(&I);
+    }
+  }
+  auto Src = llvmValuesToSrc(Values);
+  ASSERT_EQ(Values.size(), Src.size());
+  for (size_t i = 0; i < Values.size(); ++i) {
+    EXPECT_EQ(llvmValueToSrc(Values[i]), Src[i]);
+  }
+}
+
+TEST_F(LLVMIRToSrcTest, HandleBatchOfVariables) {
+  Initialize({pathToLLFiles + "global_02_cpp_dbg.ll"});
+  std::vector<const llvm::Value *> Values = {
+      IRDB->getModule(pathToLLFiles + "global_02_cpp_dbg.ll")
+          ->getGlobalVariable("g")};
+  ASSERT_NE(nullptr, Values.front());
+  for (auto A : IRDB->getAllocaInstructions()) {
+    Values.push_back(A);
+  }
+  auto Src = llvmValuesToSrc(Values);
+  ASSERT_EQ(Values.size(), Src.size());
+  for (size_t i = 0; i < Values.size(); ++i) {
+    EXPECT_EQ(llvmValueToSrc(Values[i]), Src[i]);
+  }
+  // the global and the local variable keep their source locations
+  EXPECT_EQ(0u, Src.front().find("Var : g\nLine: 1\n"));
+  EXPECT_EQ(1, std::count_if(Src.begin(), Src.end(), [](const std::string &S) {
+              return S.find("Var : i\nLine: 4\n") == 0;
+            }));
+}
+
+TEST_F(LLVMIRToSrcTest, HandleSourceFileCache) {
+  std::string Path = "source_file_cache_test.cpp";
+  {
+    std::ofstream ofs(Path);
+    ofs << "int main() {\n  int i = 42;\r\n\n  return i; }";
+  }
+  auto &Cache = SourceFileCache::getInstance();
+  std::string Line;
+  ASSERT_TRUE(Cache.getLine(Path, 2, Line));
+  EXPECT_EQ("int i = 42;", Line);
+  ASSERT_TRUE(Cache.getLine(Path, 3, Line));
+  EXPECT_EQ("", Line);
+  ASSERT_TRUE(Cache.getLine(Path, 4, Line));
+  EXPECT_EQ("return i; }", Line);
+  ASSERT_TRUE(Cache.getLine(Path, 5, Line));
+  EXPECT_EQ("", Line);
+  // the file is served from the cache until it is cleared
+  std::remove(Path.c_str());
+  ASSERT_TRUE(Cache.getLine(Path, 1, Line));
+  EXPECT_EQ("int main() {", Line);
+  Cache.clear();
+  EXPECT_FALSE(Cache.getLine(Path, 1, Line));
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
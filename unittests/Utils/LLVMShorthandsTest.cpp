@@ -3,6 +3,11 @@
 #include <phasar/Utils/LLVMShorthands.h>
 #include <phasar/Utils/Macros.h>
 
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/SourceMgr.h>
+
 using namespace std;
 using namespace psr;
 
@@ -111,6 +116,35 @@ TEST_F(LLVMGetterTest, HandleFunctionsContainingCodesInName) {
             SpecialMemberFunctionTy::NONE);
 }
 
+TEST_F(LLVMGetterTest, HandleFunctionHashOfMetadata) {
+  auto HashOf = [](const std::string &IR) {
+    llvm::LLVMContext Ctx;
+    llvm::SMDiagnostic Err;
+    auto M = llvm::parseAssemblyString(IR, Err, Ctx);
+    EXPECT_TRUE(M);
+    return M ? computeFunctionHash(M->getFunction("f")) : 0;
+  };
+  // metadata attachments and their slot numbers do not contribute
+  EXPECT_EQ(HashOf("define void @f() {\n"
+                   "  ret void, !foo !0\n"
+                   "}\n"
+                   "!0 = !{}\n"),
+            HashOf("define void @f() {\n"
+                   "  ret void, !foo !1, !bar !0\n"
+                   "}\n"
+                   "!0 = !{}\n"
+                   "!1 = !{}\n"));
+  // whereas string constants that look like attachments do
+  EXPECT_NE(HashOf("define void @f() {\n"
+                   "  call void asm sideeffect \"nop !foo !0\", \"\"()\n"
+                   "  ret void\n"
+                   "}\n"),
+            HashOf("define void @f() {\n"
+                   "  call void asm sideeffect \"nop !foo !1\", \"\"()\n"
+                   "  ret void\n"
+                   "}\n"));
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
 #include <iostream>
 #include <phasar/Utils/PAMM.h>
+#include <stdexcept>
 #include <thread>
+#include <vector>
 
 using namespace psr;
 
@@ -102,6 +104,104 @@ TEST_F(PAMMTest, HandleJSONOutput) {
   pamm.exportMeasuredData("HandleJSONOutputTest");
 }
 
+TEST_F(PAMMTest, HandleConcurrentCounter) {
+  PAMM &pamm = PAMM::getInstance();
+  PAMM::Handle counter = pamm.getHandle("concurrent");
+  EXPECT_EQ(pamm.getHandle("concurrent"), counter);
+  pamm.regCounter(counter, 10);
+  pamm.regHistogram("concurrentHist");
+  PAMM::Handle hist = pamm.getHandle("concurrentHist");
+  PAMM::Handle timer = pamm.getHandle("concurrentTimer");
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&]() {
+      for (int j = 0; j < 100000; ++j) {
+        pamm.incCounter(counter);
+      }
+      pamm.decCounter(counter, 5);
+      pamm.addToHistogram(hist, "1");
+      pamm.startTimer(timer);
+      pamm.stopTimer(timer, true);
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(pamm.getCounter("concurrent"), 10 + 4 * (100000 - 5));
+  EXPECT_EQ(pamm.elapsedTimeOfRepeatingTimer()["concurrentTimer"].size(), 4u);
+  // handles stay valid across resets
+  pamm.reset();
+  pamm.regCounter(counter);
+  EXPECT_EQ(pamm.getCounter(counter), 0);
+}
+
+TEST_F(PAMMTest, HandleRestartedTimer) {
+  PAMM &pamm = PAMM::getInstance();
+  // stopped in one thread, run again by another one
+  std::thread first([&]() {
+    pamm.startTimer("restarted");
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    pamm.stopTimer("restarted");
+  });
+  first.join();
+  std::thread second([&]() {
+    pamm.startTimer("restarted");
+    pamm.stopTimer("restarted");
+  });
+  second.join();
+  EXPECT_GE(pamm.elapsedTimeOfSingleTimer()["restarted"], 50);
+  // and one run after another by the same thread
+  pamm.startTimer("restarted");
+  pamm.stopTimer("restarted");
+  pamm.startTimer("restarted");
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  pamm.stopTimer("restarted");
+  EXPECT_GE(pamm.elapsedTime("restarted"), 20);
+  EXPECT_LT(pamm.elapsedTime("restarted"), 50);
+}
+
+TEST_F(PAMMTest, HandleScopedTimer) {
+  PAMM &pamm = PAMM::getInstance();
+  try {
+    PAMM::ScopedTimer Timer(pamm, "scoped");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    throw std::runtime_error("analysis failed");
+  } catch (const std::runtime_error &) {
+  }
+  // stopped while unwinding, so it can be started again
+  EXPECT_GE(pamm.elapsedTime("scoped"), 20);
+  { PAMM::ScopedTimer Timer(pamm, "scoped"); }
+  EXPECT_LT(pamm.elapsedTime("scoped"), 20);
+  { PAMM::ScopedTimer Timer(pamm, "inactive", false); }
+  EXPECT_EQ(0u, pamm.elapsedTimeOfSingleTimer().count("inactive"));
+}
+
+TEST_F(PAMMTest, HandleSharedCounter) {
+  PAMM &pamm = PAMM::getInstance();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&]() {
+      pamm.regSharedCounter("shared");
+      pamm.incCounter("shared", 3);
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(pamm.getCounter("shared"), 12);
+}
+
+TEST_F(PAMMTest, HandleManyIds) {
+  PAMM &pamm = PAMM::getInstance();
+  for (unsigned i = 0; i < 5000; ++i) {
+    pamm.regCounter("many" + std::to_string(i), i);
+  }
+  PAMM::Handle last = pamm.getHandle("many4999");
+  pamm.incCounter(last);
+  EXPECT_EQ(pamm.getCounter(last), 5000);
+  EXPECT_EQ(pamm.getCounter("many1234"), 1234);
+}
+
 TEST_F(PAMMTest, DISABLED_PerformanceTimerBasic) {
   time_point start_1 = std::chrono::high_resolution_clock::now();
   std::this_thread::sleep_for(std::chrono::milliseconds(10));
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include <phasar/Utils/Parallel.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace psr;
+
+TEST(ParallelTest, HandleEveryIndexOnce) {
+  std::vector<std::atomic<unsigned>> Calls(1000);
+  std::size_t Threads = parallelForEach(
+      Calls.size(), 4, [&](std::size_t i) { ++Calls[i]; });
+  EXPECT_EQ(4u, Threads);
+  for (auto &C : Calls) {
+    EXPECT_EQ(1u, C.load());
+  }
+  // never more threads than indices
+  EXPECT_EQ(2u, parallelForEach(2, 8, [](std::size_t) {}));
+  EXPECT_LE(parallelForEach(2, 0, [](std::size_t) {}), 2u);
+  EXPECT_EQ(0u, parallelForEach(0, 4, [](std::size_t) {}));
+}
+
+TEST(ParallelTest, HandleExceptions) {
+  std::atomic<unsigned> Calls(0);
+  try {
+    parallelForEach(100, 4, [&](std::size_t i) {
+      ++Calls;
+      if (i == 42 || i == 77) {
+        throw std::runtime_error(std::to_string(i));
+      }
+    });
+    FAIL() << "the exception has not been rethrown";
+  } catch (const std::runtime_error &E) {
+    // the remaining indices are processed, the lowest failure is reported
+    EXPECT_EQ(100u, Calls.load());
+    EXPECT_STREQ("42", E.what());
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <phasar/Utils/Profiler.h>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace psr;
+
+/* Test fixture */
+class ProfilerTest : public ::testing::Test {
+protected:
+  ProfilerTest() {}
+  virtual ~ProfilerTest() {}
+
+  virtual void SetUp() {
+    Profiler &P = Profiler::getInstance();
+    P.reset();
+    P.setEnabled(true);
+    P.setTraceThreshold(std::chrono::microseconds(0));
+  }
+
+  virtual void TearDown() {
+    Profiler &P = Profiler::getInstance();
+    P.setEnabled(false);
+    P.reset();
+  }
+
+  std::string folded(bool Edges = false) {
+    std::ostringstream OS;
+    Profiler::getInstance().exportFoldedStacks(OS, Edges);
+    return OS.str();
+  }
+};
+
+void recurse(int Depth) {
+  PROFILE_METHOD("recurse", "f" + std::to_string(Depth % 2));
+  PROFILE_COUNT_EDGES(1);
+  if (Depth > 0) {
+    recurse(Depth - 1);
+  }
+}
+
+TEST_F(ProfilerTest, HandleNestedScopes) {
+  {
+    PROFILE_SCOPE("outer");
+    {
+      PROFILE_SCOPE_DETAIL("inner", std::string("a;b"));
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    {
+      PROFILE_SCOPE("inner");
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+  std::string Stacks = folded();
+  EXPECT_NE(std::string::npos, Stacks.find("outer;inner(a:b) "));
+  EXPECT_NE(std::string::npos, Stacks.find("outer;inner "));
+  std::ostringstream Summary;
+  Profiler::getInstance().printSummary(Summary);
+  EXPECT_NE(std::string::npos, Summary.str().find("inner(a:b)"));
+}
+
+TEST_F(ProfilerTest, HandleMethodSpans) {
+  {
+    PROFILE_SCOPE("solve");
+    recurse(5);
+  }
+  // method spans are flattened below the enclosing scope
+  EXPECT_EQ("solve;recurse(f0) 3\nsolve;recurse(f1) 3\n", folded(true));
+}
+
+TEST_F(ProfilerTest, HandleDisabled) {
+  Profiler::getInstance().setEnabled(false);
+  {
+    PROFILE_SCOPE("solve");
+    recurse(3);
+  }
+  EXPECT_EQ("", folded(true));
+  std::ostringstream Trace;
+  Profiler::getInstance().exportChromeTrace(Trace);
+  EXPECT_EQ("{\"traceEvents\":[],\"displayTimeUnit\":\"ms\"}", Trace.str());
+}
+
+TEST_F(ProfilerTest, HandleChromeTrace) {
+  {
+    PROFILE_SCOPE_DETAIL("scope", std::string("main"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  std::thread T([]() { PROFILE_SCOPE("worker"); });
+  T.join();
+  std::ostringstream Trace;
+  Profiler::getInstance().exportChromeTrace(Trace);
+  const std::string &S = Trace.str();
+  EXPECT_NE(std::string::npos, S.find("\"name\":\"scope\""));
+  EXPECT_NE(std::string::npos, S.find("\"args\":{\"detail\":\"main\"}"));
+  EXPECT_NE(std::string::npos, S.find("\"name\":\"worker\""));
+  EXPECT_NE(std::string::npos, S.find("\"ph\":\"X\""));
+  // only spans longer than the threshold are traced
+  Profiler::getInstance().reset();
+  Profiler::getInstance().setTraceThreshold(std::chrono::seconds(10));
+  {
+    PROFILE_SCOPE("short");
+  }
+  std::ostringstream Empty;
+  Profiler::getInstance().exportChromeTrace(Empty);
+  EXPECT_EQ(std::string::npos, Empty.str().find("short"));
+}
+
+// main function for the test case
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
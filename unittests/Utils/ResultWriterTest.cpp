@@ -0,0 +1,164 @@
+#include <climits>
+#include <cstdint>
+#include <map>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <json.hpp>
+#include <phasar/Utils/ResultWriter.h>
+
+using namespace std;
+using namespace psr;
+using json = nlohmann::json;
+
+TEST(ResultWriterTest, JsonStreamMatchesDocument) {
+  ostringstream OS;
+  {
+    JsonStreamWriter W(OS);
+    W.beginArray();
+    W.beginObject();
+    W.key("DataFlow");
+    W.beginObject();
+    W.key("main::%1 = \"quoted\"\n");
+    W.beginObject();
+    W.key("Facts");
+    W.beginArray();
+    W.beginArray();
+    W.value("%1");
+    W.value("BOTTOM");
+    W.endArray();
+    W.endArray();
+    W.endObject();
+    W.key("main::ret");
+    W.null();
+    W.endObject();
+    W.endObject();
+    W.beginObject();
+    W.key("DataFlow");
+    W.value("EMPTY");
+    W.key("Count");
+    W.value(int64_t(-42));
+    W.key("Done");
+    W.value(true);
+    W.endObject();
+    W.endArray();
+  }
+  json Expected;
+  Expected[0]["DataFlow"]["main::%1 = \"quoted\"\n"]["Facts"] +=
+      {"%1", "BOTTOM"};
+  Expected[0]["DataFlow"]["main::ret"];
+  Expected[1]["DataFlow"] = "EMPTY";
+  Expected[1]["Count"] = -42;
+  Expected[1]["Done"] = true;
+  ASSERT_EQ(json::parse(OS.str()), Expected);
+}
+
+TEST(ResultWriterTest, BinaryRecords) {
+  ostringstream OS;
+  BinaryResultWriter W(OS);
+  W.beginAnalysis("ide_lca");
+  W.addResult(0, 1, 258);
+  W.addSymbol(BinaryResultWriter::SymbolKind::Fact, 1, "%x");
+  const string Expected("PSRR\x01\x00\x00\x00"
+                        "A\x07\x00\x00\x00ide_lca"
+                        "R\x00\x00\x00\x00\x01\x00\x00\x00\x02\x01\x00\x00"
+                        "S\x01\x01\x00\x00\x00\x02\x00\x00\x00%x",
+                        4 + 4 + 1 + 4 + 7 + 1 + 12 + 1 + 1 + 4 + 4 + 2);
+  ASSERT_EQ(OS.str(), Expected);
+}
+
+TEST(ResultWriterTest, BinaryEdgeLogRecords) {
+  ostringstream OS;
+  BinaryEdgeLogWriter W(OS);
+  W.addEdges(true, 1, 300, 2, {0, 128});
+  W.addSymbol(BinaryEdgeLogWriter::SymbolKind::Node, 300, "ret");
+  // small numbers take a single byte, larger ones are LEB128 encoded
+  const string Expected("PSRE\x01\x00\x00\x00"
+                        "E\x01\x01\xac\x02\x02\x02\x00\x80\x01"
+                        "S\x00\xac\x02\x03ret",
+                        4 + 4 + 1 + 1 + 1 + 2 + 1 + 1 + 1 + 2 + 1 + 1 + 2 +
+                            1 + 3);
+  ASSERT_EQ(OS.str(), Expected);
+}
+
+/* Reads an edge log as written by BinaryEdgeLogWriter. */
+struct EdgeLogReader {
+  istringstream IS;
+
+  explicit EdgeLogReader(const string &Log) : IS(Log) {}
+
+  uint64_t readVar() {
+    uint64_t V = 0;
+    for (unsigned Shift = 0;; Shift += 7) {
+      int Byte = IS.get();
+      V |= static_cast<uint64_t>(Byte & 0x7f) << Shift;
+      if (!(Byte & 0x80)) {
+        return V;
+      }
+    }
+  }
+
+  string readString() {
+    string S(readVar(), '\0');
+    IS.read(&S[0], S.size());
+    return S;
+  }
+};
+
+TEST(ResultWriterTest, BinaryEdgeLogRoundTrip) {
+  using Edge = tuple<bool, uint32_t, uint32_t, uint32_t, vector<uint32_t>>;
+  const vector<Edge> Edges = {
+      Edge(false, 0, 1, 0, {0, 1}), Edge(true, 1, 70000, 1, {}),
+      Edge(false, 127, 128, 16384, {UINT32_MAX, 2, 3})};
+  const map<uint32_t, string> Symbols = {
+      {0, "main::%1 = alloca i32"}, {1, string(200, 'x')}, {70000, ""}};
+  ostringstream OS;
+  {
+    BinaryEdgeLogWriter W(OS);
+    for (auto &Symbol : Symbols) {
+      W.addSymbol(BinaryEdgeLogWriter::SymbolKind::Fact, Symbol.first,
+                  Symbol.second);
+    }
+    for (auto &E : Edges) {
+      W.addEdges(get<0>(E), get<1>(E), get<2>(E), get<3>(E), get<4>(E));
+    }
+  }
+  EdgeLogReader R(OS.str());
+  char Magic[4];
+  R.IS.read(Magic, 4);
+  ASSERT_EQ("PSRE", string(Magic, 4));
+  uint32_t Version = 0;
+  for (unsigned Byte = 0; Byte < 4; ++Byte) {
+    Version |= static_cast<uint32_t>(R.IS.get()) << (8 * Byte);
+  }
+  EXPECT_EQ(BinaryEdgeLogWriter::Version, Version);
+  vector<Edge> ReadEdges;
+  map<uint32_t, string> ReadSymbols;
+  for (int Tag = R.IS.get(); Tag != EOF; Tag = R.IS.get()) {
+    if (Tag == 'S') {
+      ASSERT_EQ(static_cast<int>(BinaryEdgeLogWriter::SymbolKind::Fact),
+                R.IS.get());
+      uint32_t ID = R.readVar();
+      ReadSymbols[ID] = R.readString();
+    } else {
+      ASSERT_EQ('E', Tag);
+      bool Inter = R.IS.get();
+      uint32_t Source = R.readVar(), Target = R.readVar(),
+               SourceFact = R.readVar();
+      vector<uint32_t> TargetFacts(R.readVar());
+      for (auto &Fact : TargetFacts) {
+        Fact = R.readVar();
+      }
+      ReadEdges.emplace_back(Inter, Source, Target, SourceFact, TargetFacts);
+    }
+  }
+  EXPECT_EQ(Edges, ReadEdges);
+  EXPECT_EQ(Symbols, ReadSymbols);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}